@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2016-2017 Nick Naumenko (https://github.com/nnaumenko)
+ * All rights reserved
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+/**
+ * @file
+ * @brief Filter checkpoint.
+ *
+ * Periodically saves state of the registered filters to RTC memory or EEPROM and
+ * restores it after restart.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "module.h"
+#include "util_data.h"
+
+namespace checkpoint {
+
+#ifdef MODULE_TEXT
+#undef MODULE_TEXT
+#endif
+#define MODULE_TEXT(name,value) public: const char name [sizeof(value)] = value
+
+/// String literals used internally by FilterCheckpoint module
+class Texts {
+    MODULE_TEXT(moduleName, "FilterCheckpoint");
+} __attribute__((packed));
+
+extern const Texts PROGMEM texts;
+
+#undef MODULE_TEXT
+
+/// @brief Checkpoint storage in RTC user memory of ESP8266
+/// @details RTC memory keeps its contents during reset (including watchdog reset and
+/// system_restart()) and deep sleep, but not when the power is lost. RTC memory does
+/// not wear out and is suitable for frequent checkpoints.
+/// @tparam Offset Offset from the beginning of RTC user memory in bytes, must be a
+/// multiple of 4
+template <size_t Offset = 0>
+class RTCMemoryStorage {
+  public:
+    static const size_t blockSize = sizeof(uint32_t);
+    static const size_t capacity = 512 - Offset; ///< Size of RTC user memory available for checkpoint, in bytes
+    static_assert(!(Offset % blockSize), "RTC memory offset must be a multiple of 4");
+    static_assert(Offset < 512, "RTC memory offset exceeds RTC user memory size");
+  public:
+    static boolean read(size_t address, uint32_t * data, size_t size) {
+      /// @brief Reads data from RTC memory
+      /// @param address Address relative to Offset, multiple of 4
+      /// @param data 4-byte aligned buffer to read data to
+      /// @param size Number of bytes to read, multiple of 4
+      /// @return true if data were read, false otherwise
+      return (ESP.rtcUserMemoryRead((Offset + address) / blockSize, data, size));
+    }
+    static boolean write(size_t address, const uint32_t * data, size_t size) {
+      /// @brief Writes data to RTC memory
+      /// @param address Address relative to Offset, multiple of 4
+      /// @param data 4-byte aligned data to write
+      /// @param size Number of bytes to write, multiple of 4
+      /// @return true if data were written, false otherwise
+      return (ESP.rtcUserMemoryWrite((Offset + address) / blockSize, const_cast<uint32_t *>(data), size));
+    }
+};
+
+/// @brief Checkpoint storage in emulated EEPROM (flash memory)
+/// @details EEPROM keeps its contents when the power is lost, but flash memory wears
+/// out after a limited number of erase cycles; checkpoint period should be long
+/// (hours) if this storage is used. EEPROM contents are only written if changed.
+/// @tparam Address Address of the checkpoint area in EEPROM; must not overlap with
+/// the area used to save configuration (see eeprom_config.h)
+/// @tparam Size Size of the checkpoint area in EEPROM, in bytes
+template <size_t Address, size_t Size>
+class EEPROMStorage {
+  public:
+    static const size_t blockSize = sizeof(uint32_t);
+    static const size_t capacity = Size;
+  public:
+    static boolean read(size_t address, uint32_t * data, size_t size) {
+      /// @brief Reads data from EEPROM
+      /// @param address Address relative to Address
+      /// @param data Buffer to read data to
+      /// @param size Number of bytes to read
+      /// @return true if data were read, false otherwise
+      if ((address + size) > Size) return (false);
+      uint8_t * dataBytes = reinterpret_cast<uint8_t *>(data);
+      EEPROM.begin(Address + Size);
+      for (size_t i = 0; i < size; i++)
+        dataBytes[i] = EEPROM.read(Address + address + i);
+      EEPROM.end();
+      return (true);
+    }
+    static boolean write(size_t address, const uint32_t * data, size_t size) {
+      /// @brief Writes data to EEPROM
+      /// @param address Address relative to Address
+      /// @param data Data to write
+      /// @param size Number of bytes to write
+      /// @return true if data were written, false otherwise
+      if ((address + size) > Size) return (false);
+      const uint8_t * dataBytes = reinterpret_cast<const uint8_t *>(data);
+      EEPROM.begin(Address + Size);
+      for (size_t i = 0; i < size; i++)
+        if (EEPROM.read(Address + address + i) != dataBytes[i]) EEPROM.write(Address + address + i, dataBytes[i]);
+      EEPROM.end();
+      return (true);
+    }
+};
+
+/// @brief Filter checkpoint
+/// @details Keeps a list of filters and saves their state (see
+/// util::dsp::TemplateFilter::saveState()) to Storage every time onRun() is called
+/// (see ModuleTimings::setRunPeriod()). After restart, restore() loads the state saved
+/// last time, so that the filters continue from the warm state instead of starting over.
+/// @par Checkpoint consists of header (signature, crc16 checksum, size and number of
+/// filters) and filter states in order of the list; each state is preceded by its size.
+/// Filters are matched by their position in the list, thus after restart the filters
+/// must be added in the same order and with the same parameters. The state of the filter
+/// which cannot be restored (e.g. because of changed filter parameters) is skipped.
+/// @tparam Storage Storage policy, see RTCMemoryStorage and EEPROMStorage
+/// @tparam MaxFilters Maximum number of filters in the list
+/// @tparam BufferSize Maximum size of checkpoint in bytes
+template <class Storage, size_t MaxFilters = 4, size_t BufferSize = 256>
+class FilterCheckpoint : public Module<FilterCheckpoint<Storage, MaxFilters, BufferSize>> {
+  public:
+    boolean add(const char * PROGMEM name, util::dsp::Filter * filter);
+    boolean remove(const util::dsp::Filter * filter);
+    inline size_t count(void) const;
+  public:
+    boolean save(void);
+    size_t restore(util::Timestamp timestamp);
+  public:
+    inline const char * PROGMEM moduleName (void);
+    void onRun(void);
+  private:
+    struct Header {
+      uint16_t signature;
+      uint16_t checksum;     ///< crc16 of filter states
+      uint16_t size;         ///< Size of filter states in bytes
+      uint8_t filtersNumber;
+      uint8_t reserved;
+    };
+    typedef uint16_t state_size_t;
+    static const uint16_t signature = 0xF17C;
+    static const size_t blockSize = Storage::blockSize;
+    static const size_t bufferBlocks = (BufferSize + blockSize - 1) / blockSize;
+    static_assert(!(sizeof(Header) % blockSize), "Checkpoint header size must be a multiple of storage block size");
+    static_assert((bufferBlocks * blockSize + sizeof(Header)) <= Storage::capacity, "Checkpoint does not fit into storage");
+    static inline size_t roundUp(size_t size);
+  private:
+    struct Item {
+      const char * PROGMEM name;
+      util::dsp::Filter * filter;
+    };
+    Item items[MaxFilters] = {};
+    size_t itemsCount = 0;
+    uint32_t buffer[bufferBlocks];
+};
+
+/// @brief Adds filter to the list
+/// @details If the list already contains a filter with the same name (the same
+/// PROGMEM pointer), that filter is replaced and keeps its position in the list; this
+/// allows to re-create filters at run-time.
+/// @param name C-string in PROGMEM, human-readable filter name
+/// @param filter Filter to save and restore
+/// @return true if filter was added or replaced, false if the list is full or
+/// parameters are incorrect
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+boolean FilterCheckpoint<Storage, MaxFilters, BufferSize>::add(const char * PROGMEM name, util::dsp::Filter * filter) {
+  if (!name || !filter) return (false);
+  for (size_t i = 0; i < itemsCount; i++) {
+    if (items[i].name == name) {
+      items[i].filter = filter;
+      return (true);
+    }
+  }
+  if (itemsCount >= MaxFilters) return (false);
+  items[itemsCount].name = name;
+  items[itemsCount].filter = filter;
+  itemsCount++;
+  return (true);
+}
+
+/// @brief Removes filter from the list
+/// @details Must be called before the filter is deleted, unless it is replaced with
+/// add().
+/// @param filter Filter to remove
+/// @return true if filter was found and removed, false otherwise
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+boolean FilterCheckpoint<Storage, MaxFilters, BufferSize>::remove(const util::dsp::Filter * filter) {
+  for (size_t i = 0; i < itemsCount; i++) {
+    if (items[i].filter == filter) {
+      itemsCount--;
+      for (size_t j = i; j < itemsCount; j++)
+        items[j] = items[j + 1];
+      return (true);
+    }
+  }
+  return (false);
+}
+
+/// @brief Returns number of filters in the list
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+size_t FilterCheckpoint<Storage, MaxFilters, BufferSize>::count(void) const {
+  return (itemsCount);
+}
+
+/// @brief Rounds size up to the multiple of storage block size
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+size_t FilterCheckpoint<Storage, MaxFilters, BufferSize>::roundUp(size_t size) {
+  return ((size + blockSize - 1) / blockSize * blockSize);
+}
+
+/// @brief Saves state of all filters in the list to storage
+/// @details The state of the filter which does not support saving state or was not
+/// initialised is saved as empty and is skipped by restore().
+/// @return true if checkpoint was saved, false if the filter states do not fit into
+/// BufferSize or storage write failed
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+boolean FilterCheckpoint<Storage, MaxFilters, BufferSize>::save(void) {
+  uint8_t * bufferBytes = reinterpret_cast<uint8_t *>(buffer);
+  size_t size = 0;
+  for (size_t i = 0; i < itemsCount; i++) {
+    if ((size + sizeof(state_size_t)) > BufferSize) return (false);
+    const state_size_t stateSize = items[i].filter->saveState(bufferBytes + size + sizeof(state_size_t), BufferSize - size - sizeof(state_size_t));
+    if (!stateSize && items[i].filter->getStateSize()) return (false);
+    memcpy(bufferBytes + size, &stateSize, sizeof(state_size_t));
+    size += sizeof(state_size_t) + stateSize;
+  }
+  memset(bufferBytes + size, 0, roundUp(size) - size);
+  Header header;
+  header.signature = signature;
+  header.checksum = util::checksum::crc16(buffer, size);
+  header.size = size;
+  header.filtersNumber = itemsCount;
+  header.reserved = 0;
+  uint32_t headerBlocks[sizeof(Header) / blockSize];
+  memcpy(headerBlocks, &header, sizeof(Header));
+  if (!Storage::write(sizeof(Header), buffer, roundUp(size))) return (false);
+  return (Storage::write(0, headerBlocks, sizeof(Header)));
+}
+
+/// @brief Restores state of the filters in the list from storage
+/// @details Call after all filters are added to the list. If checkpoint is missing or
+/// corrupted, or the number of filters differs, no filter state is modified.
+/// @param timestamp Timestamp for the restored states (normally current time), see
+/// util::dsp::TemplateFilter::restoreState()
+/// @return Number of filters which state was restored
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+size_t FilterCheckpoint<Storage, MaxFilters, BufferSize>::restore(util::Timestamp timestamp) {
+  uint32_t headerBlocks[sizeof(Header) / blockSize];
+  if (!Storage::read(0, headerBlocks, sizeof(Header))) return (0);
+  Header header;
+  memcpy(&header, headerBlocks, sizeof(Header));
+  if ((header.signature != signature) || (header.size > BufferSize) || (header.filtersNumber != itemsCount)) return (0);
+  if (!Storage::read(sizeof(Header), buffer, roundUp(header.size))) return (0);
+  if (util::checksum::crc16(buffer, header.size) != header.checksum) return (0);
+  const uint8_t * bufferBytes = reinterpret_cast<const uint8_t *>(buffer);
+  size_t position = 0;
+  size_t restored = 0;
+  for (size_t i = 0; i < itemsCount; i++) {
+    if ((position + sizeof(state_size_t)) > header.size) break;
+    state_size_t stateSize;
+    memcpy(&stateSize, bufferBytes + position, sizeof(state_size_t));
+    position += sizeof(state_size_t);
+    if ((position + stateSize) > header.size) break;
+    if (stateSize && items[i].filter->restoreState(bufferBytes + position, stateSize, timestamp)) restored++;
+    position += stateSize;
+  }
+  return (restored);
+}
+
+/// @brief Returns human-readable module name as a c-string in PROGMEM.
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+const char * PROGMEM FilterCheckpoint<Storage, MaxFilters, BufferSize>::moduleName (void) {
+  return (texts.moduleName);
+}
+
+/// @brief Saves checkpoint periodically, implements interface method ModuleTimings::onRun()
+template <class Storage, size_t MaxFilters, size_t BufferSize>
+void FilterCheckpoint<Storage, MaxFilters, BufferSize>::onRun(void) {
+  save();
+}
+
+}; //namespace checkpoint
+
+#endif
@@ -213,6 +213,9 @@ class DiagLog : public Module<DiagLog<Storage>> {
     MessageNumber messageNumber = 0;
     template <typename CurrentPart> inline void printMessagePart(Print &destination, const CurrentPart currentPart);
     template <typename CurrentPart, typename... MessageParts> inline void printMessagePart(Print &destination, const CurrentPart currentPart, const MessageParts... messageParts);
+    template <typename Part> inline void printSinglePart(Print &destination, const Part &part);
+    inline void printSinglePart(Print &destination, const util::Value &part);
+    inline void markTruncated(size_t messageLength);
   private:
     static const Severity minAllowedSeverityFilter = Severity::CRITICAL;
     Severity severityFilter = Severity::DEBUG;
@@ -240,6 +243,8 @@ template <typename... MessageParts> uint32_t DiagLog<Storage, LogSeparatorChar>:
   ///     diag::DiagLog<>::instance()->log(diag::DiagLog<>::Severity::DEBUG, "Int value: ", myValue, F(" float value:"), 1.55);
   /// @par Message is checked against severity filter setting and discarded if its
   /// severity exceeds (less severe than) severity filter setting.
+  /// @par If the message does not fit into message buffer, it is truncated and
+  /// its end is replaced with truncation mark ("...").
   /// @par Message number and timestamp (current millis() value) are automatically
   /// appended to the message.
   /// @par Then message is printed to the output and sent to storage.
@@ -249,16 +254,20 @@ template <typename... MessageParts> uint32_t DiagLog<Storage, LogSeparatorChar>:
   /// @param messageParts Parameter pack which consists of all message parts.
   if (static_cast<uint8_t>(severity) > static_cast<uint8_t>(severityFilter)) return (messageNumber);
   MessageTimestamp timestamp = millis();
-  util::arrays::PrintToBuffer message(messageBuffer, maxMessageSize);
+  util::arrays::PrintToBufferFast message(messageBuffer, maxMessageSize);
   message.print(messageNumber);
   message.print(LogSeparatorChar);
   message.print(timestamp);
   message.print(LogSeparatorChar);
   message.print(severityString(severity));
   message.print(LogSeparatorChar);
-  //TODO: print/render message to buffer, then print whole message from buffer and send buffer contents to storage
   printMessagePart(message, messageParts...);
-  if (output) output->println(messageBuffer);
+  const size_t messageLength = message.finish();
+  if (message.getDroppedChars()) markTruncated(messageLength);
+  if (output) {
+    output->write(reinterpret_cast<const uint8_t *>(messageBuffer), messageLength);
+    output->println();
+  }
   storage.store(messageBuffer);
   if (messageNumber == 0xFFFFFFFF) {
     messageNumber++;
@@ -314,7 +323,7 @@ void DiagLog<Storage, LogSeparatorChar>::setSeverityFilter(DiagLog<Storage, LogS
 template <class Storage, char LogSeparatorChar>
 template <typename CurrentPart>
 void DiagLog<Storage, LogSeparatorChar>::printMessagePart(Print &destination, const CurrentPart currentPart) {
-  destination.print(currentPart);
+  printSinglePart(destination, currentPart);
 }
 
 /// @brief Prints non-last part of message from variadic template parameter
@@ -326,10 +335,39 @@ void DiagLog<Storage, LogSeparatorChar>::printMessagePart(Print &destination, co
 template <class Storage, char LogSeparatorChar>
 template <typename CurrentPart, typename... MessageParts>
 void DiagLog<Storage, LogSeparatorChar>::printMessagePart(Print &destination, const CurrentPart currentPart, const MessageParts... messageParts) {
-  destination.print(currentPart);
+  printSinglePart(destination, currentPart);
   printMessagePart(destination, messageParts...);
 }
 
+/// @brief Prints a single part of message.
+/// @param part Part of the message to print.
+template <class Storage, char LogSeparatorChar>
+template <typename Part>
+void DiagLog<Storage, LogSeparatorChar>::printSinglePart(Print &destination, const Part &part) {
+  destination.print(part);
+}
+
+/// @brief Prints a single part of message which is a fixed point Value.
+/// @details The value is printed with util::ValueDecimals digits after
+/// decimal point, without using Print's integer conversion.
+/// @param part Part of the message to print.
+template <class Storage, char LogSeparatorChar>
+void DiagLog<Storage, LogSeparatorChar>::printSinglePart(Print &destination, const util::Value &part) {
+  char text[util::dsp::FixedPointFormat::maxLength];
+  const size_t length = part.toString(text, sizeof(text), util::ValueDecimals);
+  destination.write(reinterpret_cast<const uint8_t *>(text), length);
+}
+
+/// @brief Replaces the end of truncated message with truncation mark.
+/// @param messageLength Length of the message in messageBuffer.
+template <class Storage, char LogSeparatorChar>
+void DiagLog<Storage, LogSeparatorChar>::markTruncated(size_t messageLength) {
+  static const char truncationMark[] = "...";
+  static const size_t truncationMarkLength = sizeof(truncationMark) - 1;
+  if (messageLength < truncationMarkLength) return;
+  memcpy(&messageBuffer[messageLength - truncationMarkLength], truncationMark, truncationMarkLength);
+}
+
 /// @brief Returns human-readable string for the specified message severity.
 /// @param severity Message severity.
 /// @return C-string in PROGMEM message severity designation.
@@ -406,19 +444,29 @@ boolean DiagLog<Storage, LogSeparatorChar>::onRespond(Print & client) {
     json.value(FPSTR(texts.jsonParMessageNumber), static_cast<unsigned long>(messageNumber) - 1);
     json.beginArray(FPSTR(texts.jsonParLog));
     size_t numberOfMessages = storage.count();
-    char tokenStr[2] = {};
-    tokenStr[0] = LogSeparatorChar;
+    const char * partNames[] = {
+      texts.jsonParMsgNo,
+      texts.jsonParMsgTime,
+      texts.jsonParMsgSev,
+      texts.jsonParMsgText
+    };
+    static const size_t numberOfParts = sizeof(partNames) / sizeof(partNames[0]);
     for (size_t i = 0; i < numberOfMessages; i++) {
-      storage.recall(i, messageBuffer, maxMessageSize);
+      //Message parts are streamed directly from storage without copying
+      const util::arrays::CStrSpans message = storage.recall(i);
       json.beginObject();
-      char * messagePart = strtok(messageBuffer, tokenStr);
-      json.value(FPSTR(texts.jsonParMsgNo), messagePart);
-      messagePart = strtok(NULL, tokenStr);
-      json.value(FPSTR(texts.jsonParMsgTime), messagePart);
-      messagePart = strtok(NULL, tokenStr);
-      json.value(FPSTR(texts.jsonParMsgSev), messagePart);
-      messagePart = strtok(NULL, tokenStr);
-      json.value(FPSTR(texts.jsonParMsgText), messagePart);
+      size_t partStart = 0;
+      for (size_t j = 0; j < numberOfParts; j++) {
+        if (partStart >= message.length()) {
+          json.value(FPSTR(partNames[j]));
+          continue;
+        }
+        //Last part is the message text which may contain separator chars
+        size_t partEnd = (j < (numberOfParts - 1)) ? message.find(LogSeparatorChar, partStart) : message.length();
+        if (partEnd == util::arrays::CStrSpans::npos) partEnd = message.length();
+        json.value(FPSTR(partNames[j]), message.substr(partStart, partEnd - partStart));
+        partStart = partEnd + 1;
+      }
       json.finish();
     }
     json.~JSONOutput();
@@ -440,6 +488,7 @@ class DiagLogStorage {
     inline boolean store(char * message);
     inline size_t count(void);
     inline size_t recall(size_t index, char *buffer, size_t bufferSize);
+    inline util::arrays::CStrSpans recall(size_t index);
   private:
     char storageBuffer[StorageBufferSize];
     util::arrays::CStrRingBuffer storageRingBuffer;
@@ -473,6 +522,15 @@ size_t DiagLogStorage<StorageBufferSize>::recall(size_t index, char *buffer, siz
   return (storageRingBuffer.get(index, buffer, bufferSize));
 }
 
+/// @brief Provides access to particular message in storage without copying
+/// @param index Index of message in the storage, in range 0 to count()
+/// @return Message text as one or two spans pointing directly to storage; the
+/// spans remain valid until next message is stored
+template <size_t StorageBufferSize>
+util::arrays::CStrSpans DiagLogStorage<StorageBufferSize>::recall(size_t index) {
+  return (storageRingBuffer.getSpans(index));
+}
+
 }; //namespace diag
 
 #endif
@@ -17,6 +17,7 @@ extern "C" {
 }
 
 #include "version.h"
+#include "project_config.h"
 
 #include "util_data.h"
 #include "util_comm.h"
@@ -24,6 +25,8 @@ extern "C" {
 #include "diag.h"
 #include "webcc.h"
 #include "webconfig.h"
+#include "telemetry.h"
+#include "checkpoint.h"
 
 const boolean CONFIG_MODE_WIFI_OPEN = true; //change to false to create password-protected WiFi network in config mode
 
@@ -33,9 +36,13 @@ WiFiServer webServer(WEB_SERVER_PORT);
 
 using DiagLog = diag::DiagLog<>;
 using WebConfig = webconfig::WebConfig <DiagLog>;
+using FilterTelemetry = telemetry::FilterTelemetry<>;
+//First 128 bytes of RTC user memory are used by OTA update
+using FilterCheckpoint = checkpoint::FilterCheckpoint<checkpoint::RTCMemoryStorage<128>, 4, 320>;
 using WebConfigControl = webcc::WebConfigControl <DiagLog, webcc::HTTPReqParserStateMachine, webcc::BufferedPrint, webcc::WebccForm,
       WebConfig,
-      DiagLog>;
+      DiagLog,
+      FilterTelemetry>;
 
 //#define BLYNK_PRINT Serial
 
@@ -88,6 +95,7 @@ const unsigned long UPDATE_TIME_MG811 = 200;//ms
 const unsigned long UPDATE_TIME_STATUS_LEDS = 250;//ms
 const unsigned long UPDATE_TIME_STATUS_VPINS = 500;//ms
 const unsigned long UPDATE_TIME_VALUE_VPINS = 500;//ms
+const unsigned long UPDATE_TIME_FILTER_CHECKPOINT = 10000;//ms
 
 /*
  * Data and status values
@@ -98,11 +106,41 @@ boolean isFaultOneWire = false;
 boolean isFaultMG811 = false;
 
 float valueTemperatureDHT = 0.0;
-float valueHumidityDHT = 0.0;
 float valueTemperatureOneWire = 0.0;
-float valueMG811 = 0.0;
 int valueMG811uncal = 0;
 
+//Physical quantity identifiers
+const util::quantity::Quantity::id_t QUANTITY_GROUP_SENSORS = 0;
+const util::quantity::Quantity::id_t QUANTITY_ID_HUMIDITY_DHT = 0;
+const util::quantity::Quantity::id_t QUANTITY_ID_CONCENTRATION_MG811 = 1;
+
+const util::Value MOLAR_MASS_CO2(4401, 2); //g/mol
+
+util::quantity::Humidity humidityDHT(QUANTITY_ID_HUMIDITY_DHT,
+                                     QUANTITY_GROUP_SENSORS,
+                                     util::Value(),
+                                     util::quantity::Humidity::Unit::RELATIVE,
+                                     util::Value(),
+                                     util::Timestamp(),
+                                     false);
+util::quantity::Concentration concentrationMG811(QUANTITY_ID_CONCENTRATION_MG811,
+                                                 QUANTITY_GROUP_SENSORS,
+                                                 util::Value(),
+                                                 util::quantity::Concentration::Unit::PPM,
+                                                 util::Timestamp(),
+                                                 false,
+                                                 util::Value(),
+                                                 util::Value(),
+                                                 MOLAR_MASS_CO2);
+
+util::Value valueFromSensor(float sensorValue) {
+  //Sensor libraries return float values with the precision of 0.1
+  static const size_t decimals = 1;
+  static const float factor = 10.0;
+  const float scaledValue = sensorValue * factor;
+  return (util::Value(static_cast<util::ValueBase>(scaledValue + ((scaledValue < 0) ? -0.5 : 0.5)), decimals));
+}
+
 boolean statusProgLED = false;
 boolean statusFaultLED = false;
 boolean statusOperateLED = false;
@@ -135,8 +173,15 @@ DHT dht(PIN_SENSOR_DHT, DHTTYPE, 15);
 
 void updateSensorDHT(void) {
   valueTemperatureDHT = (float)dht.readTemperature();
-  valueHumidityDHT = (float)dht.readHumidity();
-  isFaultDHT = (isnan(valueTemperatureDHT)) || (isnan(valueHumidityDHT));
+  const float humidity = (float)dht.readHumidity();
+  isFaultDHT = (isnan(valueTemperatureDHT)) || (isnan(humidity));
+  humidityDHT = util::quantity::Humidity(QUANTITY_ID_HUMIDITY_DHT,
+                                         QUANTITY_GROUP_SENSORS,
+                                         isFaultDHT ? util::Value() : valueFromSensor(humidity),
+                                         util::quantity::Humidity::Unit::RELATIVE,
+                                         isFaultDHT ? util::Value() : valueFromSensor(valueTemperatureDHT),
+                                         util::getTimestamp(),
+                                         !isFaultDHT);
 }
 
 /*
@@ -146,14 +191,24 @@ void updateSensorDHT(void) {
 const int MG811_ALARM_TRESHOULD = 64;
 
 //Calibration data
-double calDataMG811_a = -0.02;
-double calDataMG811_b = 18;
+util::dsp::FilterExpScale * calFilterMG811 = nullptr;
+boolean isDefaultCalMG811 = false;
+const char PROGMEM calFilterMG811Name[] = "MG811 calibration";
+
+//Default calibration: ppm = e^(-0.02 * raw + 18), defined by two reference points
+//on this curve so that the slope is not quantised by Value fraction bits
+const util::ValueBase DEFAULT_CAL_MG811_POINT0_RAW = 400;
+const util::ValueBase DEFAULT_CAL_MG811_POINT0_CALIBRATED = 22026; //e^10
+const util::ValueBase DEFAULT_CAL_MG811_POINT1_RAW = 600;
+const util::ValueBase DEFAULT_CAL_MG811_POINT1_CALIBRATED = 403;   //e^6
+//Below this raw value default calibration exceeds Value range
+const unsigned int DEFAULT_CAL_MG811_MIN_RAW = 180;
 
 void calcCalDataMG811(void) {
-  const double Y1 = log((double)eepromSavedParametersStorage.MG811CalPoint0Calibrated);
-  const double Y2 = log((double)eepromSavedParametersStorage.MG811CalPoint1Calibrated);
-  const double X1 = (double)eepromSavedParametersStorage.MG811CalPoint0Raw;
-  const double X2 = (double)eepromSavedParametersStorage.MG811CalPoint1Raw;
+  const util::Value X1(static_cast<util::ValueBase>(eepromSavedParametersStorage.MG811CalPoint0Raw));
+  const util::Value Y1(static_cast<util::ValueBase>(eepromSavedParametersStorage.MG811CalPoint0Calibrated));
+  const util::Value X2(static_cast<util::ValueBase>(eepromSavedParametersStorage.MG811CalPoint1Raw));
+  const util::Value Y2(static_cast<util::ValueBase>(eepromSavedParametersStorage.MG811CalPoint1Calibrated));
   DiagLog::instance()->log(DiagLog::Severity::DEBUG,
                            F("Calculating MG811 calibration data, ref points: "),
                            F("Raw="), eepromSavedParametersStorage.MG811CalPoint0Raw,
@@ -161,20 +216,24 @@ void calcCalDataMG811(void) {
                            F("ppm / Raw="), eepromSavedParametersStorage.MG811CalPoint1Raw,
                            F(" Calibrated="), eepromSavedParametersStorage.MG811CalPoint1Calibrated,
                            F("ppm"));
-  double tempCalDataMG811_a = (Y2 - Y1) / (X2 - X1);
-  double tempCalDataMG811_b = Y1 - tempCalDataMG811_a * X1;
-  DiagLog::instance()->log(DiagLog::Severity::DEBUG,
-                           F("Calibration data: a="), tempCalDataMG811_a,
-                           F(" b="), tempCalDataMG811_b);
-  if (isnan(tempCalDataMG811_a) ||
-      isinf(tempCalDataMG811_a) ||
-      isnan(tempCalDataMG811_b) ||
-      isinf(tempCalDataMG811_b)) {
+  util::dsp::FilterExpScale * tempCalFilterMG811 = new util::dsp::FilterExpScale(X1, Y1, X2, Y2);
+  if (tempCalFilterMG811->getStatus() != util::dsp::Filter::Status::OK) {
     DiagLog::instance()->log(DiagLog::Severity::ERROR, F("Calibration data error"));
+    delete tempCalFilterMG811;
+    if (!calFilterMG811) {
+      calFilterMG811 = new util::dsp::FilterExpScale(util::Value(DEFAULT_CAL_MG811_POINT0_RAW),
+          util::Value(DEFAULT_CAL_MG811_POINT0_CALIBRATED),
+          util::Value(DEFAULT_CAL_MG811_POINT1_RAW),
+          util::Value(DEFAULT_CAL_MG811_POINT1_CALIBRATED));
+      isDefaultCalMG811 = true;
+    }
+    FilterTelemetry::instance()->add(calFilterMG811Name, calFilterMG811);
   }
   else {
-    calDataMG811_a = tempCalDataMG811_a;
-    calDataMG811_b = tempCalDataMG811_b;
+    if (calFilterMG811) delete calFilterMG811;
+    calFilterMG811 = tempCalFilterMG811;
+    isDefaultCalMG811 = false;
+    FilterTelemetry::instance()->add(calFilterMG811Name, calFilterMG811);
     DiagLog::instance()->log(DiagLog::Severity::DEBUG, F("Calibration data accepted"));
   }
   if (eepromSavedParametersStorage.rejectCalibrationMG811) {
@@ -182,66 +241,83 @@ void calcCalDataMG811(void) {
   }
 }
 
-float calcConcentrationCO2 (unsigned int rawAdcValue) {
-  if (eepromSavedParametersStorage.rejectCalibrationMG811) return (1024.0 - rawAdcValue);
-  return (exp(calDataMG811_a * ((double)rawAdcValue) + calDataMG811_b));
+const util::Value NO_VALUE_MG811 = util::Value::fromRaw(util::ValueBaseMin);
+
+util::Value calcConcentrationCO2 (unsigned int rawAdcValue) {
+  static const util::ValueBase uncalibratedMax = 1024;
+  if (eepromSavedParametersStorage.rejectCalibrationMG811) return (util::Value(uncalibratedMax - static_cast<util::ValueBase>(rawAdcValue)));
+  if (!calFilterMG811) return (NO_VALUE_MG811);
+  if (isDefaultCalMG811 && (rawAdcValue < DEFAULT_CAL_MG811_MIN_RAW)) rawAdcValue = DEFAULT_CAL_MG811_MIN_RAW;
+  return (calFilterMG811->filter(util::getTimestamp(), util::Value(static_cast<util::ValueBase>(rawAdcValue))));
 }
 
-unsigned int movingAverage(unsigned int input) {
-  const static unsigned int AVERAGE_POINTS = 64;
-  static unsigned int inputValuesHistory[AVERAGE_POINTS] = {0};
-  static unsigned int currentValue = 0;
-  static unsigned long totalValue;
-  static boolean firstRun = true;
-  if (firstRun) {
-    firstRun = false;
-    totalValue = input * AVERAGE_POINTS;
-    for (unsigned int i = 0; i < AVERAGE_POINTS; i++)
-      inputValuesHistory[i] = input;
+//Filters
+const size_t MG811_AVERAGE_POINTS = 64;
+util::dsp::FilterMovingAverage filterMG811Average(MG811_AVERAGE_POINTS);
+const char PROGMEM filterMG811AverageName[] = "MG811 moving average";
+util::dsp::FilterLowPassTable * filterMG811LowPass = nullptr;
+unsigned int filterMG811LowPassFrequency = 0;
+const char PROGMEM filterMG811LowPassName[] = "MG811 low-pass";
+
+void initFiltersMG811(void) {
+  //Low-pass filter frequency is set in units of 0.01 Hz
+  static const size_t lowPassFrequencyDecimals = 2;
+  //Smoothing factors are precalculated for up to twice the sampling period in 4 ms steps
+  //(102 entries for any frequency); longer intervals are calculated when the loop runs late
+  static const util::Timestamp lowPassMaxTableDeltaTime = 2 * UPDATE_TIME_MG811;
+  static const size_t lowPassDeltaTimeQuantumBits = 2;
+  if (!filterMG811LowPass || (filterMG811LowPassFrequency != eepromSavedParametersStorage.filterMG811LowPassFrequency)) {
+    filterMG811LowPassFrequency = eepromSavedParametersStorage.filterMG811LowPassFrequency;
+    const util::Value fc(static_cast<util::ValueBase>(filterMG811LowPassFrequency), lowPassFrequencyDecimals);
+    util::dsp::FilterLowPassTable * tempFilterMG811LowPass = new util::dsp::FilterLowPassTable(fc, util::ValuePi, util::timestampPerSecond,
+        lowPassMaxTableDeltaTime, lowPassDeltaTimeQuantumBits);
+    FilterTelemetry::instance()->add(filterMG811LowPassName, tempFilterMG811LowPass);
+    FilterCheckpoint::instance()->add(filterMG811LowPassName, tempFilterMG811LowPass);
+    if (filterMG811LowPass) delete filterMG811LowPass;
+    filterMG811LowPass = tempFilterMG811LowPass;
   }
-  totalValue += input;
-  totalValue -= inputValuesHistory[currentValue];
-  inputValuesHistory[currentValue] = input;
-  currentValue++;
-  if (currentValue >= AVERAGE_POINTS) currentValue = 0;
-  return ((unsigned int)(totalValue / (unsigned long)AVERAGE_POINTS));
+  FilterTelemetry::instance()->add(filterMG811AverageName, &filterMG811Average);
+  FilterCheckpoint::instance()->add(filterMG811AverageName, &filterMG811Average);
 }
 
-unsigned int lowPass(unsigned int input, float dt, float fc) {
-  //See https://en.wikipedia.org/wiki/Low-pass_filter#Simple_infinite_impulse_response_filter for details
-  if ((dt == 0.0) || (fc == 0.0)) return (0);
-  float rc = 1 / (2 * PI * fc);
-  float alpha = dt / (dt + rc);
-  static float lastOutput = 0.0;
-  float currentOutput = lastOutput + alpha * ((float)input - lastOutput);
-  lastOutput = currentOutput;
-  return ((unsigned int)currentOutput);
+util::Value filterMG811(util::dsp::Filter & filter, const util::Value & input) {
+  if (util::overflow(input)) return (NO_VALUE_MG811);
+  const util::Value output = filter.filter(util::getTimestamp(), input);
+  if (filter.getStatus() != util::dsp::Filter::Status::OK) return (NO_VALUE_MG811);
+  return (output);
 }
 
 void updateSensorMG811(void) {
   unsigned int raw = analogRead(PIN_SENSOR_MG811);
   valueMG811uncal = raw;
   isFaultMG811 = (raw < MG811_ALARM_TRESHOULD);
-  if (isFaultMG811) {
-    valueMG811 = NAN;
-    return;
-  }
-  valueMG811 = calcConcentrationCO2(raw);
-  const float millisPerSecond = 1000.0;
-  const float unitsPerHz = 100.0;
-  switch (eepromSavedParametersStorage.filterMG811) {
-    case ADCFilter::OFF:
-      break;
-    case ADCFilter::AVERAGE:
-      valueMG811 = movingAverage(valueMG811);
-      break;
-    case ADCFilter::LOWPASS:
-      valueMG811 = lowPass(valueMG811, (float)UPDATE_TIME_MG811 / millisPerSecond, (float)eepromSavedParametersStorage.filterMG811LowPassFrequency / unitsPerHz);
-      break;
-    default:
-      eepromSavedParametersStorage.filterMG811 = ADCFilter::OFF;
-      break;
+  util::Value value = NO_VALUE_MG811;
+  if (!isFaultMG811) {
+    value = calcConcentrationCO2(raw);
+    switch (eepromSavedParametersStorage.filterMG811) {
+      case ADCFilter::OFF:
+        break;
+      case ADCFilter::AVERAGE:
+        value = filterMG811(filterMG811Average, value);
+        break;
+      case ADCFilter::LOWPASS:
+        initFiltersMG811();
+        value = filterMG811(*filterMG811LowPass, value);
+        break;
+      default:
+        eepromSavedParametersStorage.filterMG811 = ADCFilter::OFF;
+        break;
+    }
   }
+  concentrationMG811 = util::quantity::Concentration(QUANTITY_ID_CONCENTRATION_MG811,
+                                                     QUANTITY_GROUP_SENSORS,
+                                                     value,
+                                                     util::quantity::Concentration::Unit::PPM,
+                                                     MOLAR_MASS_CO2,
+                                                     util::getTimestamp(),
+                                                     !util::overflow(value),
+                                                     util::Value(),
+                                                     util::Value());
 }
 
 /*
@@ -273,6 +349,18 @@ void updateStatusLEDs (boolean isConfigMode) {
  * To prevent disconnecting from server, data are sent one at a time
  */
 
+void virtualWriteQuantity(int pin, const util::quantity::Quantity & quantity) {
+  static const size_t decimals = 1;
+  static const char noValueText[] = "nan";
+  if (!quantity.validate()) {
+    Blynk.virtualWrite(pin, noValueText);
+    return;
+  }
+  char text[util::dsp::FixedPointFormat::maxLength];
+  quantity.getValue().toString(text, sizeof(text), decimals);
+  Blynk.virtualWrite(pin, text);
+}
+
 void updateValueVirtualPins(void) {
   static int currentPhase = 0;
   switch (currentPhase) {
@@ -282,7 +370,7 @@ void updateValueVirtualPins(void) {
       break;
     case 1:
       //V5 = DHT humidity
-      Blynk.virtualWrite(V5, valueHumidityDHT);
+      virtualWriteQuantity(V5, humidityDHT);
       break;
     case 2:
       //V6 = OneWire temperature
@@ -290,7 +378,7 @@ void updateValueVirtualPins(void) {
       break;
     case 3:
       //V7 = MG811 signal
-      Blynk.virtualWrite(V7, valueMG811);
+      virtualWriteQuantity(V7, concentrationMG811);
       break;
   }
   currentPhase++;
@@ -330,9 +418,9 @@ void printSensorDebugInfo(void) {
   DiagLog::instance()->log(DiagLog::Severity::DEBUG,
                            F("Sensor values: "),
                            F("DHT T="), valueTemperatureDHT,
-                           F("DHT RH="), valueHumidityDHT,
+                           F("DHT RH="), humidityDHT.getValue(),
                            F(" OneWire(0) T="), valueTemperatureOneWire,
-                           F(" MG811 value="), valueMG811,
+                           F(" MG811 value="), concentrationMG811.getValue(),
                            F(" raw = "), valueMG811uncal);
 }
 
@@ -369,6 +457,11 @@ void setup() {
 
   calcCalDataMG811();
 
+  initFiltersMG811();
+  const size_t filtersRestored = FilterCheckpoint::instance()->restore(util::getTimestamp());
+  DiagLog::instance()->log(DiagLog::Severity::DEBUG, F("Filters restored from checkpoint: "), filtersRestored);
+  FilterCheckpoint::instance()->setRunPeriod(UPDATE_TIME_FILTER_CHECKPOINT);
+
   isConfigMode = !digitalRead(PIN_SWITCH_CONFIG);
   
   if (isConfigMode) {
@@ -446,6 +539,7 @@ void loop() {
   DiagLog::instance()->run();
   WebConfig::instance()->run();
   WebConfigControl::instance()->run();
+  FilterCheckpoint::instance()->run();
 
   static unsigned long lastMillisSensors = 0;
   if (checkTimedEvent(UPDATE_TIME_SENSORS, &lastMillisSensors)) {
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2016-2017 Nick Naumenko (https://github.com/nnaumenko)
+ * All rights reserved
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+/**
+ * @file
+ * @brief Project-wide build configuration.
+ * @details Switches defined here change class layouts and must be the same for
+ * every translation unit, so they are set only in this file and never in
+ * individual .ino or .cpp files.
+ */
+
+#ifndef PROJECT_CONFIG_H
+#define PROJECT_CONFIG_H
+
+/// @brief Collect filter operation counters, see util::dsp::TemplateFilter::Telemetry
+/// @details Set to 0 to remove counters from all filters
+#define UTIL_DATA_FILTER_TELEMETRY 1
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016-2017 Nick Naumenko (https://github.com/nnaumenko)
+ * All rights reserved
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include "sensorlog.h"
+
+#ifndef ARDUINO
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace sensorlog {
+
+//////////////////////////////////////////////////////////////////////
+// FlashSectorStorage
+//////////////////////////////////////////////////////////////////////
+
+/// @param firstSector Number of the first flash sector used by the storage
+/// @param sectors Number of the flash sectors used by the storage
+FlashSectorStorage::FlashSectorStorage(uint32_t firstSector, size_t sectors) {
+  this->firstSector = firstSector;
+  this->sectors = sectors;
+}
+
+/// @brief Erases sector (fills with 0xFF)
+/// @param sector Sector number within the storage
+/// @return true if successful, false otherwise
+boolean FlashSectorStorage::erase(size_t sector) {
+  if (sector >= sectors) return (false);
+  return (ESP.flashEraseSector(firstSector + sector));
+}
+
+/// @brief Reads data from sector
+/// @param sector Sector number within the storage
+/// @param offset Offset within the sector in bytes
+/// @param data Buffer to read data to
+/// @param size Size of the data in bytes
+/// @return true if successful, false otherwise
+boolean FlashSectorStorage::read(size_t sector, size_t offset, uint32_t * data, size_t size) {
+  if ((sector >= sectors) || ((offset + size) > sectorSize)) return (false);
+  return (ESP.flashRead((firstSector + sector) * sectorSize + offset, data, size));
+}
+
+/// @brief Writes data to sector
+/// @details Only bits which are set in the erased sector can be cleared by writing
+/// @param sector Sector number within the storage
+/// @param offset Offset within the sector in bytes
+/// @param data Data to write
+/// @param size Size of the data in bytes
+/// @return true if successful, false otherwise
+boolean FlashSectorStorage::write(size_t sector, size_t offset, const uint32_t * data, size_t size) {
+  if ((sector >= sectors) || ((offset + size) > sectorSize)) return (false);
+  return (ESP.flashWrite((firstSector + sector) * sectorSize + offset, const_cast<uint32_t *>(data), size));
+}
+
+#ifndef ARDUINO
+
+//////////////////////////////////////////////////////////////////////
+// MappedFileStorage
+//////////////////////////////////////////////////////////////////////
+
+/// @param path Path to the file
+/// @param sectors Number of the emulated sectors
+/// @param sectorSize Size of the emulated sector in bytes
+MappedFileStorage::MappedFileStorage(const char * path, size_t sectors, size_t sectorSize) {
+  const size_t size = sectors * sectorSize;
+  if (!size) return;
+  file = open(path, O_RDWR | O_CREAT, 0644);
+  if (file < 0) return;
+  const off_t previousSize = lseek(file, 0, SEEK_END);
+  if (ftruncate(file, size) < 0) return;
+  void * mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (mapped == MAP_FAILED) return;
+  memory = static_cast<uint8_t *>(mapped);
+  this->sectors = sectors;
+  this->sectorSize = sectorSize;
+  //Newly created area of the file is emulated as erased flash memory
+  if (previousSize >= 0 && static_cast<size_t>(previousSize) < size)
+    memset(memory + previousSize, 0xFF, size - previousSize);
+}
+
+MappedFileStorage::~MappedFileStorage() {
+  if (memory) {
+    msync(memory, sectors * sectorSize, MS_SYNC);
+    munmap(memory, sectors * sectorSize);
+  }
+  if (file >= 0) close(file);
+}
+
+/// @brief Erases sector (fills with 0xFF)
+/// @param sector Sector number within the storage
+/// @return true if successful, false otherwise
+boolean MappedFileStorage::erase(size_t sector) {
+  if (!validateArea(sector, 0, 0)) return (false);
+  memset(memory + sector * sectorSize, 0xFF, sectorSize);
+  return (true);
+}
+
+/// @brief Reads data from sector
+/// @param sector Sector number within the storage
+/// @param offset Offset within the sector in bytes
+/// @param data Buffer to read data to
+/// @param size Size of the data in bytes
+/// @return true if successful, false otherwise
+boolean MappedFileStorage::read(size_t sector, size_t offset, uint32_t * data, size_t size) {
+  if (!validateArea(sector, offset, size)) return (false);
+  memcpy(data, memory + sector * sectorSize + offset, size);
+  return (true);
+}
+
+/// @brief Writes data to sector
+/// @details Same as flash memory, only clears the bits which are not set in data
+/// @param sector Sector number within the storage
+/// @param offset Offset within the sector in bytes
+/// @param data Data to write
+/// @param size Size of the data in bytes
+/// @return true if successful, false otherwise
+boolean MappedFileStorage::write(size_t sector, size_t offset, const uint32_t * data, size_t size) {
+  if (!validateArea(sector, offset, size)) return (false);
+  uint8_t * destination = memory + sector * sectorSize + offset;
+  const uint8_t * source = reinterpret_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i++)
+    destination[i] &= source[i];
+  return (true);
+}
+
+#endif
+
+}; //namespace sensorlog
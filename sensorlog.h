@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2016-2017 Nick Naumenko (https://github.com/nnaumenko)
+ * All rights reserved
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+/**
+ * @file
+ * @brief Persistent sensor log.
+ *
+ * Append-only ring log of compact sensor records stored in flash memory, so that
+ * measurements survive restarts and periods without network connection.
+ */
+
+#ifndef SENSORLOG_H
+#define SENSORLOG_H
+
+#include <Arduino.h>
+#include "util_data.h"
+
+namespace sensorlog {
+
+//////////////////////////////////////////////////////////////////////
+// Record
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Compact sensor record
+/// @details Stores the essential data of util::quantity::Quantity in its current
+/// measurement unit.
+/// Sequence number and checksum are set by PersistentLog::append().
+struct Record {
+  public:
+    static const uint8_t flagValid = 0x01; ///< Measured value is valid
+  public:
+    uint32_t sequence;      ///< Sequence number of the record in the log
+    uint32_t timestamp;     ///< See util::quantity::Quantity::getTimestamp()
+    int32_t value;          ///< Raw value, see util::Value::getRaw()
+    uint16_t id;            ///< See util::quantity::Quantity::getId()
+    uint16_t idGroup;       ///< See util::quantity::Quantity::getIdGroup()
+    uint8_t unit;           ///< See util::quantity::Quantity::getUnit()
+    uint8_t flags;          ///< Combination of flagXXX
+    uint16_t checksum;      ///< crc16 of all the preceding fields
+  public:
+    static inline Record fromQuantity(const util::quantity::Quantity & quantity);
+    inline util::Value getValue(void) const;
+    inline boolean isValid(void) const;
+    inline uint16_t calculateChecksum(void) const;
+};
+
+static_assert(sizeof(Record) == 20, "Record must not contain padding");
+static_assert(!(sizeof(Record) % sizeof(uint32_t)), "Record size must be a multiple of flash word size");
+
+Record Record::fromQuantity(const util::quantity::Quantity & quantity) {
+  /// @brief Creates record from the physical quantity
+  /// @param quantity Physical quantity
+  /// @return Record with sequence and checksum not set
+  Record record;
+  record.sequence = 0;
+  record.timestamp = quantity.getTimestamp();
+  record.value = quantity.getValue().getRaw();
+  record.id = quantity.getId();
+  record.idGroup = quantity.getIdGroup();
+  record.unit = quantity.getUnit();
+  record.flags = quantity.validate() ? flagValid : 0;
+  record.checksum = 0;
+  return (record);
+}
+
+util::Value Record::getValue(void) const {
+  /// @brief Returns value stored in the record
+  return (util::Value::fromRaw(value));
+}
+
+boolean Record::isValid(void) const {
+  /// @brief Returns true if value stored in the record is valid
+  return (flags & flagValid);
+}
+
+uint16_t Record::calculateChecksum(void) const {
+  /// @brief Calculates crc16 checksum of the record (excluding checksum field)
+  /// @details Non-zero initial value is used so that zero-filled flash memory is
+  /// not mistaken for valid records
+  static const uint16_t poly = 0x8005;
+  static const uint16_t init = 0xFFFF;
+  return (util::checksum::crc16(this, offsetof(Record, checksum), poly, init));
+}
+
+//////////////////////////////////////////////////////////////////////
+// Storages
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Log storage in a range of raw flash sectors of ESP8266
+/// @details The sectors must not overlap with the firmware, file system (SPIFFS),
+/// emulated EEPROM and other data stored in flash memory. Typically the sectors
+/// between the end of the firmware and the beginning of the file system can be used.
+/// @par All addresses and sizes must be multiples of 4.
+class FlashSectorStorage {
+  public:
+    static const size_t sectorSize = 4096;
+  public:
+    FlashSectorStorage(uint32_t firstSector, size_t sectors);
+    inline boolean validate(void) const;
+    inline size_t getSectors(void) const;
+    inline size_t getSectorSize(void) const;
+    boolean erase(size_t sector);
+    boolean read(size_t sector, size_t offset, uint32_t * data, size_t size);
+    boolean write(size_t sector, size_t offset, const uint32_t * data, size_t size);
+  private:
+    uint32_t firstSector = 0;
+    size_t sectors = 0;
+};
+
+boolean FlashSectorStorage::validate(void) const {
+  return (sectors);
+}
+
+size_t FlashSectorStorage::getSectors(void) const {
+  return (sectors);
+}
+
+size_t FlashSectorStorage::getSectorSize(void) const {
+  return (sectorSize);
+}
+
+#ifndef ARDUINO
+
+/// @brief Log storage in a memory-mapped file, for host builds
+/// @details Emulates flash memory: erased sector is filled with 0xFF and write can
+/// only change bits from 1 to 0. The file is created if it does not exist; the
+/// file contents are preserved between program runs.
+class MappedFileStorage {
+  public:
+    MappedFileStorage(const char * path, size_t sectors, size_t sectorSize = FlashSectorStorage::sectorSize);
+    ~MappedFileStorage();
+    inline boolean validate(void) const;
+    inline size_t getSectors(void) const;
+    inline size_t getSectorSize(void) const;
+    boolean erase(size_t sector);
+    boolean read(size_t sector, size_t offset, uint32_t * data, size_t size);
+    boolean write(size_t sector, size_t offset, const uint32_t * data, size_t size);
+  private:
+    inline boolean validateArea(size_t sector, size_t offset, size_t size) const;
+  private:
+    int file = -1;
+    uint8_t * memory = nullptr;
+    size_t sectors = 0;
+    size_t sectorSize = 0;
+};
+
+boolean MappedFileStorage::validate(void) const {
+  return (memory);
+}
+
+size_t MappedFileStorage::getSectors(void) const {
+  return (sectors);
+}
+
+size_t MappedFileStorage::getSectorSize(void) const {
+  return (sectorSize);
+}
+
+boolean MappedFileStorage::validateArea(size_t sector, size_t offset, size_t size) const {
+  return (memory && (sector < sectors) && ((offset + size) <= sectorSize));
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// PersistentLog
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Persistent append-only ring log of sensor records
+/// @details Records are written sequentially into the storage sectors; when the
+/// current sector is full, the next sector is erased and the writing continues there
+/// (the oldest records stored in that sector are lost). Thus all sectors are erased
+/// in turn and equally often (wear levelling), and append() takes constant time.
+/// @par Every record has a sequence number and crc16 checksum. Records are read by
+/// sequence number; to upload the records accumulated while the network was not
+/// available, save nextSequence() when the upload is complete, and next time read
+/// records from the saved sequence number (or from firstSequence() if it is larger)
+/// up to nextSequence().
+/// @par The log is recovered by begin() after restart. If the power is lost while
+/// writing a record, this record fails checksum validation and is skipped.
+/// @tparam Storage Storage class, see FlashSectorStorage and MappedFileStorage
+template <class Storage>
+class PersistentLog {
+  public:
+    PersistentLog(Storage & storage);
+    boolean begin(void);
+    boolean append(const Record & record);
+    boolean clear(void);
+    boolean read(uint32_t sequence, Record & record);
+    inline uint32_t firstSequence(void) const;
+    inline uint32_t nextSequence(void) const;
+    inline size_t count(void) const;
+    inline size_t capacity(void) const;
+  private:
+    static const uint32_t emptySequence = UINT32_MAX;
+    uint32_t readSequence(size_t sector, size_t slot);
+    boolean readFirstRecord(size_t sector, Record & record);
+  private:
+    Storage & storage;
+    boolean initialised = false;
+    size_t sectors = 0;
+    size_t recordsPerSector = 0;
+    size_t headSector = 0;      ///< Sector where the records are currently appended
+    size_t headSlot = 0;        ///< Slot in headSector for the next record
+    uint32_t first = 0;         ///< Sequence number of the oldest stored record
+    uint32_t next = 0;          ///< Sequence number of the next record
+};
+
+template <class Storage>
+PersistentLog<Storage>::PersistentLog(Storage & storage) : storage(storage) {
+  /// @param storage Storage for the log, must contain at least 2 sectors
+}
+
+template <class Storage>
+uint32_t PersistentLog<Storage>::readSequence(size_t sector, size_t slot) {
+  uint32_t sequence;
+  if (!storage.read(sector, slot * sizeof(Record), &sequence, sizeof(sequence))) return (emptySequence);
+  return (sequence);
+}
+
+template <class Storage>
+boolean PersistentLog<Storage>::readFirstRecord(size_t sector, Record & record) {
+  if (!storage.read(sector, 0, reinterpret_cast<uint32_t *>(&record), sizeof(Record))) return (false);
+  return ((record.sequence != emptySequence) && (record.checksum == record.calculateChecksum()));
+}
+
+template <class Storage>
+boolean PersistentLog<Storage>::begin(void) {
+  /// @brief Recovers the log from the storage
+  /// @details Finds the sector with the newest records and the first free slot in it,
+  /// and the sector with the oldest records. Reads the first record of every sector
+  /// and the sequence numbers in the newest sector.
+  /// @return true if the log is ready to use, false if the storage is not valid
+  initialised = false;
+  if (!storage.validate()) return (false);
+  sectors = storage.getSectors();
+  recordsPerSector = storage.getSectorSize() / sizeof(Record);
+  if ((sectors < 2) || !recordsPerSector) return (false);
+  //Newest sector is the one with the largest sequence of the first record
+  boolean found = false;
+  uint32_t headFirst = 0;
+  for (size_t i = 0; i < sectors; i++) {
+    Record record;
+    if (!readFirstRecord(i, record)) continue;
+    if (!found || (record.sequence > headFirst)) {
+      found = true;
+      headFirst = record.sequence;
+      headSector = i;
+    }
+  }
+  if (!found) {
+    //Empty log: first append() moves to sector 0 and erases it
+    headSector = sectors - 1;
+    headSlot = recordsPerSector;
+    first = 0;
+    next = 0;
+    initialised = true;
+    return (true);
+  }
+  headSlot = 1;
+  while ((headSlot < recordsPerSector) && (readSequence(headSector, headSlot) != emptySequence))
+    headSlot++;
+  next = headFirst + headSlot;
+  //Oldest sector is the first non-empty sector after the newest one
+  first = headFirst;
+  for (size_t i = 1; i < sectors; i++) {
+    const size_t sector = (headSector + i) % sectors;
+    Record record;
+    if (readFirstRecord(sector, record) && (record.sequence < headFirst)) {
+      first = record.sequence;
+      break;
+    }
+  }
+  initialised = true;
+  return (true);
+}
+
+template <class Storage>
+boolean PersistentLog<Storage>::append(const Record & record) {
+  /// @brief Appends record to the log
+  /// @details Sets sequence number and checksum of the stored record. If the
+  /// current sector is full, the next sector is erased first.
+  /// @param record Record to append
+  /// @return true if record was written, false if the log is not initialised or
+  /// the storage failed
+  if (!initialised) return (false);
+  if (headSlot >= recordsPerSector) {
+    const size_t nextSector = (headSector + 1) % sectors;
+    if (!storage.erase(nextSector)) return (false);
+    headSector = nextSector;
+    headSlot = 0;
+    const uint32_t maxRecords = (sectors - 1) * recordsPerSector;
+    if ((next - first) > maxRecords) first = next - maxRecords;
+  }
+  Record storedRecord = record;
+  storedRecord.sequence = next;
+  storedRecord.checksum = storedRecord.calculateChecksum();
+  const boolean result = storage.write(headSector, headSlot * sizeof(Record), reinterpret_cast<const uint32_t *>(&storedRecord), sizeof(Record));
+  //The slot is used even if the write failed, since it may be partially written
+  headSlot++;
+  next++;
+  return (result);
+}
+
+template <class Storage>
+boolean PersistentLog<Storage>::clear(void) {
+  /// @brief Erases all sectors of the storage and starts the log over
+  /// @return true if all sectors were erased, false otherwise
+  if (!storage.validate()) return (false);
+  for (size_t i = 0; i < storage.getSectors(); i++)
+    if (!storage.erase(i)) return (false);
+  return (begin());
+}
+
+template <class Storage>
+boolean PersistentLog<Storage>::read(uint32_t sequence, Record & record) {
+  /// @brief Reads record from the log
+  /// @details Location of the record is calculated from its sequence number without
+  /// searching.
+  /// @param sequence Sequence number of the record, from firstSequence() to
+  /// nextSequence() - 1
+  /// @param record Variable to store the record to
+  /// @return true if the record was read, false if the record is not in the log or
+  /// failed checksum validation
+  if (!initialised || (sequence < first) || (sequence >= next)) return (false);
+  const uint32_t headFirst = next - headSlot;
+  size_t sector = headSector;
+  size_t slot = 0;
+  if (sequence >= headFirst) {
+    slot = sequence - headFirst;
+  }
+  else {
+    const uint32_t sectorsBack = (headFirst - sequence + recordsPerSector - 1) / recordsPerSector;
+    sector = (headSector + sectors - sectorsBack) % sectors;
+    slot = sequence - (headFirst - sectorsBack * recordsPerSector);
+  }
+  if (!storage.read(sector, slot * sizeof(Record), reinterpret_cast<uint32_t *>(&record), sizeof(Record))) return (false);
+  return ((record.sequence == sequence) && (record.checksum == record.calculateChecksum()));
+}
+
+template <class Storage>
+uint32_t PersistentLog<Storage>::firstSequence(void) const {
+  /// @brief Returns sequence number of the oldest record in the log
+  return (first);
+}
+
+template <class Storage>
+uint32_t PersistentLog<Storage>::nextSequence(void) const {
+  /// @brief Returns sequence number which will be assigned to the next appended record
+  return (next);
+}
+
+template <class Storage>
+size_t PersistentLog<Storage>::count(void) const {
+  /// @brief Returns number of records in the log (including corrupted records)
+  return (next - first);
+}
+
+template <class Storage>
+size_t PersistentLog<Storage>::capacity(void) const {
+  /// @brief Returns number of records which are guaranteed to be kept in the log
+  /// @details One sector is erased when the log wraps around, so the records in one
+  /// sector do not count
+  if (!initialised) return (0);
+  return ((sectors - 1) * recordsPerSector);
+}
+
+}; //namespace sensorlog
+
+#endif
@@ -0,0 +1,14 @@
+/*
+ * Copyright (C) 2016-2017 Nick Naumenko (https://github.com/nnaumenko)
+ * All rights reserved
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+#include "telemetry.h"
+
+namespace telemetry {
+
+const Texts PROGMEM texts;
+
+}; //namespace telemetry
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2016-2017 Nick Naumenko (https://github.com/nnaumenko)
+ * All rights reserved
+ * This software may be modified and distributed under the terms
+ * of the MIT license. See the LICENSE file for details.
+ */
+
+/**
+ * @file
+ * @brief Filter telemetry.
+ *
+ * Reports status and operation counters of the registered filters via webserver.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "module.h"
+#include "util_data.h"
+#include "util_comm.h"
+
+namespace telemetry {
+
+#ifdef MODULE_TEXT
+#undef MODULE_TEXT
+#endif
+#define MODULE_TEXT(name,value) public: const char name [sizeof(value)] = value
+
+/// String literals used internally by FilterTelemetry module
+class Texts {
+    MODULE_TEXT(moduleName, "FilterTelemetry");
+    MODULE_TEXT(filterTelemetryJsonPath, "/filters.json");
+
+    MODULE_TEXT(jsonParTimestamp, "timestamp");
+    MODULE_TEXT(jsonParTelemetry, "telemetry");
+    MODULE_TEXT(jsonParFilters, "filters");
+
+    MODULE_TEXT(jsonParFilterName, "name");
+    MODULE_TEXT(jsonParFilterStatus, "status");
+    MODULE_TEXT(jsonParFilterSamples, "samples");
+    MODULE_TEXT(jsonParFilterOverflows, "overflows");
+    MODULE_TEXT(jsonParFilterErrorsInit, "errInit");
+    MODULE_TEXT(jsonParFilterErrorsTooFewInputs, "errTooFewInputs");
+    MODULE_TEXT(jsonParFilterErrorsSamplingRate, "errSamplingRate");
+    MODULE_TEXT(jsonParFilterWarningsTooManyInputs, "warnTooManyInputs");
+    MODULE_TEXT(jsonParFilterLastMicros, "lastUs");
+    MODULE_TEXT(jsonParFilterPeakMicros, "peakUs");
+} __attribute__((packed));
+
+extern const Texts PROGMEM texts;
+
+#undef MODULE_TEXT
+
+/// @brief Filter telemetry
+/// @details Keeps a list of filters used by the firmware and reports their status
+/// and operation counters (see util::dsp::TemplateFilter::Telemetry) in JSON format
+/// at /filters.json.
+/// @par Operation counters are only reported if UTIL_DATA_FILTER_TELEMETRY is enabled
+/// in project_config.h; otherwise only filter names and statuses are
+/// reported and "telemetry" is set to false.
+/// @tparam MaxFilters Maximum number of filters in the list
+template <size_t MaxFilters = 8>
+class FilterTelemetry : public Module<FilterTelemetry<MaxFilters>> {
+  public:
+    boolean add(const char * PROGMEM name, util::dsp::Filter * filter);
+    boolean remove(const util::dsp::Filter * filter);
+    inline size_t count(void) const;
+  public:
+    inline const char * PROGMEM moduleName (void);
+    inline const char * PROGMEM getMainPath(void);
+  public:
+    inline boolean onHTTPReqStart(void);
+    inline boolean onHTTPReqPath(const char * path);
+    inline boolean onHTTPReqMethod(const char * method);
+    boolean onRespond(Print &client);
+  private:
+    struct Item {
+      const char * PROGMEM name;
+      util::dsp::Filter * filter;
+    };
+    Item items[MaxFilters] = {};
+    size_t itemsCount = 0;
+  private:
+    boolean httpJsonPath = false;
+};
+
+/// @brief Adds filter to the list
+/// @details If the list already contains a filter with the same name (the same
+/// PROGMEM pointer), that filter is replaced; this allows to register filters which
+/// are re-created at run-time without removing the previous instance first.
+/// @param name C-string in PROGMEM, human-readable filter name
+/// @param filter Filter to report
+/// @return true if filter was added or replaced, false if the list is full or
+/// parameters are incorrect
+template <size_t MaxFilters>
+boolean FilterTelemetry<MaxFilters>::add(const char * PROGMEM name, util::dsp::Filter * filter) {
+  if (!name || !filter) return (false);
+  for (size_t i = 0; i < itemsCount; i++) {
+    if (items[i].name == name) {
+      items[i].filter = filter;
+      return (true);
+    }
+  }
+  if (itemsCount >= MaxFilters) return (false);
+  items[itemsCount].name = name;
+  items[itemsCount].filter = filter;
+  itemsCount++;
+  return (true);
+}
+
+/// @brief Removes filter from the list
+/// @details Must be called before the filter is deleted, unless it is replaced with
+/// add().
+/// @param filter Filter to remove
+/// @return true if filter was found and removed, false otherwise
+template <size_t MaxFilters>
+boolean FilterTelemetry<MaxFilters>::remove(const util::dsp::Filter * filter) {
+  for (size_t i = 0; i < itemsCount; i++) {
+    if (items[i].filter == filter) {
+      itemsCount--;
+      for (size_t j = i; j < itemsCount; j++)
+        items[j] = items[j + 1];
+      return (true);
+    }
+  }
+  return (false);
+}
+
+/// @brief Returns number of filters in the list
+template <size_t MaxFilters>
+size_t FilterTelemetry<MaxFilters>::count(void) const {
+  return (itemsCount);
+}
+
+/// @brief Returns human-readable module name as a c-string in PROGMEM.
+template <size_t MaxFilters>
+const char * PROGMEM FilterTelemetry<MaxFilters>::moduleName (void) {
+  return (texts.moduleName);
+}
+
+/// @brief Returns default webserver path for this module, implements interface method ModuleWebServer::getMainPath().
+template <size_t MaxFilters>
+const char * PROGMEM FilterTelemetry<MaxFilters>::getMainPath (void) {
+  return (texts.filterTelemetryJsonPath);
+}
+
+/// @brief Interface to integrate into webserver, implements interface method ModuleWebServer::onHTTPReqStart()
+template <size_t MaxFilters>
+boolean FilterTelemetry<MaxFilters>::onHTTPReqStart(void) {
+  httpJsonPath = false;
+  return (true);
+}
+
+/// @brief Interface to integrate into webserver, implements interface method ModuleWebServer::onHTTPReqPath()
+template <size_t MaxFilters>
+boolean FilterTelemetry<MaxFilters>::onHTTPReqPath(const char * path) {
+  httpJsonPath = !strcmp_P(path, texts.filterTelemetryJsonPath);
+  return (httpJsonPath);
+}
+
+/// @brief Interface to integrate into webserver, implements interface method ModuleWebServer::onHTTPReqMethod()
+template <size_t MaxFilters>
+boolean FilterTelemetry<MaxFilters>::onHTTPReqMethod(const char * method) {
+  return (util::http::HTTPRequestHelper::getMethod(method) == util::http::HTTPRequestMethod::GET);
+}
+
+/// @brief Interface to integrate into webserver, implements interface method ModuleWebServer::onRespond()
+template <size_t MaxFilters>
+boolean FilterTelemetry<MaxFilters>::onRespond(Print & client) {
+  if (!httpJsonPath) return (false);
+  util::http::HTTPResponseHeader::contentHeader(client, util::http::HTTPContentType::JSON);
+  util::json::JSONOutput json (client);
+  json.value(FPSTR(texts.jsonParTimestamp), millis());
+#if UTIL_DATA_FILTER_TELEMETRY
+  static const boolean telemetryEnabled = true;
+#else
+  static const boolean telemetryEnabled = false;
+#endif
+  json.value(FPSTR(texts.jsonParTelemetry), telemetryEnabled);
+  json.beginArray(FPSTR(texts.jsonParFilters));
+  for (size_t i = 0; i < itemsCount; i++) {
+    json.beginObject();
+    json.value(FPSTR(texts.jsonParFilterName), FPSTR(items[i].name));
+    json.value(FPSTR(texts.jsonParFilterStatus), static_cast<long>(items[i].filter->getStatus()));
+    const util::dsp::Filter::Telemetry * telemetry = items[i].filter->getTelemetry();
+    if (telemetry) {
+      json.value(FPSTR(texts.jsonParFilterSamples), static_cast<unsigned long>(telemetry->samples));
+      json.value(FPSTR(texts.jsonParFilterOverflows), static_cast<unsigned long>(telemetry->overflows));
+      json.value(FPSTR(texts.jsonParFilterErrorsInit), static_cast<unsigned long>(telemetry->errorsInit));
+      json.value(FPSTR(texts.jsonParFilterErrorsTooFewInputs), static_cast<unsigned long>(telemetry->errorsTooFewInputs));
+      json.value(FPSTR(texts.jsonParFilterErrorsSamplingRate), static_cast<unsigned long>(telemetry->errorsSamplingRateTooLow));
+      json.value(FPSTR(texts.jsonParFilterWarningsTooManyInputs), static_cast<unsigned long>(telemetry->warningsTooManyInputs));
+      json.value(FPSTR(texts.jsonParFilterLastMicros), static_cast<unsigned long>(telemetry->lastMicros));
+      json.value(FPSTR(texts.jsonParFilterPeakMicros), static_cast<unsigned long>(telemetry->peakMicros));
+    }
+    json.finish();
+  }
+  json.~JSONOutput();
+  return (true);
+}
+
+}; //namespace telemetry
+
+#endif
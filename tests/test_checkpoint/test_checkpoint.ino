@@ -0,0 +1,170 @@
+#include <ESP8266WiFi.h>
+#include <EEPROM.h>
+
+#include "test.h"
+
+#include "checkpoint.h"
+
+using RTCCheckpoint = checkpoint::FilterCheckpoint<checkpoint::RTCMemoryStorage<>, 3>;
+using EEPROMCheckpoint = checkpoint::FilterCheckpoint<checkpoint::EEPROMStorage<512, 256>, 3, 128>;
+
+const char PROGMEM testFilterName1[] = "test1";
+const char PROGMEM testFilterName2[] = "test2";
+const char PROGMEM testFilterName3[] = "test3";
+
+class TestFilterCheckpoint {
+  public:
+    static void add_listFullOrSameName_expectFalseOrReplaced(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const char PROGMEM testFilterName4[] = "test4";
+      static const size_t avgPoints = 4;
+      util::dsp::FilterMovingAverage testFilter1(avgPoints);
+      util::dsp::FilterMovingAverage testFilter2(avgPoints);
+      util::dsp::FilterMovingAverage testFilter3(avgPoints);
+      util::dsp::FilterMovingAverage testFilter4(avgPoints);
+      //act
+      boolean result1 = RTCCheckpoint::instance()->add(testFilterName1, &testFilter1);
+      boolean result2 = RTCCheckpoint::instance()->add(testFilterName2, &testFilter2);
+      boolean result3 = RTCCheckpoint::instance()->add(testFilterName3, &testFilter3);
+      boolean result4 = RTCCheckpoint::instance()->add(testFilterName4, &testFilter4);
+      boolean result5 = RTCCheckpoint::instance()->add(testFilterName1, &testFilter4);
+      size_t count = RTCCheckpoint::instance()->count();
+      boolean removeResult1 = RTCCheckpoint::instance()->remove(&testFilter1);
+      //assert
+      TEST_ASSERT(result1);
+      TEST_ASSERT(result2);
+      TEST_ASSERT(result3);
+      TEST_ASSERT(!result4);
+      TEST_ASSERT(result5);
+      TEST_ASSERT(count == 3);
+      TEST_ASSERT(!removeResult1);
+      //cleanup
+      RTCCheckpoint::instance()->remove(&testFilter2);
+      RTCCheckpoint::instance()->remove(&testFilter3);
+      RTCCheckpoint::instance()->remove(&testFilter4);
+      TEST_FUNC_END();
+    }
+    static void restore_savedInRTCMemory_expectWarmFilters(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      static const util::Value fc(1);
+      static const util::Value timestampFactor = util::timestampPerSecond;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterMovingAverage(avgPoints);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterLowPass(fc, util::ValuePi, timestampFactor);
+      util::dsp::Filter * testFilter3 = new util::dsp::FilterMovingMedian(avgPoints);
+      RTCCheckpoint::instance()->add(testFilterName1, testFilter1);
+      RTCCheckpoint::instance()->add(testFilterName2, testFilter2);
+      RTCCheckpoint::instance()->add(testFilterName3, testFilter3);
+      testFilter1->filter(1, util::Value(2));
+      testFilter1->filter(101, util::Value(4));
+      testFilter2->filter(1, util::Value(10));
+      testFilter2->filter(101, util::Value(20));
+      testFilter3->filter(1, util::Value(1));
+      boolean saveResult = RTCCheckpoint::instance()->save();
+      util::Value expected1 = testFilter1->filter(201, util::Value(6));
+      util::Value expected2 = testFilter2->filter(201, util::Value(20));
+      delete(testFilter1);
+      delete(testFilter2);
+      delete(testFilter3);
+      //simulate restart: filters re-created and added in the same order
+      testFilter1 = new util::dsp::FilterMovingAverage(avgPoints);
+      testFilter2 = new util::dsp::FilterLowPass(fc, util::ValuePi, timestampFactor);
+      testFilter3 = new util::dsp::FilterMovingMedian(avgPoints);
+      RTCCheckpoint::instance()->add(testFilterName1, testFilter1);
+      RTCCheckpoint::instance()->add(testFilterName2, testFilter2);
+      RTCCheckpoint::instance()->add(testFilterName3, testFilter3);
+      //act
+      size_t restored = RTCCheckpoint::instance()->restore(10);
+      util::Value output1 = testFilter1->filter(110, util::Value(6));
+      util::Value output2 = testFilter2->filter(110, util::Value(20));
+      //assert
+      TEST_ASSERT(saveResult);
+      TEST_ASSERT(restored == 2);
+      TEST_ASSERT(output1 == expected1);
+      TEST_ASSERT(output2 == expected2);
+      //cleanup
+      RTCCheckpoint::instance()->remove(testFilter1);
+      RTCCheckpoint::instance()->remove(testFilter2);
+      RTCCheckpoint::instance()->remove(testFilter3);
+      delete(testFilter1);
+      delete(testFilter2);
+      delete(testFilter3);
+      TEST_FUNC_END();
+    }
+    static void restore_corruptedOrDifferentFilters_expectNotRestored(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      static const size_t headerBlocks = 2;
+      util::dsp::FilterMovingAverage testFilter1(avgPoints);
+      util::dsp::FilterMovingAverage testFilter2(avgPoints);
+      RTCCheckpoint::instance()->add(testFilterName1, &testFilter1);
+      RTCCheckpoint::instance()->add(testFilterName2, &testFilter2);
+      testFilter1.filter(1, util::Value(1));
+      testFilter2.filter(1, util::Value(2));
+      RTCCheckpoint::instance()->save();
+      //act
+      RTCCheckpoint::instance()->remove(&testFilter2);
+      size_t restoredDifferentFilters = RTCCheckpoint::instance()->restore(10);
+      RTCCheckpoint::instance()->add(testFilterName2, &testFilter2);
+      size_t restoredSameFilters = RTCCheckpoint::instance()->restore(10);
+      uint32_t data;
+      ESP.rtcUserMemoryRead(headerBlocks, &data, sizeof(data));
+      data ^= 1;
+      ESP.rtcUserMemoryWrite(headerBlocks, &data, sizeof(data));
+      size_t restoredCorrupted = RTCCheckpoint::instance()->restore(10);
+      //assert
+      TEST_ASSERT(!restoredDifferentFilters);
+      TEST_ASSERT(restoredSameFilters == 2);
+      TEST_ASSERT(!restoredCorrupted);
+      //cleanup
+      RTCCheckpoint::instance()->remove(&testFilter1);
+      RTCCheckpoint::instance()->remove(&testFilter2);
+      TEST_FUNC_END();
+    }
+    static void restore_savedInEEPROM_expectWarmFilters(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 8;
+      util::dsp::FilterMovingAverage testFilter1(avgPoints);
+      util::dsp::FilterMovingAverage testFilter2(avgPoints);
+      EEPROMCheckpoint::instance()->add(testFilterName1, &testFilter1);
+      for (size_t i = 0; i < avgPoints; i++)
+        testFilter1.filter(i + 1, util::Value(i));
+      boolean saveResult = EEPROMCheckpoint::instance()->save();
+      EEPROMCheckpoint::instance()->add(testFilterName1, &testFilter2);
+      //act
+      size_t restored = EEPROMCheckpoint::instance()->restore(10);
+      util::Value output1 = testFilter1.filter(avgPoints + 1, util::Value(avgPoints));
+      util::Value output2 = testFilter2.filter(11, util::Value(avgPoints));
+      //assert
+      TEST_ASSERT(saveResult);
+      TEST_ASSERT(restored == 1);
+      TEST_ASSERT(output2 == output1);
+      //cleanup
+      EEPROMCheckpoint::instance()->remove(&testFilter2);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      add_listFullOrSameName_expectFalseOrReplaced();
+      restore_savedInRTCMemory_expectWarmFilters();
+      restore_corruptedOrDifferentFilters_expectNotRestored();
+      restore_savedInEEPROM_expectWarmFilters();
+    }
+};
+
+TEST_GLOBALS();
+
+void setup() {
+  TEST_SETUP();
+  TEST_BEGIN();
+  TestFilterCheckpoint::runTests();
+  TEST_END();
+}
+
+void loop() {
+  delay(100);
+}
@@ -109,6 +109,28 @@ class TestDiagLog {
       DiagLog::instance()->disablePrintOutput();
       TEST_FUNC_END();
     }
+    static void log_messageWithValue_expectValuePrintedAsDecimal(void) {
+      TEST_FUNC_START();
+      //arrange
+      FakeStreamOut testOutput;
+      testOutput.begin();
+      DiagLog::instance()->setPrintOutput(testOutput);
+      DiagLog::instance()->setSeverityFilter();
+      static const util::Value testValue(-12375, 3); //-12.375
+      //act
+      uint32_t logResult = DiagLog::instance()->log(DiagLog::Severity::DEBUG, "value=", testValue);
+      DiagLogPrintOutputContent result;
+      boolean outputParsingResult = parseDiagLogOutput(testOutput.getOutBufferContent(), &result);
+      //assert
+      TEST_ASSERT(!testOutput.isOutBufferOverflow());
+      TEST_ASSERT(outputParsingResult);
+      TEST_ASSERT(result.messageCount == 1);
+      TEST_ASSERT(result.messageNumber[0] == logResult);
+      TEST_ASSERT(!strcmp(result.message[0], "value=-12.375"));
+      //cleanup
+      DiagLog::instance()->disablePrintOutput();
+      TEST_FUNC_END();
+    }
     static void log_messageSeverities_expectCorrectSeverityTexts(void) {
       TEST_FUNC_START();
       //arrange
@@ -185,14 +207,38 @@ class TestDiagLog {
       DiagLog::instance()->disablePrintOutput();
       TEST_FUNC_END();
     }
+    static void log_messageTooLong_expectTruncationMark(void) {
+      TEST_FUNC_START();
+      //arrange
+      FakeStreamOut testOutput;
+      testOutput.begin();
+      DiagLog::instance()->setPrintOutput(testOutput);
+      DiagLog::instance()->setSeverityFilter();
+      static const size_t longMessageSize = 300;
+      char longMessage[longMessageSize] = {};
+      memset(longMessage, 'a', longMessageSize - 1);
+      //act
+      DiagLog::instance()->log(DiagLog::Severity::DEBUG, longMessage);
+      const char * output = testOutput.getOutBufferContent();
+      const char * messageEnd = strstr(output, "\r\n");
+      //assert
+      TEST_ASSERT(messageEnd);
+      TEST_ASSERT(messageEnd && (messageEnd - output) == 255);
+      TEST_ASSERT(messageEnd && !strncmp(messageEnd - 4, "a...", 4));
+      //cleanup
+      DiagLog::instance()->disablePrintOutput();
+      TEST_FUNC_END();
+    }
   public:
     static void test_log(void) {
       log_disablePrintOutput_expectNoCrash();
       log_messageSinglePart_expectTheSameString();
       log_messageMultipleParts_expectConcatenatedParts();
+      log_messageWithValue_expectValuePrintedAsDecimal();
       log_messageSeverities_expectCorrectSeverityTexts();
       log_twoSequentialMessages_expectMessageNumberIncreases();
       log_severityFilter_expectNoFilteredMessages();
+      log_messageTooLong_expectTruncationMark();
     }
   public:
     static void setSeverityFilter_severityEmergencyAlertCritical_expectCritical(void) {
@@ -238,10 +284,43 @@ class TestDiagLog {
       setSeverityFilter_severityEmergencyAlertCritical_expectCritical();
       setSeverityFilter_severityErrorWarningNoticeInformationalDebug_expectSameSeverity();
     }
+  public:
+    static void onRespond_jsonPathWrappedStorage_expectMessagePartsStreamed(void) {
+      TEST_FUNC_START();
+      //arrange
+      using SmallDiagLog = diag::DiagLog<diag::DiagLogStorage<100> >;
+      static const size_t messagesNumber = 7;
+      FakeStreamOut testOutput;
+      testOutput.begin();
+      SmallDiagLog::instance()->disablePrintOutput();
+      SmallDiagLog::instance()->setSeverityFilter();
+      uint32_t lastMessageNumber = 0;
+      for (size_t i = 0; i < messagesNumber; i++)
+        lastMessageNumber = SmallDiagLog::instance()->log(SmallDiagLog::Severity::WARNING, "text|with|separators");
+      char expectedText[64] = {};
+      sprintf(expectedText, "{\"no\":\"%lu\",\"time\":\"", static_cast<unsigned long>(lastMessageNumber));
+      //act
+      SmallDiagLog::instance()->onHTTPReqStart();
+      boolean pathResult = SmallDiagLog::instance()->onHTTPReqPath("/diag.json");
+      boolean respondResult = SmallDiagLog::instance()->onRespond(testOutput);
+      const char * lastMessage = strstr(testOutput.getOutBufferContent(), expectedText);
+      //assert
+      TEST_ASSERT(pathResult);
+      TEST_ASSERT(respondResult);
+      TEST_ASSERT(!testOutput.isOutBufferOverflow());
+      TEST_ASSERT(lastMessage);
+      TEST_ASSERT(lastMessage && strstr(lastMessage, "\",\"sev\":\"Warning\",\"msg\":\"text|with|separators\"}]}"));
+      TEST_FUNC_END();
+    }
+  public:
+    static void test_onRespond(void) {
+      onRespond_jsonPathWrappedStorage_expectMessagePartsStreamed();
+    }
   public:
     static void runTests(void) {
       test_log();
       test_severityFilter();
+      test_onRespond();
     }
 };
 
@@ -0,0 +1,277 @@
+#include <ESP8266WiFi.h>
+
+#include "test.h"
+
+#include "sensorlog.h"
+
+#ifndef ARDUINO
+#include <unistd.h>
+#endif
+
+/// Storage in RAM, emulates flash memory: erase fills sector with 0xFF, write only clears bits
+template <size_t Sectors, size_t SectorSize>
+class TestRAMStorage {
+  public:
+    TestRAMStorage() {
+      memset(memory, 0, sizeof(memory));
+    }
+    boolean validate(void) const {
+      return (true);
+    }
+    size_t getSectors(void) const {
+      return (Sectors);
+    }
+    size_t getSectorSize(void) const {
+      return (SectorSize);
+    }
+    boolean erase(size_t sector) {
+      if (sector >= Sectors) return (false);
+      memset(memory[sector], 0xFF, SectorSize);
+      eraseCount[sector]++;
+      return (true);
+    }
+    boolean read(size_t sector, size_t offset, uint32_t * data, size_t size) {
+      if ((sector >= Sectors) || ((offset + size) > SectorSize)) return (false);
+      memcpy(data, &memory[sector][offset], size);
+      return (true);
+    }
+    boolean write(size_t sector, size_t offset, const uint32_t * data, size_t size) {
+      if ((sector >= Sectors) || ((offset + size) > SectorSize)) return (false);
+      const uint8_t * source = reinterpret_cast<const uint8_t *>(data);
+      for (size_t i = 0; i < size; i++)
+        memory[sector][offset + i] &= source[i];
+      return (true);
+    }
+  public:
+    uint8_t memory[Sectors][SectorSize];
+    size_t eraseCount[Sectors] = {};
+};
+
+class TestPersistentLog {
+  public:
+    static sensorlog::Record makeRecord(uint32_t i) {
+      sensorlog::Record record = {};
+      record.timestamp = i * 1000;
+      record.value = util::Value(i).getRaw();
+      record.id = i;
+      record.idGroup = 1;
+      record.unit = 0;
+      record.flags = sensorlog::Record::flagValid;
+      return (record);
+    }
+  public:
+    static void append_read_expectSameRecords(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t recordsNumber = 10;
+      TestRAMStorage<2, 256> storage;
+      sensorlog::PersistentLog<TestRAMStorage<2, 256> > log(storage);
+      boolean beginResult = log.begin();
+      //act
+      boolean appendResult = true;
+      for (size_t i = 0; i < recordsNumber; i++)
+        if (!log.append(makeRecord(i))) appendResult = false;
+      boolean readResult = true;
+      boolean recordsCorrect = true;
+      for (size_t i = 0; i < recordsNumber; i++) {
+        sensorlog::Record record;
+        if (!log.read(i, record)) readResult = false;
+        if ((record.sequence != i) ||
+            (record.timestamp != i * 1000) ||
+            (record.getValue() != util::Value(i)) ||
+            (record.id != i) ||
+            !record.isValid()) recordsCorrect = false;
+      }
+      sensorlog::Record record;
+      boolean readBeyondResult = log.read(recordsNumber, record);
+      //assert
+      TEST_ASSERT(beginResult);
+      TEST_ASSERT(appendResult);
+      TEST_ASSERT(readResult);
+      TEST_ASSERT(recordsCorrect);
+      TEST_ASSERT(!readBeyondResult);
+      TEST_ASSERT(log.firstSequence() == 0);
+      TEST_ASSERT(log.nextSequence() == recordsNumber);
+      TEST_ASSERT(log.count() == recordsNumber);
+      TEST_FUNC_END();
+    }
+    static void append_moreThanCapacity_expectOldestDiscardedSectorsWearLevelled(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t sectors = 4;
+      static const size_t sectorSize = sizeof(sensorlog::Record) * 5;
+      static const size_t recordsNumber = 103;
+      TestRAMStorage<sectors, sectorSize> storage;
+      sensorlog::PersistentLog<TestRAMStorage<sectors, sectorSize> > log(storage);
+      log.begin();
+      //act
+      for (size_t i = 0; i < recordsNumber; i++)
+        log.append(makeRecord(i));
+      sensorlog::Record oldestRecord, newestRecord, discardedRecord;
+      boolean oldestResult = log.read(log.firstSequence(), oldestRecord);
+      boolean newestResult = log.read(recordsNumber - 1, newestRecord);
+      boolean discardedResult = log.read(log.firstSequence() - 1, discardedRecord);
+      //assert
+      TEST_ASSERT(log.capacity() == 15);
+      TEST_ASSERT(log.count() >= log.capacity());
+      TEST_ASSERT(log.firstSequence() == 85);
+      TEST_ASSERT(log.nextSequence() == recordsNumber);
+      TEST_ASSERT(oldestResult);
+      TEST_ASSERT(oldestRecord.id == 85);
+      TEST_ASSERT(newestResult);
+      TEST_ASSERT(newestRecord.id == recordsNumber - 1);
+      TEST_ASSERT(!discardedResult);
+      for (size_t i = 0; i < sectors; i++)
+        TEST_ASSERT(storage.eraseCount[i] >= 5 && storage.eraseCount[i] <= 6);
+      TEST_FUNC_END();
+    }
+    static void begin_restart_expectLogRecovered(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t sectors = 3;
+      static const size_t sectorSize = sizeof(sensorlog::Record) * 4;
+      static const size_t recordsNumberBefore = 17;
+      static const size_t recordsNumberAfter = 6;
+      TestRAMStorage<sectors, sectorSize> storage;
+      sensorlog::PersistentLog<TestRAMStorage<sectors, sectorSize> > logBefore(storage);
+      logBefore.begin();
+      for (size_t i = 0; i < recordsNumberBefore; i++)
+        logBefore.append(makeRecord(i));
+      //act
+      sensorlog::PersistentLog<TestRAMStorage<sectors, sectorSize> > logAfter(storage);
+      boolean beginResult = logAfter.begin();
+      uint32_t firstAfterRestart = logAfter.firstSequence();
+      uint32_t nextAfterRestart = logAfter.nextSequence();
+      for (size_t i = 0; i < recordsNumberAfter; i++)
+        logAfter.append(makeRecord(recordsNumberBefore + i));
+      boolean recordsCorrect = true;
+      for (uint32_t i = logAfter.firstSequence(); i < logAfter.nextSequence(); i++) {
+        sensorlog::Record record;
+        if (!logAfter.read(i, record) || (record.id != i)) recordsCorrect = false;
+      }
+      //assert
+      TEST_ASSERT(beginResult);
+      TEST_ASSERT(firstAfterRestart == logBefore.firstSequence());
+      TEST_ASSERT(nextAfterRestart == logBefore.nextSequence());
+      TEST_ASSERT(logAfter.nextSequence() == recordsNumberBefore + recordsNumberAfter);
+      TEST_ASSERT(recordsCorrect);
+      TEST_FUNC_END();
+    }
+    static void read_corruptedRecord_expectFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t recordsNumber = 3;
+      static const size_t corruptedRecord = 1;
+      TestRAMStorage<2, 256> storage;
+      sensorlog::PersistentLog<TestRAMStorage<2, 256> > log(storage);
+      log.begin();
+      for (size_t i = 0; i < recordsNumber; i++)
+        log.append(makeRecord(i));
+      //act
+      storage.memory[0][corruptedRecord * sizeof(sensorlog::Record) + offsetof(sensorlog::Record, value)] ^= 0x01;
+      sensorlog::Record record;
+      boolean readResult0 = log.read(0, record);
+      boolean readResult1 = log.read(corruptedRecord, record);
+      boolean readResult2 = log.read(2, record);
+      //assert
+      TEST_ASSERT(readResult0);
+      TEST_ASSERT(!readResult1);
+      TEST_ASSERT(readResult2);
+      TEST_FUNC_END();
+    }
+    static void fromQuantity_genericQuantity_expectFieldsMatch(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::quantity::Quantity::id_t id = 10;
+      static const util::quantity::Quantity::id_t idGroup = 20;
+      static const util::Value value(123, 1);
+      static const util::Timestamp timestamp = 12345;
+      util::quantity::Generic validQuantity(id, idGroup, value, util::StrRef(), timestamp);
+      util::quantity::Generic invalidQuantity(id, idGroup, value, util::StrRef(), timestamp, false);
+      //act
+      sensorlog::Record validRecord = sensorlog::Record::fromQuantity(validQuantity);
+      sensorlog::Record invalidRecord = sensorlog::Record::fromQuantity(invalidQuantity);
+      //assert
+      TEST_ASSERT(validRecord.id == id);
+      TEST_ASSERT(validRecord.idGroup == idGroup);
+      TEST_ASSERT(validRecord.getValue() == value);
+      TEST_ASSERT(validRecord.timestamp == timestamp);
+      TEST_ASSERT(validRecord.unit == validQuantity.getUnit());
+      TEST_ASSERT(validRecord.isValid());
+      TEST_ASSERT(!invalidRecord.isValid());
+      TEST_FUNC_END();
+    }
+#ifndef ARDUINO
+    static void mappedFileStorage_reopened_expectRecordsPersisted(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const char path[] = "test_sensorlog.bin";
+      static const size_t sectors = 4;
+      static const size_t recordsNumber = 500;
+      unlink(path);
+      {
+        sensorlog::MappedFileStorage storage(path, sectors);
+        sensorlog::PersistentLog<sensorlog::MappedFileStorage> log(storage);
+        log.begin();
+        for (size_t i = 0; i < recordsNumber; i++)
+          log.append(makeRecord(i));
+      }
+      //act
+      sensorlog::MappedFileStorage storage(path, sectors);
+      sensorlog::PersistentLog<sensorlog::MappedFileStorage> log(storage);
+      boolean beginResult = log.begin();
+      sensorlog::Record record;
+      boolean readResult = log.read(recordsNumber - 1, record);
+      //assert
+      TEST_ASSERT(storage.validate());
+      TEST_ASSERT(beginResult);
+      TEST_ASSERT(log.nextSequence() == recordsNumber);
+      TEST_ASSERT(readResult);
+      TEST_ASSERT(record.id == recordsNumber - 1);
+      //cleanup
+      unlink(path);
+      TEST_FUNC_END();
+    }
+#endif
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+    static void performanceTest_append(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t recordsNumber = 1000;
+      static TestRAMStorage<4, 4096> storage;
+      sensorlog::PersistentLog<TestRAMStorage<4, 4096> > log(storage);
+      log.begin();
+      sensorlog::Record record = makeRecord(0);
+      PERF_TEST_START();
+      for (size_t i = 0; i < recordsNumber; i++)
+        log.append(record);
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      append_read_expectSameRecords();
+      append_moreThanCapacity_expectOldestDiscardedSectorsWearLevelled();
+      begin_restart_expectLogRecovered();
+      read_corruptedRecord_expectFalse();
+      fromQuantity_genericQuantity_expectFieldsMatch();
+#ifndef ARDUINO
+      mappedFileStorage_reopened_expectRecordsPersisted();
+#endif
+      performanceTest_append();
+    }
+};
+
+TEST_GLOBALS();
+
+void setup() {
+  TEST_SETUP();
+  TEST_BEGIN();
+  TestPersistentLog::runTests();
+  TEST_END();
+}
+
+void loop() {
+  delay(100);
+}
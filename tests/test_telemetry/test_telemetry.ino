@@ -0,0 +1,232 @@
+#include <ESP8266WiFi.h>
+
+#include "test.h"
+#include "fakestream.h"
+
+#include "telemetry.h"
+
+using FilterTelemetry = telemetry::FilterTelemetry<2>;
+
+const char PROGMEM testFilterName1[] = "test1";
+const char PROGMEM testFilterName2[] = "test2";
+
+class TestTemplateFilterTelemetry {
+  public:
+    static void filter_normalOperation_expectSamplesCounted(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      static const size_t samples = 5;
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingAverage(avgPoints);
+      //act
+      for (size_t i = 0; i < samples; i++)
+        testFilter->filter(i + 1, util::Value(1));
+      const util::dsp::Filter::Telemetry * telemetry = testFilter->getTelemetry();
+      //assert
+      TEST_ASSERT(telemetry);
+      TEST_ASSERT(telemetry->samples == samples);
+      TEST_ASSERT(!telemetry->overflows);
+      TEST_ASSERT(!telemetry->errorsInit);
+      TEST_ASSERT(!telemetry->errorsTooFewInputs);
+      TEST_ASSERT(!telemetry->errorsSamplingRateTooLow);
+      TEST_ASSERT(!telemetry->warningsTooManyInputs);
+      TEST_ASSERT(telemetry->peakMicros >= telemetry->lastMicros);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void filter_errorsAndWarnings_expectCountedByKind(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      static const util::Value negativeThreshold(-1);
+      static const util::Value fc(3);
+      static const util::Value fcDivider(1000);
+      static const util::Value q(7071, 4);
+      static const uint32_t deltaTime = 1000;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterMovingAverage(avgPoints);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterHampel(avgPoints, negativeThreshold);
+      util::dsp::Filter * testFilter3 = new util::dsp::FilterBiquad(util::dsp::FilterBiquad::Type::LOW_PASS, fc, q, fcDivider);
+      //act
+      testFilter1->filter(1);
+      testFilter1->filter(2);
+      testFilter1->filter(3, util::Value(1), util::Value(2));
+      testFilter2->filter(1, util::Value(1));
+      testFilter3->filter(1, util::Value(1));
+      testFilter3->filter(1 + deltaTime, util::Value(1));
+      const util::dsp::Filter::Telemetry * telemetry1 = testFilter1->getTelemetry();
+      const util::dsp::Filter::Telemetry * telemetry2 = testFilter2->getTelemetry();
+      const util::dsp::Filter::Telemetry * telemetry3 = testFilter3->getTelemetry();
+      //assert
+      TEST_ASSERT(telemetry1->samples == 3);
+      TEST_ASSERT(telemetry1->errorsTooFewInputs == 2);
+      TEST_ASSERT(telemetry1->warningsTooManyInputs == 1);
+      TEST_ASSERT(!telemetry1->errorsInit);
+      TEST_ASSERT(telemetry2->samples == 1);
+      TEST_ASSERT(telemetry2->errorsInit == 1);
+      TEST_ASSERT(telemetry3->samples == 2);
+      TEST_ASSERT(telemetry3->errorsSamplingRateTooLow == 1);
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      delete(testFilter3);
+      TEST_FUNC_END();
+    }
+    static void filter_overflowOutput_expectOverflowCounted(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t windowSize = 4;
+      util::dsp::Filter * testFilter = new util::dsp::FilterStatistics(windowSize);
+      const util::Value overflowInput = util::Value::fromRaw(INT32_MAX);
+      //act
+      testFilter->filter(1, overflowInput);
+      testFilter->filter(2, util::Value(1));
+      const util::dsp::Filter::Telemetry * telemetry = testFilter->getTelemetry();
+      //assert
+      TEST_ASSERT(telemetry->samples == 2);
+      TEST_ASSERT(telemetry->overflows == 1);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void resetTelemetry_expectCountersZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingAverage(avgPoints);
+      testFilter->filter(1);
+      testFilter->filter(2, util::Value(1));
+      //act
+      testFilter->resetTelemetry();
+      const util::dsp::Filter::Telemetry * telemetry = testFilter->getTelemetry();
+      //assert
+      TEST_ASSERT(!telemetry->samples);
+      TEST_ASSERT(!telemetry->errorsTooFewInputs);
+      TEST_ASSERT(!telemetry->lastMicros);
+      TEST_ASSERT(!telemetry->peakMicros);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      filter_normalOperation_expectSamplesCounted();
+      filter_errorsAndWarnings_expectCountedByKind();
+      filter_overflowOutput_expectOverflowCounted();
+      resetTelemetry_expectCountersZero();
+    }
+};
+
+class TestFilterTelemetry {
+  public:
+    static void add_listFull_expectFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const char PROGMEM testFilterName3[] = "test3";
+      static const size_t avgPoints = 4;
+      util::dsp::FilterMovingAverage testFilter1(avgPoints);
+      util::dsp::FilterMovingAverage testFilter2(avgPoints);
+      util::dsp::FilterMovingAverage testFilter3(avgPoints);
+      //act
+      boolean result1 = FilterTelemetry::instance()->add(testFilterName1, &testFilter1);
+      boolean result2 = FilterTelemetry::instance()->add(testFilterName2, &testFilter2);
+      boolean result3 = FilterTelemetry::instance()->add(testFilterName3, &testFilter3);
+      size_t count = FilterTelemetry::instance()->count();
+      //assert
+      TEST_ASSERT(result1);
+      TEST_ASSERT(result2);
+      TEST_ASSERT(!result3);
+      TEST_ASSERT(count == 2);
+      //cleanup
+      FilterTelemetry::instance()->remove(&testFilter1);
+      FilterTelemetry::instance()->remove(&testFilter2);
+      TEST_FUNC_END();
+    }
+    static void add_sameName_expectFilterReplaced(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      util::dsp::FilterMovingAverage testFilter1(avgPoints);
+      util::dsp::FilterMovingAverage testFilter2(avgPoints);
+      //act
+      FilterTelemetry::instance()->add(testFilterName1, &testFilter1);
+      FilterTelemetry::instance()->add(testFilterName1, &testFilter2);
+      size_t count = FilterTelemetry::instance()->count();
+      boolean removeResult1 = FilterTelemetry::instance()->remove(&testFilter1);
+      boolean removeResult2 = FilterTelemetry::instance()->remove(&testFilter2);
+      //assert
+      TEST_ASSERT(count == 1);
+      TEST_ASSERT(!removeResult1);
+      TEST_ASSERT(removeResult2);
+      TEST_ASSERT(!FilterTelemetry::instance()->count());
+      TEST_FUNC_END();
+    }
+    static void onHTTPReqPath_otherPath_expectFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      FakeStreamOut testOutput;
+      testOutput.begin();
+      //act
+      FilterTelemetry::instance()->onHTTPReqStart();
+      boolean pathResult = FilterTelemetry::instance()->onHTTPReqPath("/diag.json");
+      boolean respondResult = FilterTelemetry::instance()->onRespond(testOutput);
+      //assert
+      TEST_ASSERT(!pathResult);
+      TEST_ASSERT(!respondResult);
+      TEST_ASSERT(!strlen(testOutput.getOutBufferContent()));
+      TEST_FUNC_END();
+    }
+    static void onRespond_registeredFilters_expectJsonWithCounters(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      util::dsp::FilterMovingAverage testFilter1(avgPoints);
+      util::dsp::FilterMovingAverage testFilter2(avgPoints);
+      FilterTelemetry::instance()->add(testFilterName1, &testFilter1);
+      FilterTelemetry::instance()->add(testFilterName2, &testFilter2);
+      testFilter1.filter(1, util::Value(1));
+      testFilter1.filter(2, util::Value(1));
+      testFilter2.filter(1);
+      FakeStreamOut testOutput;
+      testOutput.begin();
+      //act
+      FilterTelemetry::instance()->onHTTPReqStart();
+      boolean pathResult = FilterTelemetry::instance()->onHTTPReqPath("/filters.json");
+      boolean methodResult = FilterTelemetry::instance()->onHTTPReqMethod("GET");
+      boolean respondResult = FilterTelemetry::instance()->onRespond(testOutput);
+      const char * json = strstr(testOutput.getOutBufferContent(), "\r\n\r\n");
+      //assert
+      TEST_ASSERT(pathResult);
+      TEST_ASSERT(methodResult);
+      TEST_ASSERT(respondResult);
+      TEST_ASSERT(!testOutput.isOutBufferOverflow());
+      TEST_ASSERT(json);
+      TEST_ASSERT(strstr(json, "\"telemetry\":true,\"filters\":[{\"name\":\"test1\",\"status\":1,\"samples\":2,\"overflows\":0,\"errInit\":0,\"errTooFewInputs\":0,"));
+      TEST_ASSERT(strstr(json, "{\"name\":\"test2\",\"status\":7,\"samples\":1,\"overflows\":0,\"errInit\":0,\"errTooFewInputs\":1,"));
+      //cleanup
+      FilterTelemetry::instance()->remove(&testFilter1);
+      FilterTelemetry::instance()->remove(&testFilter2);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      add_listFull_expectFalse();
+      add_sameName_expectFilterReplaced();
+      onHTTPReqPath_otherPath_expectFalse();
+      onRespond_registeredFilters_expectJsonWithCounters();
+    }
+};
+
+TEST_GLOBALS();
+
+void setup() {
+  TEST_SETUP();
+  TEST_BEGIN();
+  TestTemplateFilterTelemetry::runTests();
+  TestFilterTelemetry::runTests();
+  TEST_END();
+}
+
+void loop() {
+  delay(100);
+}
@@ -51,9 +51,29 @@ class TestJSONOutput {
       TEST_ASSERT(!strcmp(testOutput.getOutBufferContent(), referenceJSON));
       TEST_FUNC_END();
     }
+    static void value_fixedPointValues_expectDecimalNumbersAndNullForOverflow(void) {
+      TEST_FUNC_START();
+      //arrange
+      FakeStreamOut testOutput;
+      util::json::JSONOutput testJSON(testOutput);
+      static const util::Value testValue1(2155, 1);  //215.5
+      static const util::Value testValue2(-5, 2);    //-0.05
+      static const util::Value testOverflow(INT32_MAX);
+      char referenceJSON[] = "{\"Value\":215.500,\"ValueDecimals\":-0.05,\"Overflow\":null}";
+      //act
+      testJSON.value("Value", testValue1);
+      testJSON.value(F("ValueDecimals"), testValue2, 2);
+      testJSON.value("Overflow", testOverflow);
+      testJSON.~JSONOutput();
+      //assert
+      TEST_ASSERT(!testOutput.isOutBufferOverflow());
+      TEST_ASSERT(!strcmp(testOutput.getOutBufferContent(), referenceJSON));
+      TEST_FUNC_END();
+    }
     static void test_value(void) {
       value_addToObject_expectCorrectValuesAdded();
       value_addToArray_expectCorrectValuesAddedNamesIgnored();
+      value_fixedPointValues_expectDecimalNumbersAndNullForOverflow();
     }
   public:
     static void structure_nesting_expectCorrectJSON(void) {
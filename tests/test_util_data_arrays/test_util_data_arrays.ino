@@ -787,6 +787,294 @@ class TestRingBuffer {
 
 size_t TestRingBuffer::TestClass::instances = 0;
 
+class TestRingBufferMoveEmplace {
+  public:
+    class MoveCounter {
+      public:
+        MoveCounter(int value = 0) : value(value) {}
+        MoveCounter(const MoveCounter & other) : value(other.value) {
+          copies++;
+        }
+        MoveCounter(MoveCounter && other) : value(other.value) {
+          other.value = 0;
+          moves++;
+        }
+        int getValue(void) const {
+          return (value);
+        }
+        static size_t copies;
+        static size_t moves;
+      private:
+        int value;
+    };
+  public:
+    static void push_rvalue_expectMovedNotCopied(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 4;
+      util::arrays::RingBuffer<MoveCounter> ringBuffer(testBufferSize);
+      MoveCounter item(2);
+      MoveCounter::copies = 0;
+      MoveCounter::moves = 0;
+      //act
+      ringBuffer.push(MoveCounter(1));
+      ringBuffer.push(util::move(item));
+      //assert
+      TEST_ASSERT(!MoveCounter::copies);
+      TEST_ASSERT(MoveCounter::moves == 2);
+      TEST_ASSERT(ringBuffer.count() == 2);
+      TEST_ASSERT(ringBuffer[0].getValue() == 1);
+      TEST_ASSERT(ringBuffer[1].getValue() == 2);
+      TEST_FUNC_END();
+    }
+    static void emplace_quantityWithoutDefaultConstructor_expectConstructedInPlace(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 2;
+      static const util::quantity::Quantity::id_t idGroup = 1;
+      const util::quantity::Generic defaultItem(0, 0, util::Value(0), util::StrRef(), 0, false);
+      util::arrays::RingBuffer<util::quantity::Generic> ringBuffer(testBufferSize, defaultItem);
+      //act
+      ringBuffer.emplace(1, idGroup, util::Value(10), util::StrRef(), 100);
+      ringBuffer.emplace(2, idGroup, util::Value(20), util::StrRef(), 200);
+      ringBuffer.emplace(3, idGroup, util::Value(30), util::StrRef(), 300);
+      //assert
+      TEST_ASSERT(ringBuffer.count() == testBufferSize);
+      TEST_ASSERT(ringBuffer[0].getId() == 2);
+      TEST_ASSERT(ringBuffer[0].getTimestamp() == 200);
+      TEST_ASSERT(ringBuffer[1].getId() == 3);
+      TEST_ASSERT(ringBuffer[1].validate());
+      TEST_ASSERT(!ringBuffer[2].validate());
+      TEST_FUNC_END();
+    }
+    static void destructor_allocatedMemory_expectItemsDestroyed(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 4;
+      static const int pushCount = 6;
+      TestRingBuffer::TestClass t(1);
+      const size_t instancesBefore = t.getInstances();
+      size_t instancesFull = 0;
+      //act
+      {
+        util::arrays::RingBuffer<TestRingBuffer::TestClass> ringBuffer(testBufferSize);
+        for (int i = 0; i < pushCount; i++)
+          ringBuffer.emplace(i);
+        instancesFull = t.getInstances();
+      }//ringBuffer goes out of scope
+      const size_t instancesAfter = t.getInstances();
+      //assert
+      TEST_ASSERT(instancesFull == (instancesBefore + testBufferSize + 1)); //+1 is ring buffer's default item
+      TEST_ASSERT(instancesAfter == instancesBefore);
+      TEST_FUNC_END();
+    }
+    static void push_multipleTriviallyCopyableItems_expectOldestOverwritten(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 5;
+      const int items1[] = {1, 2, 3};
+      const int items2[] = {4, 5, 6, 7};
+      const int items3[] = {10, 11, 12, 13, 14, 15, 16};
+      util::arrays::RingBuffer<int> ringBuffer(testBufferSize);
+      //act
+      ringBuffer.push(items1, sizeof(items1) / sizeof(items1[0]));
+      ringBuffer.push(items2, sizeof(items2) / sizeof(items2[0]));
+      const size_t count1 = ringBuffer.count();
+      int result1[testBufferSize];
+      for (size_t i = 0; i < testBufferSize; i++)
+        result1[i] = ringBuffer[i];
+      ringBuffer.push(items3, sizeof(items3) / sizeof(items3[0]));
+      const size_t count2 = ringBuffer.count();
+      //assert
+      TEST_ASSERT(count1 == testBufferSize);
+      for (size_t i = 0; i < testBufferSize; i++)
+        TEST_ASSERT(result1[i] == static_cast<int>(i + 3));
+      TEST_ASSERT(count2 == testBufferSize);
+      for (size_t i = 0; i < testBufferSize; i++)
+        TEST_ASSERT(ringBuffer[i] == static_cast<int>(i + 12));
+      TEST_FUNC_END();
+    }
+    static void push_multipleNonTrivialItems_expectCopiedAndOldestDestroyed(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 3;
+      static const size_t itemsNumber = 4;
+      TestRingBuffer::TestClass items[itemsNumber] = {1, 2, 3, 4};
+      const size_t instancesBefore = items[0].getInstances();
+      util::arrays::RingBuffer<TestRingBuffer::TestClass> ringBuffer(testBufferSize);
+      //act
+      ringBuffer.push(items, itemsNumber);
+      const size_t instancesAfter = items[0].getInstances();
+      //assert
+      TEST_ASSERT(instancesAfter == (instancesBefore + testBufferSize + 1)); //+1 is ring buffer's default item
+      TEST_ASSERT(ringBuffer[0].getValue() == 2);
+      TEST_ASSERT(ringBuffer[2].getValue() == 4);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      push_rvalue_expectMovedNotCopied();
+      emplace_quantityWithoutDefaultConstructor_expectConstructedInPlace();
+      destructor_allocatedMemory_expectItemsDestroyed();
+      push_multipleTriviallyCopyableItems_expectOldestOverwritten();
+      push_multipleNonTrivialItems_expectCopiedAndOldestDestroyed();
+    }
+};
+
+size_t TestRingBufferMoveEmplace::MoveCounter::copies = 0;
+size_t TestRingBufferMoveEmplace::MoveCounter::moves = 0;
+
+class TestStaticRingBuffer {
+  public:
+    static void push_get_powerOfTwoSize_expectOldestOverwritten(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 4;
+      static const int pushCount = 6;
+      util::arrays::StaticRingBuffer<int, testBufferSize> ringBuffer;
+      //act
+      for (int i = 0; i < pushCount; i++)
+        ringBuffer.push(i);
+      //assert
+      TEST_ASSERT(ringBuffer.sizePowerOfTwo);
+      TEST_ASSERT(ringBuffer.full());
+      TEST_ASSERT(ringBuffer.count() == testBufferSize);
+      TEST_ASSERT(ringBuffer[0] == 2);
+      TEST_ASSERT(ringBuffer[1] == 3);
+      TEST_ASSERT(ringBuffer[2] == 4);
+      TEST_ASSERT(ringBuffer[3] == 5);
+      TEST_ASSERT(ringBuffer[4] == 0);
+      TEST_FUNC_END();
+    }
+    static void push_get_nonPowerOfTwoSize_expectOldestOverwritten(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 5;
+      static const int pushCount = 7;
+      util::arrays::StaticRingBuffer<int, testBufferSize> ringBuffer;
+      //act
+      for (int i = 0; i < pushCount; i++)
+        ringBuffer.push(i);
+      //assert
+      TEST_ASSERT(!ringBuffer.sizePowerOfTwo);
+      TEST_ASSERT(ringBuffer.full());
+      TEST_ASSERT(ringBuffer.count() == testBufferSize);
+      TEST_ASSERT(ringBuffer[0] == 2);
+      TEST_ASSERT(ringBuffer[2] == 4);
+      TEST_ASSERT(ringBuffer[4] == 6);
+      TEST_ASSERT(ringBuffer[5] == 0);
+      TEST_FUNC_END();
+    }
+    static void pop_multipleItems_expectOldestRemoved(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 4;
+      static const int pushCount = 6;
+      static const size_t popCount = 3;
+      util::arrays::StaticRingBuffer<int, testBufferSize> ringBuffer;
+      for (int i = 0; i < pushCount; i++)
+        ringBuffer.push(i);
+      //act
+      ringBuffer.pop(popCount);
+      size_t count1 = ringBuffer.count();
+      int item1 = ringBuffer[0];
+      ringBuffer.pop();
+      ringBuffer.pop();
+      //assert
+      TEST_ASSERT(count1 == (testBufferSize - popCount));
+      TEST_ASSERT(item1 == 5);
+      TEST_ASSERT(ringBuffer.empty());
+      TEST_ASSERT(!ringBuffer.count());
+      TEST_FUNC_END();
+    }
+    static void rangeFor_wrappedAround_expectOldestFirst(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 3;
+      static const int pushCount = 5;
+      util::arrays::StaticRingBuffer<int, testBufferSize> staticRingBuffer;
+      int testBuffer[testBufferSize];
+      util::arrays::RingBuffer<int> ringBuffer(testBuffer, testBufferSize);
+      util::arrays::RingBuffer<int> ringBufferNotInitialised;
+      util::arrays::StaticRingBuffer<int, testBufferSize> staticRingBufferEmpty;
+      for (int i = 0; i < pushCount; i++) {
+        staticRingBuffer.push(i);
+        ringBuffer.push(i);
+      }
+      int staticRingBufferItems[testBufferSize] = {};
+      int ringBufferItems[testBufferSize] = {};
+      size_t staticRingBufferCount = 0;
+      size_t ringBufferCount = 0;
+      size_t emptyCount = 0;
+      //act
+      for (const int & item : staticRingBuffer)
+        staticRingBufferItems[staticRingBufferCount++] = item;
+      for (const int & item : ringBuffer)
+        ringBufferItems[ringBufferCount++] = item;
+      for (const int & item : ringBufferNotInitialised) {
+        (void)item;
+        emptyCount++;
+      }
+      for (const int & item : staticRingBufferEmpty) {
+        (void)item;
+        emptyCount++;
+      }
+      //assert
+      TEST_ASSERT(staticRingBufferCount == testBufferSize);
+      TEST_ASSERT(ringBufferCount == testBufferSize);
+      TEST_ASSERT(!emptyCount);
+      for (size_t i = 0; i < testBufferSize; i++) {
+        TEST_ASSERT(staticRingBufferItems[i] == static_cast<int>(i + 2));
+        TEST_ASSERT(ringBufferItems[i] == static_cast<int>(i + 2));
+      }
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+    static void performanceTest_subscriptOperatorSum(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t testBufferSize = 256;
+      static const uint32_t numberOfOperations = 16;
+      util::arrays::StaticRingBuffer<long, testBufferSize> ringBuffer;
+      for (size_t i = 0; i < testBufferSize; i++)
+        ringBuffer.push(i);
+      volatile long sum = 0;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        for (size_t j = 0; j < ringBuffer.count(); j++)
+          sum += ringBuffer[j];
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTest_rangeForSum(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t testBufferSize = 256;
+      static const uint32_t numberOfOperations = 16;
+      util::arrays::StaticRingBuffer<long, testBufferSize> ringBuffer;
+      for (size_t i = 0; i < testBufferSize; i++)
+        ringBuffer.push(i);
+      volatile long sum = 0;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        for (const long & item : ringBuffer)
+          sum += item;
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      push_get_powerOfTwoSize_expectOldestOverwritten();
+      push_get_nonPowerOfTwoSize_expectOldestOverwritten();
+      pop_multipleItems_expectOldestRemoved();
+      rangeFor_wrappedAround_expectOldestFirst();
+      performanceTest_subscriptOperatorSum();
+      performanceTest_rangeForSum();
+    }
+};
+
 class TestCstrRingBuffer {
   public:
     static const size_t testBufferSize = 256;
@@ -1444,6 +1732,99 @@ class TestCstrRingBuffer {
       empty_notInitialised_expectTrue();
     }
   public:
+    static void getSpans_singleAndWrappedCStrings_expectSpansPointingIntoBuffer(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t smallBufferSize = 16;
+      char testBuffer[smallBufferSize] = {};
+      util::arrays::CStrRingBuffer testRingBuffer(testBuffer, smallBufferSize);
+      testRingBuffer.push("abcd");
+      testRingBuffer.push("efghij");
+      testRingBuffer.pop();
+      testRingBuffer.push("opqrstu");
+      //act
+      util::arrays::CStrSpans singleSpan = testRingBuffer.getSpans(0);
+      util::arrays::CStrSpans wrappedSpans = testRingBuffer.getSpans(1);
+      util::arrays::CStrSpans outOfRangeSpans = testRingBuffer.getSpans(2);
+      static const size_t getBufferSize = 16;
+      char getResult[getBufferSize] = {};
+      size_t getReturnedSize = testRingBuffer.get(1, getResult, getBufferSize);
+      //assert
+      TEST_ASSERT(singleSpan.getFirst() == &testBuffer[5]);
+      TEST_ASSERT(singleSpan.getFirstLength() == 6);
+      TEST_ASSERT(!singleSpan.getSecond());
+      TEST_ASSERT(wrappedSpans.getFirst() == &testBuffer[12]);
+      TEST_ASSERT(wrappedSpans.getFirstLength() == 3);
+      TEST_ASSERT(wrappedSpans.getSecond() == testBuffer);
+      TEST_ASSERT(wrappedSpans.getSecondLength() == 4);
+      TEST_ASSERT(wrappedSpans.length() == 7);
+      TEST_ASSERT(outOfRangeSpans.empty());
+      TEST_ASSERT(getReturnedSize == 7);
+      TEST_ASSERT(!strcmp(getResult, "opqrstu"));
+      TEST_FUNC_END();
+    }
+    static void getSpans_cstringEndsExactlyAtBufferEnd_expectNextCStringsCorrect(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t smallBufferSize = 11;
+      char testBuffer[smallBufferSize] = {};
+      util::arrays::CStrRingBuffer testRingBuffer(testBuffer, smallBufferSize);
+      static const size_t getBufferSize = 8;
+      char getResult[3][getBufferSize] = {};
+      //act
+      testRingBuffer.push("abcd");
+      testRingBuffer.push("efgh");
+      testRingBuffer.push("ij");
+      testRingBuffer.push("kl");
+      testRingBuffer.push("mn");
+      testRingBuffer.push("opq");
+      for (size_t i = 0; i < 3; i++)
+        testRingBuffer.getSpans(i).copy(getResult[i], getBufferSize);
+      size_t countResult = testRingBuffer.count();
+      //assert
+      TEST_ASSERT(countResult == 3);
+      TEST_ASSERT(!strcmp(getResult[0], "kl"));
+      TEST_ASSERT(!strcmp(getResult[1], "mn"));
+      TEST_ASSERT(!strcmp(getResult[2], "opq"));
+      TEST_FUNC_END();
+    }
+    static void spans_findSubstrPrintTo_expectPartsAcrossSpans(void) {
+      TEST_FUNC_START();
+      //arrange
+      const char firstPart[] = "12|34";
+      const char secondPart[] = "|test|text";
+      util::arrays::CStrSpans testSpans(firstPart, strlen(firstPart), secondPart, strlen(secondPart));
+      static const size_t printBufferSize = 32;
+      char printResult[printBufferSize] = {};
+      char substrResult[printBufferSize] = {};
+      util::arrays::PrintToBuffer printToBuffer(printResult, printBufferSize);
+      //act
+      size_t separator1 = testSpans.find('|');
+      size_t separator2 = testSpans.find('|', separator1 + 1);
+      size_t separator3 = testSpans.find('|', separator2 + 1);
+      size_t separatorNotFound = testSpans.find('#');
+      util::arrays::CStrSpans substr = testSpans.substr(separator1 + 1, separator3 - separator1 - 1);
+      substr.copy(substrResult, printBufferSize);
+      size_t printed = testSpans.substr(separator3 + 1).printTo(printToBuffer);
+      //assert
+      TEST_ASSERT(separator1 == 2);
+      TEST_ASSERT(separator2 == 5);
+      TEST_ASSERT(separator3 == 10);
+      TEST_ASSERT(separatorNotFound == util::arrays::CStrSpans::npos);
+      TEST_ASSERT(substr.getSecond() == secondPart);
+      TEST_ASSERT(!strcmp(substrResult, "34|test"));
+      TEST_ASSERT(printed == 4);
+      TEST_ASSERT(!strcmp(printResult, "text"));
+      TEST_ASSERT(testSpans.charAt(6) == 't');
+      TEST_ASSERT(testSpans.charAt(testSpans.length()) == '\0');
+      TEST_FUNC_END();
+    }
+    static void test_getSpans(void) {
+      getSpans_singleAndWrappedCStrings_expectSpansPointingIntoBuffer();
+      getSpans_cstringEndsExactlyAtBufferEnd_expectNextCStringsCorrect();
+      spans_findSubstrPrintTo_expectPartsAcrossSpans();
+    }
+  public:
 #pragma GCC push_options
 #pragma GCC optimize ("O0")
     static const size_t perfBufferSize = 2048;
@@ -1529,6 +1910,7 @@ class TestCstrRingBuffer {
       test_count();
       test_full();
       test_empty();
+      test_getSpans();
       test_performance();
     }
 };
@@ -1648,14 +2030,320 @@ class TestPrintToBuffer {
     }
 };
 
+class TestPrintToBufferFast {
+  public:
+    static void write_finish_expectTerminatedOnlyOnFinish(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t bufferSize = 10;
+      char buffer[bufferSize] = "xxxxxxxxx";
+      util::arrays::PrintToBufferFast testPrint(buffer, bufferSize);
+      const char testCString[] = "abc";
+      //act
+      testPrint.write(reinterpret_cast<const uint8_t*>(testCString), strlen(testCString));
+      testPrint.write('d');
+      char charAfterText = buffer[4];
+      size_t finishResult = testPrint.finish();
+      //assert
+      TEST_ASSERT(charAfterText == 'x');
+      TEST_ASSERT(finishResult == 4);
+      TEST_ASSERT(testPrint.length() == 4);
+      TEST_ASSERT(!strcmp(buffer, "abcd"));
+      TEST_ASSERT(!testPrint.getDroppedChars());
+      TEST_FUNC_END();
+    }
+    static void write_bufferOverflow_expectDroppedCharsCounted(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t bufferSize = 5;
+      char buffer[bufferSize] = {};
+      util::arrays::PrintToBufferFast testPrint(buffer, bufferSize);
+      const char testCString[] = "abcdef";
+      //act
+      size_t writeResult1 = testPrint.write(reinterpret_cast<const uint8_t*>(testCString), strlen(testCString));
+      size_t writeResult2 = testPrint.write('g');
+      size_t finishResult = testPrint.finish();
+      //assert
+      TEST_ASSERT(writeResult1 == bufferSize - 1);
+      TEST_ASSERT(!writeResult2);
+      TEST_ASSERT(finishResult == bufferSize - 1);
+      TEST_ASSERT(!strcmp(buffer, "abcd"));
+      TEST_ASSERT(testPrint.getDroppedChars() == 3);
+      TEST_FUNC_END();
+    }
+    static void write_embeddedNullChars_expectAllCharsCopied(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t bufferSize = 8;
+      char buffer[bufferSize] = {};
+      util::arrays::PrintToBufferFast testPrint(buffer, bufferSize);
+      const uint8_t testData[] = {'a', '\0', 'b', 'c'};
+      //act
+      size_t writeResult = testPrint.write(testData, sizeof(testData));
+      testPrint.finish();
+      //assert
+      TEST_ASSERT(writeResult == sizeof(testData));
+      TEST_ASSERT(testPrint.length() == sizeof(testData));
+      TEST_ASSERT(!memcmp(buffer, testData, sizeof(testData)));
+      TEST_FUNC_END();
+    }
+    static void test_write(void) {
+      write_finish_expectTerminatedOnlyOnFinish();
+      write_bufferOverflow_expectDroppedCharsCounted();
+      write_embeddedNullChars_expectAllCharsCopied();
+    }
+  public:
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+    static const size_t perfBufferSize = 256;
+    static const uint32_t perfNumberOfOperations = 256;
+    template <class PrintClass>
+    static void printMessages(void) {
+      static char perfBuffer[perfBufferSize];
+      const char testCString[] = "Test message";
+      for (uint32_t i = 0; i < perfNumberOfOperations; i++) {
+        PrintClass testPrint(perfBuffer, perfBufferSize);
+        testPrint.print(i);
+        testPrint.print('|');
+        testPrint.print(testCString);
+        testPrint.print('|');
+        testPrint.print(testCString);
+      }
+    }
+    static void test_performance_printToBuffer(void) {
+      PERF_TEST_FUNC_START();
+      PERF_TEST_START();
+      printMessages<util::arrays::PrintToBuffer>();
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void test_performance_printToBufferFast(void) {
+      PERF_TEST_FUNC_START();
+      PERF_TEST_START();
+      printMessages<util::arrays::PrintToBufferFast>();
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void test_performance(void) {
+      test_performance_printToBuffer();
+      test_performance_printToBufferFast();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_write();
+      test_performance();
+    }
+};
+
+class TestSortedBuffer {
+  public:
+    static int nextRandom(uint32_t &seed) {
+      seed = seed * 1103515245 + 12345;
+      return (static_cast<int>((seed >> 16) % 100) - 50);
+    }
+    static void sortNaive(int * data, size_t size) {
+      for (size_t i = 1; i < size; i++) {
+        const int item = data[i];
+        size_t j = i;
+        while (j && (data[j - 1] > item)) {
+          data[j] = data[j - 1];
+          j--;
+        }
+        data[j] = item;
+      }
+    }
+    static void insert_randomValues_expectSortedOrder(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t size = 100;
+      util::arrays::SortedBuffer<int> testSortedBuffer(size);
+      int reference[size];
+      uint32_t seed = 1;
+      //act
+      for (size_t i = 0; i < size; i++) {
+        reference[i] = nextRandom(seed);
+        testSortedBuffer.insert(reference[i]);
+      }
+      sortNaive(reference, size);
+      //assert
+      TEST_ASSERT(testSortedBuffer.validate());
+      TEST_ASSERT(testSortedBuffer.count() == size);
+      TEST_ASSERT(testSortedBuffer.full());
+      boolean sameOrder = true;
+      for (size_t i = 0; i < size; i++)
+        if (testSortedBuffer[i] != reference[i]) sameOrder = false;
+      TEST_ASSERT(sameOrder);
+      TEST_FUNC_END();
+    }
+    static void insert_bufferFull_expectFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::arrays::SortedBuffer<int> testSortedBuffer(2);
+      //act
+      boolean result1 = testSortedBuffer.insert(2);
+      boolean result2 = testSortedBuffer.insert(1);
+      boolean result3 = testSortedBuffer.insert(0);
+      //assert
+      TEST_ASSERT(result1 && result2 && !result3);
+      TEST_ASSERT((testSortedBuffer[0] == 1) && (testSortedBuffer[1] == 2));
+      TEST_ASSERT(testSortedBuffer[2] == 0);
+      TEST_FUNC_END();
+    }
+    static void remove_existingAndMissingItems_expectItemsRemovedOnce(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::arrays::SortedBuffer<int> testSortedBuffer(8);
+      static const int testItems[] = { 5, 3, 5, 9, 1, 5 };
+      for (size_t i = 0; i < (sizeof(testItems) / sizeof(testItems[0])); i++)
+        testSortedBuffer.insert(testItems[i]);
+      //act
+      boolean result1 = testSortedBuffer.remove(5);
+      boolean result2 = testSortedBuffer.remove(4);
+      boolean result3 = testSortedBuffer.remove(9);
+      boolean result4 = testSortedBuffer.remove(1);
+      //assert
+      TEST_ASSERT(result1 && !result2 && result3 && result4);
+      TEST_ASSERT(testSortedBuffer.count() == 3);
+      TEST_ASSERT((testSortedBuffer[0] == 3) && (testSortedBuffer[1] == 5) && (testSortedBuffer[2] == 5));
+      TEST_FUNC_END();
+    }
+    static void rank_multipleItems_expectNumberOfSmallerItems(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::arrays::SortedBuffer<int> testSortedBuffer(8);
+      static const int testItems[] = { 10, 20, 20, 30, 40 };
+      for (size_t i = 0; i < (sizeof(testItems) / sizeof(testItems[0])); i++)
+        testSortedBuffer.insert(testItems[i]);
+      //act & assert
+      TEST_ASSERT(testSortedBuffer.rank(5) == 0);
+      TEST_ASSERT(testSortedBuffer.rank(10) == 0);
+      TEST_ASSERT(testSortedBuffer.rank(20) == 1);
+      TEST_ASSERT(testSortedBuffer.rank(25) == 3);
+      TEST_ASSERT(testSortedBuffer.rank(50) == 5);
+      TEST_FUNC_END();
+    }
+    static void slidingWindow_randomValues_expectSameOrderAsSortedWindow(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t windowSize = 15;
+      static const size_t steps = 1000;
+      util::arrays::RingBuffer<int> testRingBuffer(windowSize);
+      util::arrays::SortedBuffer<int> testSortedBuffer(windowSize);
+      int reference[windowSize];
+      uint32_t seed = 2;
+      boolean sameOrder = true;
+      //act
+      for (size_t i = 0; i < steps; i++) {
+        const int item = nextRandom(seed);
+        if (testRingBuffer.full()) testSortedBuffer.remove(testRingBuffer[0]);
+        testRingBuffer.push(item);
+        testSortedBuffer.insert(item);
+        for (size_t j = 0; j < testRingBuffer.count(); j++)
+          reference[j] = testRingBuffer[j];
+        sortNaive(reference, testRingBuffer.count());
+        if (testSortedBuffer.count() != testRingBuffer.count()) sameOrder = false;
+        for (size_t j = 0; j < testRingBuffer.count(); j++)
+          if (testSortedBuffer[j] != reference[j]) sameOrder = false;
+      }
+      //assert
+      TEST_ASSERT(sameOrder);
+      TEST_FUNC_END();
+    }
+    static void validate_zeroSize_expectFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::arrays::SortedBuffer<int> testSortedBuffer(0);
+      //act
+      boolean insertResult = testSortedBuffer.insert(1);
+      //assert
+      TEST_ASSERT(!testSortedBuffer.validate());
+      TEST_ASSERT(!insertResult);
+      TEST_ASSERT(!testSortedBuffer.count());
+      TEST_ASSERT(testSortedBuffer[0] == 0);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      insert_randomValues_expectSortedOrder();
+      insert_bufferFull_expectFalse();
+      remove_existingAndMissingItems_expectItemsRemovedOnce();
+      rank_multipleItems_expectNumberOfSmallerItems();
+      slidingWindow_randomValues_expectSameOrderAsSortedWindow();
+      validate_zeroSize_expectFalse();
+    }
+};
+
+class TestMonotonicDeque {
+  public:
+    static void push_randomValues_expectWindowMinimumAndMaximum(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t windowSize = 7;
+      static const size_t steps = 1000;
+      util::arrays::RingBuffer<int> testRingBuffer(windowSize);
+      util::arrays::MonotonicDeque<int> testMinimums(windowSize, false);
+      util::arrays::MonotonicDeque<int> testMaximums(windowSize, true);
+      uint32_t seed = 3;
+      boolean sameMinimum = true;
+      boolean sameMaximum = true;
+      boolean countInRange = true;
+      //act
+      for (size_t i = 0; i < steps; i++) {
+        const int item = TestSortedBuffer::nextRandom(seed);
+        testRingBuffer.push(item);
+        testMinimums.push(item);
+        testMaximums.push(item);
+        int minimum = testRingBuffer[0];
+        int maximum = testRingBuffer[0];
+        for (size_t j = 1; j < testRingBuffer.count(); j++) {
+          if (testRingBuffer[j] < minimum) minimum = testRingBuffer[j];
+          if (testRingBuffer[j] > maximum) maximum = testRingBuffer[j];
+        }
+        if (testMinimums.front() != minimum) sameMinimum = false;
+        if (testMaximums.front() != maximum) sameMaximum = false;
+        if (!testMinimums.count() || (testMinimums.count() > windowSize)) countInRange = false;
+      }
+      //assert
+      TEST_ASSERT(testMinimums.validate());
+      TEST_ASSERT(testMaximums.validate());
+      TEST_ASSERT(sameMinimum);
+      TEST_ASSERT(sameMaximum);
+      TEST_ASSERT(countInRange);
+      TEST_FUNC_END();
+    }
+    static void validate_zeroSize_expectFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::arrays::MonotonicDeque<int> testMonotonicDeque(0, true);
+      //act
+      testMonotonicDeque.push(1);
+      //assert
+      TEST_ASSERT(!testMonotonicDeque.validate());
+      TEST_ASSERT(testMonotonicDeque.empty());
+      TEST_ASSERT(testMonotonicDeque.front() == 0);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      push_randomValues_expectWindowMinimumAndMaximum();
+      validate_zeroSize_expectFalse();
+    }
+};
+
 TEST_GLOBALS();
 
 void setup() {
   TEST_SETUP();
   TEST_BEGIN();
   TestRingBuffer::runTests();
+  TestRingBufferMoveEmplace::runTests();
+  TestStaticRingBuffer::runTests();
   TestCstrRingBuffer::runTests();
   TestPrintToBuffer::runTests();
+  TestPrintToBufferFast::runTests();
+  TestSortedBuffer::runTests();
+  TestMonotonicDeque::runTests();
   TEST_END();
 }
 
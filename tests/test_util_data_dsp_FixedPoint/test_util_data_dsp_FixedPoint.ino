@@ -4,6 +4,8 @@
 
 #include "util_data.h"
 
+using util::operator "" _fx;
+
 //Comment this #define to perform secondary tests (unsigned values, values without range, etc.)
 #define PRIMARY_TEST
 
@@ -225,6 +227,51 @@ class FixedPointTester {
       TEST_ASSERT(testValue == static_cast<T>(0));
       TEST_FUNC_END();
     }
+    static void parse_numberStrings_expectSameValuesAsConstructorFromString(void) {
+      TEST_FUNC_START();
+      //arrange
+      const char testNumberStr1[] = "+12.75";
+      const char testNumberStr2[] = "06.125";
+      const char testNumberStr3[] = "-7.25";
+      const char testNumberStr4[] = "3.";
+      const char testNumberStr5[] = "3.4.5";
+      const char testNumberStr6[] = "0x0625";
+      const char testNumberStr7[] = "99999999999";
+      const char testNumberStr8[] = "";
+      //act
+      T result1 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr1);
+      T result2 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr2);
+      T result3 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr3);
+      T result4 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr4);
+      T result5 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr5);
+      T result6 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr6);
+      T result7 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr7);
+      T result8 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(testNumberStr8);
+      T result9 = util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(nullptr);
+      //assert
+      TEST_ASSERT((result1 == util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>(testNumberStr1).getRaw()));
+      TEST_ASSERT((result2 == util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>(testNumberStr2).getRaw()));
+      TEST_ASSERT((result3 == util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>(testNumberStr3).getRaw()));
+      TEST_ASSERT((result4 == util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>(testNumberStr4).getRaw()));
+      TEST_ASSERT(result5 == static_cast<T>(0));
+      TEST_ASSERT(result6 == static_cast<T>(0));
+      TEST_ASSERT((result7 == util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>(testNumberStr7).getRaw()));
+      TEST_ASSERT(result8 == static_cast<T>(0));
+      TEST_ASSERT(result9 == static_cast<T>(0));
+      TEST_FUNC_END();
+    }
+    static void fromRaw_getRaw_expectSameValue(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> testFixedPoint(static_cast<T>(3));
+      //act
+      util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> testFixedPointCopy =
+        util::dsp::FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromRaw(testFixedPoint.getRaw());
+      //assert
+      TEST_ASSERT(testFixedPointCopy == testFixedPoint);
+      TEST_ASSERT(testFixedPoint.getRaw() == static_cast<T>(static_cast<T>(3) << FractionBits));
+      TEST_FUNC_END();
+    }
     static void getValue_fixedPointValues_expectCorrectConvertedValues(void) {
       TEST_FUNC_START();
       if ((FractionBits >= 2) && ((sizeof(T) * 8 - FractionBits) >= 9)) {
@@ -276,6 +323,8 @@ class FixedPointTester {
       constructorFromString_provideValidNumberStrings_expectCorrectValues();
       constructorFromString_provideInvalidNumberStrings_expectZero();
       constructorFromString_null_expectZero();
+      parse_numberStrings_expectSameValuesAsConstructorFromString();
+      fromRaw_getRaw_expectSameValue();
       getValue_fixedPointValues_expectCorrectConvertedValues();
     }
   public:
@@ -771,6 +820,521 @@ class FixedPointTester {
     }
 };
 
+class TestValueLiteral {
+  public:
+    static void literal_decimalNumbers_expectCorrectValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      //act
+      static constexpr util::Value testValue1 = 124.75_fx;
+      static constexpr util::Value testValue2 = -97.25_fx;
+      static constexpr util::Value testValue3 = 221_fx;
+      static constexpr util::Value testValue4 = 3.14159265_fx;
+      //assert
+      static_assert(testValue1.getRaw() == util::Value(12475, 2).getRaw(), "Literal is not evaluated at compile time");
+      TEST_ASSERT(testValue1 == util::Value("124.75"));
+      TEST_ASSERT(testValue2 == util::Value("-97.25"));
+      TEST_ASSERT(testValue3 == util::Value(221));
+      TEST_ASSERT(testValue4 == util::ValuePi);
+      TEST_FUNC_END();
+    }
+    static void constexprConstructor_integerAndDecimals_expectSameValueAsString(void) {
+      TEST_FUNC_START();
+      //arrange
+      //act
+      static constexpr util::Value testValue1(60125, 3);
+      static constexpr util::Value testValue2(-75, 2);
+      static constexpr util::Value testValue3(-3);
+      //assert
+      TEST_ASSERT(testValue1 == util::Value("60.125"));
+      TEST_ASSERT(testValue2 == util::Value("-.75"));
+      TEST_ASSERT(testValue3 == util::Value("-3"));
+      TEST_ASSERT(testValue3 == -util::Value(3));
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      literal_decimalNumbers_expectCorrectValues();
+      constexprConstructor_integerAndDecimals_expectSameValueAsString();
+    }
+};
+
+class TestValueMath {
+  public:
+    static boolean isClose(const util::Value &value, const util::Value &reference, const util::Value &tolerance) {
+      util::Value difference = value - reference;
+      if (difference < util::Value(0)) difference = -difference;
+      return (difference <= tolerance);
+    }
+    static void exp_knownValues_expectCorrectResultWithinOneLsb(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value oneLsb = util::Value::fromRaw(1);
+      //act
+      util::Value result1 = util::dsp::exp(0_fx);
+      util::Value result2 = util::dsp::exp(1_fx);
+      util::Value result3 = util::dsp::exp(-2.5_fx);
+      util::Value result4 = util::dsp::exp(10_fx);
+      //assert
+      TEST_ASSERT(result1 == 1_fx);
+      TEST_ASSERT(isClose(result2, 2.718282_fx, oneLsb));
+      TEST_ASSERT(isClose(result3, 0.082085_fx, oneLsb));
+      TEST_ASSERT(isClose(result4, 22026.465795_fx, oneLsb));
+      TEST_FUNC_END();
+    }
+    static void log_knownValues_expectCorrectResultWithinOneLsb(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value oneLsb = util::Value::fromRaw(1);
+      //act
+      util::Value result1 = util::dsp::log(1_fx);
+      util::Value result2 = util::dsp::log(2.718282_fx);
+      util::Value result3 = util::dsp::log(0.125_fx);
+      util::Value result4 = util::dsp::log(400_fx);
+      //assert
+      TEST_ASSERT(result1 == 0_fx);
+      TEST_ASSERT(isClose(result2, 1_fx, oneLsb));
+      TEST_ASSERT(isClose(result3, -2.079442_fx, oneLsb));
+      TEST_ASSERT(isClose(result4, 5.991465_fx, oneLsb));
+      TEST_FUNC_END();
+    }
+    static void sqrt_knownValues_expectCorrectResultWithinOneLsb(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value oneLsb = util::Value::fromRaw(1);
+      //act
+      util::Value result1 = util::dsp::sqrt(0_fx);
+      util::Value result2 = util::dsp::sqrt(16_fx);
+      util::Value result3 = util::dsp::sqrt(2_fx);
+      util::Value result4 = util::dsp::sqrt(0.25_fx);
+      //assert
+      TEST_ASSERT(result1 == 0_fx);
+      TEST_ASSERT(result2 == 4_fx);
+      TEST_ASSERT(isClose(result3, 1.414214_fx, oneLsb));
+      TEST_ASSERT(result4 == 0.5_fx);
+      TEST_FUNC_END();
+    }
+    static void pow_knownValues_expectCorrectResultWithinOneLsb(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value oneLsb = util::Value::fromRaw(1);
+      //act
+      util::Value result1 = util::dsp::pow(2_fx, 10_fx);
+      util::Value result2 = util::dsp::pow(9_fx, 0.5_fx);
+      util::Value result3 = util::dsp::pow(10_fx, -2_fx);
+      util::Value result4 = util::dsp::pow(1.5_fx, 2.5_fx);
+      //assert
+      TEST_ASSERT(isClose(result1, 1024_fx, oneLsb));
+      TEST_ASSERT(isClose(result2, 3_fx, oneLsb));
+      TEST_ASSERT(isClose(result3, 0.01_fx, oneLsb));
+      TEST_ASSERT(isClose(result4, 2.755676_fx, oneLsb));
+      TEST_FUNC_END();
+    }
+    static void mathFunctions_outOfRange_expectOverflowOrZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value overflowValue(INT32_MAX);
+      //act
+      util::Value result1 = util::dsp::exp(100_fx);
+      util::Value result2 = util::dsp::exp(-100_fx);
+      util::Value result3 = util::dsp::log(0_fx);
+      util::Value result4 = util::dsp::log(-1_fx);
+      util::Value result5 = util::dsp::sqrt(-1_fx);
+      util::Value result6 = util::dsp::pow(10_fx, 100_fx);
+      util::Value result7 = util::dsp::exp(overflowValue);
+      //assert
+      TEST_ASSERT(result1.overflow() && (result1 > 0_fx));
+      TEST_ASSERT(result2 == 0_fx);
+      TEST_ASSERT(result3.overflow() && (result3 < 0_fx));
+      TEST_ASSERT(result4.overflow() && (result4 < 0_fx));
+      TEST_ASSERT(result5 == 0_fx);
+      TEST_ASSERT(result6.overflow() && (result6 > 0_fx));
+      TEST_ASSERT(result7 == overflowValue);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      exp_knownValues_expectCorrectResultWithinOneLsb();
+      log_knownValues_expectCorrectResultWithinOneLsb();
+      sqrt_knownValues_expectCorrectResultWithinOneLsb();
+      pow_knownValues_expectCorrectResultWithinOneLsb();
+      mathFunctions_outOfRange_expectOverflowOrZero();
+    }
+};
+
+class TestValueFormat {
+  public:
+    static void toString_decimals_expectRoundedDecimalText(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value testValue = util::Value::fromRaw(10827); //10.5732421875
+      char text0[util::dsp::FixedPointFormat::maxLength];
+      char text1[util::dsp::FixedPointFormat::maxLength];
+      char text3[util::dsp::FixedPointFormat::maxLength];
+      char text5[util::dsp::FixedPointFormat::maxLength];
+      //act
+      size_t length0 = testValue.toString(text0, sizeof(text0), 0);
+      size_t length1 = testValue.toString(text1, sizeof(text1), 1);
+      size_t length3 = testValue.toString(text3, sizeof(text3), 3);
+      size_t length5 = testValue.toString(text5, sizeof(text5), 5);
+      //assert
+      TEST_ASSERT(!strcmp(text0, "11") && (length0 == 2));
+      TEST_ASSERT(!strcmp(text1, "10.6") && (length1 == 4));
+      TEST_ASSERT(!strcmp(text3, "10.573") && (length3 == 6));
+      TEST_ASSERT(!strcmp(text5, "10.57324") && (length5 == 8));
+      TEST_FUNC_END();
+    }
+    static void toString_negativeAndCarry_expectCorrectText(void) {
+      TEST_FUNC_START();
+      //arrange
+      char text1[util::dsp::FixedPointFormat::maxLength];
+      char text2[util::dsp::FixedPointFormat::maxLength];
+      char text3[util::dsp::FixedPointFormat::maxLength];
+      char text4[util::dsp::FixedPointFormat::maxLength];
+      //act
+      (-97.25_fx).toString(text1, sizeof(text1), 2);
+      (9.9999_fx).toString(text2, sizeof(text2), 2);
+      (-0.001_fx).toString(text3, sizeof(text3), 2);
+      (2000000_fx).toString(text4, sizeof(text4), 3);
+      //assert
+      TEST_ASSERT(!strcmp(text1, "-97.25"));
+      TEST_ASSERT(!strcmp(text2, "10.00"));
+      TEST_ASSERT(!strcmp(text3, "0.00"));
+      TEST_ASSERT(!strcmp(text4, "2000000.000"));
+      TEST_FUNC_END();
+    }
+    static void toString_overflowAndSmallBuffer_expectOverflowTextOrEmptyString(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value overflowMax(INT32_MAX);
+      static const util::Value overflowMin(INT32_MIN);
+      char text1[util::dsp::FixedPointFormat::maxLength];
+      char text2[util::dsp::FixedPointFormat::maxLength];
+      char text3[5];
+      //act
+      size_t length1 = overflowMax.toString(text1, sizeof(text1), 3);
+      size_t length2 = overflowMin.toString(text2, sizeof(text2), 3);
+      size_t length3 = (123.5_fx).toString(text3, sizeof(text3), 1);
+      //assert
+      TEST_ASSERT(!strcmp(text1, "OVF") && (length1 == 3));
+      TEST_ASSERT(!strcmp(text2, "-OVF") && (length2 == 4));
+      TEST_ASSERT(!strcmp(text3, "") && (length3 == 0));
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestToString(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value testValue = -12345.678_fx;
+      char text[util::dsp::FixedPointFormat::maxLength];
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testValue.toString(text, sizeof(text), util::ValueDecimals);
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestPrintGetValue(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value testValue = -12345.678_fx;
+      char text[util::dsp::FixedPointFormat::maxLength];
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        util::arrays::PrintToBuffer printToBuffer(text, sizeof(text));
+        printToBuffer.print(static_cast<long>(testValue.getValue(util::ValueDecimals)));
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      toString_decimals_expectRoundedDecimalText();
+      toString_negativeAndCarry_expectCorrectText();
+      toString_overflowAndSmallBuffer_expectOverflowTextOrEmptyString();
+      performanceTestToString();
+      performanceTestPrintGetValue();
+    }
+};
+
+class TestValueArray {
+  public:
+    static const size_t testArraySize = 37; //not a multiple of any vector width
+    static void fillTestArray(util::ValueBase * data, size_t size, uint32_t seed) {
+      //pseudo-random values in range approx. -1000.0...1000.0
+      for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = static_cast<util::ValueBase>((seed >> 8) % 2048000) - 1024000;
+      }
+    }
+    static void scaleOffset_randomValues_expectSameResultAsValueArithmetic(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::ValueBase input[testArraySize];
+      util::ValueBase output[testArraySize];
+      fillTestArray(input, testArraySize, 1);
+      static const util::Value scale = -2.375_fx;
+      static const util::Value offset = 12.5_fx;
+      //act
+      util::dsp::ValueArray::scaleOffset(input, output, testArraySize, scale, offset);
+      //assert
+      boolean sameResult = true;
+      for (size_t i = 0; i < testArraySize; i++) {
+        if (output[i] != (scale * util::Value::fromRaw(input[i]) + offset).getRaw()) sameResult = false;
+      }
+      TEST_ASSERT(sameResult);
+      TEST_FUNC_END();
+    }
+    static void scaleOffset_overflowValues_expectOverflowValuesPreserved(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t size = 9;
+      util::ValueBase data[size] = {
+        INT32_MAX, INT32_MIN, 1024, 2048, 1000000000, -1000000000, INT32_MAX, 0, INT32_MIN
+      };
+      static const util::Value scale = 10_fx;
+      static const util::Value offset = 1_fx;
+      //act
+      util::dsp::ValueArray::scaleOffset(data, data, size, scale, offset);
+      //assert
+      TEST_ASSERT(data[0] == INT32_MAX);
+      TEST_ASSERT(data[1] == INT32_MIN);
+      TEST_ASSERT(data[2] == (11_fx).getRaw());
+      TEST_ASSERT(data[3] == (21_fx).getRaw());
+      TEST_ASSERT(data[4] == INT32_MAX);
+      TEST_ASSERT(data[5] == INT32_MIN);
+      TEST_ASSERT(data[6] == INT32_MAX);
+      TEST_ASSERT(data[7] == (1_fx).getRaw());
+      TEST_ASSERT(data[8] == INT32_MIN);
+      TEST_FUNC_END();
+    }
+    static void clamp_randomValues_expectValuesWithinLimits(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::ValueBase data[testArraySize];
+      util::ValueBase reference[testArraySize];
+      fillTestArray(data, testArraySize, 2);
+      fillTestArray(reference, testArraySize, 2);
+      static const util::Value low = -100_fx;
+      static const util::Value high = 250.5_fx;
+      //act
+      util::dsp::ValueArray::clamp(data, testArraySize, low, high);
+      //assert
+      boolean correctResult = true;
+      for (size_t i = 0; i < testArraySize; i++) {
+        util::Value expected = util::Value::fromRaw(reference[i]);
+        if (expected < low) expected = low;
+        if (expected > high) expected = high;
+        if (data[i] != expected.getRaw()) correctResult = false;
+      }
+      TEST_ASSERT(correctResult);
+      TEST_FUNC_END();
+    }
+    static void sumAndMinMax_randomValues_expectSameResultAsValueArithmetic(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::ValueBase data[testArraySize];
+      fillTestArray(data, testArraySize, 3);
+      util::Value expectedSum(0);
+      util::Value expectedMin = util::Value::fromRaw(data[0]);
+      util::Value expectedMax = util::Value::fromRaw(data[0]);
+      for (size_t i = 0; i < testArraySize; i++) {
+        const util::Value current = util::Value::fromRaw(data[i]);
+        expectedSum += current;
+        if (current < expectedMin) expectedMin = current;
+        if (current > expectedMax) expectedMax = current;
+      }
+      util::Value resultMin, resultMax;
+      //act
+      util::Value resultSum = util::dsp::ValueArray::sum(data, testArraySize);
+      util::dsp::ValueArray::minMax(data, testArraySize, resultMin, resultMax);
+      //assert
+      TEST_ASSERT(resultSum == expectedSum);
+      TEST_ASSERT(resultMin == expectedMin);
+      TEST_ASSERT(resultMax == expectedMax);
+      TEST_FUNC_END();
+    }
+    static void dot_randomValues_expectSameResultAsValueArithmetic(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::ValueBase data1[testArraySize];
+      util::ValueBase data2[testArraySize];
+      fillTestArray(data1, testArraySize, 4);
+      fillTestArray(data2, testArraySize, 5);
+      for (size_t i = 0; i < testArraySize; i++)
+        data2[i] /= 256; //keep products and their sum within range
+      util::Value expected(0);
+      for (size_t i = 0; i < testArraySize; i++)
+        expected += util::Value::fromRaw(data1[i]) * util::Value::fromRaw(data2[i]);
+      //act
+      util::Value result = util::dsp::ValueArray::dot(data1, data2, testArraySize);
+      //assert
+      TEST_ASSERT(result == expected);
+      TEST_FUNC_END();
+    }
+    static void sumAndDot_overflowValues_expectFirstOverflowValue(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t size = 5;
+      const util::ValueBase data[size] = {
+        1024, -2048, INT32_MIN, INT32_MAX, 4096
+      };
+      const util::ValueBase noOverflow[size] = {
+        1024, 1024, 1024, 1024, 1024
+      };
+      const util::ValueBase overflowFirst[size] = {
+        1024, 1024, INT32_MAX, 1024, 1024
+      };
+      const util::ValueBase cancelOut[size] = {
+        INT32_MAX, 0, 0, 0, INT32_MIN + 1
+      };
+      //act
+      util::Value resultSum = util::dsp::ValueArray::sum(data, size);
+      util::Value resultSumCancelOut = util::dsp::ValueArray::sum(cancelOut, size);
+      util::Value resultDot1 = util::dsp::ValueArray::dot(data, noOverflow, size);
+      util::Value resultDot2 = util::dsp::ValueArray::dot(noOverflow, overflowFirst, size);
+      //assert
+      TEST_ASSERT(resultSum.getRaw() == INT32_MIN);
+      TEST_ASSERT(resultSumCancelOut.getRaw() == INT32_MAX);
+      TEST_ASSERT(resultDot1.getRaw() == INT32_MIN);
+      TEST_ASSERT(resultDot2.getRaw() == INT32_MAX);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestScaleOffset(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t size = 1000;
+      util::ValueBase * data = new util::ValueBase[size];
+      fillTestArray(data, size, 6);
+      PERF_TEST_START();
+      util::dsp::ValueArray::scaleOffset(data, data, size, 0.5_fx, 1_fx);
+      PERF_TEST_END();
+      delete[] data;
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestScaleOffsetValueArithmetic(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t size = 1000;
+      util::ValueBase * data = new util::ValueBase[size];
+      fillTestArray(data, size, 6);
+      PERF_TEST_START();
+      for (size_t i = 0; i < size; i++)
+        data[i] = (0.5_fx * util::Value::fromRaw(data[i]) + 1_fx).getRaw();
+      PERF_TEST_END();
+      delete[] data;
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      scaleOffset_randomValues_expectSameResultAsValueArithmetic();
+      scaleOffset_overflowValues_expectOverflowValuesPreserved();
+      clamp_randomValues_expectValuesWithinLimits();
+      sumAndMinMax_randomValues_expectSameResultAsValueArithmetic();
+      dot_randomValues_expectSameResultAsValueArithmetic();
+      sumAndDot_overflowValues_expectFirstOverflowValue();
+      performanceTestScaleOffset();
+      performanceTestScaleOffsetValueArithmetic();
+    }
+};
+
+class TestValueSaturating {
+  public:
+    static void arithmetic_valuesWithinRange_expectSameResultAsRegularArithmetic(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value x = 12.25_fx;
+      static const util::Value y = -3.5_fx;
+      util::Value::Saturating saturating;
+      //act
+      util::Value sum = saturating.add(x, y);
+      util::Value difference = saturating.sub(x, y);
+      util::Value product = saturating.mul(x, y);
+      //assert
+      TEST_ASSERT(sum == (x + y));
+      TEST_ASSERT(difference == (x - y));
+      TEST_ASSERT(product == (x * y));
+      TEST_ASSERT(!saturating.overflow());
+      TEST_ASSERT(saturating.result(product) == product);
+      TEST_FUNC_END();
+    }
+    static void arithmetic_outOfRange_expectCappedResultAndStickyOverflow(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value large = 2000000_fx;
+      static const util::Value overflowMax = util::Value::fromRaw(util::ValueBaseMax);
+      static const util::Value overflowMin = util::Value::fromRaw(util::ValueBaseMin);
+      util::Value::Saturating saturating;
+      //act
+      util::Value product = saturating.mul(large, -large);
+      boolean overflowAfterProduct = saturating.overflow();
+      util::Value sum = saturating.add(1_fx, 2_fx);
+      boolean overflowAfterSum = saturating.overflow();
+      util::Value batchResult = saturating.result(sum);
+      saturating.reset();
+      boolean overflowAfterReset = saturating.overflow();
+      util::Value difference = saturating.sub(overflowMax, 1_fx);
+      boolean overflowAfterUncheckedOperand = saturating.overflow();
+      saturating.check(overflowMax);
+      boolean overflowAfterCheckedOperand = saturating.overflow();
+      //assert
+      TEST_ASSERT(product == overflowMin);
+      TEST_ASSERT(overflowAfterProduct);
+      TEST_ASSERT(sum == 3_fx);
+      TEST_ASSERT(overflowAfterSum);
+      TEST_ASSERT(batchResult == overflowMin);
+      TEST_ASSERT(!overflowAfterReset);
+      TEST_ASSERT(!difference.overflow());
+      TEST_ASSERT(!overflowAfterUncheckedOperand);
+      TEST_ASSERT(overflowAfterCheckedOperand);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestSaturatingPolynomial(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value a = 0.25_fx;
+      static const util::Value b = -1.5_fx;
+      static const util::Value c = 3_fx;
+      static const uint32_t numberOfOperations = 1000;
+      util::Value x = 0_fx;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        util::Value::Saturating saturating;
+        x = saturating.result(saturating.add(saturating.add(saturating.mul(saturating.mul(a, x), x), saturating.mul(b, x)), c));
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestRegularPolynomial(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value a = 0.25_fx;
+      static const util::Value b = -1.5_fx;
+      static const util::Value c = 3_fx;
+      static const uint32_t numberOfOperations = 1000;
+      util::Value x = 0_fx;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        x = a * x * x + b * x + c;
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      arithmetic_valuesWithinRange_expectSameResultAsRegularArithmetic();
+      arithmetic_outOfRange_expectCappedResultAndStickyOverflow();
+      performanceTestSaturatingPolynomial();
+      performanceTestRegularPolynomial();
+    }
+};
+
 class TestFixedPoint {
   public:
     static void runTests(void) {
@@ -779,6 +1343,11 @@ class TestFixedPoint {
       FixedPointTester<int32_t, 8, float, INT32_MAX, INT32_MIN>::runTests();
       FixedPointTester<int16_t, 4, int32_t, INT16_MAX, INT16_MIN>::runTests();
       FixedPointTester<int8_t, 2, int16_t, INT8_MAX, INT8_MIN>::runTests();
+      TestValueLiteral::runTests();
+      TestValueMath::runTests();
+      TestValueFormat::runTests();
+      TestValueArray::runTests();
+      TestValueSaturating::runTests();
       #else
       FixedPointTester<uint32_t, 8, uint64_t, UINT32_MAX, 0>::runTests();
       FixedPointTester<uint16_t, 8, uint32_t, UINT16_MAX, 0>::runTests();
@@ -456,6 +456,25 @@ class TestMovingAverage {
       delete(testFilter2);
       TEST_FUNC_END();
     }
+    static void testOverflowInput_expectOverflowUntilEvicted(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 2;
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingAverage(avgPoints);
+      util::Value overflowMax = util::Value::fromRaw(util::ValueBaseMax);
+      util::Value one = util::Value(1);
+      //act
+      util::Value result1 = testFilter->filter(1, overflowMax);
+      util::Value result2 = testFilter->filter(2, one);
+      util::Value result3 = testFilter->filter(3, one);
+      //assert
+      TEST_ASSERT(result1.overflow());
+      TEST_ASSERT(result2.overflow());
+      TEST_ASSERT(result3 == one);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
   public:
     static void runTests(void) {
       testPulseStepResponsesAvg2();
@@ -463,6 +482,412 @@ class TestMovingAverage {
       testFrequenciesResponsesAvg2();
       testFrequenciesResponsesAvg16();
       testSumOverflow();
+      testOverflowInput_expectOverflowUntilEvicted();
+    }
+};
+
+class NaiveMedian {
+  public:
+    NaiveMedian(size_t numValues) : size(numValues) {
+      window = new util::Value[size];
+      sorted = new util::Value[size];
+    }
+    ~NaiveMedian() {
+      delete[] window;
+      delete[] sorted;
+    }
+    void push(const util::Value &input) {
+      if (count == size) {
+        for (size_t i = 1; i < size; i++)
+          window[i - 1] = window[i];
+        count--;
+      }
+      window[count++] = input;
+    }
+    util::Value median(void) {
+      for (size_t i = 0; i < count; i++)
+        sorted[i] = window[i];
+      return (sortedMedian());
+    }
+    util::Value medianAbsoluteDeviation(const util::Value &median) {
+      for (size_t i = 0; i < count; i++) {
+        sorted[i] = window[i] - median;
+        if (sorted[i] < util::Value(0)) sorted[i] = -sorted[i];
+      }
+      return (sortedMedian());
+    }
+  private:
+    util::Value sortedMedian(void) {
+      for (size_t i = 1; i < count; i++) {
+        const util::Value item = sorted[i];
+        size_t j = i;
+        while (j && (sorted[j - 1] > item)) {
+          sorted[j] = sorted[j - 1];
+          j--;
+        }
+        sorted[j] = item;
+      }
+      if (count & 1) return (sorted[count / 2]);
+      return (sorted[count / 2 - 1] + (sorted[count / 2] - sorted[count / 2 - 1]) / util::Value(2));
+    }
+    util::Value * window = nullptr;
+    util::Value * sorted = nullptr;
+    size_t size = 0;
+    size_t count = 0;
+};
+
+class TestMovingMedian {
+  public:
+    static util::Value randomInput(uint32_t &seed) {
+      seed = seed * 1103515245 + 12345;
+      return (util::Value::fromRaw(static_cast<util::ValueBase>((seed >> 12) % 102400) - 51200)); //-50.0...50.0
+    }
+    static boolean compareWithNaiveMedian(size_t numValues) {
+      static const size_t testInputsNumber = 300;
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingMedian(numValues);
+      NaiveMedian reference(numValues);
+      boolean result = (testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      uint32_t seed = numValues;
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        const util::Value input = randomInput(seed);
+        reference.push(input);
+        if (testFilter->filter(i + 1, input) != reference.median()) result = false;
+      }
+      delete(testFilter);
+      return (result);
+    }
+    static void test_RandomInput_expectSameResultAsNaiveMedian(void) {
+      TEST_FUNC_START();
+      //act
+      boolean oddWindowResult = compareWithNaiveMedian(7);
+      boolean evenWindowResult = compareWithNaiveMedian(8);
+      //assert
+      TEST_ASSERT(oddWindowResult);
+      TEST_ASSERT(evenWindowResult);
+      TEST_FUNC_END();
+    }
+    static void test_SpikeInput_expectSpikeRejected(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 5;
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingMedian(avgPoints);
+      static const util::Value normalInput(10);
+      static const util::Value spikeInput(1000);
+      //act
+      boolean result = true;
+      for (size_t i = 0; i < 10; i++) {
+        const util::Value output = testFilter->filter(i + 1, (i == 6) ? spikeInput : normalInput);
+        if (output != normalInput) result = false;
+      }
+      util::dsp::Filter::Status status = testFilter->getStatus();
+      //assert
+      TEST_ASSERT(status == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static const size_t performanceTestWindow = 31;
+    static void performanceTestMovingMedian(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingMedian(performanceTestWindow);
+      static const uint32_t numberOfOperations = 1000;
+      uint32_t seed = 1;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(i + 1, randomInput(seed));
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestNaiveMedian(void) {
+      PERF_TEST_FUNC_START();
+      NaiveMedian reference(performanceTestWindow);
+      static const uint32_t numberOfOperations = 1000;
+      uint32_t seed = 1;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        reference.push(randomInput(seed));
+        reference.median();
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_RandomInput_expectSameResultAsNaiveMedian();
+      test_SpikeInput_expectSpikeRejected();
+      performanceTestMovingMedian();
+      performanceTestNaiveMedian();
+    }
+};
+
+class TestHampel {
+  public:
+    static void test_RandomInput_expectSameResultAsNaiveHampel(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testInputsNumber = 300;
+      static const size_t windows[] = { 7, 8 };
+      static const util::Value threshold(1);
+      static const util::Value madScale(14826, 4);
+      boolean result = true;
+      //act
+      for (size_t w = 0; w < (sizeof(windows) / sizeof(windows[0])); w++) {
+        util::dsp::Filter * testFilter = new util::dsp::FilterHampel(windows[w], threshold);
+        NaiveMedian reference(windows[w]);
+        uint32_t seed = windows[w];
+        for (size_t i = 0; i < testInputsNumber; i++) {
+          const util::Value input = TestMovingMedian::randomInput(seed);
+          reference.push(input);
+          const util::Value median = reference.median();
+          const util::Value limit = threshold * madScale * reference.medianAbsoluteDeviation(median);
+          util::Value deviation = input - median;
+          if (deviation < util::Value(0)) deviation = -deviation;
+          const util::Value expected = (deviation > limit) ? median : input;
+          if (testFilter->filter(i + 1, input) != expected) result = false;
+        }
+        delete(testFilter);
+      }
+      //assert
+      TEST_ASSERT(result);
+      TEST_FUNC_END();
+    }
+    static void test_OutlierAndNormalVariation_expectOnlyOutlierReplaced(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 7;
+      util::dsp::Filter * testFilter = new util::dsp::FilterHampel(avgPoints);
+      static const util::Value inputs[] = {
+        util::Value(100), util::Value(102), util::Value(99), util::Value(101), util::Value(98), util::Value(103), util::Value(500), util::Value(97)
+      };
+      static const size_t inputsNumber = sizeof(inputs) / sizeof(inputs[0]);
+      static const size_t outlierIndex = 6;
+      util::Value outputs[inputsNumber];
+      //act
+      for (size_t i = 0; i < inputsNumber; i++)
+        outputs[i] = testFilter->filter(i + 1, inputs[i]);
+      util::dsp::Filter::Status status = testFilter->getStatus();
+      //assert
+      TEST_ASSERT(status == util::dsp::Filter::Status::OK);
+      boolean normalPassed = true;
+      for (size_t i = 0; i < inputsNumber; i++)
+        if ((i != outlierIndex) && (outputs[i] != inputs[i])) normalPassed = false;
+      TEST_ASSERT(normalPassed);
+      TEST_ASSERT(outputs[outlierIndex] == util::Value(101));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 5;
+      static const util::Value negativeThreshold(-1);
+      util::dsp::Filter * testFilter = new util::dsp::FilterHampel(avgPoints, negativeThreshold);
+      static const util::Value testInput(1);
+      //act
+      util::dsp::Filter::Status status1 = testFilter->getStatus();
+      util::Value result = testFilter->filter(1, testInput);
+      util::dsp::Filter::Status status2 = testFilter->getStatus();
+      //assert
+      TEST_ASSERT(status1 == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(status2 == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result == util::Value(0));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestHampel(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::Filter * testFilter = new util::dsp::FilterHampel(TestMovingMedian::performanceTestWindow);
+      static const uint32_t numberOfOperations = 1000;
+      uint32_t seed = 1;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(i + 1, TestMovingMedian::randomInput(seed));
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestNaiveHampel(void) {
+      PERF_TEST_FUNC_START();
+      NaiveMedian reference(TestMovingMedian::performanceTestWindow);
+      static const uint32_t numberOfOperations = 1000;
+      uint32_t seed = 1;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        reference.push(TestMovingMedian::randomInput(seed));
+        reference.medianAbsoluteDeviation(reference.median());
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_RandomInput_expectSameResultAsNaiveHampel();
+      test_OutlierAndNormalVariation_expectOnlyOutlierReplaced();
+      test_IncorrectInitData_expectZero();
+      performanceTestHampel();
+      performanceTestNaiveHampel();
+    }
+};
+
+class TestStatistics {
+  public:
+    static boolean compareWithNaiveStatistics(const util::dsp::FilterStatistics &filter, const util::Value * window, size_t count) {
+      //Reference is calculated with two-pass algorithm on raw values
+      double sum = 0;
+      util::Value min = window[0];
+      util::Value max = window[0];
+      for (size_t i = 0; i < count; i++) {
+        sum += window[i].getRaw();
+        if (window[i] < min) min = window[i];
+        if (window[i] > max) max = window[i];
+      }
+      const double mean = sum / count;
+      double sumSquaredDeviations = 0;
+      for (size_t i = 0; i < count; i++)
+        sumSquaredDeviations += (window[i].getRaw() - mean) * (window[i].getRaw() - mean);
+      const double variance = (count > 1) ? (sumSquaredDeviations / (count - 1)) : 0;
+      const util::dsp::FilterStatistics::Result result = filter.getStatistics();
+      static const double fractionMultiplier = 1024.0;
+      static const double tolerance = 1.0;
+      if (result.count != count) return (false);
+      if ((result.min != min) || (result.max != max)) return (false);
+      if (fabs(result.mean.getRaw() - mean) > tolerance) return (false);
+      if (fabs(result.variance.getRaw() - variance / fractionMultiplier) > tolerance) return (false);
+      if (fabs(result.standardDeviation.getRaw() - sqrt(variance)) > tolerance) return (false);
+      return (true);
+    }
+    static void test_RandomInput_expectSameResultAsNaiveStatistics(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testInputsNumber = 500;
+      static const size_t windowSize = 10;
+      util::dsp::FilterStatistics testFilter(windowSize);
+      util::Value inputs[testInputsNumber];
+      uint32_t seed = 3;
+      for (size_t i = 0; i < testInputsNumber; i++)
+        inputs[i] = TestMovingMedian::randomInput(seed);
+      boolean outputResult = true;
+      boolean statisticsResult = true;
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        const util::Value output = testFilter.filter(i + 1, inputs[i]);
+        const size_t count = (i < windowSize) ? (i + 1) : windowSize;
+        const util::Value * window = &inputs[i + 1 - count];
+        if (!compareWithNaiveStatistics(testFilter, window, count)) statisticsResult = false;
+        if (output != testFilter.getStatistics().mean) outputResult = false;
+      }
+      //assert
+      TEST_ASSERT(testFilter.getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(statisticsResult);
+      TEST_ASSERT(outputResult);
+      TEST_FUNC_END();
+    }
+    static void test_KnownValues_expectCorrectStatistics(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t windowSize = 8;
+      util::dsp::FilterStatistics testFilter(windowSize);
+      static const util::Value inputs[] = {
+        util::Value(2), util::Value(4), util::Value(4), util::Value(4), util::Value(5), util::Value(5), util::Value(7), util::Value(9)
+      };
+      static const size_t inputsNumber = sizeof(inputs) / sizeof(inputs[0]);
+      //act
+      util::Value output;
+      for (size_t i = 0; i < inputsNumber; i++)
+        output = testFilter.filter(i + 1, inputs[i]);
+      const util::dsp::FilterStatistics::Result result = testFilter.getStatistics();
+      //assert
+      TEST_ASSERT(output == util::Value(5));
+      TEST_ASSERT(result.count == inputsNumber);
+      TEST_ASSERT(result.mean == util::Value(5));
+      TEST_ASSERT(result.variance == util::Value::fromRaw(4681)); //32 / 7
+      TEST_ASSERT(result.standardDeviation == util::Value::fromRaw(2189)); //sqrt(32 / 7)
+      TEST_ASSERT(result.min == util::Value(2));
+      TEST_ASSERT(result.max == util::Value(9));
+      TEST_FUNC_END();
+    }
+    static void test_WindowSlides_expectOldValuesForgotten(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t windowSize = 3;
+      util::dsp::FilterStatistics testFilter(windowSize);
+      static const util::Value inputs[] = {
+        util::Value(100), util::Value(-100), util::Value(1), util::Value(1), util::Value(1)
+      };
+      static const size_t inputsNumber = sizeof(inputs) / sizeof(inputs[0]);
+      //act
+      util::Value outputs[inputsNumber];
+      for (size_t i = 0; i < inputsNumber; i++)
+        outputs[i] = testFilter.filter(i + 1, inputs[i]);
+      const util::dsp::FilterStatistics::Result result = testFilter.getStatistics();
+      //assert
+      TEST_ASSERT(outputs[0] == util::Value(100));
+      TEST_ASSERT(outputs[1] == util::Value(0));
+      TEST_ASSERT(outputs[2] == util::Value::fromRaw(341)); //1 / 3
+      TEST_ASSERT(outputs[4] == util::Value(1));
+      TEST_ASSERT(result.count == windowSize);
+      TEST_ASSERT(result.variance == util::Value(0));
+      TEST_ASSERT(result.standardDeviation == util::Value(0));
+      TEST_ASSERT(result.min == util::Value(1));
+      TEST_ASSERT(result.max == util::Value(1));
+      TEST_FUNC_END();
+    }
+    static void test_OverflowInput_expectInputSkipped(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t windowSize = 4;
+      util::dsp::FilterStatistics testFilter(windowSize);
+      const util::Value overflowInput = util::Value::fromRaw(INT32_MAX);
+      //act
+      const util::Value output1 = testFilter.filter(1, overflowInput);
+      testFilter.filter(2, util::Value(1));
+      testFilter.filter(3, util::Value(3));
+      const util::Value output2 = testFilter.filter(4, overflowInput);
+      const util::dsp::FilterStatistics::Result result = testFilter.getStatistics();
+      //assert
+      TEST_ASSERT(output1.overflow());
+      TEST_ASSERT(output2 == util::Value(2));
+      TEST_ASSERT(result.count == 2);
+      TEST_ASSERT(result.max == util::Value(3));
+      TEST_ASSERT(result.variance == util::Value(2));
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestStatistics(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::FilterStatistics testFilter(TestMovingMedian::performanceTestWindow);
+      static const uint32_t numberOfOperations = 1000;
+      uint32_t seed = 1;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++) {
+        testFilter.filter(i + 1, TestMovingMedian::randomInput(seed));
+        testFilter.getStatistics();
+      }
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_RandomInput_expectSameResultAsNaiveStatistics();
+      test_KnownValues_expectCorrectStatistics();
+      test_WindowSlides_expectOldValuesForgotten();
+      test_OverflowInput_expectInputSkipped();
+      performanceTestStatistics();
     }
 };
 
@@ -549,11 +974,189 @@ class TestLowPass {
       delete(testFilter2);
       TEST_FUNC_END();
     }
+    static void test_LargeStep_expectNoOverflowLatched(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(4, 1);                    //0.4 Hz
+      static const util::Value fcDivider(1000);             //Timestamp is in milliseconds
+      static const util::Timestamp deltaTime = 200;
+      static const util::ValueBase inputs[] = {400, 400, 5000, 5000, 5000, 600, 600};
+      static const size_t inputsNumber = sizeof(inputs) / sizeof(inputs[0]);
+      static const double tolerance = 5.0; //for large steps smoothing factor has resolution of Value
+      util::dsp::Filter * testFilter = new util::dsp::FilterLowPass(fc, util::ValuePi, fcDivider);
+      const double fcPi2 = static_cast<double>((fc * util::ValuePi * util::Value(2)).getRaw()) / 1024.0; //same rounding as in the filter
+      const double x = fcPi2 * deltaTime / 1000.0;
+      boolean noOverflow = true;
+      boolean sameAsReference = true;
+      double reference = 0;
+      //act
+      for (size_t i = 0; i < inputsNumber; i++) {
+        const util::Value output = testFilter->filter((i + 1) * deltaTime, util::Value(inputs[i]));
+        reference = i ? (reference + (inputs[i] - reference) * x / (x + 1.0)) : inputs[i];
+        if (util::overflow(output)) noOverflow = false;
+        if (fabs(static_cast<double>(output.getRaw()) / 1024.0 - reference) > tolerance) sameAsReference = false;
+      }
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(noOverflow);
+      TEST_ASSERT(sameAsReference);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
   public:
     static void runTests(void) {
       testPulseStepResponses20Hz();
       testFrequenciesResponses20Hz();
       testIncorrectFcValues();
+      test_LargeStep_expectNoOverflowLatched();
+    }
+};
+
+class TestLowPassTable {
+  public:
+    static void testPulseStepResponses20Hz(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc = static_cast<util::Value>(LOWPASS_A_FREQUENCY_HZ);
+      static const util::Value timestampFactor = util::timestampPerSecond;
+      static const util::Value margin(1, 1);//0.1
+      static const util::Timestamp maxTableDeltaTime = 20;
+      util::dsp::Filter * testFilter = new util::dsp::FilterLowPassTable(fc, util::ValuePi, timestampFactor, maxTableDeltaTime);
+      AnalogFilterTestSet * testInputSet = new AnalogFilterTestSet (DELTA_TIME_MS_INPUT1, DECIMALS_INPUT1, input1, SIZE_INPUT_1);
+      AnalogFilterTestSet * testReferenceSet = new AnalogFilterTestSet (DELTA_TIME_MS_INPUT1, DECIMALS_OUTPUT1_LOWPASS_A, output1_lowpass_a, SIZE_INPUT_1);
+      AnalogFilterTestSet * testOutputSet = new AnalogFilterTestSet (testInputSet->getSize());
+      testOutputSet->setDeltaTime(testInputSet->getDeltaTime());
+      //act
+      util::dsp::Filter::Status status = testFilter->getStatus();
+      boolean feedResult = AnalogFilterTester::feed(*testFilter, *testInputSet, *testOutputSet);
+      testOutputSet->makeReadOnly();
+      util::Value comparisonResult(AnalogFilterTester::compare(*testOutputSet, *testReferenceSet));
+      //assert
+      TEST_ASSERT(status == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(feedResult);
+      TEST_ASSERT(comparisonResult <= margin);
+      //cleanup
+      delete(testFilter);
+      delete(testInputSet);
+      delete(testOutputSet);
+      delete(testReferenceSet);
+      TEST_FUNC_END();
+    }
+    static void test_IrregularIntervals_expectSameResultAsReference(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(5, 1);                    //0.5 Hz
+      static const util::Value fcDivider(1000);             //Timestamp is in milliseconds
+      static const util::Timestamp maxTableDeltaTime = 400;
+      static const size_t deltaTimeQuantumBits = 2;
+      util::dsp::Filter * testFilter = new util::dsp::FilterLowPassTable(fc, util::ValuePi, fcDivider, maxTableDeltaTime, deltaTimeQuantumBits);
+      //loop jitter (multiples of 4 ms) and late iterations exceeding maxTableDeltaTime
+      static const util::Timestamp deltaTimes[] = {200, 204, 196, 200, 1000, 200, 208, 2500, 200, 192};
+      static const size_t deltaTimesNumber = sizeof(deltaTimes) / sizeof(deltaTimes[0]);
+      static const size_t testInputsNumber = 60;
+      static const double tolerance = 0.002; //2 least significant bits of Value
+      const double fcPi2 = static_cast<double>((fc * util::ValuePi * util::Value(2)).getRaw()) / 1024.0; //same rounding as in the filter
+      boolean result = true;
+      double reference = 0;
+      util::Timestamp timestamp = 1000;
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        const double input = ((i / 15) % 2) ? 80.0 : 20.0;
+        const util::Timestamp deltaTime = deltaTimes[i % deltaTimesNumber];
+        timestamp += deltaTime;
+        const util::Value output = testFilter->filter(timestamp, util::Value(static_cast<util::ValueBase>(input)));
+        if (!i) {
+          reference = input;
+        } else {
+          const double x = fcPi2 * deltaTime / 1000.0;
+          reference += (input - reference) * x / (x + 1.0);
+        }
+        if (fabs(static_cast<double>(output.getRaw()) / 1024.0 - reference) > tolerance) result = false;
+      }
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_LowFrequency_expectConvergesToInput(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(1, 2);                    //0.01 Hz
+      static const util::Value fcDivider(1000);
+      static const util::Timestamp deltaTime = 200;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterLowPassTable(fc, util::ValuePi, fcDivider, deltaTime);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterLowPass(fc, util::ValuePi, fcDivider);
+      static const util::Value initialInput(0);
+      static const util::Value testInput(5);
+      static const size_t testInputsNumber = 2000;    //400 seconds, i.e. 25 time constants
+      util::Value result1, result2;
+      //act
+      testFilter1->filter(deltaTime, initialInput);
+      testFilter2->filter(deltaTime, initialInput);
+      for (size_t i = 2; i <= testInputsNumber; i++) {
+        result1 = testFilter1->filter(i * deltaTime, testInput);
+        result2 = testFilter2->filter(i * deltaTime, testInput);
+      }
+      //assert
+      TEST_ASSERT(result1 == testInput);
+      TEST_ASSERT(result2 < testInput); //LowPass stops when the change is less than least significant bit
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc1(-1);
+      static const util::Value fc2(1);
+      static const util::Timestamp maxTableDeltaTime = 100;
+      static const util::Timestamp tooLargeTableDeltaTime = 10000;
+      static const util::Value testValue(10);
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterLowPassTable(fc1, util::ValuePi, util::timestampPerSecond, maxTableDeltaTime);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterLowPassTable(fc2, util::ValuePi, util::timestampPerSecond, tooLargeTableDeltaTime);
+      //act
+      testFilter1->filter(1, testValue);
+      util::Value outputResult1 = testFilter1->filter(2, testValue);
+      testFilter2->filter(1, testValue);
+      util::Value outputResult2 = testFilter2->filter(2, testValue);
+      //assert
+      TEST_ASSERT(testFilter1->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(outputResult1 == util::Value(0));
+      TEST_ASSERT(testFilter2->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(outputResult2 == util::Value(0));
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestLowPassTable(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Timestamp deltaTime = 200;
+      util::dsp::Filter * testFilter = new util::dsp::FilterLowPassTable(util::Value(5, 1), util::ValuePi, util::Value(1000), deltaTime);
+      static const util::Value testInput(10);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(deltaTime + i * deltaTime, testInput);
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      testPulseStepResponses20Hz();
+      test_IrregularIntervals_expectSameResultAsReference();
+      test_LowFrequency_expectConvergesToInput();
+      test_IncorrectInitData_expectZero();
+      performanceTestLowPassTable();
     }
 };
 
@@ -771,12 +1374,34 @@ class TestSquareScale {
       delete(testFilter);
       TEST_FUNC_END();
     }
+    static void test_LargeInput_expectOverflow(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value a(1);
+      static const util::Value b(0);
+      static const util::Value c(-10);
+      util::dsp::Filter * testFilter = new util::dsp::FilterSquareScale(a, b, c);
+      static const util::Value largeInput(100000);
+      static const util::Value smallInput(3);
+      //act
+      util::Value result1 = testFilter->filter(1, largeInput);
+      util::Value result2 = testFilter->filter(2, -largeInput);
+      util::Value result3 = testFilter->filter(3, smallInput);
+      //assert
+      TEST_ASSERT(result1.overflow() && (result1 > util::Value(0)));
+      TEST_ASSERT(result2.overflow() && (result2 > util::Value(0)));
+      TEST_ASSERT(result3 == util::Value(-1));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
   public:
     static void runTests(void) {
       test_InitWithThreePoints_expectCorrectValues();
       test_InitWithABC_expectCorrectValues();
       test_VertexWarning_expectWarningWhenParabolaVertexIsInRange();
       test_IncorrectInitData_expectZero();
+      test_LargeInput_expectOverflow();
     }
 };
 
@@ -871,6 +1496,1255 @@ class TestSplineScale {
     }
 };
 
+class TestPiecewiseLinearScale {
+  public:
+    static void test_InputsWithinAndOutsideKnots_expectInterpolatedValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value x[] = {util::Value(0), util::Value(10), util::Value(20), util::Value(40)};
+      static const util::Value y[] = {util::Value(0), util::Value(100), util::Value(150), util::Value(150)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterPiecewiseLinearScale(x, y, sizeof(x) / sizeof(x[0]));
+      //act
+      util::Value result1 = testFilter->filter(1, util::Value(5));
+      util::Value result2 = testFilter->filter(2, util::Value(10));
+      util::Value result3 = testFilter->filter(3, util::Value(15));
+      util::Value result4 = testFilter->filter(4, util::Value(30));
+      util::Value result5 = testFilter->filter(5, util::Value(-10));
+      util::Value result6 = testFilter->filter(6, util::Value(50));
+      util::Value result7 = testFilter->filter(7, util::Value(125, 1));
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result1 == util::Value(50));
+      TEST_ASSERT(result2 == util::Value(100));
+      TEST_ASSERT(result3 == util::Value(125));
+      TEST_ASSERT(result4 == util::Value(150));
+      TEST_ASSERT(result5 == util::Value(-100));
+      TEST_ASSERT(result6 == util::Value(150));
+      TEST_ASSERT(result7 == util::Value(1125, 1));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_ProgmemKnots_expectSameValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value PROGMEM x[] = {util::Value(100), util::Value(400), util::Value(800)};
+      static const util::Value PROGMEM y[] = {util::Value(5000), util::Value(1000), util::Value(400)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterPiecewiseLinearScale(x, y, sizeof(x) / sizeof(x[0]), true);
+      //act
+      util::Value result1 = testFilter->filter(1, util::Value(250));
+      util::Value result2 = testFilter->filter(2, util::Value(600));
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result1 == util::Value(3000));
+      TEST_ASSERT(result2 == util::Value(700));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectKnots_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value unsortedX[] = {util::Value(0), util::Value(20), util::Value(10)};
+      static const util::Value y[] = {util::Value(0), util::Value(1), util::Value(2)};
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterPiecewiseLinearScale(unsortedX, y, sizeof(unsortedX) / sizeof(unsortedX[0]));
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterPiecewiseLinearScale(unsortedX, y, 1);
+      //act
+      util::Value result1 = testFilter1->filter(1, util::Value(5));
+      util::Value result2 = testFilter2->filter(1, util::Value(5));
+      //assert
+      TEST_ASSERT(testFilter1->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(testFilter2->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result1 == util::Value(0));
+      TEST_ASSERT(result2 == util::Value(0));
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      test_InputsWithinAndOutsideKnots_expectInterpolatedValues();
+      test_ProgmemKnots_expectSameValues();
+      test_IncorrectKnots_expectZero();
+    }
+};
+
+class ReferenceNaturalSpline {
+  public:
+    static const size_t maxKnots = 16;
+    ReferenceNaturalSpline(const double * x, const double * y, size_t knotsNumber) : x(x), y(y), n(knotsNumber) {
+      double upper[maxKnots];
+      m[0] = 0; upper[0] = 0;
+      for (size_t i = 1; i < n - 1; i++) {
+        const double h0 = x[i] - x[i - 1], h1 = x[i + 1] - x[i];
+        const double right = 6 * ((y[i + 1] - y[i]) / h1 - (y[i] - y[i - 1]) / h0);
+        const double pivot = 2 * (h0 + h1) - h0 * upper[i - 1];
+        upper[i] = h1 / pivot;
+        m[i] = (right - h0 * m[i - 1]) / pivot;
+      }
+      m[n - 1] = 0;
+      for (size_t i = n - 2; i > 0; i--) m[i] -= upper[i] * m[i + 1];
+    }
+    double value(double input) const {
+      size_t i = 0;
+      while ((i < n - 2) && (input >= x[i + 1])) i++;
+      const double h = x[i + 1] - x[i];
+      const double slope = (y[i + 1] - y[i]) / h;
+      if (input < x[0]) return (y[0] + (input - x[0]) * (slope - h * m[1] / 6));
+      if (input > x[n - 1]) return (y[n - 1] + (input - x[n - 1]) * (slope + h * m[n - 2] / 6));
+      const double u = (input - x[i]) / h, w = 1 - u;
+      return (y[i] + u * (y[i + 1] - y[i]) + h * h / 6 * ((u * u * u - u) * m[i + 1] + (w * w * w - w) * m[i]));
+    }
+  private:
+    const double * x;
+    const double * y;
+    size_t n;
+    double m[maxKnots];
+};
+
+class TestNaturalSplineScale {
+  public:
+    static void test_ThreeKnots_expectSameAsSplineScale(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value x[] = {
+        util::Value(SPLINE_SCALE_A_X1, SPLINE_SCALE_A_DECIMALS),
+        util::Value(SPLINE_SCALE_A_X2, SPLINE_SCALE_A_DECIMALS),
+        util::Value(SPLINE_SCALE_A_X3, SPLINE_SCALE_A_DECIMALS)
+      };
+      static const util::Value y[] = {
+        util::Value(SPLINE_SCALE_A_Y1, SPLINE_SCALE_A_DECIMALS),
+        util::Value(SPLINE_SCALE_A_Y2, SPLINE_SCALE_A_DECIMALS),
+        util::Value(SPLINE_SCALE_A_Y3, SPLINE_SCALE_A_DECIMALS)
+      };
+      static const util::Value margin(5, 1);//0.5
+      util::dsp::Filter * testFilter = new util::dsp::FilterNaturalSplineScale(x, y, sizeof(x) / sizeof(x[0]));
+      AnalogFilterTestSet * testInputSet = new AnalogFilterTestSet (DELTA_TIME_MS_INPUT3, DECIMALS_INPUT3, input3, SIZE_INPUT_3);
+      AnalogFilterTestSet * testReferenceSet = new AnalogFilterTestSet (DELTA_TIME_MS_INPUT3, DECIMALS_OUTPUT3_SPLINE_SCALE_A, output3_splineScale_a, SIZE_INPUT_3);
+      AnalogFilterTestSet * testOutputSet = new AnalogFilterTestSet (testInputSet->getSize());
+      testOutputSet->setDeltaTime(testInputSet->getDeltaTime());
+      //act
+      boolean feedResult = AnalogFilterTester::feed(*testFilter, *testInputSet, *testOutputSet);
+      testOutputSet->makeReadOnly();
+      util::Value comparisonResult(AnalogFilterTester::compare(*testOutputSet, *testReferenceSet));
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(feedResult);
+      TEST_ASSERT(comparisonResult <= margin);
+      //cleanup
+      delete(testFilter);
+      delete(testInputSet);
+      delete(testOutputSet);
+      delete(testReferenceSet);
+      TEST_FUNC_END();
+    }
+    static void test_ManyKnots_expectSameResultAsReference(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const double xReference[] = {120, 180, 250, 330, 420, 500, 610, 720, 850};
+      static const double yReference[] = {9800, 6100, 4050, 2600, 1700, 1200, 800, 560, 400};
+      static const size_t knotsNumber = sizeof(xReference) / sizeof(xReference[0]);
+      util::Value x[knotsNumber], y[knotsNumber];
+      for (size_t i = 0; i < knotsNumber; i++) {
+        x[i] = util::Value(static_cast<util::ValueBase>(xReference[i]));
+        y[i] = util::Value(static_cast<util::ValueBase>(yReference[i]));
+      }
+      util::dsp::Filter * testFilter = new util::dsp::FilterNaturalSplineScale(x, y, knotsNumber);
+      ReferenceNaturalSpline reference(xReference, yReference, knotsNumber);
+      static const double tolerance = 0.01;
+      boolean ascendingResult = true;
+      boolean descendingResult = true;
+      boolean knotsResult = true;
+      //act
+      for (int adc = 0; adc < 1024; adc++) {
+        const util::Value output = testFilter->filter(adc + 1, util::Value(static_cast<util::ValueBase>(adc)));
+        if (fabs(static_cast<double>(output.getRaw()) / 1024.0 - reference.value(adc)) > tolerance) ascendingResult = false;
+      }
+      for (int adc = 1023; adc >= 0; adc -= 7) {
+        const util::Value output = testFilter->filter(2048 - adc, util::Value(static_cast<util::ValueBase>(adc)));
+        if (fabs(static_cast<double>(output.getRaw()) / 1024.0 - reference.value(adc)) > tolerance) descendingResult = false;
+      }
+      for (size_t i = 0; i < knotsNumber; i++)
+        if (testFilter->filter(4096 + i, x[i]) != y[i]) knotsResult = false;
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(ascendingResult);
+      TEST_ASSERT(descendingResult);
+      TEST_ASSERT(knotsResult);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_CollinearKnots_expectLinearValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value x[] = {util::Value(0), util::Value(3), util::Value(4), util::Value(10)};
+      static const util::Value y[] = {util::Value(10), util::Value(16), util::Value(18), util::Value(30)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterNaturalSplineScale(x, y, sizeof(x) / sizeof(x[0]));
+      //act
+      util::Value result1 = testFilter->filter(1, util::Value(1));
+      util::Value result2 = testFilter->filter(2, util::Value(35, 1));
+      util::Value result3 = testFilter->filter(3, util::Value(7));
+      util::Value result4 = testFilter->filter(4, util::Value(12));
+      //assert
+      TEST_ASSERT(result1 == util::Value(12));
+      TEST_ASSERT(result2 == util::Value(17));
+      TEST_ASSERT(result3 == util::Value(24));
+      TEST_ASSERT(result4 == util::Value(34));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectKnots_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value duplicateX[] = {util::Value(0), util::Value(10), util::Value(10)};
+      static const util::Value y[] = {util::Value(0), util::Value(1), util::Value(2)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterNaturalSplineScale(duplicateX, y, sizeof(duplicateX) / sizeof(duplicateX[0]));
+      //act
+      util::Value result = testFilter->filter(1, util::Value(5));
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result == util::Value(0));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestNaturalSplineScale(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value x[] = {util::Value(120), util::Value(250), util::Value(420), util::Value(610), util::Value(850)};
+      static const util::Value y[] = {util::Value(9800), util::Value(4050), util::Value(1700), util::Value(800), util::Value(400)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterNaturalSplineScale(x, y, sizeof(x) / sizeof(x[0]));
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(i + 1, util::Value(static_cast<util::ValueBase>(i)));
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestSplineScale(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::Filter * testFilter = new util::dsp::FilterSplineScale(util::Value(120), util::Value(9800),
+          util::Value(420), util::Value(1700), util::Value(850), util::Value(400));
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(i + 1, util::Value(static_cast<util::ValueBase>(i)));
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_ThreeKnots_expectSameAsSplineScale();
+      test_ManyKnots_expectSameResultAsReference();
+      test_CollinearKnots_expectLinearValues();
+      test_IncorrectKnots_expectZero();
+      performanceTestNaturalSplineScale();
+      performanceTestSplineScale();
+    }
+};
+
+class TestExpScale {
+  public:
+    static boolean isClose(const util::Value &value, const util::Value &reference, const util::Value &tolerance) {
+      util::Value difference = value - reference;
+      if (difference < util::Value(0)) difference = -difference;
+      return (difference <= tolerance);
+    }
+    static void test_InitWithFactorAndOffset_expectCorrectValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value factor(5, 1);        //0.5
+      static const util::Value offset(1);           //1.0
+      util::dsp::Filter * testFilter = new util::dsp::FilterExpScale(factor, offset);
+      static const util::Value testInput1(0);       //0.0
+      static const util::Value testInput2(2);       //2.0
+      static const util::Value testOutput1(2718, 3);  //e^1 = 2.718
+      static const util::Value testOutput2(7389, 3);  //e^2 = 7.389
+      static const util::Value tolerance(2, 3);     //0.002
+      //act
+      util::dsp::Filter::Status status = testFilter->getStatus();
+      const util::Value result1 = testFilter->filter(1, testInput1);
+      const util::Value result2 = testFilter->filter(2, testInput2);
+      //assert
+      TEST_ASSERT(status == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(isClose(result1, testOutput1, tolerance));
+      TEST_ASSERT(isClose(result2, testOutput2, tolerance));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_InitWithTwoPoints_expectCorrectValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value point1x(100);        //ADC value 100
+      static const util::Value point1y(10000);      //10000 ppm
+      static const util::Value point2x(400);        //ADC value 400
+      static const util::Value point2y(400);        //400 ppm
+      util::dsp::Filter * testFilter = new util::dsp::FilterExpScale(point1x, point1y, point2x, point2y);
+      static const util::Value testInput1(100);
+      static const util::Value testInput2(250);
+      static const util::Value testInput3(400);
+      static const util::Value testOutput1(10000);
+      static const util::Value testOutput2(2000);   //geometric mean of 10000 and 400
+      static const util::Value testOutput3(400);
+      static const util::Value tolerance(1, 3);     //0.1% of the output value
+      //act
+      util::dsp::Filter::Status status = testFilter->getStatus();
+      const util::Value result1 = testFilter->filter(1, testInput1);
+      const util::Value result2 = testFilter->filter(2, testInput2);
+      const util::Value result3 = testFilter->filter(3, testInput3);
+      //assert
+      TEST_ASSERT(status == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(isClose(result1, testOutput1, testOutput1 * tolerance));
+      TEST_ASSERT(isClose(result2, testOutput2, testOutput2 * tolerance));
+      TEST_ASSERT(isClose(result3, testOutput3, testOutput3 * tolerance));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value point1x(100);
+      static const util::Value point1y(0);          //logarithm of zero is undefined
+      static const util::Value point2x(400);
+      static const util::Value point2y(400);
+      util::dsp::Filter * testFilter = new util::dsp::FilterExpScale(point1x, point1y, point2x, point2y);
+      static const util::Value testInput(1);
+      //act
+      util::dsp::Filter::Status status1 = testFilter->getStatus();
+      const util::Value result = testFilter->filter(1, testInput);
+      util::dsp::Filter::Status status2 = testFilter->getStatus();
+      //assert
+      TEST_ASSERT(status1 == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(status2 == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result == util::Value(0));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      test_InitWithFactorAndOffset_expectCorrectValues();
+      test_InitWithTwoPoints_expectCorrectValues();
+      test_IncorrectInitData_expectZero();
+    }
+};
+
+class TestTableScale {
+  public:
+    static void test_SampledFromExpScale_expectSameValuesAtAdcInputs(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::dsp::Filter * sourceFilter = new util::dsp::FilterExpScale(util::Value(100), util::Value(10000), util::Value(400), util::Value(400));
+      static const size_t adcValues = 1024;
+      util::dsp::Filter * testFilter = new util::dsp::FilterTableScale(*sourceFilter, util::Value(0), util::Value(adcValues - 1), adcValues);
+      boolean result = true;
+      //act
+      for (size_t i = 0; i < adcValues; i++) {
+        const util::Value input(static_cast<util::ValueBase>(i));
+        if (testFilter->filter(i + 1, input) != sourceFilter->filter(i + 1, input)) result = false;
+      }
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result);
+      //cleanup
+      delete(testFilter);
+      delete(sourceFilter);
+      TEST_FUNC_END();
+    }
+    static void test_SmallTable_expectInterpolatedValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::dsp::Filter * sourceFilter = new util::dsp::FilterSquareScale(util::Value(1), util::Value(0), util::Value(0));
+      static const size_t tableSize = 11;
+      util::dsp::Filter * testFilter = new util::dsp::FilterTableScale(*sourceFilter, util::Value(0), util::Value(10), tableSize);
+      //act
+      util::Value result1 = testFilter->filter(1, util::Value(3));
+      util::Value result2 = testFilter->filter(2, util::Value(35, 1));
+      util::Value result3 = testFilter->filter(3, util::Value(925, 2));
+      util::Value result4 = testFilter->filter(4, util::Value(10));
+      //assert
+      TEST_ASSERT(result1 == util::Value(9));
+      TEST_ASSERT(result2 == util::Value(125, 1));    //(9 + 16) / 2
+      TEST_ASSERT(result3 == util::Value(8575, 2));   //81 + 0.25 * (100 - 81)
+      TEST_ASSERT(result4 == util::Value(100));
+      //cleanup
+      delete(testFilter);
+      delete(sourceFilter);
+      TEST_FUNC_END();
+    }
+    static void test_ProgmemTable_expectInterpolatedAndClampedValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value PROGMEM table[] = {util::Value(10000), util::Value(2000), util::Value(1000), util::Value(400), util::Value(300)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterTableScale(table, sizeof(table) / sizeof(table[0]), util::Value(0), util::Value(1000), true);
+      //act
+      util::Value result1 = testFilter->filter(1, util::Value(125));
+      util::Value result2 = testFilter->filter(2, util::Value(600));
+      util::Value result3 = testFilter->filter(3, util::Value(-50));
+      util::Value result4 = testFilter->filter(4, util::Value(1200));
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result1 == util::Value(6000));
+      TEST_ASSERT(result2 == util::Value(760));
+      TEST_ASSERT(result3 == util::Value(10000));
+      TEST_ASSERT(result4 == util::Value(300));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::dsp::Filter * sourceFilter = new util::dsp::FilterExpScale(util::Value(100), util::Value(-1), util::Value(400), util::Value(400));
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterTableScale(*sourceFilter, util::Value(0), util::Value(1023), 64);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterTableScale(*sourceFilter, util::Value(10), util::Value(0), 64);
+      //act
+      util::Value result1 = testFilter1->filter(1, util::Value(5));
+      util::Value result2 = testFilter2->filter(1, util::Value(5));
+      //assert
+      TEST_ASSERT(testFilter1->getStatus() == util::dsp::Filter::Status::ERROR_INIT_FAILED);
+      TEST_ASSERT(testFilter2->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result1 == util::Value(0));
+      TEST_ASSERT(result2 == util::Value(0));
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      delete(sourceFilter);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestTableScale(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::Filter * sourceFilter = new util::dsp::FilterExpScale(util::Value(100), util::Value(10000), util::Value(400), util::Value(400));
+      util::dsp::Filter * testFilter = new util::dsp::FilterTableScale(*sourceFilter, util::Value(0), util::Value(1023), 65);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(i + 1, util::Value(static_cast<util::ValueBase>(i)));
+      PERF_TEST_END();
+      delete(testFilter);
+      delete(sourceFilter);
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestExpScale(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::Filter * testFilter = new util::dsp::FilterExpScale(util::Value(100), util::Value(10000), util::Value(400), util::Value(400));
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(i + 1, util::Value(static_cast<util::ValueBase>(i)));
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_SampledFromExpScale_expectSameValuesAtAdcInputs();
+      test_SmallTable_expectInterpolatedValues();
+      test_ProgmemTable_expectInterpolatedAndClampedValues();
+      test_IncorrectInitData_expectZero();
+      performanceTestTableScale();
+      performanceTestExpScale();
+    }
+};
+
+class ReferenceBiquad {
+  public:
+    ReferenceBiquad(util::dsp::FilterBiquad::Type type, double normalisedFrequency, double q) {
+      const double w0 = 2 * M_PI * normalisedFrequency;
+      const double alpha = sin(w0) / (2 * q);
+      const double cosine = cos(w0);
+      switch (type) {
+        case util::dsp::FilterBiquad::Type::LOW_PASS:
+          b0 = (1 - cosine) / 2; b1 = 1 - cosine; b2 = b0; dcGain = 1;
+          break;
+        case util::dsp::FilterBiquad::Type::HIGH_PASS:
+          b0 = (1 + cosine) / 2; b1 = -(1 + cosine); b2 = b0; dcGain = 0;
+          break;
+        case util::dsp::FilterBiquad::Type::BAND_PASS:
+          b0 = alpha; b1 = 0; b2 = -alpha; dcGain = 0;
+          break;
+        case util::dsp::FilterBiquad::Type::NOTCH:
+          b0 = 1; b1 = -2 * cosine; b2 = 1; dcGain = 1;
+          break;
+      }
+      const double a0 = 1 + alpha;
+      b0 /= a0; b1 /= a0; b2 /= a0;
+      a1 = -2 * cosine / a0;
+      a2 = (1 - alpha) / a0;
+    }
+    void init(double input) {
+      const double output = dcGain * input;
+      s2 = b2 * input - a2 * output;
+      s1 = b1 * input - a1 * output + s2;
+    }
+    double process(double input) {
+      const double output = b0 * input + s1;
+      s1 = b1 * input - a1 * output + s2;
+      s2 = b2 * input - a2 * output;
+      return (output);
+    }
+    double getDcGain(void) {
+      return (dcGain);
+    }
+  private:
+    double b0 = 0, b1 = 0, b2 = 0, a1 = 0, a2 = 0, dcGain = 0;
+    double s1 = 0, s2 = 0;
+};
+
+class TestBiquad {
+  public:
+    static const util::Timestamp startTime = 1000;
+    static const util::Timestamp deltaTime = 200;   //milliseconds
+    static const size_t testInputsNumber = 100;
+    static double testInput(size_t index) {
+      //step with two sine waves
+      const double step = (index < (testInputsNumber / 4)) ? 10.0 : 50.0;
+      return (step + 20.0 * sin(index * 0.05) + 5.0 * sin(index * 2.1));
+    }
+    static util::Value toValue(double x) {
+      return (util::Value(static_cast<util::ValueBase>(x * 1000.0), 3));
+    }
+    static double toDouble(const util::Value &x) {
+      return (static_cast<double>(x.getRaw()) / 1024.0);
+    }
+    static boolean compareWithReference(util::dsp::FilterBiquad::Type type, const util::Value * q, size_t stages) {
+      static const util::Value fc(5, 1);            //0.5 Hz
+      static const util::Value fcDivider(1000);     //Timestamp is in milliseconds
+      static const double tolerance = 0.002; //2 least significant bits of Value
+      util::dsp::Filter * testFilter = new util::dsp::FilterBiquad(type, fc, q, stages, fcDivider);
+      static const size_t maxStages = 4;
+      if (stages > maxStages) return (false);
+      ReferenceBiquad * reference[maxStages];
+      for (size_t i = 0; i < stages; i++)
+        reference[i] = new ReferenceBiquad(type, 0.5 * deltaTime / 1000.0, toDouble(q[i]));
+      boolean result = (testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      double initialInput = 0;
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        const util::Value input = toValue(testInput(i));
+        const util::Value output = testFilter->filter(startTime + i * deltaTime, input);
+        double referenceOutput = toDouble(input);
+        if (!i) {
+          initialInput = referenceOutput;
+          for (size_t j = 0; j < stages; j++)
+            referenceOutput *= reference[j]->getDcGain();
+        }
+        else {
+          for (size_t j = 0; j < stages; j++) {
+            if (i == 1) {
+              reference[j]->init(initialInput);
+              initialInput *= reference[j]->getDcGain();
+            }
+            referenceOutput = reference[j]->process(referenceOutput);
+          }
+        }
+        if (testFilter->getStatus() != util::dsp::Filter::Status::OK) result = false;
+        if (fabs(toDouble(output) - referenceOutput) > tolerance) result = false;
+      }
+      for (size_t i = 0; i < stages; i++)
+        delete(reference[i]);
+      delete(testFilter);
+      return (result);
+    }
+    static void test_LowPassHighPassBandPassNotch_expectSameResultAsReference(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value q(7071, 4);          //0.7071
+      //act
+      boolean lowPassResult = compareWithReference(util::dsp::FilterBiquad::Type::LOW_PASS, &q, 1);
+      boolean highPassResult = compareWithReference(util::dsp::FilterBiquad::Type::HIGH_PASS, &q, 1);
+      boolean bandPassResult = compareWithReference(util::dsp::FilterBiquad::Type::BAND_PASS, &q, 1);
+      boolean notchResult = compareWithReference(util::dsp::FilterBiquad::Type::NOTCH, &q, 1);
+      //assert
+      TEST_ASSERT(lowPassResult);
+      TEST_ASSERT(highPassResult);
+      TEST_ASSERT(bandPassResult);
+      TEST_ASSERT(notchResult);
+      TEST_FUNC_END();
+    }
+    static void test_Cascade_expectSameResultAsReference(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value q[] = { util::Value(5412, 4), util::Value(13066, 4) }; //4th order Butterworth
+      //act
+      boolean lowPassResult = compareWithReference(util::dsp::FilterBiquad::Type::LOW_PASS, q, 2);
+      boolean highPassResult = compareWithReference(util::dsp::FilterBiquad::Type::HIGH_PASS, q, 2);
+      //assert
+      TEST_ASSERT(lowPassResult);
+      TEST_ASSERT(highPassResult);
+      TEST_FUNC_END();
+    }
+    static void test_ConstantInput_expectSteadyStateOutput(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(1, 1);            //0.1 Hz
+      static const util::Value fcDivider(1000);
+      static const util::Value q(7071, 4);
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterBiquad(util::dsp::FilterBiquad::Type::LOW_PASS, fc, q, fcDivider);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterBiquad(util::dsp::FilterBiquad::Type::HIGH_PASS, fc, q, fcDivider);
+      static const util::Value testInput(4321, 1);  //432.1
+      static const util::Value zero(0);
+      //act
+      boolean lowPassResult = true;
+      boolean highPassResult = true;
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        if (testFilter1->filter(startTime + i * deltaTime, testInput) != testInput) lowPassResult = false;
+        if (testFilter2->filter(startTime + i * deltaTime, testInput) != zero) highPassResult = false;
+      }
+      //assert
+      TEST_ASSERT(lowPassResult);
+      TEST_ASSERT(highPassResult);
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+    static void test_SamplingRateTooLow_expectError(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(3);               //3 Hz
+      static const util::Value fcDivider(1000);
+      static const util::Value q(7071, 4);
+      util::dsp::Filter * testFilter = new util::dsp::FilterBiquad(util::dsp::FilterBiquad::Type::LOW_PASS, fc, q, fcDivider);
+      static const util::Value testInput(10);
+      //act
+      testFilter->filter(startTime, testInput);
+      util::Value result1 = testFilter->filter(startTime + deltaTime, testInput);
+      util::dsp::Filter::Status status1 = testFilter->getStatus();
+      testFilter->filter(startTime + deltaTime + 100, testInput);
+      util::Value result2 = testFilter->filter(startTime + deltaTime + 200, testInput);
+      util::dsp::Filter::Status status2 = testFilter->getStatus();
+      //assert
+      TEST_ASSERT(status1 == util::dsp::Filter::Status::ERROR_SAMPLING_RATE_TOO_LOW);
+      TEST_ASSERT(result1 == util::Value(0));
+      TEST_ASSERT(status2 == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result2 == testInput);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(1);
+      static const util::Value negativeQ(-1);
+      util::dsp::Filter * testFilter = new util::dsp::FilterBiquad(util::dsp::FilterBiquad::Type::LOW_PASS, fc, negativeQ);
+      static const util::Value testInput(1);
+      //act
+      util::dsp::Filter::Status status1 = testFilter->getStatus();
+      util::Value result = testFilter->filter(1, testInput);
+      util::dsp::Filter::Status status2 = testFilter->getStatus();
+      //assert
+      TEST_ASSERT(status1 == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(status2 == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result == util::Value(0));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestBiquad(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value fc(5, 1);
+      static const util::Value fcDivider(1000);
+      static const util::Value q(7071, 4);
+      util::dsp::Filter * testFilter = new util::dsp::FilterBiquad(util::dsp::FilterBiquad::Type::LOW_PASS, fc, q, fcDivider);
+      static const util::Value testInput(10);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(startTime + i * deltaTime, testInput);
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestLowPass(void) {
+      PERF_TEST_FUNC_START();
+      util::dsp::Filter * testFilter = new util::dsp::FilterLowPass(util::Value(5, 1), util::ValuePi, util::Value(1000));
+      static const util::Value testInput(10);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(startTime + i * deltaTime, testInput);
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_LowPassHighPassBandPassNotch_expectSameResultAsReference();
+      test_Cascade_expectSameResultAsReference();
+      test_ConstantInput_expectSteadyStateOutput();
+      test_SamplingRateTooLow_expectError();
+      test_IncorrectInitData_expectZero();
+      performanceTestBiquad();
+      performanceTestLowPass();
+    }
+};
+
+class TestDecimator {
+  public:
+    static const util::Timestamp startTime = 1000;
+    static const util::Timestamp deltaTime = 200;   //milliseconds
+    static void test_ConstantInput_expectOutputEveryFactorInputs(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t factor = 10;
+      static const size_t stages = 3;
+      util::dsp::Filter * testFilter = new util::dsp::FilterDecimator(factor, stages);
+      static const util::Value testInput(417, 1);
+      static const size_t testInputsNumber = 3 * factor + 1;
+      boolean outputCorrect = true;
+      boolean statusCorrect = true;
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        util::Value result = testFilter->filter(startTime + i * deltaTime, testInput);
+        util::dsp::Filter::Status expectedStatus = (i % factor) ?
+            util::dsp::Filter::Status::OUTPUT_NOT_READY :
+            util::dsp::Filter::Status::OK;
+        if (testFilter->getStatus() != expectedStatus) statusCorrect = false;
+        if (result != testInput) outputCorrect = false;
+      }
+      //assert
+      TEST_ASSERT(statusCorrect);
+      TEST_ASSERT(outputCorrect);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_SingleStage_expectAverageOfLastInputs(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t factor = 5;
+      util::dsp::Filter * testFilter = new util::dsp::FilterDecimator(factor);
+      static const size_t testInputsNumber = 21;
+      util::Value results[testInputsNumber];
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++)
+        results[i] = testFilter->filter(startTime + i * deltaTime, util::Value(static_cast<util::ValueBase>(i)));
+      //assert
+      TEST_ASSERT(results[0] == util::Value(0));
+      TEST_ASSERT(results[4] == util::Value(0));
+      TEST_ASSERT(results[5] == util::Value(3));        //(1+2+3+4+5)/5
+      TEST_ASSERT(results[9] == util::Value(3));
+      TEST_ASSERT(results[10] == util::Value(8));       //(6+7+8+9+10)/5
+      TEST_ASSERT(results[15] == util::Value(13));
+      TEST_ASSERT(results[20] == util::Value(18));
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_FrequencyAboveOutputNyquist_expectSuppressed(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t factor = 10;
+      static const size_t stages = 3;
+      util::dsp::Filter * testFilter = new util::dsp::FilterDecimator(factor, stages);
+      static const util::Value offset(50);
+      static const util::Value amplitude(20);
+      static const util::Value tolerance(1, 2);
+      static const size_t testInputsNumber = 10 * factor + 1;
+      boolean alternatingSuppressed = true;
+      boolean outputRateSuppressed = true;
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        //input rate Nyquist frequency, would alias to DC if every 10th input was taken
+        const util::Value alternating = (i % 2) ? (offset - amplitude) : (offset + amplitude);
+        util::Value result = testFilter->filter(startTime + i * deltaTime, alternating);
+        if (i >= stages * factor) {
+          const util::Value difference = result - offset;
+          if (difference > tolerance || difference < -tolerance) alternatingSuppressed = false;
+        }
+      }
+      delete(testFilter);
+      testFilter = new util::dsp::FilterDecimator(factor, stages);
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        //output rate frequency, would alias to DC if every 10th input was taken
+        const util::Value sawtooth = offset + amplitude * util::Value(static_cast<util::ValueBase>(i % factor)) / util::Value(factor);
+        util::Value result = testFilter->filter(startTime + i * deltaTime, sawtooth);
+        if (i >= stages * factor) {
+          const util::Value difference = result - (offset + util::Value(9));   //sawtooth average
+          if (difference > tolerance || difference < -tolerance) outputRateSuppressed = false;
+        }
+      }
+      //assert
+      TEST_ASSERT(alternatingSuppressed);
+      TEST_ASSERT(outputRateSuppressed);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_OverflowInput_expectOverflowUntilOutOfWindow(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t factor = 4;
+      static const size_t stages = 2;
+      util::dsp::Filter * testFilter = new util::dsp::FilterDecimator(factor, stages);
+      static const util::Value testInput(25);
+      const util::Value overflowMin = util::Value::fromRaw(util::ValueBaseMin);
+      static const size_t testInputsNumber = 3 * factor + 1;
+      util::Value results[testInputsNumber];
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++)
+        results[i] = testFilter->filter(startTime + i * deltaTime, (i == 1) ? overflowMin : testInput);
+      //assert
+      TEST_ASSERT(results[0] == testInput);
+      TEST_ASSERT(results[1] == testInput);
+      TEST_ASSERT(results[4].overflow() && (results[4] < util::Value(0)));
+      TEST_ASSERT(results[8] == testInput);   //inputs 2..8 only are within filter response
+      TEST_ASSERT(results[12] == testInput);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t largeFactor = 1000;
+      static const size_t largeStages = 4;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterDecimator(0);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterDecimator(largeFactor, largeStages);
+      static const util::Value testInput(1);
+      //act
+      util::Value result1 = testFilter1->filter(1, testInput);
+      util::Value result2 = testFilter2->filter(1, testInput);
+      //assert
+      TEST_ASSERT(testFilter1->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(testFilter2->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result1 == util::Value(0));
+      TEST_ASSERT(result2 == util::Value(0));
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestDecimator(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t factor = 10;
+      static const size_t stages = 3;
+      util::dsp::Filter * testFilter = new util::dsp::FilterDecimator(factor, stages);
+      static const util::Value testInput(10);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(startTime + i * deltaTime, testInput);
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_ConstantInput_expectOutputEveryFactorInputs();
+      test_SingleStage_expectAverageOfLastInputs();
+      test_FrequencyAboveOutputNyquist_expectSuppressed();
+      test_OverflowInput_expectOverflowUntilOutOfWindow();
+      test_IncorrectInitData_expectZero();
+      performanceTestDecimator();
+    }
+};
+
+class ReferenceKalman2 {
+  public:
+    ReferenceKalman2(double processNoise) : q(processNoise) {}
+    void predict(double dt) {
+      x += v * dt;
+      p00 += dt * (2 * p01 + dt * p11) + q * dt * dt * dt / 3;
+      p01 += dt * p11 + q * dt * dt / 2;
+      p11 += q * dt;
+    }
+    void update(double z, double r) {
+      if (!initialised) {
+        x = z; p00 = r; p11 = r;
+        initialised = true;
+        return;
+      }
+      const double s = p00 + r;
+      const double k0 = p00 / s;
+      const double k1 = p01 / s;
+      const double innovation = z - x;
+      x += k0 * innovation;
+      v += k1 * innovation;
+      p11 -= k1 * p01;
+      p01 -= k0 * p01;
+      p00 -= k0 * p00;
+    }
+    double x = 0, v = 0;
+  private:
+    double q;
+    double p00 = 0, p01 = 0, p11 = 0;
+    boolean initialised = false;
+};
+
+class TestKalman {
+  public:
+    static const util::Timestamp startTime = 1000;
+    static const util::Timestamp deltaTime = 500;   //milliseconds
+    static double toDouble(const util::Value &x) {
+      return (static_cast<double>(x.getRaw()) / 1024.0);
+    }
+    static util::Value toValue(double x) {
+      return (util::Value(static_cast<util::ValueBase>(x * 1000.0), 3));
+    }
+    static void test_TwoInputs_expectWeightedByMeasurementNoise(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value processNoise(1, 2);
+      static const util::Value measurementNoise[] = {util::Value(1), util::Value(3)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterKalman(processNoise, measurementNoise, 2, util::timestampPerSecond);
+      //act
+      util::Value result = testFilter->filter(startTime, util::Value(20), util::Value(22));
+      //assert
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(result == util::Value(205, 1)); //gain for second input is 1 / (1 + 3)
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_Scalar_expectSameResultAsReference(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value processNoiseValue = toValue(0.01);
+      const double processNoise = toDouble(processNoiseValue);
+      static const double measurementNoise1 = 0.25;
+      static const double measurementNoise2 = 1.0;
+      static const util::Value measurementNoise[] = {toValue(measurementNoise1), toValue(measurementNoise2)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterKalman(processNoiseValue, measurementNoise, 2, util::timestampPerSecond);
+      static const size_t testInputsNumber = 100;
+      static const double tolerance = 0.002; //2 least significant bits of Value
+      double estimate = 0, variance = 0;
+      boolean result = true;
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        const double temperature = 21.0 + 2.0 * sin(i * 0.03);
+        const util::Value value1 = toValue(temperature + 0.5 * sin(i * 2.1));
+        const util::Value value2 = toValue(temperature + 1.0 * sin(i * 1.7 + 1.0));
+        const double input1 = toDouble(value1);
+        const double input2 = toDouble(value2);
+        const util::Value output = testFilter->filter(startTime + i * deltaTime, value1, value2);
+        if (!i) {
+          estimate = input1;
+          variance = measurementNoise1;
+        } else {
+          variance += processNoise * deltaTime / 1000.0;
+          double gain = variance / (variance + measurementNoise1);
+          estimate += gain * (input1 - estimate);
+          variance -= gain * variance;
+        }
+        const double gain = variance / (variance + measurementNoise2);
+        estimate += gain * (input2 - estimate);
+        variance -= gain * variance;
+        if (fabs(toDouble(output) - estimate) > tolerance) result = false;
+      }
+      //assert
+      TEST_ASSERT(result);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_OverflowInput_expectIgnored(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value processNoise(1, 1);
+      static const util::Value measurementNoise[] = {util::Value(1), util::Value(1)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterKalman(processNoise, measurementNoise, 2, util::timestampPerSecond);
+      const util::Value overflowMax = util::Value::fromRaw(util::ValueBaseMax);
+      static const util::Value testInput(30);
+      //act
+      util::Value result1 = testFilter->filter(startTime, overflowMax, testInput);
+      util::Value result2 = testFilter->filter(startTime + deltaTime, testInput, overflowMax);
+      util::Value result3 = testFilter->filter(startTime + 2 * deltaTime, overflowMax, overflowMax);
+      //assert
+      TEST_ASSERT(result1 == testInput);
+      TEST_ASSERT(result2 == testInput);
+      TEST_ASSERT(result3 == testInput);
+      TEST_ASSERT(testFilter->getStatus() == util::dsp::Filter::Status::OK);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_TwoState_expectSameResultAsReference(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value processNoiseValue = toValue(0.001);
+      const double processNoise = toDouble(processNoiseValue);
+      static const double measurementNoise1 = 0.25;
+      static const double measurementNoise2 = 1.0;
+      static const util::Value measurementNoise[] = {toValue(measurementNoise1), toValue(measurementNoise2)};
+      util::dsp::FilterKalman2 * testFilter = new util::dsp::FilterKalman2(processNoiseValue, measurementNoise, 2, util::timestampPerSecond);
+      ReferenceKalman2 reference(processNoise);
+      static const size_t testInputsNumber = 200;
+      static const double tolerance = 0.005;
+      static const double rate = 0.05; //per second
+      boolean result = true;
+      //act
+      for (size_t i = 0; i < testInputsNumber; i++) {
+        const double temperature = 15.0 + rate * i * deltaTime / 1000.0;
+        const util::Value value1 = toValue(temperature + 0.5 * sin(i * 2.1));
+        const util::Value value2 = toValue(temperature + 1.0 * sin(i * 1.7 + 1.0));
+        const double input1 = toDouble(value1);
+        const double input2 = toDouble(value2);
+        const util::Value output = testFilter->filter(startTime + i * deltaTime, value1, value2);
+        if (i) reference.predict(deltaTime / 1000.0);
+        reference.update(input1, measurementNoise1);
+        reference.update(input2, measurementNoise2);
+        if (fabs(toDouble(output) - reference.x) > tolerance) result = false;
+      }
+      const double estimatedRate = toDouble(testFilter->getRate());
+      //assert
+      TEST_ASSERT(result);
+      TEST_ASSERT(fabs(estimatedRate - reference.v) < tolerance);
+      TEST_ASSERT(fabs(estimatedRate - rate) < 0.02);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+    static void test_IncorrectInitData_expectZero(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value processNoise(1);
+      static const util::Value negativeNoise(-1);
+      static const util::Value measurementNoise(1);
+      static const util::Value zeroTimeDivider(0);
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterKalman(processNoise, negativeNoise);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterKalman2(processNoise, measurementNoise, zeroTimeDivider);
+      static const util::Value testInput(1);
+      //act
+      util::Value result1 = testFilter1->filter(1, testInput);
+      util::Value result2 = testFilter2->filter(1, testInput);
+      //assert
+      TEST_ASSERT(testFilter1->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(testFilter2->getStatus() == util::dsp::Filter::Status::ERROR_INIT_DATA_INCORRECT);
+      TEST_ASSERT(result1 == util::Value(0));
+      TEST_ASSERT(result2 == util::Value(0));
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+  public:
+    static void performanceTestKalman(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value measurementNoise[] = {util::Value(1), util::Value(3)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterKalman(util::Value(1, 2), measurementNoise, 2, util::timestampPerSecond);
+      static const util::Value testInput1(20);
+      static const util::Value testInput2(22);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(startTime + i * deltaTime, testInput1, testInput2);
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTestKalman2(void) {
+      PERF_TEST_FUNC_START();
+      static const util::Value measurementNoise[] = {util::Value(1), util::Value(3)};
+      util::dsp::Filter * testFilter = new util::dsp::FilterKalman2(util::Value(1, 3), measurementNoise, 2, util::timestampPerSecond);
+      static const util::Value testInput1(20);
+      static const util::Value testInput2(22);
+      static const uint32_t numberOfOperations = 1000;
+      PERF_TEST_START();
+      for (uint32_t i = 0; i < numberOfOperations; i++)
+        testFilter->filter(startTime + i * deltaTime, testInput1, testInput2);
+      PERF_TEST_END();
+      delete(testFilter);
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      test_TwoInputs_expectWeightedByMeasurementNoise();
+      test_Scalar_expectSameResultAsReference();
+      test_OverflowInput_expectIgnored();
+      test_TwoState_expectSameResultAsReference();
+      test_IncorrectInitData_expectZero();
+      performanceTestKalman();
+      performanceTestKalman2();
+    }
+};
+
+class TestFilterState {
+  public:
+    static void test_MovingAverage_expectWarmRestore(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints = 4;
+      static const size_t bufferSize = 32;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterMovingAverage(avgPoints);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterMovingAverage(avgPoints);
+      uint8_t buffer[bufferSize];
+      testFilter1->filter(1, util::Value(1));
+      testFilter1->filter(2, util::Value(2));
+      testFilter1->filter(3, util::Value(6));
+      //act
+      size_t stateSize = testFilter1->saveState(buffer, sizeof(buffer));
+      boolean restoreResult = testFilter2->restoreState(buffer, stateSize, 100);
+      util::dsp::Filter::Status restoredStatus = testFilter2->getStatus();
+      util::Value output1 = testFilter1->filter(4, util::Value(7));
+      util::Value output2 = testFilter2->filter(101, util::Value(7));
+      //assert
+      TEST_ASSERT(stateSize);
+      TEST_ASSERT(stateSize <= testFilter1->getStateSize());
+      TEST_ASSERT(restoreResult);
+      TEST_ASSERT(restoredStatus == util::dsp::Filter::Status::OK);
+      TEST_ASSERT(output2 == util::Value(4));
+      TEST_ASSERT(output2 == output1);
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+    static void test_LowPass_expectWarmRestore(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(1);
+      static const util::Value timestampFactor = util::timestampPerSecond;
+      static const util::Timestamp deltaTime = 100;
+      static const util::Timestamp restoreTime = 5;
+      static const size_t bufferSize = 32;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterLowPass(fc, util::ValuePi, timestampFactor);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterLowPass(fc, util::ValuePi, timestampFactor);
+      uint8_t buffer[bufferSize];
+      testFilter1->filter(1, util::Value(10));
+      testFilter1->filter(1 + deltaTime, util::Value(20));
+      //act
+      size_t stateSize = testFilter1->saveState(buffer, sizeof(buffer));
+      boolean restoreResult = testFilter2->restoreState(buffer, stateSize, restoreTime);
+      util::Value output1 = testFilter1->filter(1 + 2 * deltaTime, util::Value(20));
+      util::Value output2 = testFilter2->filter(restoreTime + deltaTime, util::Value(20));
+      //assert
+      TEST_ASSERT(stateSize == testFilter1->getStateSize());
+      TEST_ASSERT(restoreResult);
+      TEST_ASSERT(output2 > util::Value(10));
+      TEST_ASSERT(output2 < util::Value(20));
+      TEST_ASSERT(output2 == output1);
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      TEST_FUNC_END();
+    }
+    static void test_LowPassTable_expectWarmRestore(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value fc(1);
+      static const util::Value timestampFactor = util::timestampPerSecond;
+      static const util::Timestamp deltaTime = 100;
+      static const util::Timestamp restoreTime = 5;
+      static const size_t bufferSize = 32;
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterLowPassTable(fc, util::ValuePi, timestampFactor, deltaTime);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterLowPassTable(fc, util::ValuePi, timestampFactor, deltaTime);
+      util::dsp::Filter * testFilter3 = new util::dsp::FilterLowPassTable(fc, util::ValuePi, timestampFactor, deltaTime);
+      uint8_t buffer[bufferSize];
+      const size_t coldStateSize = testFilter1->saveState(buffer, sizeof(buffer));
+      testFilter1->filter(1, util::Value(10));
+      testFilter1->filter(1 + deltaTime, util::Value(20));
+      //act
+      size_t stateSize = testFilter1->saveState(buffer, sizeof(buffer));
+      boolean restoreResult = testFilter2->restoreState(buffer, stateSize, restoreTime);
+      util::Value output1 = testFilter1->filter(1 + 2 * deltaTime, util::Value(20));
+      util::Value output2 = testFilter2->filter(restoreTime + deltaTime, util::Value(20));
+      boolean restoreResultTruncated = testFilter3->restoreState(buffer, stateSize - 1, restoreTime);
+      //assert
+      TEST_ASSERT(!coldStateSize);
+      TEST_ASSERT(stateSize == testFilter1->getStateSize());
+      TEST_ASSERT(restoreResult);
+      TEST_ASSERT(output2 > util::Value(10));
+      TEST_ASSERT(output2 < util::Value(20));
+      TEST_ASSERT(output2 == output1);
+      TEST_ASSERT(!restoreResultTruncated);
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      delete(testFilter3);
+      TEST_FUNC_END();
+    }
+    static void test_IncompatibleState_expectNotRestored(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t avgPoints1 = 4;
+      static const size_t avgPoints2 = 2;
+      static const size_t bufferSize = 32;
+      static const util::Value fc(1);
+      util::dsp::Filter * testFilter1 = new util::dsp::FilterMovingAverage(avgPoints1);
+      util::dsp::Filter * testFilter2 = new util::dsp::FilterMovingAverage(avgPoints2);
+      util::dsp::Filter * testFilter3 = new util::dsp::FilterLowPass(fc, util::ValuePi);
+      uint8_t buffer[bufferSize];
+      for (size_t i = 0; i < avgPoints1; i++)
+        testFilter1->filter(i + 1, util::Value(i + 1));
+      testFilter2->filter(1, util::Value(1));
+      //act
+      size_t stateSize = testFilter1->saveState(buffer, sizeof(buffer));
+      boolean restoreResult1 = testFilter2->restoreState(buffer, stateSize, 100);
+      boolean restoreResult2 = testFilter3->restoreState(buffer, stateSize, 100);
+      boolean restoreResult3 = testFilter1->restoreState(buffer, stateSize - 1, 100);
+      buffer[0]++;
+      boolean restoreResult4 = testFilter1->restoreState(buffer, stateSize, 100);
+      //assert
+      TEST_ASSERT(stateSize);
+      TEST_ASSERT(!restoreResult1);
+      TEST_ASSERT(!restoreResult2);
+      TEST_ASSERT(!restoreResult3);
+      TEST_ASSERT(!restoreResult4);
+      TEST_ASSERT(testFilter2->filter(2, util::Value(3)) == util::Value(2));
+      TEST_ASSERT(testFilter3->filter(1, util::Value(5)) == util::Value(5));
+      //cleanup
+      delete(testFilter1);
+      delete(testFilter2);
+      delete(testFilter3);
+      TEST_FUNC_END();
+    }
+    static void test_StateNotSupported_expectZeroSize(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t numValues = 4;
+      static const size_t bufferSize = 32;
+      util::dsp::Filter * testFilter = new util::dsp::FilterMovingMedian(numValues);
+      uint8_t buffer[bufferSize] = {};
+      testFilter->filter(1, util::Value(1));
+      //act
+      size_t stateSizeMax = testFilter->getStateSize();
+      size_t stateSize = testFilter->saveState(buffer, sizeof(buffer));
+      boolean restoreResult = testFilter->restoreState(buffer, sizeof(buffer), 100);
+      //assert
+      TEST_ASSERT(!stateSizeMax);
+      TEST_ASSERT(!stateSize);
+      TEST_ASSERT(!restoreResult);
+      //cleanup
+      delete(testFilter);
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      test_MovingAverage_expectWarmRestore();
+      test_LowPass_expectWarmRestore();
+      test_LowPassTable_expectWarmRestore();
+      test_IncompatibleState_expectNotRestored();
+      test_StateNotSupported_expectZeroSize();
+    }
+};
+
 class TestAnalogChannel {
   public:
     static void runTests(void) {
@@ -884,10 +2758,22 @@ void setup() {
   TEST_BEGIN();
   TestAbstractFilter::runTests();
   TestMovingAverage::runTests();
+  TestMovingMedian::runTests();
+  TestHampel::runTests();
+  TestStatistics::runTests();
   TestLowPass::runTests();
+  TestLowPassTable::runTests();
   TestLinearScale::runTests();
   TestSquareScale::runTests();
   TestSplineScale::runTests();
+  TestPiecewiseLinearScale::runTests();
+  TestNaturalSplineScale::runTests();
+  TestExpScale::runTests();
+  TestTableScale::runTests();
+  TestBiquad::runTests();
+  TestDecimator::runTests();
+  TestKalman::runTests();
+  TestFilterState::runTests();
   TestAnalogChannel::runTests();
   TEST_END();
 }
@@ -643,6 +643,456 @@ class TestTemperature {
     }
 };
 
+class TestConcentration {
+  public:
+    static void conversion_convertFromPpmToPpbAndBack_expectCorrectData(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Concentration testConcentration(1, 2, util::Value(415), util::quantity::Concentration::Unit::PPM);
+      //act
+      boolean conversionResult1 = testConcentration.convertToUnit(util::quantity::Concentration::Unit::PPB);
+      util::quantity::Quantity::value_t result1 = testConcentration.getValue();
+      util::quantity::Quantity::text_t resultUnit1 = testConcentration.getUnitText();
+      boolean conversionResult2 = testConcentration.convertToUnit(util::quantity::Concentration::Unit::PPM);
+      util::quantity::Quantity::value_t result2 = testConcentration.getValue();
+      util::quantity::Quantity::text_t resultUnit2 = testConcentration.getUnitText();
+      //assert
+      TEST_ASSERT(conversionResult1);
+      TEST_ASSERT(result1 == util::Value(415000));
+      TEST_ASSERT(resultUnit1 == util::quantity::Concentration::getUnitTextByUnit(util::quantity::Concentration::Unit::PPB));
+      TEST_ASSERT(conversionResult2);
+      TEST_ASSERT(result2 == util::Value(415));
+      TEST_ASSERT(resultUnit2 == util::quantity::Concentration::getUnitTextByUnit(util::quantity::Concentration::Unit::PPM));
+      TEST_FUNC_END();
+    }
+    static void conversion_convertToMgPerCubicMeter_expectCorrectData(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::Value molarMassCO2(4401, 2);
+      const util::Value tolerance(5, 2); //0.05, mostly due to molar mass quantisation
+      util::quantity::Concentration testPpm(1, 2, util::Value(1000), util::quantity::Concentration::Unit::PPM, molarMassCO2, 0, true, util::Value(0), util::Value(2000));
+      util::quantity::Concentration testPpb(1, 2, util::Value(400000), util::quantity::Concentration::Unit::PPB, molarMassCO2);
+      util::quantity::Concentration testMg(1, 2, util::Value(720), util::quantity::Concentration::Unit::MG_PER_CUBIC_METER, molarMassCO2);
+      //act
+      boolean conversionResult1 = testPpm.convertToUnit(util::quantity::Concentration::Unit::MG_PER_CUBIC_METER);
+      boolean conversionResult2 = testPpb.convertToUnit(util::quantity::Concentration::Unit::MG_PER_CUBIC_METER);
+      boolean conversionResult3 = testMg.convertToUnit(util::quantity::Concentration::Unit::PPM);
+      //assert
+      TEST_ASSERT(conversionResult1);
+      TEST_ASSERT(absDiff(testPpm.getValue(), util::Value(1800)) < tolerance);
+      TEST_ASSERT(absDiff(testPpm.getMaxRange(), util::Value(3600)) < tolerance);
+      TEST_ASSERT(testPpm.getUnitText() == util::quantity::Concentration::getUnitTextByUnit(util::quantity::Concentration::Unit::MG_PER_CUBIC_METER));
+      TEST_ASSERT(conversionResult2);
+      TEST_ASSERT(absDiff(testPpb.getValue(), util::Value(720)) < tolerance);
+      TEST_ASSERT(conversionResult3);
+      TEST_ASSERT(absDiff(testMg.getValue(), util::Value(400)) < tolerance);
+      TEST_FUNC_END();
+    }
+    static void conversion_molarMassNotSet_expectConversionFailed(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Concentration testConcentration(1, 2, util::Value(1000), util::quantity::Concentration::Unit::PPM);
+      //act
+      boolean conversionResult = testConcentration.convertToUnit(util::quantity::Concentration::Unit::MG_PER_CUBIC_METER);
+      //assert
+      TEST_ASSERT(!conversionResult);
+      TEST_ASSERT(testConcentration.getValue() == util::Value(1000));
+      TEST_ASSERT(testConcentration.getUnit() == static_cast<util::quantity::Quantity::unit_t>(util::quantity::Concentration::Unit::PPM));
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      conversion_convertFromPpmToPpbAndBack_expectCorrectData();
+      conversion_convertToMgPerCubicMeter_expectCorrectData();
+      conversion_molarMassNotSet_expectConversionFailed();
+    }
+};
+
+class TestHumidity {
+  public:
+    static void conversion_convertFromRelativeToAbsoluteAndBack_expectCorrectData(void) {
+      TEST_FUNC_START();
+      //arrange
+      const util::Value tolerance(1, 2); //0.01
+      util::quantity::Humidity testHumidity(1, 2, util::Value(50), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      util::quantity::Humidity testHumidityFrost(1, 2, util::Value(80), util::quantity::Humidity::Unit::RELATIVE, util::Value(-10));
+      //act
+      boolean conversionResult1 = testHumidity.convertToUnit(util::quantity::Humidity::Unit::ABSOLUTE);
+      util::quantity::Quantity::value_t result1 = testHumidity.getValue();
+      util::quantity::Quantity::text_t resultUnit1 = testHumidity.getUnitText();
+      boolean conversionResult2 = testHumidity.convertToUnit(util::quantity::Humidity::Unit::RELATIVE);
+      util::quantity::Quantity::value_t result2 = testHumidity.getValue();
+      boolean conversionResult3 = testHumidityFrost.convertToUnit(util::quantity::Humidity::Unit::ABSOLUTE);
+      util::quantity::Quantity::value_t result3 = testHumidityFrost.getValue();
+      util::quantity::Humidity testAbsoluteHumidity(1, 2, result1, util::quantity::Humidity::Unit::ABSOLUTE, util::Value(20));
+      boolean conversionResult4 = testAbsoluteHumidity.convertToUnit(util::quantity::Humidity::Unit::RELATIVE);
+      util::quantity::Quantity::value_t result4 = testAbsoluteHumidity.getValue();
+      //assert
+      TEST_ASSERT(conversionResult1);
+      TEST_ASSERT(absDiff(result1, util::Value(8623, 3)) < tolerance);
+      TEST_ASSERT(resultUnit1 == util::quantity::Humidity::getUnitTextByUnit(util::quantity::Humidity::Unit::ABSOLUTE));
+      TEST_ASSERT(conversionResult2);
+      TEST_ASSERT(result2 == util::Value(50));
+      TEST_ASSERT(conversionResult3);
+      TEST_ASSERT(absDiff(result3, util::Value(1891, 3)) < tolerance);
+      TEST_ASSERT(conversionResult4);
+      TEST_ASSERT(absDiff(result4, util::Value(50)) < tolerance);
+      TEST_FUNC_END();
+    }
+    static void conversion_temperatureOutOfRange_expectConversionFailed(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Humidity testHumidity(1, 2, util::Value(50), util::quantity::Humidity::Unit::RELATIVE, util::Value(100));
+      //act
+      boolean conversionResult = testHumidity.convertToUnit(util::quantity::Humidity::Unit::ABSOLUTE);
+      util::quantity::Quantity::value_t dewPoint = testHumidity.getDewPoint();
+      //assert
+      TEST_ASSERT(!conversionResult);
+      TEST_ASSERT(testHumidity.getValue() == util::Value(50));
+      TEST_ASSERT(dewPoint.overflow());
+      TEST_FUNC_END();
+    }
+    static void getDewPoint_expectCorrectValues(void) {
+      TEST_FUNC_START();
+      //arrange
+      const util::Value tolerance(2, 2); //0.02
+      util::quantity::Humidity testHumidity1(1, 2, util::Value(50), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      util::quantity::Humidity testHumidity2(1, 2, util::Value(100), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      util::quantity::Humidity testHumidity3(1, 2, util::Value(80), util::quantity::Humidity::Unit::RELATIVE, util::Value(-10));
+      util::quantity::Humidity testHumidity4(1, 2, util::Value(8623, 3), util::quantity::Humidity::Unit::ABSOLUTE, util::Value(20));
+      util::quantity::Humidity testHumidityInvalid(1, 2, util::Value(50), util::quantity::Humidity::Unit::RELATIVE, util::Value(20), 0, false);
+      util::quantity::Humidity testHumidityZero(1, 2, util::Value(0), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      //act
+      util::quantity::Quantity::value_t dewPoint1 = testHumidity1.getDewPoint();
+      util::quantity::Quantity::value_t dewPoint2 = testHumidity2.getDewPoint();
+      util::quantity::Quantity::value_t dewPoint3 = testHumidity3.getDewPoint();
+      util::quantity::Quantity::value_t dewPoint4 = testHumidity4.getDewPoint();
+      util::quantity::Quantity::value_t dewPointInvalid = testHumidityInvalid.getDewPoint();
+      util::quantity::Quantity::value_t dewPointZero = testHumidityZero.getDewPoint();
+      //assert
+      TEST_ASSERT(absDiff(dewPoint1, util::Value(9255, 3)) < tolerance);
+      TEST_ASSERT(absDiff(dewPoint2, util::Value(20)) < tolerance);
+      TEST_ASSERT(absDiff(dewPoint3, util::Value(-12797, 3)) < tolerance);
+      TEST_ASSERT(absDiff(dewPoint4, util::Value(9255, 3)) < tolerance);
+      TEST_ASSERT(dewPointInvalid.overflow());
+      TEST_ASSERT(dewPointZero.overflow());
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      conversion_convertFromRelativeToAbsoluteAndBack_expectCorrectData();
+      conversion_temperatureOutOfRange_expectConversionFailed();
+      getDewPoint_expectCorrectValues();
+    }
+};
+
+class TestPressure {
+  public:
+    static void conversion_convertFromPascal_expectCorrectData(void) {
+      TEST_FUNC_START();
+      //arrange
+      const util::Value tolerance(2, 3); //0.002
+      util::quantity::Pressure testPressure(1, 2, util::Value(101325), util::quantity::Pressure::Unit::PASCAL);
+      //act
+      boolean conversionResult1 = testPressure.convertToUnit(util::quantity::Pressure::Unit::HECTOPASCAL);
+      util::quantity::Quantity::value_t result1 = testPressure.getValue();
+      util::quantity::Quantity::text_t resultUnit1 = testPressure.getUnitText();
+      boolean conversionResult2 = testPressure.convertToUnit(util::quantity::Pressure::Unit::KILOPASCAL);
+      util::quantity::Quantity::value_t result2 = testPressure.getValue();
+      boolean conversionResult3 = testPressure.convertToUnit(util::quantity::Pressure::Unit::MM_HG);
+      util::quantity::Quantity::value_t result3 = testPressure.getValue();
+      boolean conversionResult4 = testPressure.convertToUnit(util::quantity::Pressure::Unit::PASCAL);
+      util::quantity::Quantity::value_t result4 = testPressure.getValue();
+      //assert
+      TEST_ASSERT(conversionResult1);
+      TEST_ASSERT(result1 == util::Value(101325, 2));
+      TEST_ASSERT(resultUnit1 == util::quantity::Pressure::getUnitTextByUnit(util::quantity::Pressure::Unit::HECTOPASCAL));
+      TEST_ASSERT(conversionResult2);
+      TEST_ASSERT(absDiff(result2, util::Value(101325, 3)) < tolerance);
+      TEST_ASSERT(conversionResult3);
+      TEST_ASSERT(result3 == util::Value(760));
+      TEST_ASSERT(conversionResult4);
+      TEST_ASSERT(result4 == util::Value(101325));
+      TEST_FUNC_END();
+    }
+    static void conversion_convertFromMmHg_expectCorrectData(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Pressure testPressure(1, 2, util::Value(750), util::quantity::Pressure::Unit::MM_HG, 0, true, util::Value(700), util::Value(800));
+      util::quantity::UnitConversion conversion;
+      boolean getConversionResult = util::quantity::Pressure::getConversion(util::quantity::Pressure::Unit::MM_HG,
+                                    util::quantity::Pressure::Unit::HECTOPASCAL,
+                                    conversion);
+      //act
+      boolean conversionResult = testPressure.convertToUnit(util::quantity::Pressure::Unit::HECTOPASCAL);
+      //assert
+      TEST_ASSERT(getConversionResult);
+      TEST_ASSERT(conversionResult);
+      TEST_ASSERT(testPressure.getValue() == conversion.apply(util::Value(750)));
+      TEST_ASSERT(testPressure.getMinRange() == conversion.apply(util::Value(700)));
+      TEST_ASSERT(testPressure.getMaxRange() == conversion.apply(util::Value(800)));
+      TEST_ASSERT(absDiff(testPressure.getValue(), util::Value(999918, 3)) < util::Value(1, 3));
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      conversion_convertFromPascal_expectCorrectData();
+      conversion_convertFromMmHg_expectCorrectData();
+    }
+};
+
+class TestUnitConversion {
+  public:
+    static void apply_temperatureConversion_expectRoundedResults(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::UnitConversion celsiusToFahrenheit;
+      util::quantity::UnitConversion fahrenheitToCelsius;
+      boolean conversionResult1 = util::quantity::Temperature::getConversion(
+                                    util::quantity::Temperature::Unit::CELSIUS,
+                                    util::quantity::Temperature::Unit::FAHRENHEIT,
+                                    celsiusToFahrenheit);
+      boolean conversionResult2 = util::quantity::Temperature::getConversion(
+                                    util::quantity::Temperature::Unit::FAHRENHEIT,
+                                    util::quantity::Temperature::Unit::CELSIUS,
+                                    fahrenheitToCelsius);
+      //act
+      util::Value result1 = celsiusToFahrenheit.apply(util::Value(-40));
+      util::Value result2 = celsiusToFahrenheit.apply(util::Value(0));
+      util::Value result3 = celsiusToFahrenheit.apply(util::Value(375, 1));
+      util::Value result4 = fahrenheitToCelsius.apply(util::Value(-40));
+      util::Value result5 = fahrenheitToCelsius.apply(util::Value(995, 1));
+      util::Value result6 = fahrenheitToCelsius.apply(util::Value(0));
+      //assert
+      TEST_ASSERT(conversionResult1);
+      TEST_ASSERT(conversionResult2);
+      TEST_ASSERT(result1 == util::Value(-40));
+      TEST_ASSERT(result2 == util::Value(32));
+      TEST_ASSERT(result3 == util::Value(995, 1));
+      TEST_ASSERT(result4 == util::Value(-40));
+      TEST_ASSERT(result5 == util::Value(375, 1));
+      TEST_ASSERT(absDiff(result6, util::Value(-17778, 3)) < util::Value(1, 3));
+      TEST_FUNC_END();
+    }
+    static void apply_array_expectSameAsSingleValuesOverflowPreserved(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t valuesNumber = 7;
+      const util::ValueBase input[valuesNumber] = {
+        util::Value(-50).getRaw(),
+        util::Value(0).getRaw(),
+        util::Value(2125, 2).getRaw(),
+        util::Value(100).getRaw(),
+        util::ValueBaseMin,
+        util::ValueBaseMax,
+        util::Value(2000000).getRaw()
+      };
+      util::ValueBase output[valuesNumber] = {};
+      util::quantity::UnitConversion conversion;
+      util::quantity::Temperature::getConversion(
+        util::quantity::Temperature::Unit::CELSIUS,
+        util::quantity::Temperature::Unit::FAHRENHEIT,
+        conversion);
+      //act
+      conversion.apply(input, output, valuesNumber);
+      //assert
+      for (size_t i = 0; i < valuesNumber; i++)
+        TEST_ASSERT(output[i] == conversion.apply(util::Value::fromRaw(input[i])).getRaw());
+      TEST_ASSERT(output[3] == util::Value(212).getRaw());
+      TEST_ASSERT(output[4] == util::ValueBaseMin);
+      TEST_ASSERT(output[5] == util::ValueBaseMax);
+      TEST_ASSERT(output[6] == util::ValueBaseMax);
+      TEST_FUNC_END();
+    }
+    static void find_sameOrUndefinedUnits_expectIdentityOrFalse(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const util::quantity::UnitConversionEntry table[] = {
+        {0, 1, util::quantity::UnitConversion(2, 1, 3)}
+      };
+      static const size_t tableSize = sizeof(table) / sizeof(table[0]);
+      util::quantity::UnitConversion conversion1, conversion2, conversion3;
+      //act
+      boolean result1 = util::quantity::UnitConversion::find(table, tableSize, 0, 1, conversion1);
+      boolean result2 = util::quantity::UnitConversion::find(table, tableSize, 1, 1, conversion2);
+      boolean result3 = util::quantity::UnitConversion::find(table, tableSize, 1, 0, conversion3);
+      //assert
+      TEST_ASSERT(result1);
+      TEST_ASSERT(conversion1.apply(util::Value(5)) == util::Value(13));
+      TEST_ASSERT(result2);
+      TEST_ASSERT(conversion2.apply(util::Value(5)) == util::Value(5));
+      TEST_ASSERT(!result3);
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+    static void performanceTest_convertToUnit(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t valuesNumber = 100;
+      util::quantity::Temperature temperature(0, 0, util::Value(25), util::quantity::Temperature::Unit::CELSIUS);
+      PERF_TEST_START();
+      for (size_t i = 0; i < valuesNumber; i++)
+        temperature.convertToUnit(util::quantity::Temperature::Unit::FAHRENHEIT);
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void performanceTest_applyArray(void) {
+      PERF_TEST_FUNC_START();
+      static const size_t valuesNumber = 100;
+      static util::ValueBase values[valuesNumber];
+      for (size_t i = 0; i < valuesNumber; i++)
+        values[i] = util::Value(static_cast<util::ValueBase>(i)).getRaw();
+      util::quantity::UnitConversion conversion;
+      util::quantity::Temperature::getConversion(
+        util::quantity::Temperature::Unit::CELSIUS,
+        util::quantity::Temperature::Unit::FAHRENHEIT,
+        conversion);
+      PERF_TEST_START();
+      conversion.apply(values, values, valuesNumber);
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      apply_temperatureConversion_expectRoundedResults();
+      apply_array_expectSameAsSingleValuesOverflowPreserved();
+      find_sameOrUndefinedUnits_expectIdentityOrFalse();
+      performanceTest_convertToUnit();
+      performanceTest_applyArray();
+    }
+};
+
+/// Records concrete type passed by QuantityVisitor
+class TestTypeRecorder {
+  public:
+    enum class Handled {
+      NONE,
+      GENERIC,
+      TEMPERATURE,
+      HUMIDITY,
+      OTHER
+    };
+  public:
+    void operator()(util::quantity::Generic &) {
+      handled = Handled::GENERIC;
+    }
+    void operator()(util::quantity::Temperature &) {
+      handled = Handled::TEMPERATURE;
+    }
+    void operator()(util::quantity::Humidity &) {
+      handled = Handled::HUMIDITY;
+    }
+    template <class T>
+    void operator()(T &) {
+      handled = Handled::OTHER;
+    }
+  public:
+    Handled handled = Handled::NONE;
+};
+
+/// Converts temperatures to Fahrenheit, returns false for other quantities
+class TestToFahrenheit {
+  public:
+    boolean operator()(util::quantity::Temperature & temperature) const {
+      return (temperature.convertToUnit(util::quantity::Temperature::Unit::FAHRENHEIT));
+    }
+    template <class T>
+    boolean operator()(T &) const {
+      return (false);
+    }
+};
+
+/// Reads value of a const quantity, ignores humidity
+class TestConstValueReader {
+  public:
+    util::quantity::Quantity::value_t operator()(const util::quantity::Humidity &) const {
+      return (util::quantity::Quantity::value_t());
+    }
+    template <class T>
+    util::quantity::Quantity::value_t operator()(const T & quantity) const {
+      return (quantity.getValue());
+    }
+};
+
+class TestQuantityVisitor {
+  public:
+    static void visit_heterogeneousQuantities_expectConcreteTypesHandled(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Generic generic(1, 2, util::Value(3), "unit");
+      util::quantity::Temperature temperature(1, 2, util::Value(3), util::quantity::Temperature::Unit::CELSIUS);
+      util::quantity::Humidity humidity(1, 2, util::Value(3), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      util::quantity::Pressure pressure(1, 2, util::Value(3), util::quantity::Pressure::Unit::PASCAL);
+      util::quantity::Quantity * quantities[] = { &generic, &temperature, &humidity, &pressure };
+      static const size_t quantitiesNumber = sizeof(quantities) / sizeof(quantities[0]);
+      const TestTypeRecorder::Handled reference[quantitiesNumber] = {
+        TestTypeRecorder::Handled::GENERIC,
+        TestTypeRecorder::Handled::TEMPERATURE,
+        TestTypeRecorder::Handled::HUMIDITY,
+        TestTypeRecorder::Handled::OTHER
+      };
+      //act
+      TestTypeRecorder::Handled result[quantitiesNumber];
+      for (size_t i = 0; i < quantitiesNumber; i++) {
+        TestTypeRecorder recorder;
+        util::quantity::AllQuantitiesVisitor::visit(*quantities[i], recorder);
+        result[i] = recorder.handled;
+      }
+      //assert
+      for (size_t i = 0; i < quantitiesNumber; i++)
+        TEST_ASSERT(result[i] == reference[i]);
+      TEST_FUNC_END();
+    }
+    static void visit_typeNotInList_expectGenericFallback(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Temperature temperature(1, 2, util::Value(3), util::quantity::Temperature::Unit::CELSIUS);
+      util::quantity::Humidity humidity(1, 2, util::Value(3), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      util::quantity::Quantity quantity(temperature);
+      TestTypeRecorder recorder1, recorder2, recorder3;
+      //act
+      util::quantity::QuantityVisitor<util::quantity::Temperature>::visit(humidity, recorder1);
+      util::quantity::QuantityVisitor<util::quantity::Temperature>::visit(quantity, recorder2);
+      util::quantity::QuantityVisitor<>::visit(temperature, recorder3);
+      //assert
+      TEST_ASSERT(recorder1.handled == TestTypeRecorder::Handled::GENERIC);
+      TEST_ASSERT(recorder2.handled == TestTypeRecorder::Handled::TEMPERATURE);
+      TEST_ASSERT(recorder3.handled == TestTypeRecorder::Handled::GENERIC);
+      TEST_FUNC_END();
+    }
+    static void visit_handlerReturnsValue_expectValueReturned(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::quantity::Temperature temperature(1, 2, util::Value(100), util::quantity::Temperature::Unit::CELSIUS);
+      util::quantity::Pressure pressure(1, 2, util::Value(3), util::quantity::Pressure::Unit::PASCAL);
+      const util::quantity::Humidity humidity(1, 2, util::Value(50), util::quantity::Humidity::Unit::RELATIVE, util::Value(20));
+      util::quantity::Quantity * temperatureRef = &temperature;
+      util::quantity::Quantity * pressureRef = &pressure;
+      const util::quantity::Quantity * humidityRef = &humidity;
+      //act
+      boolean temperatureResult = util::quantity::AllQuantitiesVisitor::visit(*temperatureRef, TestToFahrenheit());
+      boolean pressureResult = util::quantity::AllQuantitiesVisitor::visit(*pressureRef, TestToFahrenheit());
+      util::quantity::Quantity::value_t temperatureValue = util::quantity::AllQuantitiesVisitor::visit(
+            static_cast<const util::quantity::Quantity &>(temperature), TestConstValueReader());
+      util::quantity::Quantity::value_t humidityValue = util::quantity::AllQuantitiesVisitor::visit(*humidityRef, TestConstValueReader());
+      //assert
+      TEST_ASSERT(temperatureResult);
+      TEST_ASSERT(temperature.getValue() == util::Value(212));
+      TEST_ASSERT(!pressureResult);
+      TEST_ASSERT(pressure.getValue() == util::Value(3));
+      TEST_ASSERT(temperatureValue == util::Value(212));
+      TEST_ASSERT(humidityValue == util::Value(0));
+      TEST_FUNC_END();
+    }
+  public:
+    static void runTests(void) {
+      visit_heterogeneousQuantities_expectConcreteTypesHandled();
+      visit_typeNotInList_expectGenericFallback();
+      visit_handlerReturnsValue_expectValueReturned();
+    }
+};
+
 template <typename T>
 class Matrix {
   public:
@@ -746,7 +1196,7 @@ class TestQuantityIntrospectionReflection {
     static void testClassTypeMatch(void) {
       TEST_FUNC_START();
       //arrange
-      static const size_t numClasses = 3;
+      static const size_t numClasses = 6;
       Matrix<boolean> referenceClassMatchMatrix(numClasses, numClasses);
       for (size_t i = 0; i < numClasses; i++)
         for (size_t j = 0; j < numClasses; j++)
@@ -755,7 +1205,10 @@ class TestQuantityIntrospectionReflection {
       const TestIntrospectionClassMatchMatrix<util::quantity::Quantity,
             util::quantity::Generic,
             util::quantity::Dimensionless,
-            util::quantity::Temperature> testClassMatchMatrix;
+            util::quantity::Temperature,
+            util::quantity::Concentration,
+            util::quantity::Humidity,
+            util::quantity::Pressure> testClassMatchMatrix;
       //assert
       TEST_ASSERT(testClassMatchMatrix == referenceClassMatchMatrix);
       TEST_FUNC_END();
@@ -975,6 +1428,9 @@ static void CheckClassSizes(void) {
   TEST_PRINTLN_DATA(sizeof(util::quantity::Generic));
   TEST_PRINTLN_DATA(sizeof(util::quantity::Dimensionless));
   TEST_PRINTLN_DATA(sizeof(util::quantity::Temperature));
+  TEST_PRINTLN_DATA(sizeof(util::quantity::Concentration));
+  TEST_PRINTLN_DATA(sizeof(util::quantity::Humidity));
+  TEST_PRINTLN_DATA(sizeof(util::quantity::Pressure));
 }
 
 TEST_GLOBALS();
@@ -985,6 +1441,11 @@ void setup() {
   TestQuantityAndGeneric::runTests();
   TestDimensionless::runTests();
   TestTemperature::runTests();
+  TestConcentration::runTests();
+  TestHumidity::runTests();
+  TestPressure::runTests();
+  TestUnitConversion::runTests();
+  TestQuantityVisitor::runTests();
   TestQuantityIntrospectionReflection::runTests();
   CheckClassSizes();
   TEST_END();
@@ -0,0 +1,216 @@
+#include <ESP8266WiFi.h>
+
+#include "test.h"
+
+#include "util_data.h"
+
+class TestSeriesEncoder {
+  public:
+    static void zigZag_varint_signedValues_expectRoundTrip(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testValuesNumber = 7;
+      const int32_t testValues[testValuesNumber] = {0, -1, 1, 63, -64, INT32_MAX, INT32_MIN};
+      const size_t expectedSizes[testValuesNumber] = {1, 1, 1, 1, 1, 5, 5};
+      uint8_t buffer[5];
+      //act
+      boolean roundTripResult = true;
+      boolean sizeResult = true;
+      for (size_t i = 0; i < testValuesNumber; i++) {
+        const size_t writeSize = util::series::SeriesEncoder::writeVarint(buffer, util::series::SeriesEncoder::zigZagEncode(testValues[i]));
+        uint32_t readValue = 0;
+        const size_t readSize = util::series::SeriesEncoder::readVarint(buffer, sizeof(buffer), readValue);
+        if (util::series::SeriesEncoder::zigZagDecode(readValue) != testValues[i]) roundTripResult = false;
+        if ((writeSize != expectedSizes[i]) || (readSize != writeSize)) sizeResult = false;
+      }
+      //assert
+      TEST_ASSERT(util::series::SeriesEncoder::zigZagEncode(-1) == 1);
+      TEST_ASSERT(util::series::SeriesEncoder::zigZagEncode(1) == 2);
+      TEST_ASSERT(roundTripResult);
+      TEST_ASSERT(sizeResult);
+      TEST_FUNC_END();
+    }
+    static void encode_decode_regularSamples_expectSameSamplesCompactSize(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t samplesNumber = 100;
+      static const util::Timestamp interval = 1000;
+      static const size_t bufferSize = 512;
+      uint8_t buffer[bufferSize];
+      util::series::SeriesEncoder encoder(buffer, bufferSize);
+      //act
+      boolean encodeResult = true;
+      for (size_t i = 0; i < samplesNumber; i++) {
+        const util::Value value = util::Value(400) + util::Value(static_cast<int32_t>(i % 8), 1);
+        if (!encoder.encode(12345 + i * interval, value)) encodeResult = false;
+      }
+      util::series::SeriesDecoder decoder(encoder.data(), encoder.size());
+      size_t decodedNumber = 0;
+      boolean decodeResult = true;
+      for (const util::series::Sample & sample : decoder) {
+        const util::Value value = util::Value(400) + util::Value(static_cast<int32_t>(decodedNumber % 8), 1);
+        if (sample.timestamp != 12345 + decodedNumber * interval) decodeResult = false;
+        if (sample.value != value) decodeResult = false;
+        decodedNumber++;
+      }
+      //assert
+      TEST_ASSERT(encodeResult);
+      TEST_ASSERT(encoder.count() == samplesNumber);
+      TEST_ASSERT(encoder.size() <= (samplesNumber * 3 + util::series::SeriesEncoder::maxSampleSize));
+      TEST_ASSERT(decodedNumber == samplesNumber);
+      TEST_ASSERT(decodeResult);
+      TEST_ASSERT(!decoder.error());
+      TEST_FUNC_END();
+    }
+    static void encode_decode_irregularExtremeSamples_expectLossless(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t samplesNumber = 6;
+      const util::series::Sample testSamples[samplesNumber] = {
+        {0xFFFFFF00, util::Value(-100)},
+        {0xFFFFFFF0, util::Value::fromRaw(util::ValueBaseMax)},
+        {0x00000010, util::Value::fromRaw(util::ValueBaseMin)},
+        {0x00000011, util::Value(0)},
+        {0x80000000, util::Value(12345, 3)},
+        {0x00000000, util::Value(-12345, 3)}
+      };
+      static const size_t bufferSize = 128;
+      uint8_t buffer[bufferSize];
+      util::series::SeriesEncoder encoder(buffer, bufferSize);
+      //act
+      for (size_t i = 0; i < samplesNumber; i++)
+        encoder.encode(testSamples[i]);
+      util::series::SeriesDecoder decoder(encoder.data(), encoder.size());
+      util::series::Sample decodedSamples[samplesNumber + 1];
+      size_t decodedNumber = 0;
+      while ((decodedNumber <= samplesNumber) && decoder.decode(decodedSamples[decodedNumber]))
+        decodedNumber++;
+      //assert
+      TEST_ASSERT(decodedNumber == samplesNumber);
+      for (size_t i = 0; i < samplesNumber; i++) {
+        TEST_ASSERT(decodedSamples[i].timestamp == testSamples[i].timestamp);
+        TEST_ASSERT(decodedSamples[i].value.getRaw() == testSamples[i].value.getRaw());
+      }
+      TEST_ASSERT(encoder.size() <= samplesNumber * util::series::SeriesEncoder::maxSampleSize);
+      TEST_ASSERT(!decoder.error());
+      TEST_FUNC_END();
+    }
+    static void encode_bufferFull_expectFalseAndEncodedDataIntact(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t bufferSize = 16;
+      uint8_t buffer[bufferSize];
+      util::series::SeriesEncoder encoder(buffer, bufferSize);
+      //act
+      size_t encodedNumber = 0;
+      while (encoder.encode(encodedNumber * 60000, util::Value(static_cast<int32_t>(encodedNumber * 1000))))
+        encodedNumber++;
+      size_t sizeBeforeFail = encoder.size();
+      boolean encodeResult = encoder.encode(0, util::Value(0));
+      util::series::SeriesDecoder decoder(encoder.data(), encoder.size());
+      size_t decodedNumber = 0;
+      for (const util::series::Sample & sample : decoder) {
+        if (sample.timestamp == decodedNumber * 60000) decodedNumber++;
+      }
+      //assert
+      TEST_ASSERT(encodedNumber);
+      TEST_ASSERT(encoder.count() == encodedNumber);
+      TEST_ASSERT(encoder.size() == sizeBeforeFail);
+      TEST_ASSERT(encoder.size() <= bufferSize);
+      TEST_ASSERT(!encodeResult);
+      TEST_ASSERT(decodedNumber == encodedNumber);
+      TEST_FUNC_END();
+    }
+    static void decode_truncatedData_expectError(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t bufferSize = 32;
+      uint8_t buffer[bufferSize];
+      util::series::SeriesEncoder encoder(buffer, bufferSize);
+      encoder.encode(100, util::Value(1));
+      encoder.encode(200, util::Value(100000));
+      //act
+      util::series::SeriesDecoder decoder(encoder.data(), encoder.size() - 1);
+      util::series::Sample sample;
+      boolean decodeResult1 = decoder.decode(sample);
+      boolean decodeResult2 = decoder.decode(sample);
+      //assert
+      TEST_ASSERT(decodeResult1);
+      TEST_ASSERT(!decodeResult2);
+      TEST_ASSERT(decoder.error());
+      TEST_ASSERT(decoder.finished());
+      TEST_FUNC_END();
+    }
+    static void encode_quantity_expectTimestampAndValueEncoded(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t bufferSize = 16;
+      uint8_t buffer[bufferSize];
+      util::series::SeriesEncoder encoder(buffer, bufferSize);
+      util::quantity::Temperature testQuantity(0, 0, util::Value(215, 1), util::quantity::Temperature::Unit::CELSIUS, 5000);
+      //act
+      boolean encodeResult = encoder.encode(testQuantity);
+      util::series::SeriesDecoder decoder(encoder.data(), encoder.size());
+      util::series::Sample sample;
+      boolean decodeResult = decoder.decode(sample);
+      //assert
+      TEST_ASSERT(encodeResult);
+      TEST_ASSERT(decodeResult);
+      TEST_ASSERT(sample.timestamp == 5000);
+      TEST_ASSERT(sample.value == util::Value(215, 1));
+      TEST_FUNC_END();
+    }
+  public:
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+    static const size_t perfSamplesNumber = 1000;
+    static const size_t perfBufferSize = perfSamplesNumber * util::series::SeriesEncoder::maxSampleSize;
+    static void test_performance_encode(void) {
+      PERF_TEST_FUNC_START();
+      static uint8_t perfBuffer[perfBufferSize];
+      util::series::SeriesEncoder encoder(perfBuffer, perfBufferSize);
+      PERF_TEST_START();
+      for (size_t i = 0; i < perfSamplesNumber; i++)
+        encoder.encode(i * 1000, util::Value(static_cast<int32_t>(i & 0x0F)));
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+    static void test_performance_decode(void) {
+      PERF_TEST_FUNC_START();
+      static uint8_t perfBuffer[perfBufferSize];
+      util::series::SeriesEncoder encoder(perfBuffer, perfBufferSize);
+      for (size_t i = 0; i < perfSamplesNumber; i++)
+        encoder.encode(i * 1000, util::Value(static_cast<int32_t>(i & 0x0F)));
+      util::series::SeriesDecoder decoder(encoder.data(), encoder.size());
+      util::series::Sample sample;
+      PERF_TEST_START();
+      while (decoder.decode(sample));
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      zigZag_varint_signedValues_expectRoundTrip();
+      encode_decode_regularSamples_expectSameSamplesCompactSize();
+      encode_decode_irregularExtremeSamples_expectLossless();
+      encode_bufferFull_expectFalseAndEncodedDataIntact();
+      decode_truncatedData_expectError();
+      encode_quantity_expectTimestampAndValueEncoded();
+      test_performance_encode();
+      test_performance_decode();
+    }
+};
+
+TEST_GLOBALS();
+
+void setup() {
+  TEST_SETUP();
+  TEST_BEGIN();
+  TestSeriesEncoder::runTests();
+  TEST_END();
+}
+
+void loop() {
+  delay(100);
+}
@@ -0,0 +1,213 @@
+#include <ESP8266WiFi.h>
+
+#include "test.h"
+
+#include "util_data.h"
+
+#ifndef ARDUINO
+#include <thread>
+#include <chrono>
+#endif
+
+/// Producer for concurrent tests: timer1 interrupt on ESP8266, second thread on host
+class TestProducer {
+  public:
+#ifdef ARDUINO
+    static const size_t bufferSize = 64;
+    static const size_t batchSize = 4;
+    static const uint32_t itemsNumber = 20000;
+    static const uint32_t timerTicks = 500; //80MHz / 16 / 500 = 10kHz
+#else
+    static const size_t bufferSize = 8192;
+    static const size_t batchSize = 16;
+    static const uint32_t itemsNumber = 2000000;
+#endif
+    typedef util::arrays::SPSCRingBuffer<uint32_t, bufferSize> Buffer;
+  public:
+    static void start(Buffer & ringBuffer) {
+      buffer = &ringBuffer;
+      nextItem = 0;
+#ifdef ARDUINO
+      timer1_isr_init();
+      timer1_attachInterrupt(produce);
+      timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
+      timer1_write(timerTicks);
+#else
+      thread = std::thread([]() {
+        while (nextItem < itemsNumber) produce();
+      });
+#endif
+    }
+    static void stop(void) {
+#ifdef ARDUINO
+      timer1_disable();
+      timer1_detachInterrupt();
+#else
+      thread.join();
+#endif
+    }
+  private:
+    static void ICACHE_RAM_ATTR produce(void) {
+      if (nextItem >= itemsNumber) return;
+      uint32_t items[batchSize];
+      size_t number = itemsNumber - nextItem;
+      if (number > batchSize) number = batchSize;
+      for (size_t i = 0; i < number; i++)
+        items[i] = nextItem + i;
+      nextItem += buffer->push(items, number);
+    }
+  private:
+    static Buffer * buffer;
+    static volatile uint32_t nextItem;
+#ifndef ARDUINO
+    static std::thread thread;
+#endif
+};
+
+TestProducer::Buffer * TestProducer::buffer = nullptr;
+volatile uint32_t TestProducer::nextItem = 0;
+#ifndef ARDUINO
+std::thread TestProducer::thread;
+#endif
+
+class TestSPSCRingBuffer {
+  public:
+    static void push_pop_singleItems_expectFifoOrder(void) {
+      TEST_FUNC_START();
+      //arrange
+      util::arrays::SPSCRingBuffer<int, 4> ringBuffer;
+      int item1 = 0, item2 = 0, item3 = 0;
+      //act
+      boolean pushResult1 = ringBuffer.push(1);
+      boolean pushResult2 = ringBuffer.push(2);
+      size_t count = ringBuffer.count();
+      boolean popResult1 = ringBuffer.pop(item1);
+      boolean popResult2 = ringBuffer.pop(item2);
+      boolean popResult3 = ringBuffer.pop(item3);
+      //assert
+      TEST_ASSERT(pushResult1);
+      TEST_ASSERT(pushResult2);
+      TEST_ASSERT(count == 2);
+      TEST_ASSERT(popResult1 && (item1 == 1));
+      TEST_ASSERT(popResult2 && (item2 == 2));
+      TEST_ASSERT(!popResult3 && !item3);
+      TEST_ASSERT(ringBuffer.empty());
+      TEST_FUNC_END();
+    }
+    static void push_bufferFull_expectRejectedOldestKept(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 4;
+      util::arrays::SPSCRingBuffer<int, testBufferSize> ringBuffer;
+      for (size_t i = 0; i < testBufferSize; i++)
+        ringBuffer.push(i);
+      const int batch[] = {10, 11};
+      int item = -1;
+      //act
+      boolean pushResult = ringBuffer.push(5);
+      size_t pushBatchResult = ringBuffer.push(batch, sizeof(batch) / sizeof(batch[0]));
+      boolean full = ringBuffer.full();
+      ringBuffer.pop(item);
+      //assert
+      TEST_ASSERT(!pushResult);
+      TEST_ASSERT(!pushBatchResult);
+      TEST_ASSERT(full);
+      TEST_ASSERT(!item);
+      TEST_ASSERT(ringBuffer.count() == (testBufferSize - 1));
+      TEST_FUNC_END();
+    }
+    static void push_pop_batchesWrappedAround_expectFifoOrder(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const size_t testBufferSize = 8;
+      static const size_t batchSize = 5;
+      static const size_t batches = 7;
+      util::arrays::SPSCRingBuffer<int, testBufferSize> ringBuffer;
+      int input[batchSize];
+      int output[batchSize + 1];
+      int nextInput = 0;
+      int nextOutput = 0;
+      boolean inOrder = true;
+      boolean batchSizeCorrect = true;
+      //act
+      for (size_t i = 0; i < batches; i++) {
+        for (size_t j = 0; j < batchSize; j++)
+          input[j] = nextInput + j;
+        if (ringBuffer.push(input, batchSize) != batchSize) batchSizeCorrect = false;
+        nextInput += batchSize;
+        const size_t popped = ringBuffer.pop(output, sizeof(output) / sizeof(output[0]));
+        if (popped != batchSize) batchSizeCorrect = false;
+        for (size_t j = 0; j < popped; j++)
+          if (output[j] != nextOutput++) inOrder = false;
+      }
+      //assert
+      TEST_ASSERT(batchSizeCorrect);
+      TEST_ASSERT(inOrder);
+      TEST_ASSERT(nextOutput == nextInput);
+      TEST_ASSERT(ringBuffer.empty());
+      TEST_FUNC_END();
+    }
+    static void concurrentProducer_expectAllItemsInOrder(void) {
+      TEST_FUNC_START();
+      //arrange
+      static const uint32_t timeout = 10000;
+      static TestProducer::Buffer ringBuffer;
+      uint32_t items[TestProducer::batchSize * 2];
+      uint32_t nextItem = 0;
+      boolean inOrder = true;
+      //act
+      TestProducer::start(ringBuffer);
+      const uint32_t startTime = millis();
+      while ((nextItem < TestProducer::itemsNumber) && ((millis() - startTime) < timeout)) {
+        const size_t popped = ringBuffer.pop(items, sizeof(items) / sizeof(items[0]));
+        for (size_t i = 0; i < popped; i++)
+          if (items[i] != nextItem++) inOrder = false;
+        if (!popped) yield();
+      }
+      TestProducer::stop();
+      //assert
+      TEST_ASSERT(inOrder);
+      TEST_ASSERT(nextItem == TestProducer::itemsNumber);
+      TEST_ASSERT(ringBuffer.empty());
+      TEST_FUNC_END();
+    }
+#pragma GCC push_options
+#pragma GCC optimize ("O0")
+    static void performanceTest_concurrentThroughput(void) {
+      PERF_TEST_FUNC_START();
+      static const uint32_t timeout = 10000;
+      static TestProducer::Buffer ringBuffer;
+      uint32_t items[TestProducer::batchSize * 2];
+      uint32_t itemsPopped = 0;
+      PERF_TEST_START();
+      TestProducer::start(ringBuffer);
+      const uint32_t startTime = millis();
+      while ((itemsPopped < TestProducer::itemsNumber) && ((millis() - startTime) < timeout))
+        itemsPopped += ringBuffer.pop(items, sizeof(items) / sizeof(items[0]));
+      TestProducer::stop();
+      PERF_TEST_END();
+      PERF_TEST_FUNC_END();
+    }
+#pragma GCC pop_options
+  public:
+    static void runTests(void) {
+      push_pop_singleItems_expectFifoOrder();
+      push_bufferFull_expectRejectedOldestKept();
+      push_pop_batchesWrappedAround_expectFifoOrder();
+      concurrentProducer_expectAllItemsInOrder();
+      performanceTest_concurrentThroughput();
+    }
+};
+
+TEST_GLOBALS();
+
+void setup() {
+  TEST_SETUP();
+  TEST_BEGIN();
+  TestSPSCRingBuffer::runTests();
+  TEST_END();
+}
+
+void loop() {
+  delay(100);
+}
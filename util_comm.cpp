@@ -475,6 +475,40 @@ void JSONOutput::value(const __FlashStringHelper * name, boolean value) {
   }
 }
 
+/// @brief Produces a Name = Value pair
+/// @param name Name as a RAM string
+/// @param value Value as a fixed point number (output is null if value is overflown)
+/// @param decimals Number of digits after decimal point
+void JSONOutput::value(const char * name, const Value & value, size_t decimals) {
+  printName(name);
+  printNumber(value, decimals);
+}
+
+/// @brief Produces a Name = Value pair
+/// @param name Name as a PROGMEM string
+/// @param value Value as a fixed point number (output is null if value is overflown)
+/// @param decimals Number of digits after decimal point
+void JSONOutput::value(const __FlashStringHelper * name, const Value & value, size_t decimals) {
+  printName(name);
+  printNumber(value, decimals);
+}
+
+/// @brief Produces a Name = Value pair
+/// @param name Name as a RAM string
+/// @param value Value as a string stored in one or two spans
+void JSONOutput::value(const char * name, const arrays::CStrSpans & value) {
+  printName(name);
+  printString(value);
+}
+
+/// @brief Produces a Name = Value pair
+/// @param name Name as a PROGMEM string
+/// @param value Value as a string stored in one or two spans
+void JSONOutput::value(const __FlashStringHelper * name, const arrays::CStrSpans & value) {
+  printName(name);
+  printString(value);
+}
+
 }; //namespace json
 
 }; //namespace util
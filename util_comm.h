@@ -14,6 +14,7 @@
 #define UTIL_COMM_H
 
 #include <arduino.h>
+#include "util_data.h"
 
 namespace util {
 
@@ -163,6 +164,10 @@ class JSONOutput {
     void value(const __FlashStringHelper * name, long value);
     void value(const __FlashStringHelper * name, unsigned long value);
     void value(const __FlashStringHelper * name, boolean value);
+    void value(const char * name, const Value & value, size_t decimals = ValueDecimals);
+    void value(const __FlashStringHelper * name, const Value & value, size_t decimals = ValueDecimals);
+    void value(const char * name, const arrays::CStrSpans & value);
+    void value(const __FlashStringHelper * name, const arrays::CStrSpans & value);
   private:
     Print * client = NULL;
   private:
@@ -191,6 +196,8 @@ class JSONOutput {
     inline void printName(const __FlashStringHelper * name);
     inline void printString(const char * string);
     inline void printString(const __FlashStringHelper * string);
+    inline void printString(const arrays::CStrSpans & string);
+    inline void printNumber(const Value & number, size_t decimals);
 };
 
 /// Print json object name from RAM string
@@ -251,6 +258,30 @@ inline void JSONOutput::printString(const __FlashStringHelper * string) {
   }
 }
 
+/// Print json object value string from spans (e.g. directly from ring buffer)
+inline void JSONOutput::printString(const arrays::CStrSpans & string) {
+  if (currentContext != contextNone) {
+    client->print(charQuote);
+    string.printTo(*client);
+    client->print(charQuote);
+  }
+}
+
+/// Print json object value number from Value
+inline void JSONOutput::printNumber(const Value & number, size_t decimals) {
+  static const char nullString[] = "null";
+  if (currentContext != contextNone) {
+    if (!overflow(number)) {
+      char text[dsp::FixedPointFormat::maxLength];
+      const size_t length = number.toString(text, sizeof(text), decimals);
+      client->write(reinterpret_cast<const uint8_t *>(text), length);
+    }
+    else {
+      client->print(FPSTR(nullString));
+    }
+  }
+}
+
 /// Go one nesting level deeper
 inline boolean JSONOutput::pushContext(Context context) {
   if (nestingStackCounter >= nestingStackSize) return (false);
@@ -7,10 +7,84 @@
 
 #include "util_data.h"
 
+#if !defined(UTIL_DATA_SCALAR_KERNELS) && defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define UTIL_DATA_VECTOR_KERNELS
+#if defined(__AVX2__)
+#define UTIL_DATA_VECTOR_BYTES 32
+#else
+#define UTIL_DATA_VECTOR_BYTES 16
+#endif
+#endif
+
 namespace util {
 
 namespace arrays {
 
+//////////////////////////////////////////////////////////////////////
+// CStrSpans
+//////////////////////////////////////////////////////////////////////
+
+size_t CStrSpans::find(char character, size_t start) const {
+  /// @brief Finds first occurrence of the char in the string
+  /// @param character Char to find
+  /// @param start Position to start searching from
+  /// @return Position of the char or npos if not found
+  if (start < firstLength) {
+    const void * found = memchr(&first[start], character, firstLength - start);
+    if (found) return (static_cast<const char *>(found) - first);
+    start = firstLength;
+  }
+  const size_t secondStart = start - firstLength;
+  if (secondStart < secondLength) {
+    const void * found = memchr(&second[secondStart], character, secondLength - secondStart);
+    if (found) return (static_cast<const char *>(found) - second + firstLength);
+  }
+  return (npos);
+}
+
+CStrSpans CStrSpans::substr(size_t start, size_t length) const {
+  /// @brief Returns view of a part of the string
+  /// @param start Position of the first char of the part
+  /// @param length Length of the part in chars; the part is truncated at the end
+  /// of the string
+  /// @return Part of the string or empty spans if start is beyond the end of string
+  const size_t totalLength = this->length();
+  if (start >= totalLength) return (CStrSpans());
+  if (length > (totalLength - start)) length = totalLength - start;
+  if (start >= firstLength)
+    return (CStrSpans(&second[start - firstLength], length));
+  const size_t firstPartLength = firstLength - start;
+  if (length <= firstPartLength)
+    return (CStrSpans(&first[start], length));
+  return (CStrSpans(&first[start], firstPartLength, second, length - firstPartLength));
+}
+
+size_t CStrSpans::copy(char * dst, size_t dstSize) const {
+  /// @brief Copies the string to buffer as a c-string
+  /// @param dst Destination buffer
+  /// @param dstSize Size of buffer at dst, chars
+  /// @return Number of chars actually copied (not including null-terminator)
+  static const size_t nullCharSize = sizeof('\0');
+  if (!dst || !dstSize) return (0);
+  const size_t maxLength = dstSize - nullCharSize;
+  const size_t firstPartLength = (firstLength < maxLength) ? firstLength : maxLength;
+  const size_t secondPartLength = (secondLength < (maxLength - firstPartLength)) ? secondLength : (maxLength - firstPartLength);
+  if (firstPartLength) memcpy(dst, first, firstPartLength);
+  if (secondPartLength) memcpy(&dst[firstPartLength], second, secondPartLength);
+  dst[firstPartLength + secondPartLength] = '\0';
+  return (firstPartLength + secondPartLength);
+}
+
+size_t CStrSpans::printTo(Print & destination) const {
+  /// @brief Prints the string without copying it to intermediate buffer
+  /// @param destination Print to output the string to
+  /// @return Number of chars printed
+  size_t printed = 0;
+  if (firstLength) printed += destination.write(reinterpret_cast<const uint8_t *>(first), firstLength);
+  if (secondLength) printed += destination.write(reinterpret_cast<const uint8_t *>(second), secondLength);
+  return (printed);
+}
+
 //////////////////////////////////////////////////////////////////////
 // CStrRingBuffer
 //////////////////////////////////////////////////////////////////////
@@ -38,7 +112,7 @@ boolean CStrRingBuffer::push(const char * item) {
     strncpy(&ringBuffer[nextIndex], item, firstPartLen); //Copy first part of the string to the end of the buffer
     //no need to set trailing null-terminator as we reserved the last character of the buffer and set it to zero
     strncpy(ringBuffer, &item[firstPartLen], secondPartLen);//Copy second part of the string to the beginnning of the buffer
-    ringBuffer[secondPartLen] = nullChar;
+    ringBuffer[secondPartLen - nullCharSize] = nullChar; //secondPartLen includes null-terminator
   }
   totalCharCount += itemLength;
   cstrCount++;
@@ -54,6 +128,7 @@ void CStrRingBuffer::pop(void) {
   //then this string is stored as two parts, first part at the end and the second part at the beginning of the ring buffer
   if ((indexOldestItem + lengthOldestItem) <= ringBufferSize) { //the string being removed from buffer is a single-part string
     indexOldestItem += lengthOldestItem;
+    if (indexOldestItem == ringBufferSize) indexOldestItem = 0; //the string being removed ended exactly at the end of the buffer
   }
   else { //the string being removed from buffer has its first part at the end of the buffer and second part at the beginning of the buffer
     size_t length2ndPart = strlen(ringBuffer) + nullCharSize;
@@ -117,7 +192,7 @@ boolean CStrRingBuffer::empty(void) const {
   return (totalCharCount == 0);
 }
 
-size_t CStrRingBuffer::get(size_t index, char *dst, size_t dstSize) {
+size_t CStrRingBuffer::get(size_t index, char *dst, size_t dstSize) const {
   /// @brief Get a c-string from the ring buffer
   /// @param index Index of c-string in the ring buffer (0 = oldest
   /// stored c-string in ring buffer)
@@ -125,32 +200,29 @@ size_t CStrRingBuffer::get(size_t index, char *dst, size_t dstSize) {
   /// @param dstSize Size of buffer at dst, chars
   /// @return Number of chars actually copied (not including
   /// null-terminator)
-  if (!dst || !dstSize) return (0);
-  if ((!validate()) || (index >= cstrCount)) {
-    if (dst && dstSize) dst[0] = nullChar;
-    return (0);
-  }
+  return (getSpans(index).copy(dst, dstSize));
+}
+
+CStrSpans CStrRingBuffer::getSpans(size_t index) const {
+  /// @brief Get a c-string from the ring buffer without copying
+  /// @param index Index of c-string in the ring buffer (0 = oldest
+  /// stored c-string in ring buffer)
+  /// @return One or two spans pointing directly to the ring buffer contents
+  /// (two spans if the c-string wraps around the end of the ring buffer), or
+  /// empty spans if index is out of range
+  /// @warning The returned spans become invalid as soon as the ring buffer is
+  /// modified with push() or pop().
+  if ((!validate()) || (index >= cstrCount)) return (CStrSpans());
   const size_t startChar = getCstrStartChar(index);
   const char * cstr = &(ringBuffer[startChar]);
   const size_t length = strlen(cstr);
-  if ((startChar + length + nullCharSize) <= ringBufferSize) { //this cstring is stored as a single-part
-    const size_t lengthToCopy = ((dstSize - nullCharSize) < length) ? (dstSize - nullCharSize) : length;
-    strncpy (dst, cstr, lengthToCopy);
-    dst[lengthToCopy] = nullChar;
-    return (lengthToCopy);
-  }
-  else { //the first part of this cstring is stored at the end of the buffer and the second part at the beginning
-    const size_t firstPartLen = (dstSize - nullCharSize) < length ? (dstSize - nullCharSize) : length;
-    size_t secondPartLen = strlen(ringBuffer);
-    if ((dstSize - firstPartLen - nullCharSize) < secondPartLen) secondPartLen = dstSize - firstPartLen - nullCharSize;
-    strncpy (dst, cstr, firstPartLen);
-    if (secondPartLen) strncpy(&dst[firstPartLen], ringBuffer, secondPartLen);
-    dst[firstPartLen + secondPartLen] = nullChar;
-    return (firstPartLen + secondPartLen);
-  }
+  if ((startChar + length + nullCharSize) <= ringBufferSize) //this cstring is stored as a single-part
+    return (CStrSpans(cstr, length));
+  //the first part of this cstring is stored at the end of the buffer and the second part at the beginning
+  return (CStrSpans(cstr, length, ringBuffer, strlen(ringBuffer)));
 }
 
-size_t CStrRingBuffer::getCstrStartChar(size_t index) {
+size_t CStrRingBuffer::getCstrStartChar(size_t index) const {
   /// @brief Get the cstring start position by cstring's index in ring buffer
   /// @param index Index in the ring buffer
   /// @return Cstring start position in the ring buffer
@@ -160,36 +232,60 @@ size_t CStrRingBuffer::getCstrStartChar(size_t index) {
   for (size_t i = 0; i < index; i++) {
     currIndex += (strlen (&ringBuffer[currIndex]) + nullCharSize);
     if (currIndex > ringBufferSize) currIndex = strlen(ringBuffer) + nullCharSize; //cstring is stored in two parts, first part at the end and second part at the beginning of the ring buffer
+    if (currIndex == ringBufferSize) currIndex = 0; //cstring ended exactly at the end of the ring buffer
   }
   return (currIndex);
 }
 
 //////////////////////////////////////////////////////////////////////
-// PrintToBuffer
+// PrintToBufferFast
 //////////////////////////////////////////////////////////////////////
 
 ///@brief Saves single char to buffer
 ///@param character Char to save
-size_t PrintToBuffer::write (uint8_t character) {
-  if (bufferPosition >= (bufferSize - nullCharSize)) return (0);
+size_t PrintToBufferFast::write (uint8_t character) {
+  if (bufferPosition >= maxLength) {
+    droppedChars++;
+    return (0);
+  }
   buffer[bufferPosition++] = static_cast<char>(character);
-  buffer[bufferPosition] = nullChar;
   return (1);
 }
 
 ///@brief Saves multiple chars to buffer
 ///@param buffer Location to copy chars from
 ///@param size Size of the buffer in chars
-size_t PrintToBuffer::write(const uint8_t *buffer, size_t size) {
-  const size_t maxCharsToCopy = bufferSize - bufferPosition - nullCharSize;
-  if (maxCharsToCopy <= nullCharSize) return (0);
+size_t PrintToBufferFast::write(const uint8_t *buffer, size_t size) {
+  const size_t maxCharsToCopy = maxLength - bufferPosition;
   const size_t charsToCopy = size > maxCharsToCopy ? maxCharsToCopy : size;
-  strncpy(&this->buffer[bufferPosition], reinterpret_cast<const char*>(buffer), charsToCopy);
-  this->buffer[bufferPosition + charsToCopy] = nullChar;
+  droppedChars += size - charsToCopy;
+  if (!charsToCopy) return (0);
+  memcpy(&this->buffer[bufferPosition], buffer, charsToCopy);
   bufferPosition += charsToCopy;
   return (charsToCopy);
 }
 
+//////////////////////////////////////////////////////////////////////
+// PrintToBuffer
+//////////////////////////////////////////////////////////////////////
+
+///@brief Saves single char to buffer
+///@param character Char to save
+size_t PrintToBuffer::write (uint8_t character) {
+  const size_t written = PrintToBufferFast::write(character);
+  finish();
+  return (written);
+}
+
+///@brief Saves multiple chars to buffer
+///@param buffer Location to copy chars from
+///@param size Size of the buffer in chars
+size_t PrintToBuffer::write(const uint8_t *buffer, size_t size) {
+  const size_t written = PrintToBufferFast::write(buffer, size);
+  finish();
+  return (written);
+}
+
 }; //namespace arrays
 
 namespace checksum {
@@ -249,10 +345,534 @@ uint16_t crc16(const void * buffer, size_t bufferSize, uint16_t poly, uint16_t i
 
 namespace dsp {
 
+//////////////////////////////////////////////////////////////////////
+// FixedPointMath
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Calculates exponent e^x
+/// @details Argument is reduced to x = k * ln(2) + r, where |r| <= ln(2) / 2, then
+/// e^r is calculated by 7th degree Taylor polynomial and multiplied by 2^k with bit shift.
+/// @par Truncation error of the polynomial does not exceed r^8 / 8! < 2^-27 and the
+/// rounding error of Horner scheme does not exceed 2^-27, thus relative error of the
+/// result is less than 2^-26 (before the result is rounded to resultFractionBits).
+/// @param x Argument with fractionBits fraction bits
+/// @param resultFractionBits Number of fraction bits of the returned value
+/// @return e^x with resultFractionBits fraction bits, rounded to nearest value; if the result
+/// does not fit into 32 bits, INT64_MAX is returned
+int64_t FixedPointMath::exp(int64_t x, size_t resultFractionBits) {
+  static const int64_t one = static_cast<int64_t>(1) << fractionBits;
+  static const int64_t ln2 = 744261118; //ln(2) with 30 fraction bits
+  static const int64_t invLn2 = 47274; //1/ln(2) with 15 fraction bits
+  static const size_t invLn2FractionBits = 15;
+  static const int64_t argumentLimit = static_cast<int64_t>(64) << fractionBits;
+  static const int64_t maxShift = 32;
+  static const int64_t taylorCoefficients[] = {
+    one / 5040, one / 720, one / 120, one / 24, one / 6, one / 2, one, one
+  };
+  if (x > argumentLimit) return (INT64_MAX);
+  if (x < -argumentLimit) return (0);
+  //x = k * ln(2) + r
+  const int64_t k = ((x >> invLn2FractionBits) * invLn2 + (one >> 1)) >> fractionBits;
+  const int64_t r = x - k * ln2;
+  //e^r
+  int64_t result = taylorCoefficients[0];
+  for (size_t i = 1; i < (sizeof(taylorCoefficients) / sizeof(taylorCoefficients[0])); i++)
+    result = taylorCoefficients[i] + ((result * r) >> fractionBits);
+  //e^x = e^r * 2^k
+  const int64_t shift = k + static_cast<int64_t>(resultFractionBits) - static_cast<int64_t>(fractionBits);
+  if (shift >= maxShift) return (INT64_MAX);
+  if (shift >= 0) return (result << shift);
+  if (-shift >= maxShift * 2) return (0);
+  return ((result + (static_cast<int64_t>(1) << (-shift - 1))) >> (-shift));
+}
+
+/// @brief Calculates natural logarithm ln(x)
+/// @details Argument is reduced to x = m * 2^e, where sqrt(1/2) <= m < sqrt(2), then
+/// ln(m) is calculated as 2 * (s + s^3 / 3 + s^5 / 5 + s^7 / 7), s = (m - 1) / (m + 1).
+/// @par Since |s| < 0.172, truncation error of the series does not exceed
+/// 2 * s^9 / 9 < 2^-25; together with rounding errors the absolute error of the result
+/// is less than 2^-24.
+/// @param x Argument with xFractionBits fraction bits, must be greater than zero
+/// @param xFractionBits Number of fraction bits of the argument
+/// @return ln(x) with fractionBits fraction bits
+int64_t FixedPointMath::log(uint32_t x, size_t xFractionBits) {
+  static const int64_t one = static_cast<int64_t>(1) << fractionBits;
+  static const int64_t ln2 = 744261118; //ln(2) with 30 fraction bits
+  static const int64_t sqrt2 = 1518500250; //sqrt(2) with 30 fraction bits
+  static const int64_t seriesCoefficients[] = { one / 7, one / 5, one / 3, one };
+  if (!x) return (INT64_MIN);
+  //x = m * 2^e
+  size_t msb = sizeof(x) * 8 - 1;
+  while (!(x & (static_cast<uint32_t>(1) << msb))) msb--;
+  int64_t e = static_cast<int64_t>(msb) - static_cast<int64_t>(xFractionBits);
+  const int64_t m = (msb <= fractionBits) ?
+                    (static_cast<int64_t>(x) << (fractionBits - msb)) :
+                    (static_cast<int64_t>(x) >> (msb - fractionBits));
+  //s = (m - 1) / (m + 1); if m >= sqrt(2) then m / 2 is used instead
+  int64_t numerator = m - one;
+  int64_t denominator = m + one;
+  if (m >= sqrt2) {
+    numerator = m - 2 * one;
+    denominator = m + 2 * one;
+    e++;
+  }
+  const int64_t s = numerator * one / denominator;
+  const int64_t s2 = (s * s) >> fractionBits;
+  //ln(m)
+  int64_t result = seriesCoefficients[0];
+  for (size_t i = 1; i < (sizeof(seriesCoefficients) / sizeof(seriesCoefficients[0])); i++)
+    result = seriesCoefficients[i] + ((result * s2) >> fractionBits);
+  result = (result * s) >> (fractionBits - 1);
+  //ln(x) = ln(m) + e * ln(2)
+  return (result + e * ln2);
+}
+
+/// @brief Calculates integer square root
+/// @details Bit-by-bit calculation, no division or multiplication is used
+/// @param x Argument
+/// @return Square root of x rounded to the nearest integer
+uint32_t FixedPointMath::sqrt(uint64_t x) {
+  uint64_t result = 0;
+  uint64_t bit = static_cast<uint64_t>(1) << (sizeof(x) * 8 - 2);
+  while (bit > x) bit >>= 2;
+  while (bit) {
+    if (x >= result + bit) {
+      x -= result + bit;
+      result = (result >> 1) + bit;
+    }
+    else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  //x now is a remainder; round up if x >= result + 0.5
+  if (x > result) result++;
+  return (static_cast<uint32_t>(result));
+}
+
+/// @brief Multiplies intermediary value by FixedPoint value
+/// @details Used to calculate exponent argument for pow(). The least significant bits of
+/// x are discarded to avoid overflow of 64-bit product.
+/// @param x Intermediary value with fractionBits fraction bits
+/// @param y Raw FixedPoint value
+/// @param yFractionBits Number of fraction bits of y
+/// @return x * y with fractionBits fraction bits; the result is capped at the value
+/// beyond which exp() always overflows or returns zero
+int64_t FixedPointMath::mul(int64_t x, int64_t y, size_t yFractionBits) {
+  static const size_t discardedBits = 6;
+  static const int64_t limit = static_cast<int64_t>(65) << fractionBits;
+  const int64_t product = (x >> discardedBits) * y;
+  if (yFractionBits >= discardedBits) {
+    const int64_t result = product >> (yFractionBits - discardedBits);
+    if (result > limit) return (limit);
+    if (result < -limit) return (-limit);
+    return (result);
+  }
+  const size_t shift = discardedBits - yFractionBits;
+  if (product > (limit >> shift)) return (limit);
+  if (product < -(limit >> shift)) return (-limit);
+  return (product * (static_cast<int64_t>(1) << shift));
+}
+
+/// @brief Calculates sine and cosine
+/// @details Argument is reduced to x = k * pi / 2 + r, where |r| <= pi / 4, then sin(r)
+/// and cos(r) are calculated by 9th and 10th degree Taylor polynomials and rotated by
+/// k quadrants.
+/// @par Truncation error of the polynomials does not exceed (pi / 4)^11 / 11! < 2^-29,
+/// together with rounding errors the absolute error of the results is less than 2^-28.
+/// @param x Argument in radians with fractionBits fraction bits; precision of argument
+/// reduction degrades for large arguments, |x| should not exceed 2^8 * pi
+/// @param sine Variable to store sin(x) with fractionBits fraction bits
+/// @param cosine Variable to store cos(x) with fractionBits fraction bits
+void FixedPointMath::sinCos(int64_t x, int64_t & sine, int64_t & cosine) {
+  static const int64_t one = static_cast<int64_t>(1) << fractionBits;
+  static const int64_t halfPi = 1686629713; //pi / 2 with 30 fraction bits
+  static const int64_t sinCoefficients[] = {
+    one / 362880, -one / 5040, one / 120, -one / 6, one
+  };
+  static const int64_t cosCoefficients[] = {
+    -one / 3628800, one / 40320, -one / 720, one / 24, -one / 2, one
+  };
+  //x = k * pi / 2 + r
+  const int64_t k = (x >= 0) ? ((x + halfPi / 2) / halfPi) : -((-x + halfPi / 2) / halfPi);
+  const int64_t r = x - k * halfPi;
+  const int64_t r2 = (r * r) >> fractionBits;
+  //sin(r), cos(r)
+  int64_t sinR = sinCoefficients[0];
+  for (size_t i = 1; i < (sizeof(sinCoefficients) / sizeof(sinCoefficients[0])); i++)
+    sinR = sinCoefficients[i] + ((sinR * r2) >> fractionBits);
+  sinR = (sinR * r) >> fractionBits;
+  int64_t cosR = cosCoefficients[0];
+  for (size_t i = 1; i < (sizeof(cosCoefficients) / sizeof(cosCoefficients[0])); i++)
+    cosR = cosCoefficients[i] + ((cosR * r2) >> fractionBits);
+  //rotate by k quadrants
+  switch (k & 3) {
+    case 0:
+      sine = sinR;
+      cosine = cosR;
+      break;
+    case 1:
+      sine = cosR;
+      cosine = -sinR;
+      break;
+    case 2:
+      sine = -sinR;
+      cosine = -cosR;
+      break;
+    default:
+      sine = -cosR;
+      cosine = sinR;
+      break;
+  }
+}
+
+/// @brief Multiplies two intermediary values
+/// @details Both values are split into integer and fraction parts so that 64-bit
+/// products do not overflow; the product of fraction parts is truncated.
+/// @param x Intermediary value with fractionBits fraction bits
+/// @param y Intermediary value with fractionBits fraction bits
+/// @return x * y with fractionBits fraction bits; the result must be less than 2^33 by
+/// absolute value
+int64_t FixedPointMath::mulIntermediary(int64_t x, int64_t y) {
+  static const int64_t fractionMask = (static_cast<int64_t>(1) << fractionBits) - 1;
+  const int64_t xInteger = x >> fractionBits;
+  const int64_t xFraction = x & fractionMask;
+  const int64_t yInteger = y >> fractionBits;
+  const int64_t yFraction = y & fractionMask;
+  return (xInteger * y + xFraction * yInteger + ((xFraction * yFraction) >> fractionBits));
+}
+
+/// @brief Divides two intermediary values
+/// @details If x exceeds 2^32 by absolute value, both values are shifted right so
+/// that x shifted by fractionBits fits in 64 bits.
+/// @param x Dividend, intermediary value with fractionBits fraction bits
+/// @param y Divisor, intermediary value with fractionBits fraction bits
+/// @return x / y with fractionBits fraction bits; the result is capped at 2^33 by
+/// absolute value (also if y is zero)
+int64_t FixedPointMath::divIntermediary(int64_t x, int64_t y) {
+  static const uint64_t dividendLimit = static_cast<uint64_t>(1) << 32;
+  static const uint64_t limit = static_cast<uint64_t>(1) << (fractionBits + 33);
+  const boolean negative = ((x < 0) != (y < 0));
+  uint64_t dividend = (x < 0) ? -static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+  uint64_t divisor = (y < 0) ? -static_cast<uint64_t>(y) : static_cast<uint64_t>(y);
+  while (dividend >= dividendLimit) {
+    dividend >>= 1;
+    divisor >>= 1;
+  }
+  uint64_t quotient = limit;
+  if (divisor) quotient = (dividend << fractionBits) / divisor;
+  if (quotient > limit) quotient = limit;
+  return (negative ? -static_cast<int64_t>(quotient) : static_cast<int64_t>(quotient));
+}
+
+//////////////////////////////////////////////////////////////////////
+// FixedPointFormat
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Writes decimal number to the buffer
+/// @param buffer Buffer to write the text to
+/// @param bufferSize Size of the buffer in chars, including trailing zero
+/// @param magnitude Absolute value of the number with fractionBits fraction bits
+/// @param fractionBits Number of fraction bits of magnitude, must be less than 30
+/// @param negative True if the number is negative
+/// @param decimals Number of digits after decimal point, capped at maxDecimals
+/// @return Number of chars written (excluding trailing zero) or zero if the buffer is too
+/// small to hold the text
+size_t FixedPointFormat::format(char * buffer, size_t bufferSize, uint32_t magnitude, size_t fractionBits, boolean negative, size_t decimals) {
+  static const uint32_t decimalPowers[maxDecimals + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+  };
+  static const char decimalPointChar = '.';
+  static const char minusSignChar = '-';
+  if (decimals > maxDecimals) decimals = maxDecimals;
+  //Fraction part is scaled to decimals and rounded to nearest
+  uint32_t integerPart = magnitude >> fractionBits;
+  const uint32_t fractionPart = magnitude & ((static_cast<uint32_t>(1) << fractionBits) - 1);
+  const uint64_t rounding = static_cast<uint64_t>(1) << fractionBits >> 1;
+  uint32_t fractionDigits = static_cast<uint32_t>((static_cast<uint64_t>(fractionPart) * decimalPowers[decimals] + rounding) >> fractionBits);
+  if (fractionDigits >= decimalPowers[decimals]) {
+    fractionDigits -= decimalPowers[decimals];
+    integerPart++;
+  }
+  //Text is composed from the last char to the first one
+  char text[maxLength];
+  char * position = text + maxLength;
+  if (decimals) {
+    position = writeDigits(position, fractionDigits, decimals);
+    *(--position) = decimalPointChar;
+  }
+  position = writeDigits(position, integerPart, 1);
+  if (negative && (integerPart || fractionDigits)) *(--position) = minusSignChar;
+  const size_t length = static_cast<size_t>(text + maxLength - position);
+  if (!buffer || (length >= bufferSize)) {
+    if (buffer && bufferSize) buffer[0] = '\0';
+    return (0);
+  }
+  memcpy(buffer, position, length);
+  buffer[length] = '\0';
+  return (length);
+}
+
+/// @brief Writes overflow value designation to the buffer
+/// @param buffer Buffer to write the text to
+/// @param bufferSize Size of the buffer in chars, including trailing zero
+/// @param negative True for negative overflow value
+/// @return Number of chars written (excluding trailing zero) or zero if the buffer is too
+/// small to hold the text
+size_t FixedPointFormat::formatOverflow(char * buffer, size_t bufferSize, boolean negative) {
+  static const char PROGMEM overflowText[] = "-OVF";
+  const char * text = negative ? overflowText : (overflowText + 1);
+  const size_t length = strlen_P(text);
+  if (!buffer || (length >= bufferSize)) {
+    if (buffer && bufferSize) buffer[0] = '\0';
+    return (0);
+  }
+  strncpy_P(buffer, text, bufferSize);
+  return (length);
+}
+
+/// @brief Writes decimal digits of the integer value, ending just before the specified position
+/// @param end Position of the buffer following the last digit
+/// @param value Integer value to write
+/// @param minDigits Minimum number of digits, the value is padded with leading zeros
+/// @return Position of the first digit written
+char * FixedPointFormat::writeDigits(char * end, uint32_t value, size_t minDigits) {
+  static const char PROGMEM digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+  static const uint64_t reciprocal100 = 1374389535; //2^37 / 100, rounded up
+  static const size_t reciprocal100Shift = 37;
+  static const uint32_t digitPairRadix = 100;
+  static const uint32_t decimalRadix = 10;
+  char * position = end;
+  size_t digits = 0;
+  while (value >= digitPairRadix) {
+    const uint32_t quotient = static_cast<uint32_t>((value * reciprocal100) >> reciprocal100Shift);
+    const uint32_t pair = (value - quotient * digitPairRadix) * 2;
+    position -= 2;
+    position[0] = static_cast<char>(pgm_read_byte(&digitPairs[pair]));
+    position[1] = static_cast<char>(pgm_read_byte(&digitPairs[pair + 1]));
+    digits += 2;
+    value = quotient;
+  }
+  if (value >= decimalRadix) {
+    position -= 2;
+    position[0] = static_cast<char>(pgm_read_byte(&digitPairs[value * 2]));
+    position[1] = static_cast<char>(pgm_read_byte(&digitPairs[value * 2 + 1]));
+    digits += 2;
+  }
+  else {
+    *(--position) = static_cast<char>('0' + value);
+    digits++;
+  }
+  while (digits < minDigits) {
+    *(--position) = '0';
+    digits++;
+  }
+  return (position);
+}
+
+//////////////////////////////////////////////////////////////////////
+// ValueArray
+//////////////////////////////////////////////////////////////////////
+
+#ifdef UTIL_DATA_VECTOR_KERNELS
+typedef ValueBase ValueBaseVector __attribute__((vector_size(UTIL_DATA_VECTOR_BYTES)));
+static const size_t valueBaseLanes = sizeof(ValueBaseVector) / sizeof(ValueBase);
+
+/// @brief Selects lanes from vector a where mask is set and from vector b otherwise
+template <typename V>
+static inline V selectLanes(const V & mask, const V & a, const V & b) {
+  return ((a & mask) | (b & ~mask));
+}
+#endif
+
+/// @brief Clamps intermediary value to the range of Value
+/// @details Written without branches so that loops calling it can be vectorised
+inline IntermediaryValue ValueArray::clampRange(IntermediaryValue x) {
+  x = (x < static_cast<IntermediaryValue>(ValueBaseMin)) ? static_cast<IntermediaryValue>(ValueBaseMin) : x;
+  return ((x > static_cast<IntermediaryValue>(ValueBaseMax)) ? static_cast<IntermediaryValue>(ValueBaseMax) : x);
+}
+
+/// @brief Checks whether Value in internal representation is overflow value
+/// @details Written without branches so that loops calling it can be vectorised
+inline boolean ValueArray::isOverflow(ValueBase x) {
+  return ((x == ValueBaseMin) | (x == ValueBaseMax));
+}
+
+/// @brief Multiplies two Values in internal representation, the product is truncated
+/// towards zero exactly as Value multiplication does
+inline IntermediaryValue ValueArray::mulElement(ValueBase x, ValueBase y) {
+  static const IntermediaryValue fractionMask = (static_cast<IntermediaryValue>(1) << ValueFractionBits) - 1;
+  static const size_t signShift = sizeof(IntermediaryValue) * 8 - 1;
+  const IntermediaryValue product = static_cast<IntermediaryValue>(x) * static_cast<IntermediaryValue>(y);
+  return ((product + ((product >> signShift) & fractionMask)) >> ValueFractionBits);
+}
+
+/// @brief Calculates x * scale + offset for a single Value in internal representation
+/// @details Written without branches so that loops calling it can be vectorised
+inline ValueBase ValueArray::scaleOffsetElement(ValueBase x, ValueBase scale, ValueBase offset) {
+  const IntermediaryValue scaled = clampRange(mulElement(x, scale));
+  const IntermediaryValue result = clampRange(scaled + static_cast<IntermediaryValue>(offset));
+  const boolean scaledOverflow = (scaled == static_cast<IntermediaryValue>(ValueBaseMin)) || (scaled == static_cast<IntermediaryValue>(ValueBaseMax));
+  const boolean inputOverflow = (x == ValueBaseMin) || (x == ValueBaseMax);
+  return (static_cast<ValueBase>(inputOverflow ? x : (scaledOverflow ? scaled : result)));
+}
+
+/// @brief Calculates output[i] = input[i] * scale + offset
+/// @details The result is the same as of Value calculation scale * input[i] + offset,
+/// except that overflow input values remain the same overflow values.
+/// @param input Array of input values
+/// @param output Array to store the result (may be the same as input)
+/// @param count Number of values in the arrays
+/// @param scale Scale factor; if overflow value, all outputs are set to this value
+/// @param offset Offset; if overflow value, all outputs are set to this value
+void ValueArray::scaleOffset(const ValueBase * input, ValueBase * output, size_t count, const Value & scale, const Value & offset) {
+  if (!input || !output) return;
+  const ValueBase scaleRaw = scale.getRaw();
+  const ValueBase offsetRaw = offset.getRaw();
+  if (overflow(scale) || overflow(offset)) {
+    const ValueBase overflowRaw = overflow(scale) ? scaleRaw : offsetRaw;
+    for (size_t i = 0; i < count; i++)
+      output[i] = overflowRaw;
+    return;
+  }
+  for (size_t i = 0; i < count; i++)
+    output[i] = scaleOffsetElement(input[i], scaleRaw, offsetRaw);
+}
+
+/// @brief Clamps values to the range from low to high
+/// @param data Array of values to process
+/// @param count Number of values in the array
+/// @param low Lower limit
+/// @param high Upper limit, must be greater than or equal to low
+void ValueArray::clamp(ValueBase * data, size_t count, const Value & low, const Value & high) {
+  if (!data) return;
+  const ValueBase lowRaw = low.getRaw();
+  const ValueBase highRaw = high.getRaw();
+  size_t i = 0;
+#ifdef UTIL_DATA_VECTOR_KERNELS
+  const ValueBaseVector lowV = ValueBaseVector{} + lowRaw;
+  const ValueBaseVector highV = ValueBaseVector{} + highRaw;
+  for (; (i + valueBaseLanes) <= count; i += valueBaseLanes) {
+    ValueBaseVector x;
+    memcpy(&x, data + i, sizeof(x));
+    x = selectLanes<ValueBaseVector>(x < lowV, lowV, x);
+    x = selectLanes<ValueBaseVector>(x > highV, highV, x);
+    memcpy(data + i, &x, sizeof(x));
+  }
+#endif
+  for (; i < count; i++) {
+    if (data[i] < lowRaw) data[i] = lowRaw;
+    if (data[i] > highRaw) data[i] = highRaw;
+  }
+}
+
+/// @brief Calculates sum of the values
+/// @details The sum is accumulated in IntermediaryValue without intermediary range
+/// checks; the result is capped at the range of Value.
+/// @par If any of the values is overflow value, the first overflow value in the
+/// array is returned.
+/// @param data Array of values
+/// @param count Number of values in the array
+/// @return Sum of the values
+Value ValueArray::sum(const ValueBase * data, size_t count) {
+  if (!data) return (Value());
+  IntermediaryValue total = 0;
+  boolean overflowInputs = false;
+  for (size_t i = 0; i < count; i++) {
+    total += data[i];
+    overflowInputs |= isOverflow(data[i]);
+  }
+  if (overflowInputs) {
+    for (size_t i = 0; i < count; i++)
+      if (isOverflow(data[i])) return (Value::fromRaw(data[i]));
+  }
+  return (Value::fromRaw(static_cast<ValueBase>(clampRange(total))));
+}
+
+/// @brief Finds minimum and maximum values
+/// @param data Array of values
+/// @param count Number of values in the array
+/// @param minimum Minimum value in the array or zero if array is empty
+/// @param maximum Maximum value in the array or zero if array is empty
+void ValueArray::minMax(const ValueBase * data, size_t count, Value & minimum, Value & maximum) {
+  if (!data || !count) {
+    minimum = Value();
+    maximum = Value();
+    return;
+  }
+  ValueBase minRaw = data[0];
+  ValueBase maxRaw = data[0];
+  size_t i = 0;
+#ifdef UTIL_DATA_VECTOR_KERNELS
+  if (count >= valueBaseLanes) {
+    ValueBaseVector minV;
+    memcpy(&minV, data, sizeof(minV));
+    ValueBaseVector maxV = minV;
+    for (i = valueBaseLanes; (i + valueBaseLanes) <= count; i += valueBaseLanes) {
+      ValueBaseVector x;
+      memcpy(&x, data + i, sizeof(x));
+      minV = selectLanes<ValueBaseVector>(x < minV, x, minV);
+      maxV = selectLanes<ValueBaseVector>(x > maxV, x, maxV);
+    }
+    for (size_t j = 0; j < valueBaseLanes; j++) {
+      if (minV[j] < minRaw) minRaw = minV[j];
+      if (maxV[j] > maxRaw) maxRaw = maxV[j];
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    if (data[i] < minRaw) minRaw = data[i];
+    if (data[i] > maxRaw) maxRaw = data[i];
+  }
+  minimum = Value::fromRaw(minRaw);
+  maximum = Value::fromRaw(maxRaw);
+}
+
+/// @brief Calculates dot product of two arrays
+/// @details Every product is truncated as Value multiplication does, then the
+/// products are accumulated in IntermediaryValue without intermediary range checks;
+/// the result is capped at the range of Value.
+/// @par If any of the values is overflow value, the first overflow value is returned
+/// (data1[i] is checked before data2[i]).
+/// @param data1 First array of values
+/// @param data2 Second array of values
+/// @param count Number of values in each array
+/// @return Sum of data1[i] * data2[i]
+Value ValueArray::dot(const ValueBase * data1, const ValueBase * data2, size_t count) {
+  if (!data1 || !data2) return (Value());
+  IntermediaryValue total = 0;
+  boolean overflowInputs = false;
+  for (size_t i = 0; i < count; i++) {
+    total += mulElement(data1[i], data2[i]);
+    overflowInputs |= isOverflow(data1[i]) | isOverflow(data2[i]);
+  }
+  if (overflowInputs) {
+    for (size_t i = 0; i < count; i++) {
+      if (isOverflow(data1[i])) return (Value::fromRaw(data1[i]));
+      if (isOverflow(data2[i])) return (Value::fromRaw(data2[i]));
+    }
+  }
+  return (Value::fromRaw(static_cast<ValueBase>(clampRange(total))));
+}
+
 }; //namespace dsp
 
 namespace quantity {
 
+//////////////////////////////////////////////////////////////////////
+// Quantity
+//////////////////////////////////////////////////////////////////////
+
 boolean Quantity::setConvertedValue(
   value_t value,
   unit_t units,
@@ -278,46 +898,126 @@ boolean Quantity::setConvertedValue(
   return (true);
 }
 
-boolean Dimensionless::convertToUnit(Dimensionless::Unit unit) {
-  /// @brief Performs conversion to a measurement unit
+boolean Quantity::convertByTable(
+  unit_t unit,
+  text_t unitText,
+  const UnitConversionEntry * table,
+  size_t tableSize)
+{
+  /// @brief Converts initial value and range to a measurement unit using conversion table
   /// @param unit Measurement unit to convert to
-  /// @return true if conversion was successful,
-  /// false if error occured during conversion
-  const Unit initDimensionlessUnit = static_cast<Unit>(getInitUnit());
-  static const value_t percentFactor(100);
-  //If not initialised, fail
+  /// @param unitText Human-readable form of unit
+  /// @param table Conversion table of the descendant class
+  /// @param tableSize Number of entries in the conversion table
+  /// @return true if conversion was successful, false if quantity is not valid or
+  /// conversion from initial unit to unit is not defined
   if (!validate()) return (false);
-  //If init and target units are the same, revert to init values
-  if (unit == initDimensionlessUnit) {
-    setConvertedValue(getInitValue(),
-                      getInitUnit(),
-                      getUnitTextByUnit(initDimensionlessUnit),
-                      getInitMinRange(),
-                      getInitMaxRange());
-    return (true);
-  }
-  //Convert from no-unit to percent (multiply by 100%)
-  if (initDimensionlessUnit == Unit::NONE && unit == Unit::PERCENT) {
-    setConvertedValue(getInitValue() * percentFactor,
-                      static_cast <unit_t>(Unit::PERCENT),
-                      getUnitTextByUnit(Unit::PERCENT),
-                      getInitMinRange() * percentFactor,
-                      getInitMaxRange() * percentFactor);
+  UnitConversion conversion;
+  if (!UnitConversion::find(table, tableSize, initUnit, unit, conversion)) return (false);
+  return (applyConversion(unit, unitText, conversion));
+}
+
+boolean Quantity::applyConversion(
+  unit_t unit,
+  text_t unitText,
+  const UnitConversion & conversion)
+{
+  /// @brief Converts initial value and range to a measurement unit
+  /// @param unit Measurement unit to convert to
+  /// @param unitText Human-readable form of unit
+  /// @param conversion Conversion from initial unit to unit
+  /// @return true if conversion was successful, false if quantity is not valid
+  return (setConvertedValue(conversion.apply(initValue),
+                            unit,
+                            unitText,
+                            conversion.apply(initMinRange),
+                            conversion.apply(initMaxRange)));
+}
+
+//////////////////////////////////////////////////////////////////////
+// UnitConversion
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Converts array of values
+/// @details Converting the whole array is a single loop without Value range
+/// checks of intermediary results, the result is the same as converting every
+/// value with apply(const Value &).
+/// @param input Array of values to convert
+/// @param output Array to store the result (may be the same as input)
+/// @param count Number of values in the arrays
+void UnitConversion::apply(const ValueBase * input, ValueBase * output, size_t count) const {
+  if (!input || !output) return;
+  for (size_t i = 0; i < count; i++)
+    output[i] = applyElement(input[i]);
+}
+
+/// @brief Finds conversion between measurement units in conversion table
+/// @param table Conversion table
+/// @param tableSize Number of entries in the table
+/// @param fromUnit Measurement unit to convert from
+/// @param toUnit Measurement unit to convert to
+/// @param conversion Found conversion; identity conversion if fromUnit and toUnit
+/// are the same
+/// @return true if conversion was found, false otherwise
+boolean UnitConversion::find(const UnitConversionEntry * table,
+                             size_t tableSize,
+                             uint8_t fromUnit,
+                             uint8_t toUnit,
+                             UnitConversion & conversion)
+{
+  if (fromUnit == toUnit) {
+    conversion = UnitConversion();
     return (true);
   }
-  //Convert from percent to no-unit (divide by 100%)
-  if (initDimensionlessUnit == Unit::PERCENT && unit == Unit::NONE) {
-    setConvertedValue(getInitValue() / percentFactor,
-                      static_cast <unit_t>(Unit::NONE),
-                      getUnitTextByUnit (Unit::NONE),
-                      getInitMinRange() / percentFactor,
-                      getInitMaxRange() / percentFactor);
-    return (true);
+  if (!table) return (false);
+  for (size_t i = 0; i < tableSize; i++) {
+    if ((table[i].fromUnit == fromUnit) && (table[i].toUnit == toUnit)) {
+      conversion = table[i].conversion;
+      return (true);
+    }
   }
-  //Unit not found or conversion not defined, fail
   return (false);
 }
 
+//////////////////////////////////////////////////////////////////////
+// Dimensionless Quantity
+//////////////////////////////////////////////////////////////////////
+
+static constexpr UnitConversionEntry dimensionlessConversions[] = {
+  //No-unit to percent: multiply by 100%
+  {static_cast<Quantity::unit_t>(Dimensionless::Unit::NONE), static_cast<Quantity::unit_t>(Dimensionless::Unit::PERCENT), UnitConversion(100, 1)},
+  //Percent to no-unit: divide by 100%
+  {static_cast<Quantity::unit_t>(Dimensionless::Unit::PERCENT), static_cast<Quantity::unit_t>(Dimensionless::Unit::NONE), UnitConversion(1, 100)},
+};
+
+boolean Dimensionless::convertToUnit(Dimensionless::Unit unit) {
+  /// @brief Performs conversion to a measurement unit
+  /// @param unit Measurement unit to convert to
+  /// @return true if conversion was successful,
+  /// false if error occured during conversion
+  return (convertByTable(static_cast<unit_t>(unit),
+                         getUnitTextByUnit(unit),
+                         dimensionlessConversions,
+                         sizeof(dimensionlessConversions) / sizeof(dimensionlessConversions[0])));
+}
+
+boolean Dimensionless::getConversion(Dimensionless::Unit fromUnit,
+                                     Dimensionless::Unit toUnit,
+                                     UnitConversion & conversion)
+{
+  /// @brief Provides conversion between measurement units, e.g. for converting
+  /// arrays of values with UnitConversion::apply()
+  /// @param fromUnit Measurement unit to convert from
+  /// @param toUnit Measurement unit to convert to
+  /// @param conversion Conversion from fromUnit to toUnit
+  /// @return true if conversion is defined, false otherwise
+  return (UnitConversion::find(dimensionlessConversions,
+                               sizeof(dimensionlessConversions) / sizeof(dimensionlessConversions[0]),
+                               static_cast<unit_t>(fromUnit),
+                               static_cast<unit_t>(toUnit),
+                               conversion));
+}
+
 Dimensionless::text_t Dimensionless::getUnitTextByUnit(Dimensionless::Unit unit) {
   /// @brief Returns human-readable form of a measurement unit
   /// @param Measurement unit
@@ -335,43 +1035,43 @@ Dimensionless::text_t Dimensionless::getUnitTextByUnit(Dimensionless::Unit unit)
   return (StrRef());
 }
 
+//////////////////////////////////////////////////////////////////////
+// Temperature
+//////////////////////////////////////////////////////////////////////
+
+static constexpr UnitConversionEntry temperatureConversions[] = {
+  //Celsius to Fahrenheit: F = C * 9 / 5 + 32
+  {static_cast<Quantity::unit_t>(Temperature::Unit::CELSIUS), static_cast<Quantity::unit_t>(Temperature::Unit::FAHRENHEIT), UnitConversion(9, 5, 32)},
+  //Fahrenheit to Celsius: C = (F - 32) * 5 / 9 = F * 5 / 9 - 160 / 9
+  {static_cast<Quantity::unit_t>(Temperature::Unit::FAHRENHEIT), static_cast<Quantity::unit_t>(Temperature::Unit::CELSIUS), UnitConversion(5, 9, -160, 9)},
+};
+
 boolean Temperature::convertToUnit(Temperature::Unit unit) {
   /// @brief Performs conversion to a measurement unit
   /// @param unit Measurement unit to convert to
   /// @return true if conversion was successful,
   /// false if error occured during conversion
-  const Unit initTempUnit = static_cast<Unit>(getInitUnit());
-  //If not initialised, fail
-  if (!validate()) return (false);
-  //If init and target units are the same, revert to init values
-  if (unit == initTempUnit) {
-    setConvertedValue(getInitValue(),
-                      getInitUnit(),
-                      getUnitTextByUnit(initTempUnit),
-                      getInitMinRange(),
-                      getInitMaxRange());
-    return (true);
-  }
-  //Convert Celsius to Fahrenheit
-  if (initTempUnit == Unit::CELSIUS && unit == Unit::FAHRENHEIT) {
-    setConvertedValue(celsiusToFahrenheit(getInitValue()),
-                      static_cast <unit_t>(Unit::FAHRENHEIT),
-                      getUnitTextByUnit(Unit::FAHRENHEIT),
-                      celsiusToFahrenheit(getInitMinRange()),
-                      celsiusToFahrenheit(getInitMaxRange()));
-    return (true);
-  }
-  //Convert Fahrenheit to Celsius
-  if (initTempUnit == Unit::FAHRENHEIT && unit == Unit::CELSIUS) {
-    setConvertedValue(fahrenheitToCelsius(getInitValue()),
-                      static_cast <unit_t>(Unit::CELSIUS),
-                      getUnitTextByUnit (Unit::CELSIUS),
-                      fahrenheitToCelsius(getInitMinRange()),
-                      fahrenheitToCelsius(getInitMaxRange()));
-    return (true);
-  }
-  //Unit not found or conversion not defined, fail
-  return (false);
+  return (convertByTable(static_cast<unit_t>(unit),
+                         getUnitTextByUnit(unit),
+                         temperatureConversions,
+                         sizeof(temperatureConversions) / sizeof(temperatureConversions[0])));
+}
+
+boolean Temperature::getConversion(Temperature::Unit fromUnit,
+                                   Temperature::Unit toUnit,
+                                   UnitConversion & conversion)
+{
+  /// @brief Provides conversion between measurement units, e.g. for converting
+  /// arrays of values with UnitConversion::apply()
+  /// @param fromUnit Measurement unit to convert from
+  /// @param toUnit Measurement unit to convert to
+  /// @param conversion Conversion from fromUnit to toUnit
+  /// @return true if conversion is defined, false otherwise
+  return (UnitConversion::find(temperatureConversions,
+                               sizeof(temperatureConversions) / sizeof(temperatureConversions[0]),
+                               static_cast<unit_t>(fromUnit),
+                               static_cast<unit_t>(toUnit),
+                               conversion));
 }
 
 Temperature::text_t Temperature::getUnitTextByUnit(Temperature::Unit unit) {
@@ -392,22 +1092,361 @@ Temperature::text_t Temperature::getUnitTextByUnit(Temperature::Unit unit) {
   //return (nullptr);
 }
 
-Temperature::value_t Temperature::celsiusToFahrenheit(value_t celsiusValue) {
-  ///Convert temperature from degrees Celsius to degrees Fahrenheit
-  static const value_t celsiusFahrenheitA1(9);
-  static const value_t celsiusFahrenheitA2(5);
-  static const value_t celsiusFahrenheitB(32);
-  return ((celsiusValue * celsiusFahrenheitA1 / celsiusFahrenheitA2) + celsiusFahrenheitB);
+//////////////////////////////////////////////////////////////////////
+// Concentration
+//////////////////////////////////////////////////////////////////////
+
+static constexpr UnitConversionEntry concentrationConversions[] = {
+  //ppm to ppb: multiply by 1000
+  {static_cast<Quantity::unit_t>(Concentration::Unit::PPM), static_cast<Quantity::unit_t>(Concentration::Unit::PPB), UnitConversion(1000, 1)},
+  //ppb to ppm: divide by 1000
+  {static_cast<Quantity::unit_t>(Concentration::Unit::PPB), static_cast<Quantity::unit_t>(Concentration::Unit::PPM), UnitConversion(1, 1000)},
+};
+
+boolean Concentration::convertToUnit(Concentration::Unit unit) {
+  /// @brief Performs conversion to a measurement unit
+  /// @param unit Measurement unit to convert to
+  /// @return true if conversion was successful,
+  /// false if error occured during conversion or if molar mass required for
+  /// conversion was not set
+  UnitConversion conversion;
+  if (!getConversion(static_cast<Unit>(getInitUnit()), unit, molarMass, conversion)) return (false);
+  return (applyConversion(static_cast<unit_t>(unit), getUnitTextByUnit(unit), conversion));
+}
+
+Concentration::text_t Concentration::getUnitTextByUnit(Concentration::Unit unit) {
+  /// @brief Returns human-readable form of a measurement unit
+  /// @param Measurement unit
+  /// @return A cstring in RAM with human-readable form of unit
+  switch (unit) {
+    case Unit::PPM:
+      return (text_t(F("ppm")));
+    case Unit::PPB:
+      return (text_t(F("ppb")));
+    case Unit::MG_PER_CUBIC_METER:
+      return (text_t(F("mg/m3")));
+  }
+  return (StrRef());
+}
+
+boolean Concentration::getConversion(Concentration::Unit fromUnit,
+                                     Concentration::Unit toUnit,
+                                     value_t molarMass,
+                                     UnitConversion & conversion)
+{
+  /// @brief Provides conversion between measurement units, e.g. for converting
+  /// arrays of values with UnitConversion::apply()
+  /// @details mg/m3 = ppm * molarMass / molarVolume, molar volume is 24.45 l/mol
+  /// @param fromUnit Measurement unit to convert from
+  /// @param toUnit Measurement unit to convert to
+  /// @param molarMass Molar mass of the gas in grams per mole, only used for conversion
+  /// to or from MG_PER_CUBIC_METER
+  /// @param conversion Conversion from fromUnit to toUnit
+  /// @return true if conversion is defined, false otherwise
+  static const int32_t molarVolume = 2445; //24.45 l/mol, in 0.01 l/mol
+  static const int32_t molarVolumeFactor = 100;
+  static const int32_t ppbPerPpm = 1000;
+  static const int32_t molarMassDivider = static_cast<int32_t>(1) << ValueFractionBits;
+  static const int32_t maxMolarMass = 20000;
+  if (UnitConversion::find(concentrationConversions,
+                           sizeof(concentrationConversions) / sizeof(concentrationConversions[0]),
+                           static_cast<unit_t>(fromUnit),
+                           static_cast<unit_t>(toUnit),
+                           conversion)) return (true);
+  if (molarMass.overflow() || (molarMass <= value_t(0)) || (molarMass > value_t(maxMolarMass))) return (false);
+  const int32_t molarMassRaw = molarMass.getRaw();
+  if (fromUnit == Unit::PPM && toUnit == Unit::MG_PER_CUBIC_METER) {
+    conversion = UnitConversion(molarMassRaw * molarVolumeFactor, molarVolume * molarMassDivider);
+    return (true);
+  }
+  if (fromUnit == Unit::PPB && toUnit == Unit::MG_PER_CUBIC_METER) {
+    conversion = UnitConversion(molarMassRaw, molarVolume * molarMassDivider * (ppbPerPpm / molarVolumeFactor));
+    return (true);
+  }
+  if (fromUnit == Unit::MG_PER_CUBIC_METER && toUnit == Unit::PPM) {
+    conversion = UnitConversion(molarVolume * molarMassDivider, molarMassRaw * molarVolumeFactor);
+    return (true);
+  }
+  if (fromUnit == Unit::MG_PER_CUBIC_METER && toUnit == Unit::PPB) {
+    conversion = UnitConversion(molarVolume * molarMassDivider * (ppbPerPpm / molarVolumeFactor), molarMassRaw);
+    return (true);
+  }
+  return (false);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Humidity
+//////////////////////////////////////////////////////////////////////
+
+//Magnus formula coefficients and other constants used for humidity calculations,
+//intermediary values (dsp::FixedPointMath::fractionBits fraction bits)
+static const int64_t magnusB = 18919330939;            //17.62
+static const int64_t magnusC = 261048112251;           //243.12 degrees Celsius
+static const int64_t zeroCelsius = 293292579226;       //273.15 Kelvin
+static const int64_t absoluteHumidityB = 14224017715;  //6.112 hPa * 2.1674 g*K/(m3*hPa)
+static const int64_t ln100 = 4944763835;               //ln(100)
+
+boolean Humidity::convertToUnit(Humidity::Unit unit) {
+  /// @brief Performs conversion to a measurement unit
+  /// @param unit Measurement unit to convert to
+  /// @return true if conversion was successful,
+  /// false if error occured during conversion or temperature is out of range
+  UnitConversion conversion;
+  if (!getConversion(static_cast<Unit>(getInitUnit()), unit, temperature, conversion)) return (false);
+  return (applyConversion(static_cast<unit_t>(unit), getUnitTextByUnit(unit), conversion));
+}
+
+Humidity::text_t Humidity::getUnitTextByUnit(Humidity::Unit unit) {
+  /// @brief Returns human-readable form of a measurement unit
+  /// @param Measurement unit
+  /// @return A cstring in RAM with human-readable form of unit
+  switch (unit) {
+    case Unit::RELATIVE:
+      return (text_t(F("%")));
+    case Unit::ABSOLUTE:
+      return (text_t(F("g/m3")));
+  }
+  return (StrRef());
+}
+
+boolean Humidity::getConversion(Humidity::Unit fromUnit,
+                                Humidity::Unit toUnit,
+                                value_t temperature,
+                                UnitConversion & conversion)
+{
+  /// @brief Provides conversion between measurement units at given temperature,
+  /// e.g. for converting arrays of values with UnitConversion::apply()
+  /// @details Absolute humidity is proportional to relative humidity at the given
+  /// temperature, see absoluteHumidityFactor()
+  /// @param fromUnit Measurement unit to convert from
+  /// @param toUnit Measurement unit to convert to
+  /// @param temperature Air temperature in degrees Celsius
+  /// @param conversion Conversion from fromUnit to toUnit
+  /// @return true if conversion is defined, false otherwise
+  static const int32_t one = static_cast<int32_t>(1) << dsp::FixedPointMath::fractionBits;
+  if (fromUnit == toUnit) {
+    conversion = UnitConversion();
+    return (true);
+  }
+  const int64_t factor = absoluteHumidityFactor(temperature);
+  if (!factor) return (false);
+  if (fromUnit == Unit::RELATIVE && toUnit == Unit::ABSOLUTE) {
+    conversion = UnitConversion(static_cast<int32_t>(factor), one);
+    return (true);
+  }
+  if (fromUnit == Unit::ABSOLUTE && toUnit == Unit::RELATIVE) {
+    conversion = UnitConversion(one, static_cast<int32_t>(factor));
+    return (true);
+  }
+  return (false);
+}
+
+Humidity::value_t Humidity::getDewPoint(void) const {
+  /// @brief Calculates dew point by Magnus formula
+  /// @details gamma = ln(RH / 100%) + b * t / (c + t), dew point = c * gamma / (b - gamma)
+  /// @return Dew point in degrees Celsius or overflow value if the quantity is
+  /// not valid or dew point cannot be calculated
+  static const value_t noDewPoint = value_t::fromRaw(ValueBaseMin);
+  if (!validate()) return (noDewPoint);
+  value_t relativeHumidity = getInitValue();
+  if (static_cast<Unit>(getInitUnit()) != Unit::RELATIVE) {
+    UnitConversion conversion;
+    if (!getConversion(static_cast<Unit>(getInitUnit()), Unit::RELATIVE, temperature, conversion)) return (noDewPoint);
+    relativeHumidity = conversion.apply(relativeHumidity);
+  }
+  if (relativeHumidity.overflow() || (relativeHumidity <= value_t(0))) return (noDewPoint);
+  if (!absoluteHumidityFactor(temperature)) return (noDewPoint);
+  const int64_t t = dsp::FixedPointMath::fromFixedPoint(temperature);
+  const int64_t gamma =
+    dsp::FixedPointMath::log(static_cast<uint32_t>(relativeHumidity.getRaw()), ValueFractionBits) - ln100 +
+    dsp::FixedPointMath::divIntermediary(dsp::FixedPointMath::mulIntermediary(magnusB, t), magnusC + t);
+  const int64_t dewPoint =
+    dsp::FixedPointMath::divIntermediary(dsp::FixedPointMath::mulIntermediary(magnusC, gamma), magnusB - gamma);
+  return (dsp::FixedPointMath::toFixedPoint<value_t>(dewPoint));
+}
+
+int64_t Humidity::absoluteHumidityFactor(value_t temperature) {
+  /// @brief Calculates ratio of absolute humidity (g/m3) to relative humidity (%)
+  /// @details Saturation vapour pressure is Es = 6.112 hPa * e^(b * t / (c + t)),
+  /// absolute humidity is 2.1674 * RH * Es / (273.15 + t)
+  /// @param temperature Air temperature in degrees Celsius
+  /// @return Ratio with dsp::FixedPointMath::fractionBits fraction bits or zero
+  /// if temperature is out of range
+  static const value_t minTemperature(-45);
+  static const value_t maxTemperature(60);
+  if (temperature.overflow() || (temperature < minTemperature) || (temperature > maxTemperature)) return (0);
+  const int64_t t = dsp::FixedPointMath::fromFixedPoint(temperature);
+  const int64_t exponent =
+    dsp::FixedPointMath::divIntermediary(dsp::FixedPointMath::mulIntermediary(magnusB, t), magnusC + t);
+  const int64_t saturationFactor =
+    dsp::FixedPointMath::mulIntermediary(absoluteHumidityB, dsp::FixedPointMath::exp(exponent, dsp::FixedPointMath::fractionBits));
+  return (dsp::FixedPointMath::divIntermediary(saturationFactor, zeroCelsius + t));
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pressure
+//////////////////////////////////////////////////////////////////////
+
+//1 mmHg = 101325 / 760 Pa
+static constexpr UnitConversionEntry pressureConversions[] = {
+  {static_cast<Quantity::unit_t>(Pressure::Unit::PASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::HECTOPASCAL), UnitConversion(1, 100)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::PASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::KILOPASCAL), UnitConversion(1, 1000)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::PASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::MM_HG), UnitConversion(760, 101325)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::HECTOPASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::PASCAL), UnitConversion(100, 1)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::HECTOPASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::KILOPASCAL), UnitConversion(1, 10)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::HECTOPASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::MM_HG), UnitConversion(76000, 101325)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::KILOPASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::PASCAL), UnitConversion(1000, 1)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::KILOPASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::HECTOPASCAL), UnitConversion(10, 1)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::KILOPASCAL), static_cast<Quantity::unit_t>(Pressure::Unit::MM_HG), UnitConversion(760000, 101325)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::MM_HG), static_cast<Quantity::unit_t>(Pressure::Unit::PASCAL), UnitConversion(101325, 760)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::MM_HG), static_cast<Quantity::unit_t>(Pressure::Unit::HECTOPASCAL), UnitConversion(101325, 76000)},
+  {static_cast<Quantity::unit_t>(Pressure::Unit::MM_HG), static_cast<Quantity::unit_t>(Pressure::Unit::KILOPASCAL), UnitConversion(101325, 760000)},
+};
+
+boolean Pressure::convertToUnit(Pressure::Unit unit) {
+  /// @brief Performs conversion to a measurement unit
+  /// @param unit Measurement unit to convert to
+  /// @return true if conversion was successful,
+  /// false if error occured during conversion
+  return (convertByTable(static_cast<unit_t>(unit),
+                         getUnitTextByUnit(unit),
+                         pressureConversions,
+                         sizeof(pressureConversions) / sizeof(pressureConversions[0])));
+}
+
+Pressure::text_t Pressure::getUnitTextByUnit(Pressure::Unit unit) {
+  /// @brief Returns human-readable form of a measurement unit
+  /// @param Measurement unit
+  /// @return A cstring in RAM with human-readable form of unit
+  switch (unit) {
+    case Unit::PASCAL:
+      return (text_t(F("Pa")));
+    case Unit::HECTOPASCAL:
+      return (text_t(F("hPa")));
+    case Unit::KILOPASCAL:
+      return (text_t(F("kPa")));
+    case Unit::MM_HG:
+      return (text_t(F("mmHg")));
+  }
+  return (StrRef());
 }
 
-Temperature::value_t Temperature::fahrenheitToCelsius(value_t fahrenheitValue) {
-  ///Convert temperature from degrees Fahrenheit to degrees Celsius
-  static const value_t fahrenheitCelsiusA1(5);
-  static const value_t fahrenheitCelsiusA2(9);
-  static const value_t fahrenheitCelsiusB(32);
-  return ((fahrenheitValue - fahrenheitCelsiusB) * fahrenheitCelsiusA1 / fahrenheitCelsiusA2);
+boolean Pressure::getConversion(Pressure::Unit fromUnit,
+                                Pressure::Unit toUnit,
+                                UnitConversion & conversion)
+{
+  /// @brief Provides conversion between measurement units, e.g. for converting
+  /// arrays of values with UnitConversion::apply()
+  /// @param fromUnit Measurement unit to convert from
+  /// @param toUnit Measurement unit to convert to
+  /// @param conversion Conversion from fromUnit to toUnit
+  /// @return true if conversion is defined, false otherwise
+  return (UnitConversion::find(pressureConversions,
+                               sizeof(pressureConversions) / sizeof(pressureConversions[0]),
+                               static_cast<unit_t>(fromUnit),
+                               static_cast<unit_t>(toUnit),
+                               conversion));
 }
 
 }; //namespace quantity
 
+namespace series {
+
+//////////////////////////////////////////////////////////////////////
+// SeriesEncoder
+//////////////////////////////////////////////////////////////////////
+
+boolean SeriesEncoder::encode(const Sample & sample) {
+  /// @brief Encodes the sample and appends it to the buffer
+  /// @details First sample stores timestamp and value as they are, second sample
+  /// stores timestamp delta, subsequent samples store delta of timestamp delta.
+  /// @param sample Sample to encode
+  /// @return true if the sample was encoded, false if the encoder is not initialised
+  /// or there is not enough space in buffer (in this case nothing is written)
+  if (!validate()) return (false);
+  const uint32_t timestamp = sample.timestamp;
+  const uint32_t value = static_cast<uint32_t>(sample.value.getRaw());
+  const uint32_t timestampDelta = timestamp - previousTimestamp;
+  const uint32_t encodedTimestamp = (samples < 2) ? timestampDelta : (timestampDelta - previousTimestampDelta);
+  uint8_t encoded[maxSampleSize];
+  size_t encodedSize = writeVarint(encoded, zigZagEncode(static_cast<int32_t>(encodedTimestamp)));
+  encodedSize += writeVarint(&encoded[encodedSize], zigZagEncode(static_cast<int32_t>(value - previousValue)));
+  if ((bufferSize - position) < encodedSize) return (false);
+  memcpy(&buffer[position], encoded, encodedSize);
+  position += encodedSize;
+  if (samples) previousTimestampDelta = timestampDelta;
+  previousTimestamp = timestamp;
+  previousValue = value;
+  samples++;
+  return (true);
+}
+
+size_t SeriesEncoder::writeVarint(uint8_t * buffer, uint32_t value) {
+  /// @brief Writes variable length integer, 7 bits per byte, least significant
+  /// bits first
+  /// @param buffer Buffer to write to, must have space for at least 5 bytes
+  /// @param value Value to write
+  /// @return Number of bytes written
+  static const uint8_t moreBytesFlag = 0x80;
+  static const uint8_t bitsPerByte = 7;
+  size_t size = 0;
+  while (value >= moreBytesFlag) {
+    buffer[size++] = static_cast<uint8_t>(value) | moreBytesFlag;
+    value >>= bitsPerByte;
+  }
+  buffer[size++] = static_cast<uint8_t>(value);
+  return (size);
+}
+
+size_t SeriesEncoder::readVarint(const uint8_t * buffer, size_t bufferSize, uint32_t & value) {
+  /// @brief Reads variable length integer written by writeVarint()
+  /// @param buffer Buffer to read from
+  /// @param bufferSize Number of bytes available in buffer
+  /// @param value Variable to store the read value
+  /// @return Number of bytes read or 0 if the integer is truncated or too long
+  static const uint8_t moreBytesFlag = 0x80;
+  static const uint8_t bitsPerByte = 7;
+  static const size_t maxSize = 5;
+  value = 0;
+  for (size_t i = 0; (i < bufferSize) && (i < maxSize); i++) {
+    value |= static_cast<uint32_t>(buffer[i] & ~moreBytesFlag) << (i * bitsPerByte);
+    if (!(buffer[i] & moreBytesFlag)) return (i + 1);
+  }
+  return (0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// SeriesDecoder
+//////////////////////////////////////////////////////////////////////
+
+boolean SeriesDecoder::decode(Sample & sample) {
+  /// @brief Decodes next sample
+  /// @param sample Variable to store the decoded sample
+  /// @return true if the sample was decoded, false if there are no more samples
+  /// or the data are malformed (see error())
+  if (finished()) return (false);
+  uint32_t encodedTimestamp, encodedValue;
+  const size_t timestampSize = SeriesEncoder::readVarint(&buffer[position], bufferSize - position, encodedTimestamp);
+  const size_t valueSize = timestampSize ?
+                           SeriesEncoder::readVarint(&buffer[position + timestampSize], bufferSize - position - timestampSize, encodedValue) : 0;
+  if (!valueSize) {
+    malformed = true;
+    return (false);
+  }
+  position += timestampSize + valueSize;
+  const uint32_t timestampDifference = static_cast<uint32_t>(SeriesEncoder::zigZagDecode(encodedTimestamp));
+  const uint32_t timestampDelta = (samples < 2) ? timestampDifference : (previousTimestampDelta + timestampDifference);
+  const uint32_t timestamp = previousTimestamp + timestampDelta;
+  const uint32_t value = previousValue + static_cast<uint32_t>(SeriesEncoder::zigZagDecode(encodedValue));
+  if (samples) previousTimestampDelta = timestampDelta;
+  previousTimestamp = timestamp;
+  previousValue = value;
+  samples++;
+  sample.timestamp = timestamp;
+  sample.value = Value::fromRaw(static_cast<ValueBase>(value));
+  return (true);
+}
+
+}; //namespace series
+
 }; //namespace util
@@ -13,6 +13,7 @@
  *  * checksum: checksum calculation
  *  * dsp: digital signal processing
  *  * quantity: physical quantities
+ *  * series: compact encoding of timestamped value series
  */
 
 #ifndef UTIL_DATA_H
@@ -20,6 +21,8 @@
 
 #include <Arduino.h>
 
+#include "project_config.h"
+
 //new, placement new and delete are already defined in ESP8266 libraries
 //void * operator new (size_t size) { return malloc (size); }
 //void * operator new (size_t size, void * ptr) { return ptr; }
@@ -53,6 +56,46 @@ struct TypeSelect<true, T1, T2> {
   typedef T1 data_t;
 };
 
+//////////////////////////////////////////////////////////////////////
+// RemoveReference, move & forward
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Removes reference from type
+/// @details RemoveReference::data_t is defined as <typename T> with
+/// lvalue or rvalue reference removed.
+template <typename T>
+struct RemoveReference {
+  typedef T data_t;
+};
+/// See RemoveReference
+template <typename T>
+struct RemoveReference<T &> {
+  typedef T data_t;
+};
+/// See RemoveReference
+template <typename T>
+struct RemoveReference < T && > {
+  typedef T data_t;
+};
+
+/// @brief Casts argument to rvalue reference so that it can be moved from
+template <typename T>
+constexpr typename RemoveReference<T>::data_t && move(T && t) {
+  return (static_cast < typename RemoveReference<T>::data_t && > (t));
+}
+
+/// @brief Forwards argument preserving its value category (perfect forwarding)
+template <typename T>
+constexpr T && forward(typename RemoveReference<T>::data_t & t) {
+  return (static_cast < T && > (t));
+}
+
+/// See forward
+template <typename T>
+constexpr T && forward(typename RemoveReference<T>::data_t && t) {
+  return (static_cast < T && > (t));
+}
+
 //////////////////////////////////////////////////////////////////////
 // Ref
 //////////////////////////////////////////////////////////////////////
@@ -185,21 +228,79 @@ class StrRef : public Ref<char> {
 
 namespace arrays {
 
+//////////////////////////////////////////////////////////////////////
+// RingBufferIterator
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Forward iterator over the items of a ring buffer
+/// @details Walks the items from oldest to newest; provides range-based for loop
+/// support for RingBuffer and StaticRingBuffer. The iterator performs no validity
+/// checks: it must not be used after the ring buffer is modified.
+/// @tparam T Type of the data stored in the ring buffer
+template <typename T>
+class RingBufferIterator {
+  public:
+    inline RingBufferIterator(const T * current, const T * bufferBegin, const T * bufferEnd, size_t remaining);
+    inline const T & operator * (void) const;
+    inline RingBufferIterator & operator ++ (void);
+    inline boolean operator != (const RingBufferIterator & other) const;
+  private:
+    const T * current;
+    const T * bufferBegin;
+    const T * bufferEnd;
+    size_t remaining;
+};
+
+template <typename T>
+RingBufferIterator<T>::RingBufferIterator(const T * current, const T * bufferBegin, const T * bufferEnd, size_t remaining) :
+  current(current), bufferBegin(bufferBegin), bufferEnd(bufferEnd), remaining(remaining) {
+  /// @param current Item pointed to by the iterator
+  /// @param bufferBegin Beginning of the ring buffer memory area
+  /// @param bufferEnd End of the ring buffer memory area (past the last item)
+  /// @param remaining Number of items from current to the end of the sequence
+}
+
+template <typename T>
+const T & RingBufferIterator<T>::operator * (void) const {
+  return (*current);
+}
+
+template <typename T>
+RingBufferIterator<T> & RingBufferIterator<T>::operator ++ (void) {
+  current++;
+  if (current == bufferEnd) current = bufferBegin;
+  remaining--;
+  return (*this);
+}
+
+template <typename T>
+boolean RingBufferIterator<T>::operator != (const RingBufferIterator<T> & other) const {
+  return (remaining != other.remaining);
+}
+
 //////////////////////////////////////////////////////////////////////
 // RingBuffer
 //////////////////////////////////////////////////////////////////////
 
 /// @brief Circular buffer
-/// @tparam T Type of the data to be stored in buffer. Must have a trivial
-/// constructor and copy constructor to compile (or to be a PODtype)
+/// @tparam T Type of the data to be stored in buffer. Must have a copy or move
+/// constructor. If T has no default constructor, the default item must be
+/// specified in constructor.
 /// @warning If <T> has a constructor and its sizeof() is smaller than pointer's
-/// sizeof(), <T> will be passed by value which results in extra copy constructor
-/// calls). To avoid this, make sure that sizeof(T) is greater or equal than
-/// sizeof(T*).
+/// sizeof(), <T> will be returned by subscript operator by value which results in
+/// extra copy constructor calls). To avoid this, make sure that sizeof(T) is greater
+/// or equal than sizeof(T*).
 /// @details Implements a circular buffer. Data are sent to the circular buffer with
-/// push() method until buffer is full and oldest data is overwritten. Oldest data
-/// can be removed from the circular buffer with pop() method. Any element in circular
-/// buffer is accessible via subscript operator (0 is oldest stored element).
+/// push() or emplace() method until buffer is full and oldest data is overwritten
+/// (the destructor of the overwritten item is called). Oldest data can be removed
+/// from the circular buffer with pop() method. Any element in circular buffer is
+/// accessible via subscript operator (0 is oldest stored element).
+/// @par Items are constructed in the buffer memory only when pushed: push(T&&)
+/// moves the item and emplace() constructs it in place from constructor parameters,
+/// thus large items (e.g. quantity::Quantity) are not copied. Multiple trivially
+/// copyable items are copied with memcpy() by push(const T *, size_t).
+/// @par Items can also be accessed in range-based for loop (oldest item first); this
+/// skips per-access validity and index checks performed by subscript operator.
 
 template <typename T>
 class RingBuffer {
@@ -216,18 +317,29 @@ class RingBuffer {
   public:
     inline RingBuffer ();
     inline RingBuffer (void * buffer, size_t itemsInBuffer);
+    inline RingBuffer (void * buffer, size_t itemsInBuffer, const T & defaultItem);
     inline RingBuffer (size_t itemsInBuffer);
+    inline RingBuffer (size_t itemsInBuffer, const T & defaultItem);
     inline ~RingBuffer ();
     inline boolean validate(void) const;
-    void push(data_t item);
+    void push(const T & item);
+    void push(T && item);
+    void push(const T * items, size_t number);
+    template <typename... Args> void emplace(Args && ... args);
     inline void pop(void);
     inline void pop(size_t number);
     inline size_t count(void) const;
     inline boolean full(void) const;
     inline boolean empty(void) const;
     data_t operator [] (size_t index) const;
+  public:
+    typedef RingBufferIterator<T> Iterator;
+    inline Iterator begin(void) const;
+    inline Iterator end(void) const;
   private:
     inline void popUnsafe(void);
+    inline T * reserveUnsafe(void);
+    inline void allocate(size_t itemsInBuffer);
   private:
     T * ringBuffer = NULL;
     boolean memoryAllocated = false;
@@ -258,32 +370,58 @@ RingBuffer<T>::RingBuffer (void * buffer, size_t itemsInBuffer) {
   ringBufferSize = itemsInBuffer;
 }
 
+template <typename T>
+RingBuffer<T>::RingBuffer (void * buffer, size_t itemsInBuffer, const T & defaultItem) : defaultItem(defaultItem) {
+  /// @brief Creates a ring buffer with an item returned by subscript operator on error
+  /// @details Use this constructor if T has no default constructor
+  /// @param buffer Memory area to store buffer data
+  /// @param itemsInBuffer How much items of type T can be stored in the buffer
+  /// @param defaultItem Item returned by subscript operator if index is out of range
+  ringBuffer = reinterpret_cast<T*>(buffer);
+  ringBufferSize = itemsInBuffer;
+}
+
 template <typename T>
 RingBuffer<T>::RingBuffer (size_t itemsInBuffer) {
   /// @brief Creates a ring buffer and allocates memory to store the data
   /// @warning Not recommended for repeated use due to possible memory fragmentation
   /// @param itemsInBuffer How much items of type T can be stored in the buffer
+  allocate(itemsInBuffer);
+}
+
+template <typename T>
+RingBuffer<T>::RingBuffer (size_t itemsInBuffer, const T & defaultItem) : defaultItem(defaultItem) {
+  /// @brief Creates a ring buffer with an item returned by subscript operator on error
+  /// and allocates memory to store the data
+  /// @details Use this constructor if T has no default constructor
+  /// @warning Not recommended for repeated use due to possible memory fragmentation
+  /// @param itemsInBuffer How much items of type T can be stored in the buffer
+  /// @param defaultItem Item returned by subscript operator if index is out of range
+  allocate(itemsInBuffer);
+}
+
+template <typename T>
+void RingBuffer<T>::allocate(size_t itemsInBuffer) {
+  /// @brief Allocates memory to store the data
+  /// @details Items are not constructed until they are pushed to the ring buffer
+  /// @param itemsInBuffer How much items of type T can be stored in the buffer
   ringBuffer = reinterpret_cast<T*> (malloc(itemsInBuffer * sizeof(T)));
   if (ringBuffer) {
-    new (ringBuffer) T[itemsInBuffer];
     ringBufferSize = itemsInBuffer;
     memoryAllocated = true;
   }
 }
+
 template <typename T>
 RingBuffer<T>::~RingBuffer () {
   /// @brief Performs a ring buffer cleanup
-  /// @details If no memory was allocated by this class, just calls pop() for every item in buffer
-  /// @par If memory was allocated by this class, it is released using delete()
+  /// @details Calls destructor for every item in buffer
+  /// @par If memory was allocated by this class, it is released using free()
   if (!validate()) return;
-  if (memoryAllocated) {
-    delete(ringBuffer);
-  }
-  else {
-    const size_t tempCount = itemsCount; //itemsCount field will be modified by popUnsafe()
-    for (size_t i = 0; i < tempCount; i++)
-      popUnsafe();
-  }
+  const size_t tempCount = itemsCount; //itemsCount field will be modified by popUnsafe()
+  for (size_t i = 0; i < tempCount; i++)
+    popUnsafe();
+  if (memoryAllocated) free(ringBuffer);
 }
 
 template <typename T>
@@ -294,19 +432,85 @@ boolean RingBuffer<T>::validate(void) const {
 }
 
 template <typename T>
-void RingBuffer<T>::push(RingBuffer<T>::data_t item) {
-  /// @brief Adds item to the ring buffer
+T * RingBuffer<T>::reserveUnsafe(void) {
+  /// @brief Removes an oldest item if the ring buffer is full and returns memory
+  /// location to construct the new item in
+  /// @warning Should not be called if the ring buffer is non-initialised. The caller
+  /// must construct the item and increment itemsCount
+  if (itemsCount == ringBufferSize) popUnsafe();
+  size_t nextIndex = indexOldestItem + itemsCount;
+  if (nextIndex >= ringBufferSize) nextIndex -= (ringBufferSize);
+  return (&ringBuffer[nextIndex]);
+}
+
+template <typename T>
+void RingBuffer<T>::push(const T & item) {
+  /// @brief Adds a copy of item to the ring buffer
   /// @details Adds item to the ring buffer. If the ring buffer is full,
   /// an oldest item is removed from the ring buffer
   /// @param item Item to be added to the ring buffer
   if (!validate()) return;
-  if (itemsCount == ringBufferSize) popUnsafe();
-  size_t nextIndex = indexOldestItem + itemsCount;
-  if (nextIndex >= ringBufferSize) nextIndex -= (ringBufferSize);
-  new (&ringBuffer[nextIndex]) T(item);
+  new (reserveUnsafe()) T(item);
+  itemsCount++;
+}
+
+template <typename T>
+void RingBuffer<T>::push(T && item) {
+  /// @brief Moves item to the ring buffer
+  /// @details If the ring buffer is full, an oldest item is removed from the ring buffer
+  /// @param item Item to be moved to the ring buffer
+  if (!validate()) return;
+  new (reserveUnsafe()) T(util::move(item));
+  itemsCount++;
+}
+
+template <typename T>
+template <typename... Args>
+void RingBuffer<T>::emplace(Args && ... args) {
+  /// @brief Constructs item directly in the ring buffer memory
+  /// @details If the ring buffer is full, an oldest item is removed from the ring buffer
+  /// @param args Parameters passed to the constructor of T
+  if (!validate()) return;
+  new (reserveUnsafe()) T(util::forward<Args>(args)...);
   itemsCount++;
 }
 
+template <typename T>
+void RingBuffer<T>::push(const T * items, size_t number) {
+  /// @brief Adds copies of multiple items to the ring buffer
+  /// @details Items are added in order, thus if number of items exceeds the free
+  /// space in the ring buffer, the oldest items are removed; if number of items
+  /// exceeds the ring buffer size, only the last items are stored.
+  /// @par Trivially copyable items are copied with memcpy() in no more than two
+  /// blocks.
+  /// @param items Items to be added to the ring buffer
+  /// @param number Number of items
+  if (!validate() || !items) return;
+  if (!__has_trivial_copy(T) || !__has_trivial_destructor(T)) {
+    for (size_t i = 0; i < number; i++)
+      push(items[i]);
+    return;
+  }
+  if (number > ringBufferSize) {
+    items += (number - ringBufferSize);
+    number = ringBufferSize;
+  }
+  const size_t freeItems = ringBufferSize - itemsCount;
+  if (number > freeItems) {
+    const size_t removedItems = number - freeItems;
+    indexOldestItem += removedItems;
+    if (indexOldestItem >= ringBufferSize) indexOldestItem -= ringBufferSize;
+    itemsCount -= removedItems;
+  }
+  size_t nextIndex = indexOldestItem + itemsCount;
+  if (nextIndex >= ringBufferSize) nextIndex -= ringBufferSize;
+  size_t firstBlock = ringBufferSize - nextIndex;
+  if (firstBlock > number) firstBlock = number;
+  memcpy(static_cast<void *>(&ringBuffer[nextIndex]), items, firstBlock * sizeof(T));
+  memcpy(static_cast<void *>(ringBuffer), items + firstBlock, (number - firstBlock) * sizeof(T));
+  itemsCount += number;
+}
+
 template <typename T>
 void RingBuffer<T>::popUnsafe(void) {
   /// @brief Removes an oldest item from the ring buffer without performing any validity check
@@ -374,990 +578,4125 @@ typename RingBuffer<T>::data_t RingBuffer<T>::operator [] (size_t index) const {
   return (ringBuffer[ringBufferIndex]);
 }
 
+template <typename T>
+typename RingBuffer<T>::Iterator RingBuffer<T>::begin(void) const {
+  /// @brief Returns iterator pointing to the oldest item in the ring buffer
+  if (!validate()) return (Iterator(NULL, NULL, NULL, 0));
+  return (Iterator(&ringBuffer[indexOldestItem], ringBuffer, ringBuffer + ringBufferSize, itemsCount));
+}
+
+template <typename T>
+typename RingBuffer<T>::Iterator RingBuffer<T>::end(void) const {
+  /// @brief Returns iterator pointing past the newest item in the ring buffer
+  return (Iterator(NULL, NULL, NULL, 0));
+}
+
 //////////////////////////////////////////////////////////////////////
-// CStrRingBuffer
+// StaticRingBuffer
 //////////////////////////////////////////////////////////////////////
 
-/// @brief Circular buffer for storing c-strings
-/// @details Implements a c-string circular buffer. C-strings are sent to the circular
-/// buffer with push() method until buffer is full, then oldest c-strings are
-/// overwritten. Oldest c-strings can also be manually removed from the circular
-/// buffer with pop() method. Circular buffer contents are accessible with get()
-/// method.
-class CStrRingBuffer {
+/// @brief Circular buffer with capacity defined at compile time
+/// @tparam T Type of the data to be stored in buffer. Must have a trivial
+/// constructor and copy assignment operator
+/// @tparam Size Maximum number of items in the buffer
+/// @details Provides the same interface as RingBuffer, but the items are stored
+/// within the object and no heap memory is used; the buffer is always valid.
+/// @par If Size is a power of two, indices wrap around with bit mask instead of
+/// comparison, thus prefer power-of-two sizes for buffers accessed via subscript
+/// operator in time-critical code. Range-based for loop (oldest item first) does not
+/// perform any index calculations at all.
+template <typename T, size_t Size>
+class StaticRingBuffer {
+  public:
+    typedef typename RingBuffer<T>::data_t data_t;
+    typedef RingBufferIterator<T> Iterator;
+    static_assert(Size, "Static ring buffer size must not be zero");
+    static const boolean sizePowerOfTwo = !(Size & (Size - 1));
   public:
-    inline CStrRingBuffer ();
-    inline CStrRingBuffer (char * buffer, size_t charsInBuffer);
     inline boolean validate(void) const;
-    boolean push(const char * item);
-    void pop(void);
-    size_t count(void) const;
-    boolean full(const char * item) const;
-    boolean full(size_t length) const;
-    boolean empty(void) const;
-    size_t get(size_t index, char *dst, size_t dstSize);
-  private:
-    inline boolean fullUnsafe(const char * item) const;
-    inline boolean fullUnsafe(size_t length) const;
-    inline size_t getNextIndex(void) const;
+    inline void push(data_t item);
+    inline void pop(void);
+    inline void pop(size_t number);
+    inline size_t count(void) const;
+    inline boolean full(void) const;
+    inline boolean empty(void) const;
+    inline data_t operator [] (size_t index) const;
+    inline Iterator begin(void) const;
+    inline Iterator end(void) const;
   private:
-    size_t getCstrStartChar(size_t index);
+    static inline size_t wrap(size_t index);
   private:
-    char * ringBuffer = NULL;
-    size_t ringBufferSize = 0;
+    T ringBuffer[Size];
     size_t indexOldestItem = 0;
-    size_t totalCharCount = 0;
-    size_t cstrCount = 0;
-    static const char nullChar = '\0';
-    static const size_t nullCharSize = sizeof (nullChar);
+    size_t itemsCount = 0;
+  private:
+    const T defaultItem = T();
 };
 
-CStrRingBuffer::CStrRingBuffer() {
-  /// @brief Creates non-initialised c-string circular buffer
-  /// @details Only needed for compatibility
-  /// @par Non-initialised circular buffer behaves as empty
-  /// ring buffer with the following differences:
-  /// * validate() always returns false
-  /// * push() and pop() perform no action
-  /// * count() always returns 0
+template <typename T, size_t Size>
+size_t StaticRingBuffer<T, Size>::wrap(size_t index) {
+  /// @brief Wraps index around the end of the buffer
+  /// @param index Index less than 2 * Size
+  /// @return Index in range 0 to Size - 1
+  if (sizePowerOfTwo) return (index & (Size - 1));
+  return ((index >= Size) ? (index - Size) : index);
 }
 
-CStrRingBuffer::CStrRingBuffer(char * buffer, size_t charsInBuffer) {
-  /// @brief Creates a ring buffer
-  /// @param buffer Memory area to store buffer data
-  /// @param charsInBuffer Buffer size in chars
-  if (charsInBuffer < (2 * nullCharSize)) return;
-  if (!buffer) return;
-  //Minimum buffer length 2 chars, 1 char is reserved for '\0' at the end
-  //of the buffer to be able to print cstrings directly from the ring buffer
-  ringBuffer = buffer;
-  ringBufferSize = charsInBuffer - nullCharSize;
-  ringBuffer[charsInBuffer - 1] = '\0';
+template <typename T, size_t Size>
+boolean StaticRingBuffer<T, Size>::validate(void) const {
+  /// @brief Only needed for compatibility with RingBuffer
+  /// @return Always true
+  return (true);
 }
 
-boolean CStrRingBuffer::validate(void) const {
-  /// @brief Checks if the c-string ring buffer is initialised
-  /// @return true if ring buffer is initialised, otherwise returns false
-  return ((ringBuffer != NULL) && (ringBufferSize != 0));
+template <typename T, size_t Size>
+void StaticRingBuffer<T, Size>::push(data_t item) {
+  /// @brief Adds item to the ring buffer
+  /// @details If the ring buffer is full, an oldest item is overwritten
+  /// @param item Item to be added to the ring buffer
+  ringBuffer[wrap(indexOldestItem + itemsCount)] = item;
+  if (itemsCount == Size)
+    indexOldestItem = wrap(indexOldestItem + 1);
+  else
+    itemsCount++;
 }
 
-size_t CStrRingBuffer::getNextIndex(void) const {
-  /// @brief Finds next position to store a c-string in buffer
-  /// @return Position in the buffer to store next c-string
-  const size_t nextIndex = indexOldestItem + totalCharCount;
-  if (nextIndex >= ringBufferSize) return (nextIndex - ringBufferSize);
-  return (nextIndex);
+template <typename T, size_t Size>
+void StaticRingBuffer<T, Size>::pop(void) {
+  /// @brief Removes an oldest item from the ring buffer
+  if (!itemsCount) return;
+  indexOldestItem = wrap(indexOldestItem + 1);
+  itemsCount--;
 }
 
-/// @brief A Print class which saves to buffer everything was printed with it
-/// @details Text is saved to buffer until buffer is full. After that new
-/// text is ignored
-class PrintToBuffer : public Print {
+template <typename T, size_t Size>
+void StaticRingBuffer<T, Size>::pop(size_t number) {
+  /// @brief Removes a certain amount of oldest items from the ring buffer
+  /// @param number Number of items to remove
+  if (number > itemsCount) number = itemsCount;
+  indexOldestItem = wrap(indexOldestItem + number);
+  itemsCount -= number;
+}
+
+template <typename T, size_t Size>
+size_t StaticRingBuffer<T, Size>::count(void) const {
+  /// @brief Checks number of items in the ring buffer
+  /// @return Number of items currently stored in the ring buffer
+  return (itemsCount);
+}
+
+template <typename T, size_t Size>
+boolean StaticRingBuffer<T, Size>::full(void) const {
+  /// @brief Checks whether the ring buffer is full
+  /// @return true if the item cannot be pushed to the ring buffer without
+  /// overwriting an oldest item, otherwise returns false
+  return (itemsCount == Size);
+}
+
+template <typename T, size_t Size>
+boolean StaticRingBuffer<T, Size>::empty(void) const {
+  /// @brief Checks whether the ring buffer is empty
+  /// @return true if there are no items in the ring buffer, otherwise
+  /// returns false
+  return (!itemsCount);
+}
+
+template <typename T, size_t Size>
+typename StaticRingBuffer<T, Size>::data_t StaticRingBuffer<T, Size>::operator [] (size_t index) const {
+  /// @brief Get an item from the ring buffer
+  /// @param index Index of item in the ring buffer (0 = oldest item in ring buffer)
+  /// @return Item from the ring buffer or defaultItem if index is out of range
+  if (index >= itemsCount) return (defaultItem);
+  return (ringBuffer[wrap(indexOldestItem + index)]);
+}
+
+template <typename T, size_t Size>
+typename StaticRingBuffer<T, Size>::Iterator StaticRingBuffer<T, Size>::begin(void) const {
+  /// @brief Returns iterator pointing to the oldest item in the ring buffer
+  return (Iterator(&ringBuffer[indexOldestItem], ringBuffer, ringBuffer + Size, itemsCount));
+}
+
+template <typename T, size_t Size>
+typename StaticRingBuffer<T, Size>::Iterator StaticRingBuffer<T, Size>::end(void) const {
+  /// @brief Returns iterator pointing past the newest item in the ring buffer
+  return (Iterator(NULL, NULL, NULL, 0));
+}
+
+//////////////////////////////////////////////////////////////////////
+// SPSCRingBuffer
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Lock-free single-producer single-consumer circular buffer
+/// @tparam T Type of the data to be stored in buffer. Must have a trivial
+/// constructor and copy assignment operator
+/// @tparam Size Maximum number of items in the buffer, must be a power of two
+/// @details Allows to pass data from one execution context (producer, e.g. timer
+/// interrupt service routine or a thread) to another (consumer, e.g. loop()) without
+/// disabling interrupts or using locks. Only producer may call push() and only
+/// consumer may call pop(); count(), empty() and full() may be called from either.
+/// @par Unlike RingBuffer, oldest items are never overwritten: if the buffer is full,
+/// push() rejects the new items so that the data already passed to consumer are
+/// never modified.
+/// @par Each side only writes its own index; the index is published with release
+/// semantics after the items are written or read, and the index of the other side
+/// is read with acquire semantics. Indices run freely and wrap with a bit mask.
+/// @warning When called from interrupt service routine on ESP8266, the routine must
+/// be placed in RAM (ICACHE_RAM_ATTR). All member functions are forced inline
+/// (always_inline) so that their code is placed together with the calling function;
+/// plain inline is only a hint and could leave an out-of-line copy in flash.
+template <typename T, size_t Size>
+class SPSCRingBuffer {
   public:
-    inline PrintToBuffer(char * buffer, size_t bufferSize);
-    virtual size_t write(uint8_t character);
-    virtual size_t write(const uint8_t *buffer, size_t size);//TODO
+    typedef typename RingBuffer<T>::data_t data_t;
+    static_assert(Size && !(Size & (Size - 1)), "SPSC ring buffer size must be a power of two");
+  public:
+    inline boolean push(data_t item) __attribute__((always_inline));
+    inline size_t push(const T * items, size_t number) __attribute__((always_inline));
+    inline boolean pop(T & item) __attribute__((always_inline));
+    inline size_t pop(T * items, size_t number) __attribute__((always_inline));
+    inline size_t count(void) const __attribute__((always_inline));
+    inline boolean empty(void) const __attribute__((always_inline));
+    inline boolean full(void) const __attribute__((always_inline));
   private:
-    char * buffer = NULL;
-    size_t bufferSize = 0;
-    size_t bufferPosition = 0;
-    static const char nullChar = '\0';
-    static const size_t nullCharSize = sizeof (nullChar);
+    static inline size_t loadAcquire(const volatile size_t & index) __attribute__((always_inline));
+    static inline void storeRelease(volatile size_t & index, size_t value) __attribute__((always_inline));
+  private:
+    static const size_t indexMask = Size - 1;
+    T ringBuffer[Size];
+    volatile size_t indexWrite = 0; ///< Number of items pushed, modified by producer only
+    volatile size_t indexRead = 0;  ///< Number of items popped, modified by consumer only
 };
 
-/// @brief Initialises PrintToBuffer
-/// @param buffer Buffer to save printed text to
-/// @param bufferSize Size of the buffer in chars
-PrintToBuffer::PrintToBuffer(char * buffer, size_t bufferSize) {
-  this->buffer = buffer;
-  this->bufferSize = bufferSize;
+template <typename T, size_t Size>
+size_t SPSCRingBuffer<T, Size>::loadAcquire(const volatile size_t & index) {
+  return (__atomic_load_n(&index, __ATOMIC_ACQUIRE));
 }
 
-}; //namespace arrays
+template <typename T, size_t Size>
+void SPSCRingBuffer<T, Size>::storeRelease(volatile size_t & index, size_t value) {
+  __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+}
 
-namespace checksum {
+template <typename T, size_t Size>
+boolean SPSCRingBuffer<T, Size>::push(data_t item) {
+  /// @brief Adds item to the ring buffer; producer only
+  /// @param item Item to be added to the ring buffer
+  /// @return true if item was added, false if the ring buffer is full
+  const size_t write = indexWrite;
+  if ((write - loadAcquire(indexRead)) == Size) return (false);
+  ringBuffer[write & indexMask] = item;
+  storeRelease(indexWrite, write + 1);
+  return (true);
+}
 
-//////////////////////////////////////////////////////////////////////
-// crc16
-//////////////////////////////////////////////////////////////////////
+template <typename T, size_t Size>
+size_t SPSCRingBuffer<T, Size>::push(const T * items, size_t number) {
+  /// @brief Adds multiple items to the ring buffer; producer only
+  /// @details Items become available to consumer all at once
+  /// @param items Items to be added to the ring buffer
+  /// @param number Number of items
+  /// @return Number of items added; less than number if the ring buffer is full
+  const size_t write = indexWrite;
+  const size_t available = Size - (write - loadAcquire(indexRead));
+  if (number > available) number = available;
+  for (size_t i = 0; i < number; i++)
+    ringBuffer[(write + i) & indexMask] = items[i];
+  storeRelease(indexWrite, write + number);
+  return (number);
+}
 
-/// @brief Calculates checksum crc16 for a memory area
-/// @details Implementation based on this great guide: http://www.ross.net/crc/download/crc_v3.txt
-/// @param buffer A memory area to calculate crc16 for
-/// @param bufferSize Memory area size in bytes
-/// @param poly A polynomial to calculate CRC. High (17th) bit of the polynomial is implicitly set. Default is 0x8005.
-/// @param reverseIn If true, bit order in every input byte is reversed before performing CRC calculations. True by default.
-/// @param reverseOut If true, bit order in CRC value is reversed after calculations. True by default.
-/// @return Calculated CRC16 value
-uint16_t crc16(const void * buffer, size_t bufferSize, uint16_t poly = 0x8005, uint16_t init = 0x0000, boolean reverseIn = true, boolean reverseOut = true);
+template <typename T, size_t Size>
+boolean SPSCRingBuffer<T, Size>::pop(T & item) {
+  /// @brief Removes an oldest item from the ring buffer; consumer only
+  /// @param item Variable to store the removed item to
+  /// @return true if item was removed, false if the ring buffer is empty
+  const size_t read = indexRead;
+  if (loadAcquire(indexWrite) == read) return (false);
+  item = ringBuffer[read & indexMask];
+  storeRelease(indexRead, read + 1);
+  return (true);
+}
 
-}; //namespace checksum
+template <typename T, size_t Size>
+size_t SPSCRingBuffer<T, Size>::pop(T * items, size_t number) {
+  /// @brief Removes multiple oldest items from the ring buffer; consumer only
+  /// @param items Buffer to store the removed items to (oldest item first)
+  /// @param number Size of the buffer (maximum number of items to remove)
+  /// @return Number of items removed
+  const size_t read = indexRead;
+  const size_t available = loadAcquire(indexWrite) - read;
+  if (number > available) number = available;
+  for (size_t i = 0; i < number; i++)
+    items[i] = ringBuffer[(read + i) & indexMask];
+  storeRelease(indexRead, read + number);
+  return (number);
+}
 
-namespace dsp {
+template <typename T, size_t Size>
+size_t SPSCRingBuffer<T, Size>::count(void) const {
+  /// @brief Checks number of items in the ring buffer
+  /// @details If called while the other side pushes or pops items, the result may
+  /// be outdated by the time it is returned
+  /// @return Number of items currently stored in the ring buffer
+  const size_t read = loadAcquire(indexRead);
+  return (loadAcquire(indexWrite) - read);
+}
+
+template <typename T, size_t Size>
+boolean SPSCRingBuffer<T, Size>::empty(void) const {
+  /// @brief Checks whether the ring buffer is empty
+  return (!count());
+}
+
+template <typename T, size_t Size>
+boolean SPSCRingBuffer<T, Size>::full(void) const {
+  /// @brief Checks whether the ring buffer is full
+  return (count() == Size);
+}
 
 //////////////////////////////////////////////////////////////////////
-// FixedPoint
+// SortedBuffer
 //////////////////////////////////////////////////////////////////////
 
-/// @brief Fixed point number with integer and fraction parts
-/// @tparam T An integer base type for fixed point number.
-/// @tparam FractionBits Number of least significant bits storing fraction part
-/// @tparam U A wider range data type, used as intermediary to avoid overflow during calculations.
-/// Ideally should be twice as wide as T. If U is not specified, T is also used as intermediary (
-/// not recommended since it may lead to overflow during multiplication/division and initialisation
-/// from integer with decimal point shift).
-/// @tparam TRangeMin Minimum value possible for T
-/// @tparam TRangeMax Maximum value possible for T
-/// @details Basic arithmetic (+, -, *, /, +=, -=, *=, /=) and logic (<, <=, >, >=, !=, ==)
-/// operations are possible.
-/// @par If as a result of the arithmetic operation the Fixed Point value reaches
-/// minimum or maximum possible values for integer part, it becames an overflow value. The
-/// overflow values are capped at minimum and maximum of possible range. Any further arithmetic
-/// operation with overflow value results in the same overflow value.
-/// @par Overflow can be detected with overflow() function.
-/// @par If both TRangeMin or TRangeMax are zero, no range check is performed and the
-/// fixed-point value is not overflow-safe; overflow() always returns false.
-/// @par Minimum and maximum possible values for integer part are declared as constants min and max.
-/// @par Conversion to the integer type T is possible and is performed by rounding (i.e. if fraction
-/// part is greater or equal to 0.5 the return value is increased by 1).
-template <typename T, size_t FractionBits, typename U = T, T TMinRange = static_cast<T>(0), T TMaxRange = static_cast<T>(0)>
-class FixedPoint {
-  public:
-    /// @brief Default constructor, sets value to zero
-    inline FixedPoint() {
-      value.setT(tZero);
-    }
-    /// @brief Copy constructor, copies value from other FixedPoint object
-    /// @param other Other FixedPoint object to copy value from
-    inline FixedPoint(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &other) {
-      value = other.value;
-    }
-    FixedPoint(T integer, size_t decimalsPrecision = 0);
-    FixedPoint(const char * str);
-  public:
-    /// @brief Convert integer part to integer type T
-    /// @details Conversion is performed by rounding, e.g. conversion of value 1.5 will return 2
-    /// @return Integer part of the value
-    inline explicit operator T() const {
-      if (TMinRange && TMaxRange) {
-        if (value.get() == TMaxRange) return (TMaxRange);
-        if (value.get() == TMinRange) return (TMinRange);
-      }
-      T absValue = value.get();
-      boolean negativeValue = false;
-      if (TMinRange && TMaxRange) {
-        if (TMinRange < tZero) {
-          if (absValue < tZero) {
-            absValue = ~absValue + tOne;
-            negativeValue = true;
-          }
-        }
-      }
-      absValue = (absValue >> FractionBits) + ((absValue >> (FractionBits - 1)) & tOne); //add 1 if most significant fraction bit is set (fraction part >= 0.5)
-      return (negativeValue ? ~absValue + tOne : absValue);
-    }
-    /// @brief Assignment operator, copies value from other FixedPoint object
-    /// @param other Other FixedPoint object to copy value from
-    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator = (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &other) {
-      value.setT(other.value.get());
-      return (*this);
-    }
-  public:
-    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator += (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      value.setU(static_cast<U>(value.get()) + static_cast<U>(rhs.value.get()));
-      return (*this);
-    }
-    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator -= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      value.setU(static_cast<U>(value.get()) - static_cast<U>(rhs.value.get()));
-      return (*this);
-    }
-    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator *= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      value.setU(static_cast<U>(value.get()) * static_cast<U>(rhs.value.get()) / static_cast<U>(fractionBitsPwr2));
-      return (*this);
-    }
-    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator /= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      value.setU(static_cast<U>(value.get()) * static_cast<U>(fractionBitsPwr2) /  static_cast<U>(rhs.value.get()));
-      return (*this);
-    }
-    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
-    operator + (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
-      temp += rhs;
-      return (temp);
-    }
-    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
-    operator - (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
-      temp -= rhs;
-      return (temp);
-    }
-    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
-    operator * (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
-      temp *= rhs;
-      return (temp);
-    }
-    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
-    operator / (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
-      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
-      temp /= rhs;
-      return (temp);
-    }
-  public:
-    inline boolean operator == (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
-      return (value.get() == rhs.value.get());
-    }
-    inline boolean operator != (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
-      return (!(*this == rhs));
-    }
-    inline boolean operator < (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
-      return (value.get() < rhs.value.get());
-    }
-    inline boolean operator > (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
-      return (rhs < *this);
-    }
-    inline boolean operator <= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
-      return (!(*this > rhs));
-    }
-    inline boolean operator >= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
-      return (!(*this < rhs));
-    }
-  public:
-    static const T min = TMinRange  ? ((TMinRange >> FractionBits) + 1) : TMinRange; ///< Minimum range for integer part of FixedPoint value
-    static const T max = TMaxRange >> FractionBits; ///< Maximum range for integer part of FixedPoint value
+/// @brief Sorted buffer (multiset) with access by rank
+/// @tparam T Type of the data to be stored in buffer. Must have a trivial
+/// constructor and copy constructor and less-than operator
+/// @details Implemented as indexable skip list: every link stores the number of
+/// items it skips, thus insertion, removal, access by rank and rank calculation are
+/// performed in O(log N) operations.
+/// @par Items are sent to the buffer with insert() and removed with remove(). Any item
+/// is accessible via subscript operator (0 is the smallest item). Equal items are
+/// allowed.
+/// @par Together with RingBuffer can be used to maintain order statistics (median,
+/// percentiles) of a sliding window: the oldest item from RingBuffer is removed from
+/// SortedBuffer before a new item is pushed to both.
+/// @warning Memory is allocated in constructor; not recommended for repeated use due
+/// to possible memory fragmentation. Maximum size is 65534 items.
+template <typename T>
+class SortedBuffer {
   public:
-    /// @brief Detect overflow
-    /// @par value Value to check for overflow
-    /// @return true if the value of this object is overflow, false otherwise.
-    /// If the minimum/maximum limits are not set, always returns false.
-    inline boolean overflow(void) const {
-      if (!TMinRange && !TMaxRange) return (false);
-      if ((value.get() == TMinRange) || (value.get() == TMaxRange)) return (true);
-      return (false);
-    }
+    typedef typename TypeSelect < (sizeof(T*) < sizeof(T)), const T &, T >::data_t data_t;
   public:
-    T getValue(size_t decimalPrecision, boolean *status = nullptr) const;
-  protected:
-    /// @brief Internal value class, created to encapsulate the value and unify value assignment
-    class Value {
-      public:
-        /// @brief Sets value from type T value
-        /// @newValue New value of type T, consists of integer and fraction part at this point
-        /// @return true if no overflow occured, false otherwise
-        inline boolean setT(T newValue) {
-          val = newValue;
-          return (true);
-        }
-        /// @brief Sets value from type U value
-        /// @newValue New value of type U, consists of integer and fraction part at this point
-        /// @return true if no overflow occured, false otherwise
-        inline boolean setU(U newValue) {
-          if (TMinRange && TMaxRange) {
-            if (val == TMaxRange || val == TMinRange) {
-              return (false);
-            }
-            if (newValue < static_cast<U>(TMinRange)) {
-              val = TMinRange;
-              return (false);
-            }
-            if (newValue > static_cast<U>(TMaxRange)) {
-              val = TMaxRange;
-              return (false);
-            }
-          }
-          val = static_cast<T>(newValue);
-          return (true);
-        }
-        /// @brief Returns value of type T (with integer and fraction parts)
-        /// @returns Value of type T, consists of integer and fraction part
-        inline T get(void) const {
-          return (val);
-        }
-      private:
-        T val = {}; ///< Storage for value
-    };
-    Value value;
-  protected:
-    static const T tZero = static_cast<T>(0); ///< 0 constant of type T
-    static const T tOne = static_cast<T>(1);  ///< 1 constant of type T
-    static const T fractionBitsPwr2 = tOne << FractionBits; ///< A number of type T, equals to 2 pow FractionBits
-    //Make sure that FractionBits are less than total bit width of T
-    static_assert(FractionBits < (sizeof(T) * 8), "Too many fraction bits");
-    //Make sure that more than zero FractionBits are defined (if zero fraction bits required, simply use type T)
-    static_assert(FractionBits > 0, "Too few fraction bits");
+    SortedBuffer(size_t itemsInBuffer);
+    ~SortedBuffer();
+    inline boolean validate(void) const;
+    boolean insert(data_t item);
+    boolean remove(data_t item);
+    inline size_t count(void) const;
+    inline boolean full(void) const;
+    data_t operator [] (size_t index) const;
+    size_t rank(data_t item) const;
+  private:
+    typedef uint16_t index_t;
+    inline index_t & link(index_t node, size_t level) const;
+    inline index_t & width(index_t node, size_t level) const;
+    size_t randomLevel(void);
+  private:
+    static const index_t head = 0;                ///< Head node, stores no item
+    static const index_t nil = UINT16_MAX;        ///< End of list
+    static const size_t maxLevelsLimit = 16;
+    T * items = NULL;                             ///< Node items, node 0 is head
+    index_t * links = NULL;                       ///< Next node for every node and level
+    index_t * widths = NULL;                      ///< Number of items skipped by every link
+    index_t freeNodes = nil;                      ///< First unused node, unused nodes are linked at level 0
+    size_t bufferSize = 0;
+    size_t itemsCount = 0;
+    size_t levels = 0;
+    uint32_t randomState = 2463534242;            ///< Xorshift generator state used to select node levels
+  private:
+    const T defaultItem = T();
 };
 
-template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
-FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::FixedPoint(T value, size_t decimalsPrecision) {
-  /// @brief Creates a Fixed Point value from integer value with known decimal precision
-  /// @details For example Pi can be defined as follows (provided that large number fits into type T):
-  ///     FixedPoint(314159265, 8);
-  /// @param value Integer part
-  /// @param decimalsPrecision How many least significant decimal digits are fractions
-  /// (= for how many digits to left-shift decimal point)
-  if (!value) {
-    this->value.setT(tZero);
+template <typename T>
+SortedBuffer<T>::SortedBuffer(size_t itemsInBuffer) {
+  /// @brief Creates a sorted buffer and allocates memory to store the data
+  /// @param itemsInBuffer How much items of type T can be stored in the buffer
+  if (!itemsInBuffer || (itemsInBuffer >= nil)) return;
+  levels = 1;
+  while ((levels < maxLevelsLimit) && ((static_cast<size_t>(1) << levels) < itemsInBuffer)) levels++;
+  const size_t nodes = itemsInBuffer + 1;
+  items = reinterpret_cast<T*>(malloc(nodes * sizeof(T)));
+  links = reinterpret_cast<index_t*>(malloc(nodes * levels * sizeof(index_t)));
+  widths = reinterpret_cast<index_t*>(malloc(nodes * levels * sizeof(index_t)));
+  if (!items || !links || !widths) {
+    if (items) free(items);
+    if (links) free(links);
+    if (widths) free(widths);
+    items = NULL;
+    links = NULL;
+    widths = NULL;
     return;
   }
-  if (decimalsPrecision) {
-    static const T decimalRadix = static_cast<T>(10);
-    T divider = tOne;
-    for (size_t i = 0; i < decimalsPrecision; i++) {
-      if (TMinRange && TMaxRange) {
-        if (divider < (TMaxRange / decimalRadix)) {
-          divider *= decimalRadix;
-        }//if (divider < (TMaxRange / decimalRadix))
-        else {
-          value /= decimalRadix;
-          if (!value) {
-            this->value.setT(tZero);
-            return;
-          }
-        }
-      }
-      else {//if (TMinRange && TMaxRange)
-        divider *= decimalRadix;
-      }
+  for (size_t i = 0; i < nodes; i++)
+    new (&items[i]) T;
+  for (size_t i = 0; i < levels; i++) {
+    link(head, i) = nil;
+    width(head, i) = 1;
+  }
+  for (size_t i = 1; i < nodes; i++)
+    link(i, 0) = (i + 1 < nodes) ? static_cast<index_t>(i + 1) : nil;
+  freeNodes = 1;
+  bufferSize = itemsInBuffer;
+}
+
+template <typename T>
+SortedBuffer<T>::~SortedBuffer() {
+  /// @brief Releases memory allocated by the sorted buffer
+  if (!validate()) return;
+  free(items);
+  free(links);
+  free(widths);
+}
+
+template <typename T>
+boolean SortedBuffer<T>::validate(void) const {
+  /// @brief Checks if the sorted buffer is initialised
+  /// @return true if sorted buffer is initialised, otherwise returns false
+  return (items && bufferSize);
+}
+
+template <typename T>
+typename SortedBuffer<T>::index_t & SortedBuffer<T>::link(index_t node, size_t level) const {
+  return (links[node * levels + level]);
+}
+
+template <typename T>
+typename SortedBuffer<T>::index_t & SortedBuffer<T>::width(index_t node, size_t level) const {
+  return (widths[node * levels + level]);
+}
+
+template <typename T>
+size_t SortedBuffer<T>::randomLevel(void) {
+  /// @brief Selects level for a new node
+  /// @return Number of levels, level n+1 is selected with probability 1/2 of level n
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  uint32_t randomBits = randomState;
+  size_t level = 1;
+  while ((level < levels) && (randomBits & 1)) {
+    level++;
+    randomBits >>= 1;
+  }
+  return (level);
+}
+
+template <typename T>
+boolean SortedBuffer<T>::insert(SortedBuffer<T>::data_t item) {
+  /// @brief Adds item to the sorted buffer
+  /// @param item Item to be added to the sorted buffer
+  /// @return true if item was added, false if the buffer is full or non-initialised
+  if (!validate() || (itemsCount == bufferSize)) return (false);
+  index_t update[maxLevelsLimit];
+  size_t updateRank[maxLevelsLimit];
+  index_t node = head;
+  size_t nodeRank = 0;
+  for (size_t i = levels; i-- > 0;) {
+    while ((link(node, i) != nil) && (items[link(node, i)] < item)) {
+      nodeRank += width(node, i);
+      node = link(node, i);
     }
-    this->value.setU(static_cast<U>(value) * static_cast<U>(fractionBitsPwr2) / static_cast<U>(divider));
-    return;
+    update[i] = node;
+    updateRank[i] = nodeRank;
   }
-  if (TMinRange && TMaxRange) {
-    if (value < min) {
-      this->value.setT(TMinRange);
-      return;
+  const index_t newNode = freeNodes;
+  freeNodes = link(newNode, 0);
+  items[newNode] = item;
+  const size_t newNodeLevel = randomLevel();
+  for (size_t i = 0; i < levels; i++) {
+    if (i < newNodeLevel) {
+      const size_t skipped = updateRank[0] - updateRank[i];
+      link(newNode, i) = link(update[i], i);
+      link(update[i], i) = newNode;
+      width(newNode, i) = static_cast<index_t>(width(update[i], i) - skipped);
+      width(update[i], i) = static_cast<index_t>(skipped + 1);
     }
-    if (value > max) {
-      this->value.setT(TMaxRange);
-      return;
+    else {
+      width(update[i], i)++;
     }
   }
-  this->value.setT(value << FractionBits);
+  itemsCount++;
+  return (true);
 }
 
-template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
-FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::FixedPoint(const char * str) {
-  const char * currStrChar = str;
-  const char decimalPointChar = '.';
-  const char minusSignChar = '-';
-  const char plusSignChar = '+';
-  const T decimalRadixT = static_cast<T>(10);
-  value.setT(tZero);
-  //make sure str is not NULL and not empty
-  if ((!str) || (!(*currStrChar))) return;
-  //check plus & minus sign
-  boolean negative = false;
-  if ((*currStrChar) == minusSignChar) {
-    currStrChar++;
-    negative = true;
-    if (TMinRange && TMaxRange) {
-      if (TMinRange > tZero) return;
-    }
-  } else {
-    if ((*currStrChar) == plusSignChar) currStrChar++;
+template <typename T>
+boolean SortedBuffer<T>::remove(SortedBuffer<T>::data_t item) {
+  /// @brief Removes item from the sorted buffer
+  /// @details If several items are equal to item, only one of them is removed
+  /// @param item Item to be removed from the sorted buffer
+  /// @return true if item was removed, false if the item was not found
+  if (!validate() || !itemsCount) return (false);
+  index_t update[maxLevelsLimit];
+  index_t node = head;
+  for (size_t i = levels; i-- > 0;) {
+    while ((link(node, i) != nil) && (items[link(node, i)] < item))
+      node = link(node, i);
+    update[i] = node;
   }
-  //process integer part
-  T integerPart = static_cast<U>(0);
-  while ((*currStrChar) && ((*currStrChar) != decimalPointChar)) {
-    if (((*currStrChar) < '0') || ((*currStrChar) > '9')) {
-      value.setT(tZero);
-      return;
+  const index_t removedNode = link(update[0], 0);
+  if ((removedNode == nil) || (item < items[removedNode])) return (false);
+  for (size_t i = 0; i < levels; i++) {
+    if (link(update[i], i) == removedNode) {
+      width(update[i], i) = static_cast<index_t>(width(update[i], i) + width(removedNode, i) - 1);
+      link(update[i], i) = link(removedNode, i);
     }
-    T currentDigit = static_cast<T>((*currStrChar) - '0');
-    if (negative) currentDigit = ~currentDigit + tOne;
-    integerPart = integerPart * decimalRadixT + currentDigit;
-    if (TMinRange && TMaxRange) {
-      if (integerPart < (min + 1)) {
-        value.setT(TMinRange);
-        return;
-      }
-      if (integerPart > (max - 1)) {
+    else {
+      width(update[i], i)--;
+    }
+  }
+  link(removedNode, 0) = freeNodes;
+  freeNodes = removedNode;
+  itemsCount--;
+  return (true);
+}
+
+template <typename T>
+size_t SortedBuffer<T>::count(void) const {
+  /// @brief Checks number of items in the sorted buffer
+  /// @return Number of items currently stored in the sorted buffer
+  if (!validate()) return (0);
+  return (itemsCount);
+}
+
+template <typename T>
+boolean SortedBuffer<T>::full(void) const {
+  /// @brief Checks whether the sorted buffer is full
+  /// @return true if no more items can be inserted to the buffer, otherwise returns false
+  if (!validate()) return (false);
+  return (itemsCount == bufferSize);
+}
+
+template <typename T>
+typename SortedBuffer<T>::data_t SortedBuffer<T>::operator [] (size_t index) const {
+  /// @brief Get an item from the sorted buffer by its rank
+  /// @param index Index of item in the sorted buffer (0 = smallest item)
+  /// @return Item from the sorted buffer or defaultItem if error occured during operation
+  if (!validate()) return (defaultItem);
+  if (index >= itemsCount) return (defaultItem);
+  size_t remaining = index + 1;
+  index_t node = head;
+  for (size_t i = levels; i-- > 0;) {
+    while ((link(node, i) != nil) && (width(node, i) <= remaining)) {
+      remaining -= width(node, i);
+      node = link(node, i);
+    }
+  }
+  return (items[node]);
+}
+
+template <typename T>
+size_t SortedBuffer<T>::rank(SortedBuffer<T>::data_t item) const {
+  /// @brief Finds number of items in the sorted buffer which are less than item
+  /// @param item Item to compare with
+  /// @return Number of items less than item (= index of first item not less than item)
+  if (!validate()) return (0);
+  index_t node = head;
+  size_t nodeRank = 0;
+  for (size_t i = levels; i-- > 0;) {
+    while ((link(node, i) != nil) && (items[link(node, i)] < item)) {
+      nodeRank += width(node, i);
+      node = link(node, i);
+    }
+  }
+  return (nodeRank);
+}
+
+//////////////////////////////////////////////////////////////////////
+// MonotonicDeque
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Minimum or maximum of the last windowSize items
+/// @tparam T Type of the data to be stored in buffer. Must have a trivial
+/// constructor and copy constructor and less-than operator
+/// @details Implemented as monotonic deque: items which can never become the extremum
+/// of the window (older than and not better than the newly pushed item) are removed
+/// from the back, items which left the window are removed from the front. Every item
+/// is added and removed once, thus push() costs amortised O(1) operations and front()
+/// costs O(1) operations.
+/// @par Every push() moves the window by one item; the deque does not store items
+/// which cannot be returned by front(), so it cannot be used to access the window
+/// contents.
+/// @warning Memory is allocated in constructor; not recommended for repeated use due
+/// to possible memory fragmentation.
+template <typename T>
+class MonotonicDeque {
+  public:
+    typedef typename TypeSelect < (sizeof(T*) < sizeof(T)), const T &, T >::data_t data_t;
+  public:
+    MonotonicDeque(size_t windowSize, boolean maximum);
+    ~MonotonicDeque();
+    inline boolean validate(void) const;
+    void push(data_t item);
+    inline size_t count(void) const;
+    inline boolean empty(void) const;
+    data_t front(void) const;
+  private:
+    inline size_t index(size_t position) const;
+  private:
+    T * items = NULL;
+    uint32_t * sequences = NULL;                  ///< Number of push() call which added every item
+    size_t bufferSize = 0;
+    size_t indexFront = 0;
+    size_t itemsCount = 0;
+    uint32_t sequence = 0;                        ///< Number of push() calls, wraps around
+    boolean maximum = false;
+  private:
+    const T defaultItem = T();
+};
+
+template <typename T>
+MonotonicDeque<T>::MonotonicDeque(size_t windowSize, boolean maximum) {
+  /// @brief Creates a monotonic deque and allocates memory to store the data
+  /// @param windowSize Number of the last pushed items to find extremum of
+  /// @param maximum If true, front() returns maximum of the window, otherwise minimum
+  if (!windowSize) return;
+  items = reinterpret_cast<T*>(malloc(windowSize * sizeof(T)));
+  sequences = reinterpret_cast<uint32_t*>(malloc(windowSize * sizeof(uint32_t)));
+  if (!items || !sequences) {
+    if (items) free(items);
+    if (sequences) free(sequences);
+    items = NULL;
+    sequences = NULL;
+    return;
+  }
+  for (size_t i = 0; i < windowSize; i++)
+    new (&items[i]) T;
+  bufferSize = windowSize;
+  this->maximum = maximum;
+}
+
+template <typename T>
+MonotonicDeque<T>::~MonotonicDeque() {
+  /// @brief Releases memory allocated by the monotonic deque
+  if (!validate()) return;
+  free(items);
+  free(sequences);
+}
+
+template <typename T>
+boolean MonotonicDeque<T>::validate(void) const {
+  /// @brief Checks if the monotonic deque is initialised
+  /// @return true if monotonic deque is initialised, otherwise returns false
+  return (items && bufferSize);
+}
+
+template <typename T>
+size_t MonotonicDeque<T>::index(size_t position) const {
+  /// @brief Converts position in the deque (0 = front) into index in the buffer
+  const size_t bufferIndex = indexFront + position;
+  if (bufferIndex >= bufferSize) return (bufferIndex - bufferSize);
+  return (bufferIndex);
+}
+
+template <typename T>
+void MonotonicDeque<T>::push(MonotonicDeque<T>::data_t item) {
+  /// @brief Adds item to the window, removing the oldest item if the window is full
+  /// @param item Item to add
+  if (!validate()) return;
+  sequence++;
+  if (itemsCount && ((sequence - sequences[indexFront]) >= bufferSize)) {
+    if (++indexFront >= bufferSize) indexFront = 0;
+    itemsCount--;
+  }
+  while (itemsCount) {
+    const T & last = items[index(itemsCount - 1)];
+    if (maximum ? (item < last) : (last < item)) break;
+    itemsCount--;
+  }
+  const size_t bufferIndex = index(itemsCount);
+  items[bufferIndex] = item;
+  sequences[bufferIndex] = sequence;
+  itemsCount++;
+}
+
+template <typename T>
+size_t MonotonicDeque<T>::count(void) const {
+  /// @brief Returns number of items kept in the deque
+  /// @details Only items which may become the extremum are kept, thus the result
+  /// is usually less than the number of items in the window
+  return (itemsCount);
+}
+
+template <typename T>
+boolean MonotonicDeque<T>::empty(void) const {
+  /// @brief Checks if no items were pushed to the deque
+  return (!itemsCount);
+}
+
+template <typename T>
+typename MonotonicDeque<T>::data_t MonotonicDeque<T>::front(void) const {
+  /// @brief Returns extremum of the window
+  /// @return Maximum or minimum of the last windowSize pushed items, or default item
+  /// if the deque is empty or not initialised
+  if (!validate() || !itemsCount) return (defaultItem);
+  return (items[indexFront]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// CStrSpans
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Read-only view of a string which is stored in memory as one or two
+/// contiguous parts (spans)
+/// @details Used to access c-strings stored in CStrRingBuffer without copying
+/// them: a c-string which wraps around the end of the ring buffer is represented
+/// by two spans, first at the end and second at the beginning of the buffer.
+/// @par The spans are not null-terminated and point directly to the memory where
+/// the string is stored; they remain valid only until the memory is modified.
+class CStrSpans {
+  public:
+    static const size_t npos = SIZE_MAX;
+  public:
+    inline CStrSpans() {}
+    inline CStrSpans(const char * first, size_t firstLength, const char * second = NULL, size_t secondLength = 0);
+    inline size_t length(void) const;
+    inline boolean empty(void) const;
+    inline const char * getFirst(void) const;
+    inline size_t getFirstLength(void) const;
+    inline const char * getSecond(void) const;
+    inline size_t getSecondLength(void) const;
+    inline char charAt(size_t index) const;
+    size_t find(char character, size_t start = 0) const;
+    CStrSpans substr(size_t start, size_t length = npos) const;
+    size_t copy(char * dst, size_t dstSize) const;
+    size_t printTo(Print & destination) const;
+  private:
+    const char * first = NULL;
+    size_t firstLength = 0;
+    const char * second = NULL;
+    size_t secondLength = 0;
+};
+
+/// @brief Creates a view of one or two spans
+/// @param first First span
+/// @param firstLength Length of the first span in chars
+/// @param second Second span or NULL if the string is stored in one span
+/// @param secondLength Length of the second span in chars
+CStrSpans::CStrSpans(const char * first, size_t firstLength, const char * second, size_t secondLength) {
+  if (!firstLength && secondLength) {
+    //Only keep non-empty spans, so that a single span is always the first one
+    first = second;
+    firstLength = secondLength;
+    second = NULL;
+    secondLength = 0;
+  }
+  this->first = firstLength ? first : NULL;
+  this->firstLength = first ? firstLength : 0;
+  this->second = secondLength ? second : NULL;
+  this->secondLength = second ? secondLength : 0;
+}
+
+size_t CStrSpans::length(void) const {
+  /// @brief Returns total length of the string in chars
+  return (firstLength + secondLength);
+}
+
+boolean CStrSpans::empty(void) const {
+  /// @brief Returns true if the string has zero length
+  return (!length());
+}
+
+const char * CStrSpans::getFirst(void) const {
+  /// @brief Returns pointer to the first span (not null-terminated) or NULL if empty
+  return (first);
+}
+
+size_t CStrSpans::getFirstLength(void) const {
+  /// @brief Returns length of the first span in chars
+  return (firstLength);
+}
+
+const char * CStrSpans::getSecond(void) const {
+  /// @brief Returns pointer to the second span (not null-terminated) or NULL if the
+  /// string is stored as a single span
+  return (second);
+}
+
+size_t CStrSpans::getSecondLength(void) const {
+  /// @brief Returns length of the second span in chars
+  return (secondLength);
+}
+
+char CStrSpans::charAt(size_t index) const {
+  /// @brief Returns char at the specified position of the string
+  /// @param index Position in the string
+  /// @return Char at index or '\0' if index is beyond the end of the string
+  if (index < firstLength) return (first[index]);
+  index -= firstLength;
+  if (index < secondLength) return (second[index]);
+  return ('\0');
+}
+
+//////////////////////////////////////////////////////////////////////
+// CStrRingBuffer
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Circular buffer for storing c-strings
+/// @details Implements a c-string circular buffer. C-strings are sent to the circular
+/// buffer with push() method until buffer is full, then oldest c-strings are
+/// overwritten. Oldest c-strings can also be manually removed from the circular
+/// buffer with pop() method. Circular buffer contents are accessible with get()
+/// method, or without copying with getSpans() method.
+class CStrRingBuffer {
+  public:
+    inline CStrRingBuffer ();
+    inline CStrRingBuffer (char * buffer, size_t charsInBuffer);
+    inline boolean validate(void) const;
+    boolean push(const char * item);
+    void pop(void);
+    size_t count(void) const;
+    boolean full(const char * item) const;
+    boolean full(size_t length) const;
+    boolean empty(void) const;
+    size_t get(size_t index, char *dst, size_t dstSize) const;
+    CStrSpans getSpans(size_t index) const;
+  private:
+    inline boolean fullUnsafe(const char * item) const;
+    inline boolean fullUnsafe(size_t length) const;
+    inline size_t getNextIndex(void) const;
+  private:
+    size_t getCstrStartChar(size_t index) const;
+  private:
+    char * ringBuffer = NULL;
+    size_t ringBufferSize = 0;
+    size_t indexOldestItem = 0;
+    size_t totalCharCount = 0;
+    size_t cstrCount = 0;
+    static const char nullChar = '\0';
+    static const size_t nullCharSize = sizeof (nullChar);
+};
+
+CStrRingBuffer::CStrRingBuffer() {
+  /// @brief Creates non-initialised c-string circular buffer
+  /// @details Only needed for compatibility
+  /// @par Non-initialised circular buffer behaves as empty
+  /// ring buffer with the following differences:
+  /// * validate() always returns false
+  /// * push() and pop() perform no action
+  /// * count() always returns 0
+}
+
+CStrRingBuffer::CStrRingBuffer(char * buffer, size_t charsInBuffer) {
+  /// @brief Creates a ring buffer
+  /// @param buffer Memory area to store buffer data
+  /// @param charsInBuffer Buffer size in chars
+  if (charsInBuffer < (2 * nullCharSize)) return;
+  if (!buffer) return;
+  //Minimum buffer length 2 chars, 1 char is reserved for '\0' at the end
+  //of the buffer to be able to print cstrings directly from the ring buffer
+  ringBuffer = buffer;
+  ringBufferSize = charsInBuffer - nullCharSize;
+  ringBuffer[charsInBuffer - 1] = '\0';
+}
+
+boolean CStrRingBuffer::validate(void) const {
+  /// @brief Checks if the c-string ring buffer is initialised
+  /// @return true if ring buffer is initialised, otherwise returns false
+  return ((ringBuffer != NULL) && (ringBufferSize != 0));
+}
+
+size_t CStrRingBuffer::getNextIndex(void) const {
+  /// @brief Finds next position to store a c-string in buffer
+  /// @return Position in the buffer to store next c-string
+  const size_t nextIndex = indexOldestItem + totalCharCount;
+  if (nextIndex >= ringBufferSize) return (nextIndex - ringBufferSize);
+  return (nextIndex);
+}
+
+/// @brief A Print class which saves printed text to buffer and tracks its length
+/// @details Text is saved to buffer until buffer is full. After that new text is
+/// dropped and the number of dropped chars is counted, so that truncation can be
+/// detected with getDroppedChars().
+/// @par Null-terminator is not written after every write; call finish() when the
+/// text is complete to terminate it. One char of the buffer is always reserved
+/// for the null-terminator.
+class PrintToBufferFast : public Print {
+  public:
+    inline PrintToBufferFast(char * buffer, size_t bufferSize);
+    virtual size_t write(uint8_t character);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    inline size_t finish(void);
+    inline size_t length(void) const;
+    inline size_t getDroppedChars(void) const;
+  private:
+    char * buffer = NULL;
+    size_t maxLength = 0;
+    size_t bufferPosition = 0;
+    size_t droppedChars = 0;
+    static const char nullChar = '\0';
+    static const size_t nullCharSize = sizeof (nullChar);
+};
+
+/// @brief Initialises PrintToBufferFast
+/// @param buffer Buffer to save printed text to
+/// @param bufferSize Size of the buffer in chars
+PrintToBufferFast::PrintToBufferFast(char * buffer, size_t bufferSize) {
+  if (!buffer || !bufferSize) return;
+  this->buffer = buffer;
+  this->maxLength = bufferSize - nullCharSize;
+}
+
+/// @brief Null-terminates the text saved to buffer
+/// @return Length of the text in chars (not including null-terminator)
+size_t PrintToBufferFast::finish(void) {
+  if (buffer) buffer[bufferPosition] = nullChar;
+  return (bufferPosition);
+}
+
+/// @brief Returns length of the text saved to buffer in chars
+size_t PrintToBufferFast::length(void) const {
+  return (bufferPosition);
+}
+
+/// @brief Returns number of chars which did not fit into buffer
+/// @return Number of dropped chars or 0 if the text was not truncated
+size_t PrintToBufferFast::getDroppedChars(void) const {
+  return (droppedChars);
+}
+
+/// @brief A Print class which saves to buffer everything was printed with it
+/// @details Text is saved to buffer until buffer is full. After that new
+/// text is ignored
+/// @par Buffer contents are null-terminated after every write. If the text is
+/// only needed after it is completely printed, use PrintToBufferFast instead.
+class PrintToBuffer : public PrintToBufferFast {
+  public:
+    inline PrintToBuffer(char * buffer, size_t bufferSize);
+    virtual size_t write(uint8_t character);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+};
+
+/// @brief Initialises PrintToBuffer
+/// @param buffer Buffer to save printed text to
+/// @param bufferSize Size of the buffer in chars
+PrintToBuffer::PrintToBuffer(char * buffer, size_t bufferSize) : PrintToBufferFast(buffer, bufferSize) {
+}
+
+}; //namespace arrays
+
+namespace checksum {
+
+//////////////////////////////////////////////////////////////////////
+// crc16
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Calculates checksum crc16 for a memory area
+/// @details Implementation based on this great guide: http://www.ross.net/crc/download/crc_v3.txt
+/// @param buffer A memory area to calculate crc16 for
+/// @param bufferSize Memory area size in bytes
+/// @param poly A polynomial to calculate CRC. High (17th) bit of the polynomial is implicitly set. Default is 0x8005.
+/// @param reverseIn If true, bit order in every input byte is reversed before performing CRC calculations. True by default.
+/// @param reverseOut If true, bit order in CRC value is reversed after calculations. True by default.
+/// @return Calculated CRC16 value
+uint16_t crc16(const void * buffer, size_t bufferSize, uint16_t poly = 0x8005, uint16_t init = 0x0000, boolean reverseIn = true, boolean reverseOut = true);
+
+}; //namespace checksum
+
+namespace dsp {
+
+//////////////////////////////////////////////////////////////////////
+// FixedPoint
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Fixed point number with integer and fraction parts
+/// @tparam T An integer base type for fixed point number.
+/// @tparam FractionBits Number of least significant bits storing fraction part
+/// @tparam U A wider range data type, used as intermediary to avoid overflow during calculations.
+/// Ideally should be twice as wide as T. If U is not specified, T is also used as intermediary (
+/// not recommended since it may lead to overflow during multiplication/division and initialisation
+/// from integer with decimal point shift).
+/// @tparam TRangeMin Minimum value possible for T
+/// @tparam TRangeMax Maximum value possible for T
+/// @details Basic arithmetic (+, -, *, /, +=, -=, *=, /=) and logic (<, <=, >, >=, !=, ==)
+/// operations are possible.
+/// @par If as a result of the arithmetic operation the Fixed Point value reaches
+/// minimum or maximum possible values for integer part, it becames an overflow value. The
+/// overflow values are capped at minimum and maximum of possible range. Any further arithmetic
+/// operation with overflow value results in the same overflow value.
+/// @par Overflow can be detected with overflow() function.
+/// @par If both TRangeMin or TRangeMax are zero, no range check is performed and the
+/// fixed-point value is not overflow-safe; overflow() always returns false.
+/// @par Minimum and maximum possible values for integer part are declared as constants min and max.
+/// @par Conversion to the integer type T is possible and is performed by rounding (i.e. if fraction
+/// part is greater or equal to 0.5 the return value is increased by 1).
+template <typename T, size_t FractionBits, typename U = T, T TMinRange = static_cast<T>(0), T TMaxRange = static_cast<T>(0)>
+class FixedPoint {
+  public:
+    /// @brief Default constructor, sets value to zero
+    constexpr FixedPoint() : value(tZero) {}
+    /// @brief Copy constructor, copies value from other FixedPoint object
+    /// @param other Other FixedPoint object to copy value from
+    constexpr FixedPoint(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &other) : value(other.value) {}
+    /// @brief Creates a Fixed Point value from integer value with known decimal precision
+    /// @details For example Pi can be defined as follows (provided that large number fits into type T):
+    ///     FixedPoint(314159265, 8);
+    /// @par The constructor is constexpr: if both parameters are constants, the value is
+    /// calculated at compile time and no initialisation code is generated.
+    /// @param integer Integer part
+    /// @param decimalsPrecision How many least significant decimal digits are fractions
+    /// (= for how many digits to left-shift decimal point)
+    constexpr FixedPoint(T integer, size_t decimalsPrecision = 0) :
+      value(decimalsPrecision ? fromDecimal(integer, tOne, decimalsPrecision) : fromInteger(integer)) {}
+    FixedPoint(const char * str);
+  public:
+    /// @brief Creates a Fixed Point value from its internal representation
+    /// @param raw Internal representation (integer and fraction part) of the value
+    /// @return Fixed Point value
+    static constexpr FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> fromRaw(T raw) {
+      return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>(raw, RawTag()));
+    }
+    /// @brief Creates a Fixed Point value from intermediary representation of type U
+    /// @details Intermediary representation has the same fraction bits as internal
+    /// representation but a wider range; the value is capped at range limits
+    /// @param intermediary Intermediary representation of the value
+    /// @return Fixed Point value
+    static constexpr FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> fromIntermediary(U intermediary) {
+      return (fromRaw(clampU(intermediary)));
+    }
+    /// @brief Returns internal representation of the value
+    /// @return Value of type T, consists of integer and fraction part
+    constexpr T getRaw(void) const {
+      return (value.get());
+    }
+    static constexpr T parse(const char * str);
+  public:
+    /// @brief Convert integer part to integer type T
+    /// @details Conversion is performed by rounding, e.g. conversion of value 1.5 will return 2
+    /// @return Integer part of the value
+    inline explicit operator T() const {
+      if (TMinRange && TMaxRange) {
+        if (value.get() == TMaxRange) return (TMaxRange);
+        if (value.get() == TMinRange) return (TMinRange);
+      }
+      T absValue = value.get();
+      boolean negativeValue = false;
+      if (TMinRange && TMaxRange) {
+        if (TMinRange < tZero) {
+          if (absValue < tZero) {
+            absValue = ~absValue + tOne;
+            negativeValue = true;
+          }
+        }
+      }
+      absValue = (absValue >> FractionBits) + ((absValue >> (FractionBits - 1)) & tOne); //add 1 if most significant fraction bit is set (fraction part >= 0.5)
+      return (negativeValue ? ~absValue + tOne : absValue);
+    }
+    /// @brief Assignment operator, copies value from other FixedPoint object
+    /// @param other Other FixedPoint object to copy value from
+    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator = (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &other) {
+      value.setT(other.value.get());
+      return (*this);
+    }
+  public:
+    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator += (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      value.setU(static_cast<U>(value.get()) + static_cast<U>(rhs.value.get()));
+      return (*this);
+    }
+    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator -= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      value.setU(static_cast<U>(value.get()) - static_cast<U>(rhs.value.get()));
+      return (*this);
+    }
+    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator *= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      value.setU(static_cast<U>(value.get()) * static_cast<U>(rhs.value.get()) / static_cast<U>(fractionBitsPwr2));
+      return (*this);
+    }
+    inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>& operator /= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      value.setU(static_cast<U>(value.get()) * static_cast<U>(fractionBitsPwr2) /  static_cast<U>(rhs.value.get()));
+      return (*this);
+    }
+    /// @brief Unary minus
+    /// @details Negation of overflow value results in an opposite overflow value
+    constexpr FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> operator - () const {
+      return (fromRaw(
+                (TMinRange && TMaxRange && (value.get() == TMinRange)) ? TMaxRange :
+                (TMinRange && TMaxRange && (value.get() == TMaxRange)) ? TMinRange :
+                static_cast<T>(tZero - value.get())));
+    }
+    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
+    operator + (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
+      temp += rhs;
+      return (temp);
+    }
+    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
+    operator - (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
+      temp -= rhs;
+      return (temp);
+    }
+    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
+    operator * (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
+      temp *= rhs;
+      return (temp);
+    }
+    friend inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>
+    operator / (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+      FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> temp = lhs;
+      temp /= rhs;
+      return (temp);
+    }
+  public:
+    inline boolean operator == (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
+      return (value.get() == rhs.value.get());
+    }
+    inline boolean operator != (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
+      return (!(*this == rhs));
+    }
+    inline boolean operator < (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
+      return (value.get() < rhs.value.get());
+    }
+    inline boolean operator > (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
+      return (rhs < *this);
+    }
+    inline boolean operator <= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
+      return (!(*this > rhs));
+    }
+    inline boolean operator >= (const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) const {
+      return (!(*this < rhs));
+    }
+  public:
+    static const T min = TMinRange  ? ((TMinRange >> FractionBits) + 1) : TMinRange; ///< Minimum range for integer part of FixedPoint value
+    static const T max = TMaxRange >> FractionBits; ///< Maximum range for integer part of FixedPoint value
+    static const size_t fractionBits = FractionBits; ///< Number of fraction bits
+  public:
+    /// @brief Detect overflow
+    /// @par value Value to check for overflow
+    /// @return true if the value of this object is overflow, false otherwise.
+    /// If the minimum/maximum limits are not set, always returns false.
+    inline boolean overflow(void) const {
+      if (!TMinRange && !TMaxRange) return (false);
+      if ((value.get() == TMinRange) || (value.get() == TMaxRange)) return (true);
+      return (false);
+    }
+  public:
+    /// @brief Saturating arithmetic with sticky overflow flag
+    /// @details Addition, subtraction and multiplication results are capped at
+    /// the range limits without branching on the operands, so a chain of operations
+    /// compiles to straight-line code. Instead of checking overflow() after every
+    /// operation, the caller performs a batch of operations and checks overflow()
+    /// of this object once: it is set if any result was an overflow value since
+    /// construction or last reset().
+    /// @par Only results are tracked, since operands are mostly results of previous
+    /// operations. Operands coming from outside of the batch (e.g. filter inputs)
+    /// should be passed through check() unless they are known to be within range.
+    /// @par Unlike regular arithmetic, an overflow operand does not force the result to
+    /// be overflow value; use result() to obtain overflow value for the whole batch. The
+    /// sign of the batch overflow is the sign of the first saturated result, since later
+    /// operations on a capped value may change its sign.
+    /// @par If the range is not set, results are not capped and overflow() always
+    /// returns false.
+    class Saturating {
+      public:
+        inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> add(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+          return (track(clampU(static_cast<U>(lhs.getRaw()) + static_cast<U>(rhs.getRaw()))));
+        }
+        inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> sub(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+          return (track(clampU(static_cast<U>(lhs.getRaw()) - static_cast<U>(rhs.getRaw()))));
+        }
+        inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> mul(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &lhs, const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &rhs) {
+          return (track(clampU(static_cast<U>(lhs.getRaw()) * static_cast<U>(rhs.getRaw()) / static_cast<U>(fractionBitsPwr2))));
+        }
+        /// @brief Includes an operand from outside of the batch into overflow tracking
+        /// @param x Operand to check
+        /// @return x
+        inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> check(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &x) {
+          return (track(x.getRaw()));
+        }
+        /// @brief Checks sticky overflow flag
+        /// @return true if any result or checked operand was overflow value since
+        /// construction or last reset(), false otherwise
+        inline boolean overflow(void) const {
+          return (overflowFlag);
+        }
+        /// @brief Clears sticky overflow flag
+        inline void reset(void) {
+          overflowFlag = false;
+          overflowNegative = false;
+        }
+        /// @brief Returns final result of the batch
+        /// @param x Result of the last operation of the batch
+        /// @return x if no overflow occured in the batch, otherwise overflow value
+        /// with the same sign as the first saturated result or checked operand
+        inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> result(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &x) const {
+          if (!overflowFlag) return (x);
+          return (fromRaw(overflowNegative ? TMinRange : TMaxRange));
+        }
+      private:
+        static constexpr boolean isLimit(T raw) {
+          return ((TMinRange || TMaxRange) && ((raw == TMinRange) | (raw == TMaxRange)));
+        }
+        inline FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> track(T raw) {
+          const boolean limit = isLimit(raw);
+          overflowNegative = overflowFlag ? overflowNegative : (limit & (raw == TMinRange));
+          overflowFlag = overflowFlag | limit;
+          return (fromRaw(raw));
+        }
+        boolean overflowFlag = false;
+        boolean overflowNegative = false;
+    };
+  public:
+    T getValue(size_t decimalPrecision, boolean *status = nullptr) const;
+    size_t toString(char * buffer, size_t bufferSize, size_t decimals) const;
+  protected:
+    /// @brief Internal value class, created to encapsulate the value and unify value assignment
+    class Value {
+      public:
+        constexpr Value() {}
+        /// @brief Initialises value from type T value without range check
+        /// @param initValue Initial value of type T, consists of integer and fraction part
+        constexpr Value(T initValue) : val(initValue) {}
+        /// @brief Sets value from type T value
+        /// @newValue New value of type T, consists of integer and fraction part at this point
+        /// @return true if no overflow occured, false otherwise
+        inline boolean setT(T newValue) {
+          val = newValue;
+          return (true);
+        }
+        /// @brief Sets value from type U value
+        /// @newValue New value of type U, consists of integer and fraction part at this point
+        /// @return true if no overflow occured, false otherwise
+        inline boolean setU(U newValue) {
+          if (TMinRange && TMaxRange) {
+            if (val == TMaxRange || val == TMinRange) {
+              return (false);
+            }
+            if (newValue < static_cast<U>(TMinRange)) {
+              val = TMinRange;
+              return (false);
+            }
+            if (newValue > static_cast<U>(TMaxRange)) {
+              val = TMaxRange;
+              return (false);
+            }
+          }
+          val = static_cast<T>(newValue);
+          return (true);
+        }
+        /// @brief Returns value of type T (with integer and fraction parts)
+        /// @returns Value of type T, consists of integer and fraction part
+        constexpr T get(void) const {
+          return (val);
+        }
+      private:
+        T val = {}; ///< Storage for value
+    };
+    Value value;
+  private:
+    /// @brief Tag to select constructor from internal representation
+    struct RawTag {};
+    constexpr FixedPoint(T raw, RawTag) : value(raw) {}
+  private:
+    static constexpr T fromInteger(T integer);
+    static constexpr T fromDecimal(T integer, T divider, size_t decimalsPrecision);
+    static constexpr T clampU(U newValue);
+    static constexpr boolean isDigit(char c);
+    static constexpr T parseSign(const char * str);
+    static constexpr T parseInteger(const char * str, boolean negative, T integerPart);
+    static constexpr T parseIntegerDigit(const char * str, boolean negative, T integerPart);
+    static constexpr T parseFraction(const char * str);
+    static constexpr boolean validateFraction(const char * str);
+  protected:
+    static const T tZero = static_cast<T>(0); ///< 0 constant of type T
+    static const T tOne = static_cast<T>(1);  ///< 1 constant of type T
+    static const T fractionBitsPwr2 = tOne << FractionBits; ///< A number of type T, equals to 2 pow FractionBits
+    //Make sure that FractionBits are less than total bit width of T
+    static_assert(FractionBits < (sizeof(T) * 8), "Too many fraction bits");
+    //Make sure that more than zero FractionBits are defined (if zero fraction bits required, simply use type T)
+    static_assert(FractionBits > 0, "Too few fraction bits");
+};
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromInteger(T integer) {
+  /// @brief Converts integer to internal representation, capping at range limits
+  /// @param integer Integer part
+  /// @return Internal representation of the value
+  return ((TMinRange && TMaxRange && (integer < min)) ? TMinRange :
+          (TMinRange && TMaxRange && (integer > max)) ? TMaxRange :
+          static_cast<T>(integer * fractionBitsPwr2));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromDecimal(T integer, T divider, size_t decimalsPrecision) {
+  /// @brief Converts integer with decimal point shift to internal representation
+  /// @details Accumulates the decimal divider, one digit per recursion step. If the
+  /// divider is about to exceed the range, the integer is divided instead (least
+  /// significant digits are lost)
+  /// @param integer Integer value
+  /// @param divider Decimal divider accumulated so far
+  /// @param decimalsPrecision Decimal digits remaining to process
+  /// @return Internal representation of the value
+  return ((!integer) ? tZero :
+          (!decimalsPrecision) ?
+          clampU(static_cast<U>(integer) * static_cast<U>(fractionBitsPwr2) / static_cast<U>(divider)) :
+          (!(TMinRange && TMaxRange) || (divider < (TMaxRange / static_cast<T>(10)))) ?
+          fromDecimal(integer, static_cast<T>(divider * static_cast<T>(10)), decimalsPrecision - 1) :
+          fromDecimal(static_cast<T>(integer / static_cast<T>(10)), divider, decimalsPrecision - 1));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::clampU(U newValue) {
+  /// @brief Converts U value to T value, capping at range limits
+  /// @param newValue Value of type U, consists of integer and fraction part
+  /// @return Value of type T
+  return ((TMinRange && TMaxRange && (newValue < static_cast<U>(TMinRange))) ? TMinRange :
+          (TMinRange && TMaxRange && (newValue > static_cast<U>(TMaxRange))) ? TMaxRange :
+          static_cast<T>(newValue));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parse(const char * str) {
+  /// @brief Converts decimal number c-string to internal representation at compile time
+  /// @details Produces the same result as FixedPoint(const char * str) but is evaluated
+  /// at compile time if str is a constant (see also user-defined literal _fx).
+  /// @par Since the function is recursive, it is not intended to parse long strings at
+  /// runtime; use FixedPoint(const char * str) instead.
+  /// @param str C-string with decimal number, e.g. "-10.25"
+  /// @return Internal representation of the value or zero if the string is not a valid
+  /// number
+  return ((!str || !(*str)) ? tZero : parseSign(str));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr boolean FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::isDigit(char c) {
+  return ((c >= '0') && (c <= '9'));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parseSign(const char * str) {
+  /// @brief Processes plus or minus sign in the beginning of the string
+  return (((*str) == '-') ?
+          ((TMinRange && TMaxRange && (TMinRange > tZero)) ? tZero : parseInteger(str + 1, true, tZero)) :
+          parseInteger(((*str) == '+') ? (str + 1) : str, false, tZero));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parseInteger(const char * str, boolean negative, T integerPart) {
+  /// @brief Processes integer part of the number, one digit per recursion step
+  return ((!(*str)) ? static_cast<T>(integerPart * fractionBitsPwr2) :
+          ((*str) == '.') ?
+          (validateFraction(str + 1) ?
+           static_cast<T>(integerPart * fractionBitsPwr2 +
+                          (negative ? static_cast<T>(tZero - parseFraction(str + 1)) : parseFraction(str + 1))) :
+           tZero) :
+          (!isDigit(*str)) ? tZero :
+          parseIntegerDigit(str, negative, static_cast<T>(integerPart * static_cast<T>(10) +
+                            (negative ? static_cast<T>(tZero - static_cast<T>((*str) - '0')) : static_cast<T>((*str) - '0')))));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parseIntegerDigit(const char * str, boolean negative, T integerPart) {
+  /// @brief Checks integer part for overflow after the digit was added
+  return ((TMinRange && TMaxRange && (integerPart < (min + 1))) ? TMinRange :
+          (TMinRange && TMaxRange && (integerPart > (max - 1))) ? TMaxRange :
+          parseInteger(str + 1, negative, integerPart));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr boolean FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::validateFraction(const char * str) {
+  /// @brief Checks that fraction part contains only decimal digits
+  return (!(*str) || (isDigit(*str) && validateFraction(str + 1)));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+constexpr T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::parseFraction(const char * str) {
+  /// @brief Processes fraction part of the number starting from the last digit
+  return ((!(*str)) ? tZero :
+          static_cast<T>((parseFraction(str + 1) + (static_cast<T>((*str) - '0') << FractionBits)) / static_cast<T>(10)));
+}
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::FixedPoint(const char * str) {
+  const char * currStrChar = str;
+  const char decimalPointChar = '.';
+  const char minusSignChar = '-';
+  const char plusSignChar = '+';
+  const T decimalRadixT = static_cast<T>(10);
+  value.setT(tZero);
+  //make sure str is not NULL and not empty
+  if ((!str) || (!(*currStrChar))) return;
+  //check plus & minus sign
+  boolean negative = false;
+  if ((*currStrChar) == minusSignChar) {
+    currStrChar++;
+    negative = true;
+    if (TMinRange && TMaxRange) {
+      if (TMinRange > tZero) return;
+    }
+  } else {
+    if ((*currStrChar) == plusSignChar) currStrChar++;
+  }
+  //process integer part
+  T integerPart = static_cast<U>(0);
+  while ((*currStrChar) && ((*currStrChar) != decimalPointChar)) {
+    if (((*currStrChar) < '0') || ((*currStrChar) > '9')) {
+      value.setT(tZero);
+      return;
+    }
+    T currentDigit = static_cast<T>((*currStrChar) - '0');
+    if (negative) currentDigit = ~currentDigit + tOne;
+    integerPart = integerPart * decimalRadixT + currentDigit;
+    if (TMinRange && TMaxRange) {
+      if (integerPart < (min + 1)) {
+        value.setT(TMinRange);
+        return;
+      }
+      if (integerPart > (max - 1)) {
         value.setT(TMaxRange);
         return;
       }
-    }//if (TMinRange && TMaxRange)
-    currStrChar++;
-  }//while
-  integerPart = integerPart << FractionBits;
-  if (!(*currStrChar)) {
-    value.setT(integerPart);
+    }//if (TMinRange && TMaxRange)
+    currStrChar++;
+  }//while
+  integerPart = integerPart << FractionBits;
+  if (!(*currStrChar)) {
+    value.setT(integerPart);
+    return;
+  }
+  //set fraction part pointer to the last digit of the str
+  const char * decimalPointStrChar = currStrChar;
+  while (*(currStrChar + 1)) {
+    currStrChar++;
+  }
+  //process fraction part
+  T fractionPart = tZero;
+  while (currStrChar != decimalPointStrChar) {
+    if (((*currStrChar) < '0') || ((*currStrChar) > '9')) {
+      value.setT(tZero);
+      return;
+    }
+    T currentDigit = static_cast<T>((*currStrChar) - '0');
+    fractionPart = (fractionPart + (currentDigit << FractionBits)) / decimalRadixT;
+    currStrChar--;
+  }
+  if (negative) fractionPart = ~fractionPart + tOne;
+  value.setT(integerPart + fractionPart);
+}
+
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::getValue(size_t decimalPrecision, boolean *status) const {
+  /// @brief Converts a Fixed Point value to the base type with a specified decimal precision
+  /// @details For example, result of conversion of value of 10.573 can be 10
+  /// (for decimalPrecision 0), 106 (for decimalPrecision 1), 1057 (for decimalPrecision 2),
+  /// 10573 (for decimalPrecision 3), 105730 (for decimalPrecision 4), etc.
+  /// @param decimalPrecision How many least significant decimal digits of the returned value
+  /// are fractions (= for how many digits to left-shift decimal point)
+  /// @param status Pointer to boolean variable which will be set to true if conversion was
+  /// successful and to false otherwise. If not needed, this parameter can be skipped or
+  /// set equal to nullptr
+  /// @return Conversion result or TMinRange/TMaxRange if result is out of range of type T
+  /// (TMinRange...TMaxRange)
+  if (status) {
+    (*status) = false;
+  }
+  U tempValue = static_cast<U>(this->value.get());
+  static const U decimalRadix = static_cast<U>(10);
+  for (size_t i = 0; i < decimalPrecision; i++) {
+    tempValue *= decimalRadix;
+    if (TMinRange && TMaxRange) {
+      if (tempValue < static_cast<U>(TMinRange)) {
+        return (TMinRange);
+      }
+      if (tempValue > static_cast<U>(TMaxRange)) {
+        return (TMaxRange);
+      }
+    }//if (TMinRange && TMaxRange)
+  }//for
+  if (status) {
+    (*status) = true;
+  }
+  tempValue /= static_cast<U>(fractionBitsPwr2);
+  return (static_cast<T>(tempValue));
+}
+
+//////////////////////////////////////////////////////////////////////
+// FixedPoint math functions
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Integer kernels for FixedPoint exponent, logarithm, square root and
+/// trigonometric functions
+/// @details All intermediary calculations are performed in 64-bit integers with
+/// fractionBits fraction bits regardless of the format of FixedPoint arguments;
+/// no floating point operations are used.
+/// @par Use exp(), log(), sqrt() and pow() templates rather than calling this class
+/// directly.
+class FixedPointMath {
+  public:
+    static const size_t fractionBits = 30; ///< Fraction bits used for intermediary values
+    static int64_t exp(int64_t x, size_t resultFractionBits);
+    static int64_t log(uint32_t x, size_t xFractionBits);
+    static uint32_t sqrt(uint64_t x);
+    static int64_t mul(int64_t x, int64_t y, size_t yFractionBits);
+    static void sinCos(int64_t x, int64_t &sine, int64_t &cosine);
+    static int64_t mulIntermediary(int64_t x, int64_t y);
+    static int64_t divIntermediary(int64_t x, int64_t y);
+    static inline int64_t mulFraction(int64_t x, int32_t fraction);
+    template <typename T, T TMinRange, T TMaxRange>
+    static inline T clamp(int64_t x);
+    template <class F>
+    static inline int64_t fromFixedPoint(const F &x);
+    template <class F>
+    static inline F toFixedPoint(int64_t x);
+};
+
+int64_t FixedPointMath::mulFraction(int64_t x, int32_t fraction) {
+  /// @brief Multiplies 64-bit value by fraction
+  /// @details x is split into high and low parts so that 64-bit products do not
+  /// overflow; the low part product is truncated
+  /// @param x Value to multiply, must be less than 2^50 by absolute value
+  /// @param fraction Multiplier with fractionBits fraction bits
+  /// @return x * fraction
+  static const size_t splitBits = 20;
+  static const int64_t lowMask = (static_cast<int64_t>(1) << splitBits) - 1;
+  const int64_t high = (x >> splitBits) * fraction;
+  const int64_t low = (x & lowMask) * fraction;
+  return ((high >> (fractionBits - splitBits)) + (low >> fractionBits));
+}
+
+template <typename T, T TMinRange, T TMaxRange>
+T FixedPointMath::clamp(int64_t x) {
+  /// @brief Converts 64-bit intermediary value to type T, capping at range limits
+  /// @details If range limits are not set, the value is capped at the limits of type T
+  /// @param x Value to convert
+  /// @return Value of type T
+  static const boolean isSigned = (static_cast<T>(-1) < static_cast<T>(0));
+  static const T tMax = isSigned ? static_cast<T>((static_cast<uint64_t>(1) << (sizeof(T) * 8 - 1)) - 1) : static_cast<T>(~static_cast<T>(0));
+  static const T tMin = isSigned ? static_cast<T>(-tMax - 1) : static_cast<T>(0);
+  static const T rangeMin = (TMinRange && TMaxRange) ? TMinRange : tMin;
+  static const T rangeMax = (TMinRange && TMaxRange) ? TMaxRange : tMax;
+  if (x < static_cast<int64_t>(rangeMin)) return (rangeMin);
+  if (x > static_cast<int64_t>(rangeMax)) return (rangeMax);
+  return (static_cast<T>(x));
+}
+
+template <class F>
+int64_t FixedPointMath::fromFixedPoint(const F &x) {
+  /// @brief Converts FixedPoint value to intermediary value
+  /// @tparam F FixedPoint type with less than fractionBits fraction bits
+  /// @param x FixedPoint value
+  /// @return Intermediary value with fractionBits fraction bits
+  static_assert(F::fractionBits < fractionBits, "Too many fraction bits for intermediary value");
+  return (static_cast<int64_t>(x.getRaw()) * (static_cast<int64_t>(1) << (fractionBits - F::fractionBits)));
+}
+
+template <class F>
+F FixedPointMath::toFixedPoint(int64_t x) {
+  /// @brief Converts intermediary value to FixedPoint value with rounding
+  /// @tparam F FixedPoint type with less than fractionBits fraction bits
+  /// @param x Intermediary value with fractionBits fraction bits
+  /// @return FixedPoint value, capped at range limits
+  static_assert(F::fractionBits < fractionBits, "Too many fraction bits for intermediary value");
+  static const size_t shiftBits = fractionBits - F::fractionBits;
+  static const int64_t rounding = static_cast<int64_t>(1) << (shiftBits - 1);
+  return (F::fromIntermediary((x + rounding) >> shiftBits));
+}
+
+/// @brief Exponent function e^x for FixedPoint values
+/// @details Argument is reduced to k * ln(2) + r, then e^r is calculated by polynomial
+/// and scaled by 2^k (see FixedPointMath::exp()).
+/// @par Relative error of the result does not exceed 2^-26, plus half of the least
+/// significant bit due to rounding. Note that since the relative error of the result
+/// equals to absolute error of the argument, quantisation of x itself (half of the
+/// least significant bit of x) usually dominates.
+/// @par If the result is out of range, it is capped at maximum range (overflow value).
+/// Overflow argument results in the same overflow value.
+/// @param x Argument
+/// @return e^x
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> exp(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &x) {
+  static_assert(sizeof(T) <= sizeof(uint32_t), "FixedPoint math functions require base type of 32 bits or less");
+  static_assert(FractionBits < FixedPointMath::fractionBits, "Too many fraction bits for FixedPoint math functions");
+  if (x.overflow()) return (x);
+  const int64_t argument = static_cast<int64_t>(x.getRaw()) * (static_cast<int64_t>(1) << (FixedPointMath::fractionBits - FractionBits));
+  return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromRaw(
+            FixedPointMath::clamp<T, TMinRange, TMaxRange>(FixedPointMath::exp(argument, FractionBits))));
+}
+
+/// @brief Natural logarithm ln(x) for FixedPoint values
+/// @details Argument is reduced to m * 2^e, sqrt(1/2) <= m < sqrt(2), then ln(m)
+/// is calculated by series (see FixedPointMath::log()).
+/// @par Absolute error of the result does not exceed 2^-24, plus half of the least
+/// significant bit due to rounding.
+/// @par If x is zero or negative, minimum range (overflow value) is returned. Overflow
+/// argument results in the same overflow value.
+/// @param x Argument
+/// @return ln(x)
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> log(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &x) {
+  static_assert(sizeof(T) <= sizeof(uint32_t), "FixedPoint math functions require base type of 32 bits or less");
+  static_assert(FractionBits < FixedPointMath::fractionBits, "Too many fraction bits for FixedPoint math functions");
+  static const int64_t minusInfinity = INT64_MIN;
+  if (x.overflow()) return (x);
+  if (x.getRaw() <= static_cast<T>(0))
+    return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromRaw(FixedPointMath::clamp<T, TMinRange, TMaxRange>(minusInfinity)));
+  const int64_t rounding = static_cast<int64_t>(1) << (FixedPointMath::fractionBits - FractionBits - 1);
+  const int64_t result = (FixedPointMath::log(static_cast<uint32_t>(x.getRaw()), FractionBits) + rounding) >> (FixedPointMath::fractionBits - FractionBits);
+  return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromRaw(FixedPointMath::clamp<T, TMinRange, TMaxRange>(result)));
+}
+
+/// @brief Square root for FixedPoint values
+/// @details The result is calculated exactly and rounded to the nearest value, thus error
+/// does not exceed half of the least significant bit.
+/// @par If x is negative, zero is returned. Overflow argument results in the same overflow
+/// value.
+/// @param x Argument
+/// @return Square root of x
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> sqrt(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &x) {
+  static_assert(sizeof(T) <= sizeof(uint32_t), "FixedPoint math functions require base type of 32 bits or less");
+  static_assert(FractionBits < FixedPointMath::fractionBits, "Too many fraction bits for FixedPoint math functions");
+  if (x.overflow()) return (x);
+  if (x.getRaw() <= static_cast<T>(0)) return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>());
+  const uint64_t square = static_cast<uint64_t>(x.getRaw()) << FractionBits;
+  return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromRaw(
+            FixedPointMath::clamp<T, TMinRange, TMaxRange>(static_cast<int64_t>(FixedPointMath::sqrt(square)))));
+}
+
+/// @brief Power function x^y for FixedPoint values
+/// @details Calculated as e^(y * ln(x)) with intermediary value ln(x) kept at internal
+/// precision.
+/// @par Relative error of the result does not exceed (|y| + 1) * 2^-23, plus half of the
+/// least significant bit due to rounding.
+/// @par Only positive x is supported; if x is zero or negative, zero is returned. If the
+/// result is out of range, it is capped at maximum range (overflow value). If either x or
+/// y is overflow value, overflow value is returned.
+/// @param x Base
+/// @param y Exponent
+/// @return x^y
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> pow(const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &x,
+    const FixedPoint<T, FractionBits, U, TMinRange, TMaxRange> &y) {
+  static_assert(sizeof(T) <= sizeof(uint32_t), "FixedPoint math functions require base type of 32 bits or less");
+  static_assert(FractionBits < FixedPointMath::fractionBits, "Too many fraction bits for FixedPoint math functions");
+  if (x.overflow()) return (x);
+  if (y.overflow()) return (y);
+  if (x.getRaw() <= static_cast<T>(0)) return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>());
+  const int64_t argument = FixedPointMath::mul(FixedPointMath::log(static_cast<uint32_t>(x.getRaw()), FractionBits),
+                           static_cast<int64_t>(y.getRaw()),
+                           FractionBits);
+  return (FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::fromRaw(
+            FixedPointMath::clamp<T, TMinRange, TMaxRange>(FixedPointMath::exp(argument, FractionBits))));
+}
+
+//////////////////////////////////////////////////////////////////////
+// FixedPoint text formatting
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Converts FixedPoint values to decimal text
+/// @details Digits are produced two at a time from digit pair table; division by
+/// 100 is replaced with multiplication by reciprocal and no 64-bit division is used.
+/// @par Use FixedPoint::toString() rather than calling this class directly.
+class FixedPointFormat {
+  public:
+    static const size_t maxDecimals = 9; ///< Maximum number of digits after decimal point
+    static const size_t maxLength = 22;  ///< Buffer size sufficient for any value: sign, 10 integer digits, decimal point, 9 decimals and trailing zero
+    static size_t format(char * buffer, size_t bufferSize, uint32_t magnitude, size_t fractionBits, boolean negative, size_t decimals);
+    static size_t formatOverflow(char * buffer, size_t bufferSize, boolean negative);
+  private:
+    static char * writeDigits(char * end, uint32_t value, size_t minDigits);
+};
+
+template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
+size_t FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::toString(char * buffer, size_t bufferSize, size_t decimals) const {
+  /// @brief Writes a Fixed Point value to the buffer as decimal number
+  /// @details For example, value of 10.573 is written as "11" (for decimals 0),
+  /// "10.6" (for decimals 1), "10.57" (for decimals 2), "10.573" (for decimals 3), etc.
+  /// The value is rounded to the nearest number with specified decimals; the trailing zero
+  /// is always added.
+  /// @par Overflow values are written as "OVF" or "-OVF".
+  /// @par FixedPointFormat::maxLength is a sufficient buffer size for any value.
+  /// @param buffer Buffer to write the text to
+  /// @param bufferSize Size of the buffer in chars, including trailing zero
+  /// @param decimals Number of digits after decimal point (up to FixedPointFormat::maxDecimals)
+  /// @return Number of chars written (excluding trailing zero) or zero if the buffer is too
+  /// small to hold the text
+  static_assert(sizeof(T) <= sizeof(uint32_t), "FixedPoint formatting requires base type of 32 bits or less");
+  static_assert(FractionBits < (sizeof(uint32_t) * 8 - 2), "Too many fraction bits for FixedPoint formatting");
+  const boolean negative = (value.get() < tZero);
+  if (overflow()) return (FixedPointFormat::formatOverflow(buffer, bufferSize, negative));
+  const uint32_t magnitude = negative ?
+                             (static_cast<uint32_t>(0) - static_cast<uint32_t>(value.get())) :
+                             static_cast<uint32_t>(value.get());
+  return (FixedPointFormat::format(buffer, bufferSize, magnitude, FractionBits, negative, decimals));
+}
+
+}; //namespace dsp
+
+//////////////////////////////////////////////////////////////////////
+// Value
+//////////////////////////////////////////////////////////////////////
+
+typedef int32_t ValueBase;
+static const ValueBase ValueBaseMin = INT32_MIN;
+static const ValueBase ValueBaseMax = INT32_MAX;
+static const size_t ValueFractionBits = 10;
+static const size_t ValueDecimals = 3; ///< Decimal digits sufficient to represent fraction part of Value
+typedef int64_t IntermediaryValue;
+
+using Value = dsp::FixedPoint<ValueBase, ValueFractionBits, IntermediaryValue, ValueBaseMin, ValueBaseMax>;
+
+constexpr Value ValuePi = Value(314159265, 8);
+
+/// @brief Decimal number literal used to initialise Value at compile time
+/// @details Stores the literal's characters as a c-string and converts it to
+/// internal representation of Value. Since raw is a constant expression, the
+/// conversion is always performed by compiler.
+template <char... Chars>
+struct ValueLiteral {
+  static constexpr char str[sizeof...(Chars) + 1] = {Chars..., '\0'};
+  static constexpr ValueBase raw = Value::parse(str);
+};
+
+template <char... Chars>
+constexpr char ValueLiteral<Chars...>::str[sizeof...(Chars) + 1];
+
+/// @brief User-defined literal for Value, e.g. 3.14159_fx or 25_fx
+/// @details The value is always calculated at compile time. Only decimal notation
+/// is supported (e.g. 1e3_fx or 0x10_fx result in zero). Negative values are
+/// written with unary minus, e.g. -0.5_fx
+template <char... Chars>
+constexpr Value operator "" _fx() {
+  return (Value::fromRaw(ValueLiteral<Chars...>::raw));
+}
+
+/// @brief Checks whether the valve is overflown (out of range)
+/// @details This function is for compatibility only
+/// @par Reserved for the case when Value is a Plain-Old-Data type (e.g. float) and does not have methods
+/// @param value Value to check
+/// @return True if value is overflown, false if value is a regular number
+inline boolean overflow(const Value & value) {
+  return (value.overflow());
+}
+
+/// @brief Returns an integer value with known decimal precision
+/// @par For example for value 10.7 and precision 1 (1 digit after decimal point) will return 107
+/// @par This function is for compatibility only
+/// @par Reserved for the case when Value is a Plain-Old-Data type (e.g. float) and does not have methods
+/// @param value Value
+/// @return Converted value or zero if conversion failed
+inline ValueBase getValue(const Value & value, size_t decimals, boolean *status = nullptr) {
+  return (value.getValue(decimals, status));
+}
+
+//////////////////////////////////////////////////////////////////////
+// Timestamp
+//////////////////////////////////////////////////////////////////////
+
+typedef uint32_t Timestamp;
+
+inline Timestamp getTimestamp(void) {
+  return (millis());
+}
+
+constexpr Value timestampPerSecond(1000); // 1000 milliseconds per second
+
+namespace dsp {
+
+//////////////////////////////////////////////////////////////////////
+// ValueArray
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Kernels processing contiguous arrays of Value in their internal representation
+/// (ValueBase)
+/// @details Intended for bulk processing, e.g. offline calibration fitting or replay of
+/// sensor logs. All kernels produce the same results regardless of implementation.
+/// @par If compiled for a host with SIMD support (SSE2, AVX2 or NEON) by GCC or Clang,
+/// clamp() and minMax() use compiler vector extensions; otherwise (e.g. on ESP8266)
+/// portable scalar implementation is used. Defining UTIL_DATA_SCALAR_KERNELS forces
+/// scalar implementation. Kernels with 64-bit intermediary values (scaleOffset(), sum(),
+/// dot()) are written as branchless scalar loops which the compiler vectorises itself;
+/// explicit 64-bit vector lanes turned out slower than that on SSE2 and AVX2.
+/// @par Input and output arrays do not need to be aligned and may be the same array.
+class ValueArray {
+  public:
+    static void scaleOffset(const ValueBase * input, ValueBase * output, size_t count, const Value & scale, const Value & offset);
+    static void clamp(ValueBase * data, size_t count, const Value & low, const Value & high);
+    static Value sum(const ValueBase * data, size_t count);
+    static void minMax(const ValueBase * data, size_t count, Value & minimum, Value & maximum);
+    static Value dot(const ValueBase * data1, const ValueBase * data2, size_t count);
+  private:
+    static inline IntermediaryValue clampRange(IntermediaryValue x);
+    static inline boolean isOverflow(ValueBase x);
+    static inline ValueBase scaleOffsetElement(ValueBase x, ValueBase scale, ValueBase offset);
+    static inline IntermediaryValue mulElement(ValueBase x, ValueBase y);
+};
+
+//////////////////////////////////////////////////////////////////////
+// Saturating
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Regular arithmetic with the same interface as FixedPoint::Saturating
+/// @tparam T Type without saturating arithmetic (e.g. float)
+/// @details Used by filters instead of T::Saturating if T does not provide it.
+/// Like FixedPoint::Saturating without range, results are not capped and overflow()
+/// always returns false.
+template <typename T>
+class PlainArithmetic {
+  public:
+    inline T add(const T &lhs, const T &rhs) {
+      return (lhs + rhs);
+    }
+    inline T sub(const T &lhs, const T &rhs) {
+      return (lhs - rhs);
+    }
+    inline T mul(const T &lhs, const T &rhs) {
+      return (lhs * rhs);
+    }
+    inline T check(const T &x) {
+      return (x);
+    }
+    inline boolean overflow(void) const {
+      return (false);
+    }
+    inline void reset(void) {}
+    inline T result(const T &x) const {
+      return (x);
+    }
+};
+
+/// @brief Selects saturating arithmetic for type T
+/// @details Saturating::data_t is defined as T::Saturating if T provides it
+/// (e.g. FixedPoint), otherwise as PlainArithmetic<T>.
+template <typename T>
+struct Saturating {
+  private:
+    template <typename V> static typename V::Saturating select(int);
+    template <typename V> static PlainArithmetic<V> select(...);
+  public:
+    typedef decltype(select<T>(0)) data_t;
+};
+
+/// @brief Converts values to and from their internal representation
+/// @details RawValue::data_t is the internal representation of T if T provides
+/// getRaw() and fromRaw() (e.g. FixedPoint), otherwise T itself. Used to save and
+/// restore filter state without copying objects bytewise.
+template <typename T>
+struct RawValue {
+  private:
+    template <typename V> static auto select(int) -> decltype(V().getRaw());
+    template <typename V> static V select(...);
+  public:
+    typedef decltype(select<T>(0)) data_t;
+    static inline data_t getRaw(const T & value) {
+      return (getRawImpl<T>(value, 0));
+    }
+    static inline T fromRaw(data_t raw) {
+      return (fromRawImpl<T>(raw, 0));
+    }
+  private:
+    template <typename V> static inline auto getRawImpl(const V & value, int) -> decltype(value.getRaw()) {
+      return (value.getRaw());
+    }
+    template <typename V> static inline V getRawImpl(const V & value, long) {
+      return (value);
+    }
+    template <typename V> static inline auto fromRawImpl(data_t raw, int) -> decltype(V::fromRaw(raw)) {
+      return (V::fromRaw(raw));
+    }
+    template <typename V> static inline V fromRawImpl(data_t raw, long) {
+      return (raw);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////
+// Filter
+//////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Timestamp>
+class TemplateFilter {
+  public:
+    enum class Status {
+      NONE,                               ///< No status returned
+      OK,                                 ///< Filter functions normally
+      ERROR_INIT_DATA_INCORRECT,          ///< Error: incorrect data provided for filter initialisation
+      ERROR_INIT_NOT_ENOUGH_MEMORY,       ///< Error: incorrect data provided for filter initialisation
+      ERROR_INIT_FAILED,                  ///< Error: filter initialisation failed
+      WARNING_INIT_DATA_INCORRECT,        ///< Warning: incorrect data provided for filter initialisation; filter may produce unexpected results
+      WARNING_TOO_MANY_INPUTS,            ///< Warning: too many inputs provided for the filter; some inputs were ignored
+      ERROR_TOO_FEW_INPUTS,               ///< Error: too few inputs provided for the filter
+      ERROR_SAMPLING_RATE_TOO_LOW,        ///< Error: time between inputs is too long for the filter frequency
+      OUTPUT_NOT_READY,                   ///< Filter functions normally, but no new output is produced for this input; last output is returned
+    };
+  public:
+    /// @brief Filter operation counters
+    /// @details Only collected if UTIL_DATA_FILTER_TELEMETRY is enabled in
+    /// project_config.h, see getTelemetry()
+    struct Telemetry {
+      uint32_t samples;                   ///< Number of filter() calls
+      uint32_t overflows;                 ///< Number of outputs which are overflow value
+      uint32_t errorsInit;                ///< Number of filter() calls rejected due to initialisation error
+      uint32_t errorsTooFewInputs;        ///< Number of ERROR_TOO_FEW_INPUTS statuses
+      uint32_t errorsSamplingRateTooLow;  ///< Number of ERROR_SAMPLING_RATE_TOO_LOW statuses
+      uint32_t warningsTooManyInputs;     ///< Number of WARNING_TOO_MANY_INPUTS statuses
+      uint32_t lastMicros;                ///< Duration of the last filter() call, microseconds
+      uint32_t peakMicros;                ///< Longest duration of filter() call, microseconds
+    };
+  public:
+    virtual ~TemplateFilter() {};
+    inline const T& filter(Timestamp timestamp = 0);
+    template <typename... Inputs> const T& filter(Timestamp timestamp, const Inputs... inputs);
+    Status getStatus(void);
+    inline const Telemetry * getTelemetry(void) const;
+    inline void resetTelemetry(void);
+  public:
+    size_t getStateSize(void) const;
+    size_t saveState(void * buffer, size_t bufferSize) const;
+    boolean restoreState(const void * buffer, size_t size, Timestamp timestamp);
+  protected:
+    virtual Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp) = 0;
+  protected:
+    virtual size_t getFilterStateSize(void) const;
+    virtual size_t saveFilterState(uint8_t * buffer, size_t bufferSize) const;
+    virtual boolean restoreFilterState(const uint8_t * buffer, size_t size);
+  protected:
+    Timestamp getDeltaTime(Timestamp currentTime);
+  protected:
+    void setInitStatus(Status initStatus);
+    void setInputsNumber(size_t min, size_t max);
+  private:
+    void process(const T *inputs, size_t inputsNumber, Timestamp timestamp);
+    inline boolean initError(void) const;
+  private:
+    static const uint8_t stateFormatVersion = 1;
+    struct StateHeader {
+      uint8_t formatVersion;
+      uint8_t valueSize;
+      uint16_t filterStateSize;
+    };
+  private:
+    Status status = Status::NONE;
+  private:
+    T outputValue = static_cast<T>(0);
+    Timestamp lastTime = static_cast<Timestamp>(0);
+  private:
+    size_t minInputs = 0;
+    size_t maxInputs = 0;
+#if UTIL_DATA_FILTER_TELEMETRY
+  private:
+    Telemetry telemetry = {};
+#endif
+};
+
+template <typename T, typename Timestamp>
+const T& TemplateFilter<T, Timestamp>::filter(Timestamp timestamp) {
+  process(nullptr, 0, timestamp);
+  return (outputValue);
+}
+
+template <typename T, typename Timestamp>
+template <typename... Inputs> const T& TemplateFilter<T, Timestamp>::filter(Timestamp timestamp, const Inputs... inputs) {
+  T inputsArray[] = { T(inputs)... };
+  process(inputsArray, sizeof...(inputs), timestamp);
+  return (outputValue);
+}
+
+template <typename T, typename Timestamp>
+void TemplateFilter<T, Timestamp>::process(const T * inputs, size_t inputsNumber, Timestamp timestamp) {
+  /// @brief Checks status and number of inputs, then calls filterProcess()
+  /// @param inputs Inputs array or nullptr if no inputs are provided
+  /// @param inputsNumber Number of items in inputs array
+  /// @param timestamp Timestamp of the inputs
+#if UTIL_DATA_FILTER_TELEMETRY
+  const uint32_t startMicros = micros();
+#endif
+  outputValue = static_cast<T>(0);
+  const boolean rejected = initError();
+  if (!rejected) {
+    //filter() without inputs is rejected if any inputs are required; otherwise number of
+    //inputs is only checked if both limits are set
+    if (minInputs && (!inputsNumber || (maxInputs && (inputsNumber < minInputs)))) {
+      status = Status::ERROR_TOO_FEW_INPUTS;
+    }
+    else {
+      status = filterProcess(inputs, inputsNumber, outputValue, timestamp);
+      if ((status == Status::OK) && minInputs && maxInputs && (inputsNumber > maxInputs)) {
+        status = Status::WARNING_TOO_MANY_INPUTS;
+      }
+    }
+  }
+  lastTime = timestamp;
+#if UTIL_DATA_FILTER_TELEMETRY
+  telemetry.samples++;
+  if (overflow(outputValue)) telemetry.overflows++;
+  if (rejected) telemetry.errorsInit++;
+  if (status == Status::ERROR_TOO_FEW_INPUTS) telemetry.errorsTooFewInputs++;
+  if (status == Status::ERROR_SAMPLING_RATE_TOO_LOW) telemetry.errorsSamplingRateTooLow++;
+  if (status == Status::WARNING_TOO_MANY_INPUTS) telemetry.warningsTooManyInputs++;
+  telemetry.lastMicros = micros() - startMicros;
+  if (telemetry.lastMicros > telemetry.peakMicros) telemetry.peakMicros = telemetry.lastMicros;
+#endif
+}
+
+template <typename T, typename Timestamp>
+boolean TemplateFilter<T, Timestamp>::initError(void) const {
+  return ((status == Status::ERROR_INIT_DATA_INCORRECT) ||
+          (status == Status::ERROR_INIT_NOT_ENOUGH_MEMORY) ||
+          (status == Status::ERROR_INIT_FAILED));
+}
+
+template <typename T, typename Timestamp>
+size_t TemplateFilter<T, Timestamp>::getStateSize(void) const {
+  /// @brief Returns buffer size sufficient to save filter state with saveState()
+  /// @return Maximum size of the filter state in bytes or zero if the filter does not
+  /// support saving its state
+  const size_t filterStateSize = getFilterStateSize();
+  if (!filterStateSize) return (0);
+  return (sizeof(StateHeader) + sizeof(T) + filterStateSize);
+}
+
+template <typename T, typename Timestamp>
+size_t TemplateFilter<T, Timestamp>::saveState(void * buffer, size_t bufferSize) const {
+  /// @brief Saves filter state (last output and internal state of derived filter) to a
+  /// binary blob
+  /// @details The blob can be restored with restoreState() into the filter created with
+  /// the same parameters, e.g. after device restart, so that the filter does not start
+  /// from the cold state. The blob is not portable between platforms.
+  /// @param buffer Buffer to save the state to
+  /// @param bufferSize Size of the buffer in bytes, see getStateSize()
+  /// @return Number of bytes saved or zero if the filter does not support saving its
+  /// state, was not initialised or the buffer is too small
+  if (!buffer || initError()) return (0);
+  if (bufferSize < (sizeof(StateHeader) + sizeof(T))) return (0);
+  uint8_t * filterState = reinterpret_cast<uint8_t *>(buffer) + sizeof(StateHeader) + sizeof(T);
+  const size_t filterStateSize = saveFilterState(filterState, bufferSize - sizeof(StateHeader) - sizeof(T));
+  if (!filterStateSize || (filterStateSize > UINT16_MAX)) return (0);
+  StateHeader header;
+  header.formatVersion = stateFormatVersion;
+  header.valueSize = sizeof(T);
+  header.filterStateSize = filterStateSize;
+  memcpy(buffer, &header, sizeof(StateHeader));
+  const typename RawValue<T>::data_t outputRaw = RawValue<T>::getRaw(outputValue);
+  memcpy(reinterpret_cast<uint8_t *>(buffer) + sizeof(StateHeader), &outputRaw, sizeof(outputRaw));
+  return (sizeof(StateHeader) + sizeof(T) + filterStateSize);
+}
+
+template <typename T, typename Timestamp>
+boolean TemplateFilter<T, Timestamp>::restoreState(const void * buffer, size_t size, Timestamp timestamp) {
+  /// @brief Restores filter state saved by saveState()
+  /// @details Timestamps are not saved, since they normally restart from zero after
+  /// device restart; instead the restored state is considered to correspond to the
+  /// specified timestamp, and the time between this timestamp and the next input is
+  /// used by time-dependent filters.
+  /// @param buffer Blob produced by saveState()
+  /// @param size Size of the blob in bytes
+  /// @param timestamp Timestamp for the restored state (normally current time), must
+  /// not be zero
+  /// @return true if the state was restored, false if the blob is incorrect or was saved
+  /// by a different type of filter or by a filter with different parameters; in this
+  /// case the filter state is not modified
+  if (!buffer || initError()) return (false);
+  if (size < (sizeof(StateHeader) + sizeof(T))) return (false);
+  StateHeader header;
+  memcpy(&header, buffer, sizeof(StateHeader));
+  if ((header.formatVersion != stateFormatVersion) || (header.valueSize != sizeof(T))) return (false);
+  if (size != (sizeof(StateHeader) + sizeof(T) + header.filterStateSize)) return (false);
+  const uint8_t * filterState = reinterpret_cast<const uint8_t *>(buffer) + sizeof(StateHeader) + sizeof(T);
+  if (!restoreFilterState(filterState, header.filterStateSize)) return (false);
+  typename RawValue<T>::data_t outputRaw;
+  memcpy(&outputRaw, reinterpret_cast<const uint8_t *>(buffer) + sizeof(StateHeader), sizeof(outputRaw));
+  outputValue = RawValue<T>::fromRaw(outputRaw);
+  lastTime = timestamp;
+  status = Status::OK;
+  return (true);
+}
+
+template <typename T, typename Timestamp>
+size_t TemplateFilter<T, Timestamp>::getFilterStateSize(void) const {
+  /// @brief To be implemented by derived filter if it supports saving its state
+  /// @return Maximum size of internal state of derived filter in bytes, zero if saving
+  /// the state is not supported
+  return (0);
+}
+
+template <typename T, typename Timestamp>
+size_t TemplateFilter<T, Timestamp>::saveFilterState(uint8_t * buffer, size_t bufferSize) const {
+  /// @brief To be implemented by derived filter if it supports saving its state
+  /// @param buffer Buffer to save internal state of derived filter to
+  /// @param bufferSize Size of the buffer in bytes
+  /// @return Number of bytes saved, zero if saving the state is not supported or buffer
+  /// is too small
+  (void)buffer;
+  (void)bufferSize;
+  return (0);
+}
+
+template <typename T, typename Timestamp>
+boolean TemplateFilter<T, Timestamp>::restoreFilterState(const uint8_t * buffer, size_t size) {
+  /// @brief To be implemented by derived filter if it supports saving its state
+  /// @details Must validate the state and leave the filter unmodified if the state is
+  /// incorrect
+  /// @param buffer Internal state of derived filter saved by saveFilterState()
+  /// @param size Size of the state in bytes
+  /// @return true if the state was restored, false otherwise
+  (void)buffer;
+  (void)size;
+  return (false);
+}
+
+template <typename T, typename Timestamp>
+Timestamp TemplateFilter<T, Timestamp>::getDeltaTime(Timestamp currentTime) {
+  if (!lastTime) return (static_cast<Timestamp>(0));
+  return (currentTime - lastTime);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status TemplateFilter<T, Timestamp>::getStatus(void) {
+  return (status);
+}
+
+template <typename T, typename Timestamp>
+const typename TemplateFilter<T, Timestamp>::Telemetry * TemplateFilter<T, Timestamp>::getTelemetry(void) const {
+  /// @brief Returns filter operation counters
+  /// @details Counters are only collected if UTIL_DATA_FILTER_TELEMETRY is enabled in project_config.h;
+  /// otherwise they are compiled away and the filter has no extra size or run-time cost
+  /// @return Pointer to counters or nullptr if telemetry is disabled
+#if UTIL_DATA_FILTER_TELEMETRY
+  return (&telemetry);
+#else
+  return (nullptr);
+#endif
+}
+
+template <typename T, typename Timestamp>
+void TemplateFilter<T, Timestamp>::resetTelemetry(void) {
+  /// @brief Sets all filter operation counters to zero
+#if UTIL_DATA_FILTER_TELEMETRY
+  telemetry = Telemetry();
+#endif
+}
+
+template <typename T, typename Timestamp>
+void TemplateFilter<T, Timestamp>::setInitStatus(Status initStatus) {
+  status = initStatus;
+}
+
+template <typename T, typename Timestamp>
+void TemplateFilter<T, Timestamp>::setInputsNumber(size_t min, size_t max) {
+  if (min > max) return;
+  minInputs = min;
+  maxInputs = max;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// MovingAverage
+//////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Timestamp>
+class MovingAverage : public TemplateFilter<T, Timestamp> {
+  public:
+    MovingAverage(size_t numValues);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~MovingAverage() {}
+  protected:
+    virtual size_t getFilterStateSize(void) const;
+    virtual size_t saveFilterState(uint8_t * buffer, size_t bufferSize) const;
+    virtual boolean restoreFilterState(const uint8_t * buffer, size_t size);
+  private:
+    typedef uint16_t state_count_t;
+    arrays::RingBuffer<T> ringBuffer;
+    size_t windowSize = 0;
+    size_t overflowInputs = 0; ///< Number of overflow values in ringBuffer
+    T lastValue = static_cast<T>(0);
+};
+
+template <typename T, typename Timestamp>
+MovingAverage<T, Timestamp>::MovingAverage(size_t numValues) : ringBuffer(numValues) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  if (!ringBuffer.validate()) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
+  }
+  windowSize = numValues;
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+size_t MovingAverage<T, Timestamp>::getFilterStateSize(void) const {
+  if (windowSize > UINT16_MAX) return (0);
+  return (sizeof(state_count_t) + windowSize * sizeof(T));
+}
+
+template <typename T, typename Timestamp>
+size_t MovingAverage<T, Timestamp>::saveFilterState(uint8_t * buffer, size_t bufferSize) const {
+  /// @brief Saves number of values in the window followed by the values, oldest first
+  const state_count_t count = ringBuffer.count();
+  const size_t size = sizeof(state_count_t) + count * sizeof(T);
+  if (!getFilterStateSize() || (bufferSize < size)) return (0);
+  memcpy(buffer, &count, sizeof(state_count_t));
+  buffer += sizeof(state_count_t);
+  for (const T & item : ringBuffer) {
+    const typename RawValue<T>::data_t raw = RawValue<T>::getRaw(item);
+    memcpy(buffer, &raw, sizeof(raw));
+    buffer += sizeof(T);
+  }
+  return (size);
+}
+
+template <typename T, typename Timestamp>
+boolean MovingAverage<T, Timestamp>::restoreFilterState(const uint8_t * buffer, size_t size) {
+  if (size < sizeof(state_count_t)) return (false);
+  state_count_t count;
+  memcpy(&count, buffer, sizeof(state_count_t));
+  if ((count > windowSize) || (size != (sizeof(state_count_t) + count * sizeof(T)))) return (false);
+  buffer += sizeof(state_count_t);
+  ringBuffer.pop(ringBuffer.count());
+  overflowInputs = 0;
+  for (size_t i = 0; i < count; i++) {
+    typename RawValue<T>::data_t raw;
+    memcpy(&raw, buffer, sizeof(raw));
+    const T value = RawValue<T>::fromRaw(raw);
+    buffer += sizeof(T);
+    ringBuffer.push(value);
+    if (overflow(value)) overflowInputs++;
+  }
+  return (true);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status MovingAverage<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  if (ringBuffer.full() && overflow(ringBuffer[0])) overflowInputs--;
+  ringBuffer.push(inputs[0]);
+  if (overflow(inputs[0])) overflowInputs++;
+  //Fast path: sum without per-item overflow check, overflow is checked once for the whole sum
+  typename Saturating<T>::data_t saturating;
+  T sum = static_cast<T>(0);
+  for (const T & item : ringBuffer)
+    sum = saturating.add(sum, item);
+  if (!overflowInputs && !saturating.overflow() && ringBuffer.count()) {
+    output = sum / static_cast<T>(ringBuffer.count());
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  //Slow path: the sum does not fit into T or overflow values are in the buffer
+  T total = static_cast<T>(0);
+  T subtotal = static_cast<T>(0);
+  for (const T & item : ringBuffer) {
+    T backupSubtotal = subtotal;
+    subtotal += item;
+    if (overflow(subtotal)) {
+      //When overflow occurs we divide part of the sum (subtotal) by amount of items and add it to total (precision is lost but overflow avoided)
+      total += (backupSubtotal / static_cast<T>(ringBuffer.count()));
+      subtotal = item;
+    }
+  }
+  if (ringBuffer.count()) {
+    total += (subtotal / static_cast<T>(ringBuffer.count())); //if there was no overflow, then total is still zero at this point
+  }
+  output = total;
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+};
+
+//////////////////////////////////////////////////////////////////////
+// MovingMedian
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Median of the last numValues inputs
+/// @details Inputs are kept in RingBuffer (in order of arrival) and in SortedBuffer
+/// (in ascending order), so that each input costs O(log N) operations instead of
+/// sorting the whole window.
+/// @par If number of values in the window is even, average of two middle values is
+/// returned.
+template <typename T, typename Timestamp>
+class MovingMedian : public TemplateFilter<T, Timestamp> {
+  public:
+    MovingMedian(size_t numValues);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~MovingMedian() {}
+  protected:
+    void push(const T &input);
+    T median(void) const;
+    T medianAbsoluteDeviation(const T &median) const;
+  private:
+    T kthDeviation(const T &median, size_t lessCount, size_t k) const;
+  private:
+    arrays::RingBuffer<T> ringBuffer;
+    arrays::SortedBuffer<T> sortedBuffer;
+};
+
+template <typename T, typename Timestamp>
+MovingMedian<T, Timestamp>::MovingMedian(size_t numValues) : ringBuffer(numValues), sortedBuffer(numValues) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  if (!ringBuffer.validate() || !sortedBuffer.validate()) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+void MovingMedian<T, Timestamp>::push(const T & input) {
+  /// @brief Adds input to the window, removing the oldest input if the window is full
+  /// @param input Input value
+  if (ringBuffer.full()) sortedBuffer.remove(ringBuffer[0]);
+  ringBuffer.push(input);
+  sortedBuffer.insert(input);
+}
+
+template <typename T, typename Timestamp>
+T MovingMedian<T, Timestamp>::median(void) const {
+  /// @brief Calculates median of the values in the window
+  /// @return Median value or zero if the window is empty
+  const size_t count = sortedBuffer.count();
+  if (!count) return (static_cast<T>(0));
+  if (count & 1) return (sortedBuffer[count / 2]);
+  const T lower = sortedBuffer[count / 2 - 1];
+  const T upper = sortedBuffer[count / 2];
+  return (lower + (upper - lower) / static_cast<T>(2));
+}
+
+template <typename T, typename Timestamp>
+T MovingMedian<T, Timestamp>::kthDeviation(const T & median, size_t lessCount, size_t k) const {
+  /// @brief Finds k-th smallest absolute deviation from median
+  /// @details Deviations of the values below median (taken in descending order) and of
+  /// the values not less than median (taken in ascending order) form two sorted sequences;
+  /// k-th smallest item of their union is found by binary search in O(log N) accesses
+  /// to the sorted buffer
+  /// @param median Median of the values in the window
+  /// @param lessCount Number of values less than median
+  /// @param k Index of deviation (0 = smallest)
+  /// @return k-th smallest absolute deviation
+  struct Deviation {
+    inline static T below(const arrays::SortedBuffer<T> &buffer, const T &median, size_t lessCount, size_t index) {
+      return (median - buffer[lessCount - 1 - index]);
+    }
+    inline static T above(const arrays::SortedBuffer<T> &buffer, const T &median, size_t lessCount, size_t index) {
+      return (buffer[lessCount + index] - median);
+    }
+  };
+  const size_t belowCount = lessCount;
+  const size_t aboveCount = sortedBuffer.count() - lessCount;
+  //Find how many of k + 1 smallest deviations are below median
+  size_t low = (k + 1 > aboveCount) ? (k + 1 - aboveCount) : 0;
+  size_t high = (k + 1 < belowCount) ? (k + 1) : belowCount;
+  while (low < high) {
+    const size_t middle = (low + high) / 2;
+    if (Deviation::below(sortedBuffer, median, lessCount, middle) < Deviation::above(sortedBuffer, median, lessCount, k - middle))
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  const size_t takenBelow = low;
+  const size_t takenAbove = k + 1 - low;
+  if (!takenBelow) return (Deviation::above(sortedBuffer, median, lessCount, takenAbove - 1));
+  if (!takenAbove) return (Deviation::below(sortedBuffer, median, lessCount, takenBelow - 1));
+  const T lastBelow = Deviation::below(sortedBuffer, median, lessCount, takenBelow - 1);
+  const T lastAbove = Deviation::above(sortedBuffer, median, lessCount, takenAbove - 1);
+  return ((lastBelow > lastAbove) ? lastBelow : lastAbove);
+}
+
+template <typename T, typename Timestamp>
+T MovingMedian<T, Timestamp>::medianAbsoluteDeviation(const T & median) const {
+  /// @brief Calculates median absolute deviation (MAD) of the values in the window
+  /// @param median Median of the values in the window
+  /// @return Median of absolute deviations from median or zero if the window is empty
+  const size_t count = sortedBuffer.count();
+  if (!count) return (static_cast<T>(0));
+  const size_t lessCount = sortedBuffer.rank(median);
+  if (count & 1) return (kthDeviation(median, lessCount, count / 2));
+  const T lower = kthDeviation(median, lessCount, count / 2 - 1);
+  const T upper = kthDeviation(median, lessCount, count / 2);
+  return (lower + (upper - lower) / static_cast<T>(2));
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status MovingMedian<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  push(inputs[0]);
+  output = median();
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Hampel
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Hampel outlier rejection filter
+/// @details If the input deviates from median of the last numValues inputs by more
+/// than threshold * 1.4826 * MAD (median absolute deviation, scaled to estimate
+/// standard deviation), the input is considered outlier and replaced with median;
+/// otherwise the input is passed through unchanged.
+/// @par The window includes the current input, thus the filter introduces no delay.
+/// Each input costs O(log N) operations for window update and O(log^2 N) operations
+/// for MAD calculation.
+template <typename T, typename Timestamp>
+class Hampel : public MovingMedian<T, Timestamp> {
+  public:
+    Hampel(size_t numValues, const T &threshold = static_cast<T>(3));
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~Hampel() {}
+  private:
+    T limitFactor = static_cast<T>(0);
+};
+
+template <typename T, typename Timestamp>
+Hampel<T, Timestamp>::Hampel(size_t numValues, const T & threshold) : MovingMedian<T, Timestamp>(numValues) {
+  static const T madToStandardDeviation = T(14826, 4);
+  if (TemplateFilter<T, Timestamp>::getStatus() != TemplateFilter<T, Timestamp>::Status::OK) return;
+  limitFactor = threshold * madToStandardDeviation;
+  if ((threshold < static_cast<T>(0)) || overflow(limitFactor)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status Hampel<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  MovingMedian<T, Timestamp>::push(inputs[0]);
+  const T median = MovingMedian<T, Timestamp>::median();
+  const T deviationLimit = limitFactor * MovingMedian<T, Timestamp>::medianAbsoluteDeviation(median);
+  T deviation = inputs[0] - median;
+  if (deviation < static_cast<T>(0)) deviation = -deviation;
+  output = (deviation > deviationLimit) ? median : inputs[0];
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Mean, variance, standard deviation, minimum and maximum of the last
+/// numValues inputs
+/// @details Filter output is mean of the window; all statistics are returned by
+/// getStatistics().
+/// @par Mean is calculated from the exact sum of the raw values in the window. Sum of
+/// squared deviations from mean is updated with sliding Welford's algorithm in O(1)
+/// operations per input; to avoid accumulation of rounding errors it is recalculated
+/// from the window once per numValues inputs, which adds amortised O(1) operations per
+/// input. Minimum and maximum are found with MonotonicDeque in amortised O(1)
+/// operations per input.
+/// @par Variance is the sample variance (sum of squared deviations is divided by the
+/// number of values minus one); if the result does not fit into T, variance is
+/// overflow value. Standard deviation is calculated directly from the sum of squared
+/// deviations and does not overflow.
+/// @par Overflow inputs are skipped and do not enter the window.
+/// @tparam T FixedPoint type
+template <typename T, typename Timestamp>
+class Statistics : public TemplateFilter<T, Timestamp> {
+  public:
+    struct Result {
+      size_t count;
+      T mean;
+      T variance;
+      T standardDeviation;
+      T min;
+      T max;
+    };
+  public:
+    Statistics(size_t numValues);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~Statistics() {}
+    Result getStatistics(void) const;
+  private:
+    void push(const T &input);
+    void recalculate(void);
+    T mean(void) const;
+  private:
+    static const size_t meanGuardBits = FixedPointMath::fractionBits / 2; ///< squared deviation has FixedPointMath::fractionBits guard bits
+    arrays::RingBuffer<T> ringBuffer;
+    arrays::MonotonicDeque<T> minimums;
+    arrays::MonotonicDeque<T> maximums;
+    int64_t sum = 0;                   ///< Sum of raw values in the window
+    int64_t meanWithGuardBits = 0;     ///< Mean of raw values in the window, with meanGuardBits fraction bits
+    int64_t sumSquaredDeviations = 0;  ///< In units of squared raw value
+    size_t recalculateCountdown = 0;
+};
+
+template <typename T, typename Timestamp>
+Statistics<T, Timestamp>::Statistics(size_t numValues) : ringBuffer(numValues), minimums(numValues, false), maximums(numValues, true) {
+  static const size_t inputNumber = 1;
+  static_assert(sizeof(T) <= sizeof(int32_t), "Raw values must fit in 32 bits");
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  if (!ringBuffer.validate() || !minimums.validate() || !maximums.validate()) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
+  }
+  recalculateCountdown = numValues;
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+void Statistics<T, Timestamp>::push(const T & input) {
+  /// @brief Adds input to the window, removing the oldest input if the window is full
+  /// @details Sliding Welford's update: when value xOld is replaced with xNew and mean
+  /// changes from meanOld to meanNew, sum of squared deviations changes by
+  /// (xNew - xOld) * (xNew - meanNew + xOld - meanOld); when value is added without
+  /// replacement, xOld and meanOld are replaced with meanNew.
+  /// @param input Input value, must not be overflow
+  const int64_t inputWithGuardBits = static_cast<int64_t>(input.getRaw()) << meanGuardBits;
+  const int64_t meanOld = meanWithGuardBits;
+  const boolean replace = ringBuffer.full();
+  int64_t oldestWithGuardBits = 0;
+  if (replace) {
+    oldestWithGuardBits = static_cast<int64_t>(ringBuffer[0].getRaw()) << meanGuardBits;
+    sum -= ringBuffer[0].getRaw();
+  }
+  ringBuffer.push(input);
+  minimums.push(input);
+  maximums.push(input);
+  sum += input.getRaw();
+  meanWithGuardBits = (sum << meanGuardBits) / static_cast<int64_t>(ringBuffer.count());
+  if (!replace) {
+    sumSquaredDeviations += FixedPointMath::mulIntermediary(inputWithGuardBits - meanOld, inputWithGuardBits - meanWithGuardBits);
+    return;
+  }
+  sumSquaredDeviations += FixedPointMath::mulIntermediary(inputWithGuardBits - oldestWithGuardBits,
+                          (inputWithGuardBits - meanWithGuardBits) + (oldestWithGuardBits - meanOld));
+  if (sumSquaredDeviations < 0) sumSquaredDeviations = 0;
+  if (!--recalculateCountdown) recalculate();
+}
+
+template <typename T, typename Timestamp>
+void Statistics<T, Timestamp>::recalculate(void) {
+  /// @brief Calculates sum of squared deviations from the window contents
+  sumSquaredDeviations = 0;
+  for (size_t i = 0; i < ringBuffer.count(); i++) {
+    const int64_t deviation = (static_cast<int64_t>(ringBuffer[i].getRaw()) << meanGuardBits) - meanWithGuardBits;
+    sumSquaredDeviations += FixedPointMath::mulIntermediary(deviation, deviation);
+  }
+  recalculateCountdown = ringBuffer.count();
+}
+
+template <typename T, typename Timestamp>
+T Statistics<T, Timestamp>::mean(void) const {
+  /// @brief Rounds mean of the window to T
+  static const int64_t rounding = static_cast<int64_t>(1) << (meanGuardBits - 1);
+  return (T::fromIntermediary((meanWithGuardBits + rounding) >> meanGuardBits));
+}
+
+template <typename T, typename Timestamp>
+typename Statistics<T, Timestamp>::Result Statistics<T, Timestamp>::getStatistics(void) const {
+  /// @brief Returns statistics of the values in the window
+  /// @return Number of values in the window, mean, sample variance, standard deviation,
+  /// minimum and maximum; all statistics are zero if the window is empty, variance and
+  /// standard deviation are zero if the window contains a single value
+  Result result;
+  result.count = ringBuffer.count();
+  result.mean = mean();
+  result.variance = static_cast<T>(0);
+  result.standardDeviation = static_cast<T>(0);
+  result.min = minimums.front();
+  result.max = maximums.front();
+  if (result.count < 2) return (result);
+  static const int64_t rounding = static_cast<int64_t>(1) << (T::fractionBits - 1);
+  const int64_t squaredRaw = sumSquaredDeviations / static_cast<int64_t>(result.count - 1);
+  result.variance = T::fromIntermediary((squaredRaw + rounding) >> T::fractionBits);
+  result.standardDeviation = T::fromIntermediary(FixedPointMath::sqrt(static_cast<uint64_t>(squaredRaw)));
+  return (result);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status Statistics<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  if (!overflow(inputs[0])) push(inputs[0]);
+  output = ringBuffer.empty() ? inputs[0] : mean();
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// LowPass
+//////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Timestamp>
+class LowPass : public TemplateFilter<T, Timestamp> {
+  public:
+    LowPass(const T &fc, const T &pi, const T & fcDivider = static_cast<T>(1));
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~LowPass() {}
+  protected:
+    virtual size_t getFilterStateSize(void) const;
+    virtual size_t saveFilterState(uint8_t * buffer, size_t bufferSize) const;
+    virtual boolean restoreFilterState(const uint8_t * buffer, size_t size);
+  private:
+    T fc = static_cast<T>(0);
+    T fcDivider = static_cast<T>(1);
+    T fcPi2 = static_cast<T>(0);
+    T lastOutput = static_cast<T>(0);
+};
+
+template <typename T, typename Timestamp>
+LowPass<T, Timestamp>::LowPass(const T & fc, const T & pi, const T & fcDivider) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  if ((fc <= static_cast<T>(0)) || (fcDivider <= static_cast<T>(0)) || overflow (fc / fcDivider)) {
+    this->fc = static_cast<T>(0);
+    this->fcDivider = static_cast<T>(1);
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  this->fc = fc;
+  this->fcDivider = fcDivider;
+  fcPi2 = fc * pi * static_cast<T>(2);
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+size_t LowPass<T, Timestamp>::getFilterStateSize(void) const {
+  return (sizeof(T));
+}
+
+template <typename T, typename Timestamp>
+size_t LowPass<T, Timestamp>::saveFilterState(uint8_t * buffer, size_t bufferSize) const {
+  if (bufferSize < sizeof(T)) return (0);
+  const typename RawValue<T>::data_t raw = RawValue<T>::getRaw(lastOutput);
+  memcpy(buffer, &raw, sizeof(raw));
+  return (sizeof(T));
+}
+
+template <typename T, typename Timestamp>
+boolean LowPass<T, Timestamp>::restoreFilterState(const uint8_t * buffer, size_t size) {
+  if (size != sizeof(T)) return (false);
+  typename RawValue<T>::data_t raw;
+  memcpy(&raw, buffer, sizeof(raw));
+  lastOutput = RawValue<T>::fromRaw(raw);
+  return (true);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status LowPass<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+
+  Timestamp deltaTime (this->getDeltaTime(timestamp));
+  if (!inputsNumber) {
+    return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  }
+  if (!deltaTime) {
+    output = static_cast<T>(inputs[0]);
+  }
+  else {
+    T dt = static_cast<T>(deltaTime);
+    const T dtFcPi2 = dt * fcPi2;
+    const T denominator = dtFcPi2 / fcDivider + static_cast<T>(1);
+    const T difference = inputs[0] - lastOutput;
+    T delta = dtFcPi2 * difference / denominator / fcDivider;
+    //Large step: multiply the difference by smoothing factor instead, so that intermediary
+    //value stays within range at the cost of precision
+    if (overflow(delta)) delta = difference * (dtFcPi2 / fcDivider / denominator);
+    output = lastOutput + delta;
+  }
+  //Overflow output (e.g. overflow input) is returned but never becomes filter state
+  if (!overflow(output)) lastOutput = output;
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// LowPassTable
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Low-pass filter with precalculated smoothing factors
+/// @details Implements the same first order low-pass filter as LowPass:
+/// output = lastOutput + alpha * (input - lastOutput), where
+/// alpha = dt * 2 * pi * fc / (dt * 2 * pi * fc + fcDivider) and dt is the time between
+/// inputs. Values of alpha are calculated at initialisation for dt from 0 to
+/// maxTableDeltaTime in steps of 2^deltaTimeQuantumBits, thus each input costs a table
+/// lookup and a multiply-add instead of divisions.
+/// @par If the time between inputs exceeds maxTableDeltaTime (e.g. the loop runs late),
+/// alpha is calculated for the actual time between inputs, so irregular sampling is
+/// handled correctly at the cost of one division.
+/// @par Smoothing factors are stored with FixedPointMath::fractionBits fraction bits and
+/// the filter state has stateGuardBits more fraction bits than T, so that the output
+/// converges to a constant input even if alpha is very small.
+/// @par Output for the first input equals the input; inputs with the same timestamp do
+/// not change the output. Overflow inputs are passed to output and do not affect filter
+/// state.
+/// @par Saved state keeps the guard bits; state of the filter which did not receive
+/// any inputs yet is not saved.
+/// @tparam T FixedPoint type
+template <typename T, typename Timestamp>
+class LowPassTable : public TemplateFilter<T, Timestamp> {
+  public:
+    LowPassTable(const T &fc, const T &pi, const T &fcDivider, Timestamp maxTableDeltaTime, size_t deltaTimeQuantumBits = 0);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~LowPassTable();
+  protected:
+    virtual size_t getFilterStateSize(void) const;
+    virtual size_t saveFilterState(uint8_t * buffer, size_t bufferSize) const;
+    virtual boolean restoreFilterState(const uint8_t * buffer, size_t size);
+  private:
+    int32_t calculateAlpha(Timestamp deltaTime) const;
+  private:
+    int32_t * alphaTable = nullptr;   ///< Smoothing factors with FixedPointMath::fractionBits fraction bits
+    Timestamp maxTableDeltaTime = static_cast<Timestamp>(0);
+    size_t deltaTimeQuantumBits = 0;
+    int64_t fcPi2 = 0;                ///< 2 * pi * fc as raw value of T
+    int64_t fcDivider = 1;            ///< fcDivider as raw value of T
+    boolean initialised = false;
+    int64_t lastOutput = 0;           ///< Filter state with stateGuardBits extra fraction bits
+    static const size_t stateGuardBits = 16;
+    static const size_t maxDeltaTimeQuantumBits = 16;
+    static const size_t maxAlphaTableSize = 1024;
+};
+
+template <typename T, typename Timestamp>
+LowPassTable<T, Timestamp>::LowPassTable(const T & fc, const T & pi, const T & fcDivider, Timestamp maxTableDeltaTime, size_t deltaTimeQuantumBits) {
+  /// @brief Initialises the filter and calculates the table of smoothing factors
+  /// @param fc Cutoff frequency
+  /// @param pi Value of pi for type T
+  /// @param fcDivider Divider of fc, e.g. 1000 if timestamp is in milliseconds and fc is in Hz
+  /// @param maxTableDeltaTime Maximum time between inputs covered by the table
+  /// @param deltaTimeQuantumBits Time between inputs is rounded to 2^deltaTimeQuantumBits for table lookup
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  const T fcPi2 = fc * pi * static_cast<T>(2);
+  if ((fc <= static_cast<T>(0)) || (fcDivider <= static_cast<T>(0)) || overflow(fc / fcDivider) || overflow(fcPi2) ||
+      (deltaTimeQuantumBits > maxDeltaTimeQuantumBits)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  const size_t alphaTableSize = static_cast<size_t>(maxTableDeltaTime >> deltaTimeQuantumBits) + 2;
+  if (alphaTableSize > maxAlphaTableSize) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  alphaTable = reinterpret_cast<int32_t *>(malloc(alphaTableSize * sizeof(int32_t)));
+  if (!alphaTable) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
+  }
+  this->fcPi2 = static_cast<int64_t>(fcPi2.getRaw());
+  this->fcDivider = static_cast<int64_t>(fcDivider.getRaw());
+  this->maxTableDeltaTime = maxTableDeltaTime;
+  this->deltaTimeQuantumBits = deltaTimeQuantumBits;
+  for (size_t i = 0; i < alphaTableSize; i++)
+    alphaTable[i] = calculateAlpha(static_cast<Timestamp>(i) << deltaTimeQuantumBits);
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+LowPassTable<T, Timestamp>::~LowPassTable() {
+  if (alphaTable) free(alphaTable);
+}
+
+template <typename T, typename Timestamp>
+size_t LowPassTable<T, Timestamp>::getFilterStateSize(void) const {
+  return (sizeof(lastOutput));
+}
+
+template <typename T, typename Timestamp>
+size_t LowPassTable<T, Timestamp>::saveFilterState(uint8_t * buffer, size_t bufferSize) const {
+  if (!initialised || (bufferSize < sizeof(lastOutput))) return (0);
+  memcpy(buffer, &lastOutput, sizeof(lastOutput));
+  return (sizeof(lastOutput));
+}
+
+template <typename T, typename Timestamp>
+boolean LowPassTable<T, Timestamp>::restoreFilterState(const uint8_t * buffer, size_t size) {
+  if (size != sizeof(lastOutput)) return (false);
+  memcpy(&lastOutput, buffer, sizeof(lastOutput));
+  initialised = true;
+  return (true);
+}
+
+template <typename T, typename Timestamp>
+int32_t LowPassTable<T, Timestamp>::calculateAlpha(Timestamp deltaTime) const {
+  /// @brief Calculates smoothing factor for the time between inputs
+  /// @param deltaTime Time between inputs
+  /// @return Smoothing factor with FixedPointMath::fractionBits fraction bits
+  static const int64_t one = static_cast<int64_t>(1) << FixedPointMath::fractionBits;
+  static const int64_t maxProduct = static_cast<int64_t>(1) << 62;
+  if (static_cast<int64_t>(deltaTime) > (maxProduct / fcPi2)) return (static_cast<int32_t>(one));
+  const int64_t product = static_cast<int64_t>(deltaTime) * fcPi2;
+  return (static_cast<int32_t>(one - (fcDivider << FixedPointMath::fractionBits) / (product + fcDivider)));
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status LowPassTable<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  static const int64_t rounding = static_cast<int64_t>(1) << (stateGuardBits - 1);
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  if (overflow(inputs[0])) {
+    output = inputs[0];
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  const Timestamp deltaTime = this->getDeltaTime(timestamp);
+  const int64_t input = static_cast<int64_t>(inputs[0].getRaw()) << stateGuardBits;
+  if (!initialised) {
+    lastOutput = input;
+    initialised = true;
+  }
+  else {
+    const Timestamp quantumRounding = (static_cast<Timestamp>(1) << deltaTimeQuantumBits) >> 1;
+    const int32_t alpha = (deltaTime <= maxTableDeltaTime) ?
+                          alphaTable[(deltaTime + quantumRounding) >> deltaTimeQuantumBits] :
+                          calculateAlpha(deltaTime);
+    lastOutput += FixedPointMath::mulFraction(input - lastOutput, alpha);
+  }
+  output = T::fromIntermediary((lastOutput + rounding) >> stateGuardBits);
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// LinearScale
+//////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Timestamp>
+class LinearScale : public TemplateFilter<T, Timestamp> {
+  public:
+    LinearScale(const T &x1, const T &y1, const T &x2, const T &y2);
+    LinearScale(const T &a, const T &b);
+    LinearScale(const T &b);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+  private:
+    T a = static_cast<T>(1);
+    T b = static_cast<T>(0);
+};
+
+template <typename T, typename Timestamp>
+LinearScale<T, Timestamp>::LinearScale(const T & x1, const T & y1, const T & x2, const T & y2) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  if (x1 == x2) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  a = (y1 - y2) / (x1 - x2);
+  b = y1 - a * x1;
+  if (overflow(a) || overflow(b) || (a == static_cast<T>(0))) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+LinearScale<T, Timestamp>::LinearScale(const T & a, const T & b) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  this->a = a;
+  this->b = b;
+  if (overflow(a) || overflow(b)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+LinearScale<T, Timestamp>::LinearScale(const T & b) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  this->a = static_cast<T>(1);
+  this->b = b;
+  if (overflow(b)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status LinearScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  output = a * inputs[0] + b;
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// SquareScale
+//////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Timestamp>
+class SquareScale : public TemplateFilter<T, Timestamp> {
+  public:
+    SquareScale(const T &x1, const T &y1,
+                const T &x2, const T &y2,
+                const T &x3, const T &y3);
+    SquareScale(const T &a, const T &b, const T&c);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+  private:
+    T a = static_cast<T>(0);
+    T b = static_cast<T>(1);
+    T c = static_cast<T>(0);
+    T h = static_cast<T>(0);
+};
+
+template <typename T, typename Timestamp>
+SquareScale<T, Timestamp>::SquareScale(
+  const T & x1, const T & y1,
+  const T & x2, const T & y2,
+  const T & x3, const T & y3) {
+  //Set input number
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  //Calculate square function a, b, c coefficients
+  const T denominator1 = (x1 - x2);
+  const T denominator2 = (x1 - x3);
+  const T denominator3 = (x2 - x3);
+  if ((denominator1 == static_cast<T>(0)) ||
+      (denominator2 == static_cast<T>(0)) ||
+      (denominator3 == static_cast<T>(0))) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  a = x3 * (y2 - y1) + x2 * (y1 - y3) + x1 * (y3 - y2);
+  a /= denominator1;
+  a /= denominator2;
+  a /= denominator3;
+  b = (y1 - y2) * x3 * x3 + (y3 - y1) * x2 * x2 + (y2 - y3) * x1 * x1;
+  b /= denominator1;
+  b /= denominator2;
+  b /= denominator3;
+  c = y1 * (x2 - x3) * x2 * x3 + y2 * (x3 - x1) * x3 * x1 + y3 * (x1 - x2) * x1 * x2;
+  c /= denominator1;
+  c /= denominator2;
+  c /= denominator3;
+  if (overflow(a) || overflow(b) || overflow(c)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
+    return;
+  }
+  //Check parabola vertex position
+  if (a == static_cast<T>(0)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+    return;
+  }
+  h = b / a / static_cast<T>(-2);
+  //k = c - h * h;
+  if (overflow(h)) return;
+  T xmin = x1;
+  if (x2 < xmin) xmin = x2;
+  if (x3 < xmin) xmin = x3;
+  T xmax = x3;
+  if (x2 > xmax) xmax = x2;
+  if (x1 > xmax) xmax = x1;
+  if ((h > xmin) && (h < xmax)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::WARNING_INIT_DATA_INCORRECT);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+SquareScale<T, Timestamp>::SquareScale(const T & a, const T & b, const T & c) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  this->a = a;
+  this->b = b;
+  this->c = c;
+  if (overflow(a) || overflow(b) || overflow (c)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status SquareScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  typename Saturating<T>::data_t saturating;
+  const T x = saturating.check(inputs[0]);
+  const T y = saturating.add(saturating.add(saturating.mul(saturating.mul(a, x), x), saturating.mul(b, x)), c);
+  output = saturating.result(y);
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// SplineScale
+//////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Timestamp>
+class SplineScale : public TemplateFilter<T, Timestamp> {
+  public:
+    SplineScale(const T &x1, const T &y1,
+                const T &x2, const T &y2,
+                const T &x3, const T &y3);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+  private:
+    T a1 = static_cast<T>(0);
+    T b1 = static_cast<T>(1);
+    T a2 = static_cast<T>(0);
+    T b2 = static_cast<T>(1);
+    T x1 = static_cast<T>(0);
+    T y1 = static_cast<T>(0);
+    T x2 = static_cast<T>(0);
+    T y2 = static_cast<T>(0);
+    T x3 = static_cast<T>(0);
+    T y3 = static_cast<T>(0);
+};
+
+template <typename T, typename Timestamp>
+SplineScale<T, Timestamp>::SplineScale(
+  const T & xMin, const T & yMin,
+  const T & xMid, const T & yMid,
+  const T & xMax, const T & yMax) {
+  //Set input number
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  //Initialise points
+  x1 = xMin;
+  y1 = yMin;
+  x2 = xMid;
+  y2 = yMid;
+  x3 = xMax;
+  y3 = yMax;
+  //Sort points by x in accending order
+  struct TSwapHelper {
+    inline static void swap(T &a, T &b) {
+      T temp = a;
+      a = b;
+      b = temp;
+    }
+  };
+  if (x1 > x2) {
+    TSwapHelper::swap(x1, x2);
+    TSwapHelper::swap(y1, y2);
+  }
+  if (x2 > x3) {
+    TSwapHelper::swap(x2, x3);
+    TSwapHelper::swap(y2, y3);
+  }
+  if (x1 > x2) {
+    TSwapHelper::swap(x1, x2);
+    TSwapHelper::swap(y1, y2);
+  }
+
+  //Calculate cubic spline coefficients
+  const T denominator1 = 2 * (x1 - x2);
+  const T denominator2 = x1 - x3;
+  const T denominator3 = x2 - x3;
+  if ((denominator1 == static_cast<T>(0)) ||
+      (denominator2 == static_cast<T>(0)) ||
+      (denominator3 == static_cast<T>(0))) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  a1 = x1 * (y2 - y3) + x2 * (y3 - y1) + x3 * (y1 - y2);
+  a1 /= denominator1;
+  a1 /= denominator2;
+  a1 /= denominator3;
+  a1 /= (x1 - x2);
+  a2 = a1 * (x2 - x1);
+  a2 /= (x2 - x3);
+  b1 = x1 * x1 * (y3 - y2) - x1 * (x2 * (-3 * y1 + y2 + 2 * y3) + 3 * x3 * (y1 - y2)) + x2 * x2 * (y3 - y1) + x2 * x3 * (y2 - y1) + 2 * x3 * x3 * (y1 - y2);
+  b1 /= denominator1;
+  b1 /= denominator2;
+  b1 /= denominator3;
+  b2 = 2 * x1 * x1 * (y2 - y3) + x2 * (x1 * (y3 - y2) + x3 * (2 * y1 + y2 - 3 * y3)) + 3 * x1 * x3 * (y3 - y2) + x2 * x2 * (y3 - y1) + x3 * x3 * (y2 - y1);
+  b2 /= denominator1;
+  b2 /= denominator2;
+  b2 /= denominator3;
+  //Check validity
+  if (overflow(a1) || overflow(a2) || overflow(b1) || overflow(b2)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status SplineScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  output = (inputs[0] < x2) ?
+           (a1 * (inputs[0] - x1) * (inputs[0] - x1) * (inputs[0] - x1) + b1 * (inputs[0] - x1) + y1) :
+           (a2 * (inputs[0] - x3) * (inputs[0] - x3) * (inputs[0] - x3) + b2 * (inputs[0] - x3) + y3);
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+//////////////////////////////////////////////////////////////////////
+// KnotScale
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Common part of scales defined by N knots (points)
+/// @details Knots are given as arrays of x and y values, x values must be in strictly
+/// ascending order. The arrays are not copied and must remain valid during the lifetime
+/// of the filter; they may be located in PROGMEM.
+/// @par Segment of the input value is found by binary search; the last found segment is
+/// checked first, since consecutive inputs usually fall within the same segment.
+/// @tparam T FixedPoint type
+template <typename T, typename Timestamp>
+class KnotScale : public TemplateFilter<T, Timestamp> {
+  public:
+    virtual ~KnotScale() {}
+  protected:
+    KnotScale(const T *x, const T *y, size_t knotsNumber, boolean progmemKnots);
+    inline size_t getKnotsNumber(void) const;
+    inline T getX(size_t index) const;
+    inline T getY(size_t index) const;
+    size_t findSegment(const T &x);
+  private:
+    inline T readKnot(const T *knots, size_t index) const;
+  private:
+    const T * x = nullptr;
+    const T * y = nullptr;
+    size_t knotsNumber = 0;
+    boolean progmemKnots = false;
+    size_t lastSegment = 0;
+};
+
+template <typename T, typename Timestamp>
+KnotScale<T, Timestamp>::KnotScale(const T * x, const T * y, size_t knotsNumber, boolean progmemKnots) {
+  /// @brief Initialises the knots and checks their validity
+  /// @param x Array of knots' x values in ascending order
+  /// @param y Array of knots' y values
+  /// @param knotsNumber Number of knots, must be at least 2
+  /// @param progmemKnots If true the arrays are assumed to be located in PROGMEM, if false in RAM
+  static const size_t inputNumber = 1;
+  static const size_t minKnotsNumber = 2;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  this->x = x;
+  this->y = y;
+  this->progmemKnots = progmemKnots;
+  if (!x || !y || (knotsNumber < minKnotsNumber)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
     return;
   }
-  //set fraction part pointer to the last digit of the str
-  const char * decimalPointStrChar = currStrChar;
-  while (*(currStrChar + 1)) {
-    currStrChar++;
-  }
-  //process fraction part
-  T fractionPart = tZero;
-  while (currStrChar != decimalPointStrChar) {
-    if (((*currStrChar) < '0') || ((*currStrChar) > '9')) {
-      value.setT(tZero);
+  for (size_t i = 0; i < knotsNumber; i++) {
+    if (overflow(getX(i)) || overflow(getY(i)) || (i && (getX(i) <= getX(i - 1)))) {
+      TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
       return;
     }
-    T currentDigit = static_cast<T>((*currStrChar) - '0');
-    fractionPart = (fractionPart + (currentDigit << FractionBits)) / decimalRadixT;
-    currStrChar--;
   }
-  if (negative) fractionPart = ~fractionPart + tOne;
-  value.setT(integerPart + fractionPart);
+  this->knotsNumber = knotsNumber;
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
 }
 
-
-template <typename T, size_t FractionBits, typename U, T TMinRange, T TMaxRange>
-T FixedPoint<T, FractionBits, U, TMinRange, TMaxRange>::getValue(size_t decimalPrecision, boolean *status) const {
-  /// @brief Converts a Fixed Point value to the base type with a specified decimal precision
-  /// @details For example, result of conversion of value of 10.573 can be 10
-  /// (for decimalPrecision 0), 106 (for decimalPrecision 1), 1057 (for decimalPrecision 2),
-  /// 10573 (for decimalPrecision 3), 105730 (for decimalPrecision 4), etc.
-  /// @param decimalPrecision How many least significant decimal digits of the returned value
-  /// are fractions (= for how many digits to left-shift decimal point)
-  /// @param status Pointer to boolean variable which will be set to true if conversion was
-  /// successful and to false otherwise. If not needed, this parameter can be skipped or
-  /// set equal to nullptr
-  /// @return Conversion result or TMinRange/TMaxRange if result is out of range of type T
-  /// (TMinRange...TMaxRange)
-  if (status) {
-    (*status) = false;
-  }
-  U tempValue = static_cast<U>(this->value.get());
-  static const U decimalRadix = static_cast<U>(10);
-  for (size_t i = 0; i < decimalPrecision; i++) {
-    tempValue *= decimalRadix;
-    if (TMinRange && TMaxRange) {
-      if (tempValue < static_cast<U>(TMinRange)) {
-        return (TMinRange);
-      }
-      if (tempValue > static_cast<U>(TMaxRange)) {
-        return (TMaxRange);
-      }
-    }//if (TMinRange && TMaxRange)
-  }//for
-  if (status) {
-    (*status) = true;
-  }
-  tempValue /= static_cast<U>(fractionBitsPwr2);
-  return (static_cast<T>(tempValue));
+template <typename T, typename Timestamp>
+size_t KnotScale<T, Timestamp>::getKnotsNumber(void) const {
+  /// @return Number of knots or zero if the knots are not valid
+  return (knotsNumber);
 }
 
-}; //namespace dsp
-
-//////////////////////////////////////////////////////////////////////
-// Value
-//////////////////////////////////////////////////////////////////////
-
-typedef int32_t ValueBase;
-static const ValueBase ValueBaseMin = INT32_MIN;
-static const ValueBase ValueBaseMax = INT32_MAX;
-static const size_t ValueFractionBits = 10;
-typedef int64_t IntermediaryValue;
-
-using Value = dsp::FixedPoint<ValueBase, ValueFractionBits, IntermediaryValue, ValueBaseMin, ValueBaseMax>;
+template <typename T, typename Timestamp>
+T KnotScale<T, Timestamp>::getX(size_t index) const {
+  return (readKnot(x, index));
+}
 
-static const Value ValuePi = Value(314159265, 8);
+template <typename T, typename Timestamp>
+T KnotScale<T, Timestamp>::getY(size_t index) const {
+  return (readKnot(y, index));
+}
 
-/// @brief Checks whether the valve is overflown (out of range)
-/// @details This function is for compatibility only
-/// @par Reserved for the case when Value is a Plain-Old-Data type (e.g. float) and does not have methods
-/// @param value Value to check
-/// @return True if value is overflown, false if value is a regular number
-inline boolean overflow(const Value & value) {
-  return (value.overflow());
+template <typename T, typename Timestamp>
+T KnotScale<T, Timestamp>::readKnot(const T * knots, size_t index) const {
+  if (!progmemKnots) return (knots[index]);
+  decltype(knots->getRaw()) raw;
+  memcpy_P(&raw, &knots[index], sizeof(raw));
+  return (T::fromRaw(raw));
 }
 
-/// @brief Returns an integer value with known decimal precision
-/// @par For example for value 10.7 and precision 1 (1 digit after decimal point) will return 107
-/// @par This function is for compatibility only
-/// @par Reserved for the case when Value is a Plain-Old-Data type (e.g. float) and does not have methods
-/// @param value Value
-/// @return Converted value or zero if conversion failed
-inline ValueBase getValue(const Value & value, size_t decimals, boolean *status = nullptr) {
-  return (value.getValue(decimals, status));
+template <typename T, typename Timestamp>
+size_t KnotScale<T, Timestamp>::findSegment(const T & x) {
+  /// @brief Finds segment which contains x
+  /// @param x Value to find
+  /// @return Index of segment i, so that x[i] <= x < x[i + 1]; for the values outside of
+  /// knots range the first or the last segment is returned
+  if ((lastSegment + 1) < knotsNumber && (getX(lastSegment) <= x) && (x < getX(lastSegment + 1)))
+    return (lastSegment);
+  size_t first = 0;
+  size_t last = knotsNumber - 2;
+  while (first < last) {
+    const size_t middle = (first + last + 1) / 2;
+    if (getX(middle) <= x) first = middle; else last = middle - 1;
+  }
+  lastSegment = first;
+  return (first);
 }
 
 //////////////////////////////////////////////////////////////////////
-// Timestamp
+// PiecewiseLinearScale
 //////////////////////////////////////////////////////////////////////
 
-typedef uint32_t Timestamp;
+/// @brief Scale which linearly interpolates between N knots
+/// @details Values outside of knots range are extrapolated using the first or the last
+/// segment. Slopes of the segments are calculated at initialisation, thus each input costs
+/// a segment lookup and one multiplication.
+/// @tparam T FixedPoint type
+template <typename T, typename Timestamp>
+class PiecewiseLinearScale : public KnotScale<T, Timestamp> {
+  public:
+    PiecewiseLinearScale(const T *x, const T *y, size_t knotsNumber, boolean progmemKnots = false);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~PiecewiseLinearScale();
+  private:
+    int64_t * slopes = nullptr;   ///< Segment slopes with FixedPointMath::fractionBits fraction bits
+};
 
-inline Timestamp getTimestamp(void) {
-  return (millis());
+template <typename T, typename Timestamp>
+PiecewiseLinearScale<T, Timestamp>::PiecewiseLinearScale(const T * x, const T * y, size_t knotsNumber, boolean progmemKnots) :
+  KnotScale<T, Timestamp>(x, y, knotsNumber, progmemKnots)
+{
+  if (TemplateFilter<T, Timestamp>::getStatus() != TemplateFilter<T, Timestamp>::Status::OK) return;
+  const size_t segmentsNumber = knotsNumber - 1;
+  slopes = reinterpret_cast<int64_t *>(malloc(segmentsNumber * sizeof(int64_t)));
+  if (!slopes) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
+  }
+  for (size_t i = 0; i < segmentsNumber; i++) {
+    const int64_t dx = FixedPointMath::fromFixedPoint(this->getX(i + 1)) - FixedPointMath::fromFixedPoint(this->getX(i));
+    const int64_t dy = FixedPointMath::fromFixedPoint(this->getY(i + 1)) - FixedPointMath::fromFixedPoint(this->getY(i));
+    slopes[i] = FixedPointMath::divIntermediary(dy, dx);
+  }
 }
 
-const Value timestampPerSecond(1000); // 1000 milliseconds per second
+template <typename T, typename Timestamp>
+PiecewiseLinearScale<T, Timestamp>::~PiecewiseLinearScale() {
+  if (slopes) free(slopes);
+}
 
-namespace dsp {
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status PiecewiseLinearScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  if (overflow(inputs[0])) {
+    output = inputs[0];
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  const size_t segment = this->findSegment(inputs[0]);
+  const int64_t dx = FixedPointMath::fromFixedPoint(inputs[0]) - FixedPointMath::fromFixedPoint(this->getX(segment));
+  output = FixedPointMath::toFixedPoint<T>(FixedPointMath::fromFixedPoint(this->getY(segment)) +
+                                           FixedPointMath::mulIntermediary(dx, slopes[segment]));
+  return (TemplateFilter<T, Timestamp>::Status::OK);
+}
 
 //////////////////////////////////////////////////////////////////////
-// Filter
+// NaturalSplineScale
 //////////////////////////////////////////////////////////////////////
 
+/// @brief Scale which interpolates N knots with natural cubic spline
+/// @details Second derivatives M of the spline in the knots are found at initialisation
+/// by solving tridiagonal system (M is zero in the first and the last knot). Within
+/// segment i the spline is calculated as
+/// y[i] + u * (y[i + 1] - y[i]) + (u^3 - u) * m1[i] + (w^3 - w) * m0[i], where
+/// u = (x - x[i]) / h[i], w = 1 - u, h[i] = x[i + 1] - x[i], m0[i] = M[i] * h[i]^2 / 6 and
+/// m1[i] = M[i + 1] * h[i]^2 / 6.
+/// @par Values outside of knots range are extrapolated linearly with the slope of the
+/// spline in the first or the last knot.
+/// @tparam T FixedPoint type
 template <typename T, typename Timestamp>
-class TemplateFilter {
-  public:
-    enum class Status {
-      NONE,                               ///< No status returned
-      OK,                                 ///< Filter functions normally
-      ERROR_INIT_DATA_INCORRECT,          ///< Error: incorrect data provided for filter initialisation
-      ERROR_INIT_NOT_ENOUGH_MEMORY,       ///< Error: incorrect data provided for filter initialisation
-      ERROR_INIT_FAILED,                  ///< Error: filter initialisation failed
-      WARNING_INIT_DATA_INCORRECT,        ///< Warning: incorrect data provided for filter initialisation; filter may produce unexpected results
-      WARNING_TOO_MANY_INPUTS,            ///< Warning: too many inputs provided for the filter; some inputs were ignored
-      ERROR_TOO_FEW_INPUTS,               ///< Error: too few inputs provided for the filter
-    };
+class NaturalSplineScale : public KnotScale<T, Timestamp> {
   public:
-    virtual ~TemplateFilter() {};
-    inline const T& filter(Timestamp timestamp = 0);
-    template <typename... Inputs> const T& filter(Timestamp timestamp, const Inputs... inputs);
-    Status getStatus(void);
-  protected:
-    virtual Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp) = 0;
-  protected:
-    Timestamp getDeltaTime(Timestamp currentTime);
-  protected:
-    void setInitStatus(Status initStatus);
-    void setInputsNumber(size_t min, size_t max);
-  private:
-    Status status = Status::NONE;
+    NaturalSplineScale(const T *x, const T *y, size_t knotsNumber, boolean progmemKnots = false);
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~NaturalSplineScale();
   private:
-    T outputValue = static_cast<T>(0);
-    Timestamp lastTime = static_cast<Timestamp>(0);
+    boolean calculateCoefficients(void);
   private:
-    size_t minInputs = 0;
-    size_t maxInputs = 0;
+    struct Segment {
+      int64_t inverseH;   ///< 1 / h[i]
+      int64_t m0;         ///< M[i] * h[i]^2 / 6
+      int64_t m1;         ///< M[i + 1] * h[i]^2 / 6
+    };
+    Segment * segments = nullptr;
+    int64_t firstSlope = 0;
+    int64_t lastSlope = 0;
 };
 
 template <typename T, typename Timestamp>
-const T& TemplateFilter<T, Timestamp>::filter(Timestamp timestamp) {
-  outputValue = static_cast<T>(0);
-  if ((status == Status::ERROR_INIT_DATA_INCORRECT) ||
-      (status == Status::ERROR_INIT_NOT_ENOUGH_MEMORY) ||
-      (status == Status::ERROR_INIT_FAILED)) {
-    lastTime = timestamp;
-    return (outputValue);
-  }
-  if (minInputs) {
-    status = Status::ERROR_TOO_FEW_INPUTS;
-    lastTime = timestamp;
-    return (outputValue);
-  }
-  status = filterProcess(nullptr, 0, outputValue, timestamp);
-  lastTime = timestamp;
-  return (outputValue);
-}
-
-template <typename T, typename Timestamp>
-template <typename... Inputs> const T& TemplateFilter<T, Timestamp>::filter(Timestamp timestamp, const Inputs... inputs) {
-  T inputsArray[] = { T(inputs)... };
-  outputValue = static_cast<T>(0);
-  if ((status == Status::ERROR_INIT_DATA_INCORRECT) ||
-      (status == Status::ERROR_INIT_NOT_ENOUGH_MEMORY) ||
-      (status == Status::ERROR_INIT_FAILED)) {
-    lastTime = timestamp;
-    return (outputValue);
-  }
-  if (minInputs && maxInputs && (sizeof...(inputs) < minInputs)) {
-    status = Status::ERROR_TOO_FEW_INPUTS;
-    lastTime = timestamp;
-    return (outputValue);
-  }
-  status = filterProcess(inputsArray, sizeof...(inputs), outputValue, timestamp);
-  if ((status == Status::OK) && minInputs && maxInputs && (sizeof...(inputs) > maxInputs)) {
-    status = Status::WARNING_TOO_MANY_INPUTS;
+NaturalSplineScale<T, Timestamp>::NaturalSplineScale(const T * x, const T * y, size_t knotsNumber, boolean progmemKnots) :
+  KnotScale<T, Timestamp>(x, y, knotsNumber, progmemKnots)
+{
+  if (TemplateFilter<T, Timestamp>::getStatus() != TemplateFilter<T, Timestamp>::Status::OK) return;
+  segments = reinterpret_cast<Segment *>(malloc((knotsNumber - 1) * sizeof(Segment)));
+  if (!segments || !calculateCoefficients()) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
   }
-  lastTime = timestamp;
-  return (outputValue);
-}
-
-template <typename T, typename Timestamp>
-Timestamp TemplateFilter<T, Timestamp>::getDeltaTime(Timestamp currentTime) {
-  if (!lastTime) return (static_cast<Timestamp>(0));
-  return (currentTime - lastTime);
 }
 
 template <typename T, typename Timestamp>
-typename TemplateFilter<T, Timestamp>::Status TemplateFilter<T, Timestamp>::getStatus(void) {
-  return (status);
+NaturalSplineScale<T, Timestamp>::~NaturalSplineScale() {
+  if (segments) free(segments);
 }
 
 template <typename T, typename Timestamp>
-void TemplateFilter<T, Timestamp>::setInitStatus(Status initStatus) {
-  status = initStatus;
+boolean NaturalSplineScale<T, Timestamp>::calculateCoefficients(void) {
+  /// @brief Solves tridiagonal system for second derivatives and fills segments data
+  /// @details Equations for the knots 1..N-2 are
+  /// h[i-1] * M[i-1] + 2 * (h[i-1] + h[i]) * M[i] + h[i] * M[i+1] = 6 * (slope[i] - slope[i-1]);
+  /// the system is solved with Thomas algorithm.
+  /// @return true if successful, false if there is not enough memory for temporary data
+  const size_t knotsNumber = this->getKnotsNumber();
+  const size_t segmentsNumber = knotsNumber - 1;
+  int64_t * secondDerivatives = reinterpret_cast<int64_t *>(malloc(knotsNumber * sizeof(int64_t)));
+  int64_t * upperDiagonal = reinterpret_cast<int64_t *>(malloc(knotsNumber * sizeof(int64_t)));
+  if (!secondDerivatives || !upperDiagonal) {
+    if (secondDerivatives) free(secondDerivatives);
+    if (upperDiagonal) free(upperDiagonal);
+    return (false);
+  }
+  //Forward sweep; segments temporarily store h[i] and slope[i]
+  for (size_t i = 0; i < segmentsNumber; i++) {
+    const int64_t h = FixedPointMath::fromFixedPoint(this->getX(i + 1)) - FixedPointMath::fromFixedPoint(this->getX(i));
+    const int64_t dy = FixedPointMath::fromFixedPoint(this->getY(i + 1)) - FixedPointMath::fromFixedPoint(this->getY(i));
+    segments[i].m0 = h;
+    segments[i].m1 = FixedPointMath::divIntermediary(dy, h);
+  }
+  secondDerivatives[0] = 0;
+  upperDiagonal[0] = 0;
+  for (size_t i = 1; i < segmentsNumber; i++) {
+    const int64_t lower = segments[i - 1].m0;
+    const int64_t upper = segments[i].m0;
+    const int64_t right = 6 * (segments[i].m1 - segments[i - 1].m1);
+    const int64_t pivot = 2 * (lower + upper) - FixedPointMath::mulIntermediary(lower, upperDiagonal[i - 1]);
+    upperDiagonal[i] = FixedPointMath::divIntermediary(upper, pivot);
+    secondDerivatives[i] = FixedPointMath::divIntermediary(right - FixedPointMath::mulIntermediary(lower, secondDerivatives[i - 1]), pivot);
+  }
+  //Back substitution
+  secondDerivatives[segmentsNumber] = 0;
+  for (size_t i = segmentsNumber - 1; i > 0; i--)
+    secondDerivatives[i] -= FixedPointMath::mulIntermediary(upperDiagonal[i], secondDerivatives[i + 1]);
+  //Segments data
+  for (size_t i = 0; i < segmentsNumber; i++) {
+    const int64_t h = segments[i].m0;
+    const int64_t slope = segments[i].m1;
+    const int64_t h2div6 = FixedPointMath::mulIntermediary(h, h) / 6;
+    segments[i].inverseH = FixedPointMath::divIntermediary(static_cast<int64_t>(1) << FixedPointMath::fractionBits, h);
+    segments[i].m0 = FixedPointMath::mulIntermediary(secondDerivatives[i], h2div6);
+    segments[i].m1 = FixedPointMath::mulIntermediary(secondDerivatives[i + 1], h2div6);
+    //Slopes in the first and the last knot: slope[i] - h[i] * (2 * M[i] + M[i+1]) / 6 and slope[i] + h[i] * (M[i] + 2 * M[i+1]) / 6
+    if (!i) firstSlope = slope - FixedPointMath::mulIntermediary(2 * segments[i].m0 + segments[i].m1, segments[i].inverseH);
+    if (i == (segmentsNumber - 1)) lastSlope = slope + FixedPointMath::mulIntermediary(segments[i].m0 + 2 * segments[i].m1, segments[i].inverseH);
+  }
+  free(secondDerivatives);
+  free(upperDiagonal);
+  return (true);
 }
 
 template <typename T, typename Timestamp>
-void TemplateFilter<T, Timestamp>::setInputsNumber(size_t min, size_t max) {
-  if (min > max) return;
-  minInputs = min;
-  maxInputs = max;
+typename TemplateFilter<T, Timestamp>::Status NaturalSplineScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  static const int64_t one = static_cast<int64_t>(1) << FixedPointMath::fractionBits;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  if (overflow(inputs[0])) {
+    output = inputs[0];
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  const int64_t x = FixedPointMath::fromFixedPoint(inputs[0]);
+  const size_t lastKnot = this->getKnotsNumber() - 1;
+  if (inputs[0] < this->getX(0)) {
+    const int64_t dx = x - FixedPointMath::fromFixedPoint(this->getX(0));
+    output = FixedPointMath::toFixedPoint<T>(FixedPointMath::fromFixedPoint(this->getY(0)) + FixedPointMath::mulIntermediary(dx, firstSlope));
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  if (inputs[0] > this->getX(lastKnot)) {
+    const int64_t dx = x - FixedPointMath::fromFixedPoint(this->getX(lastKnot));
+    output = FixedPointMath::toFixedPoint<T>(FixedPointMath::fromFixedPoint(this->getY(lastKnot)) + FixedPointMath::mulIntermediary(dx, lastSlope));
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  const size_t i = this->findSegment(inputs[0]);
+  const Segment & segment = segments[i];
+  const int64_t y0 = FixedPointMath::fromFixedPoint(this->getY(i));
+  const int64_t y1 = FixedPointMath::fromFixedPoint(this->getY(i + 1));
+  const int64_t u = FixedPointMath::mulIntermediary(x - FixedPointMath::fromFixedPoint(this->getX(i)), segment.inverseH);
+  const int64_t w = one - u;
+  const int64_t cubicU = FixedPointMath::mulIntermediary(FixedPointMath::mulIntermediary(u, u), u) - u;
+  const int64_t cubicW = FixedPointMath::mulIntermediary(FixedPointMath::mulIntermediary(w, w), w) - w;
+  output = FixedPointMath::toFixedPoint<T>(y0 + FixedPointMath::mulIntermediary(u, y1 - y0) +
+                                           FixedPointMath::mulIntermediary(cubicU, segment.m1) +
+                                           FixedPointMath::mulIntermediary(cubicW, segment.m0));
+  return (TemplateFilter<T, Timestamp>::Status::OK);
 }
 
-
 //////////////////////////////////////////////////////////////////////
-// MovingAverage
+// ExpScale
 //////////////////////////////////////////////////////////////////////
 
+/// @brief Exponential scale y = e^(a * x + b)
+/// @details Intended for sensors with log-linear characteristic, e.g. MG811 CO2 sensor
+/// (logarithm of gas concentration is linear to the sensor output).
+/// @par When initialised with two calibration points, ln(y) is interpolated as
+/// ln(y1) + (x - x1) * (ln(y2) - ln(y1)) / (x2 - x1) rather than calculated from
+/// coefficient a, since typically a is too small to be represented by T with
+/// sufficient precision.
 template <typename T, typename Timestamp>
-class MovingAverage : public TemplateFilter<T, Timestamp> {
+class ExpScale : public TemplateFilter<T, Timestamp> {
   public:
-    MovingAverage(size_t numValues);
+    ExpScale(const T &x1, const T &y1, const T &x2, const T &y2);
+    ExpScale(const T &a, const T &b);
     virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
-    virtual ~MovingAverage() {}
   private:
-    arrays::RingBuffer<T> ringBuffer;
-    T lastValue = static_cast<T>(0);
+    T x1 = static_cast<T>(0);
+    T logY1 = static_cast<T>(0);
+    T deltaLogY = static_cast<T>(1);
+    T deltaX = static_cast<T>(1);
 };
 
 template <typename T, typename Timestamp>
-MovingAverage<T, Timestamp>::MovingAverage(size_t numValues) : ringBuffer(numValues) {
+ExpScale<T, Timestamp>::ExpScale(const T & x1, const T & y1, const T & x2, const T & y2) {
   static const size_t inputNumber = 1;
   TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  if (!ringBuffer.validate()) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+  if ((x1 == x2) || (y1 <= static_cast<T>(0)) || (y2 <= static_cast<T>(0))) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  this->x1 = x1;
+  logY1 = log(y1);
+  deltaLogY = log(y2) - logY1;
+  deltaX = x2 - x1;
+  if (overflow(logY1) || overflow(deltaLogY) || overflow(deltaX) || (deltaLogY == static_cast<T>(0))) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
     return;
   }
   TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 template <typename T, typename Timestamp>
-typename TemplateFilter<T, Timestamp>::Status MovingAverage<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+ExpScale<T, Timestamp>::ExpScale(const T & a, const T & b) {
+  static const size_t inputNumber = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
+  logY1 = b;
+  deltaLogY = a;
+  if (overflow(a) || overflow(b)) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status ExpScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
   (void)timestamp;
   if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
-  ringBuffer.push(inputs[0]);
-  T total = static_cast<T>(0);
-  T subtotal = static_cast<T>(0);
-  for (int i = 0; i < ringBuffer.count(); i++) {
-    T backupSubtotal = subtotal;
-    subtotal += ringBuffer[i];
-    if (overflow(subtotal)) {
-      //When overflow occurs we divide part of the sum (subtotal) by amount of items and add it to total (precision is lost but overflow avoided)
-      total += (backupSubtotal / static_cast<T>(ringBuffer.count()));
-      subtotal = ringBuffer[i];
-    }
-  }
-  if (ringBuffer.count()) {
-    total += (subtotal / static_cast<T>(ringBuffer.count())); //if there was no overflow, then total is still zero at this point
-  }
-  output = total;
+  output = exp(logY1 + (inputs[0] - x1) * deltaLogY / deltaX);
   return (TemplateFilter<T, Timestamp>::Status::OK);
-};
+}
 
 //////////////////////////////////////////////////////////////////////
-// LowPass
+// TableScale
 //////////////////////////////////////////////////////////////////////
 
+/// @brief Scale defined by a table of output values for equally spaced inputs
+/// @details The table covers input domain from xMin to xMax; each input costs a table
+/// read and a linear interpolation between two adjacent entries. Inputs outside of the
+/// domain are clamped to the domain.
+/// @par The table is either calculated at initialisation by sampling another scale filter
+/// (e.g. ExpScale for MG811 CO2 sensor sampled over 10-bit ADC range), or supplied as an
+/// array located in RAM or PROGMEM. The supplied array is not copied and must remain valid
+/// during the lifetime of the filter.
+/// @tparam T FixedPoint type
 template <typename T, typename Timestamp>
-class LowPass : public TemplateFilter<T, Timestamp> {
+class TableScale : public TemplateFilter<T, Timestamp> {
   public:
-    LowPass(const T &fc, const T &pi, const T & fcDivider = static_cast<T>(1));
+    TableScale(TemplateFilter<T, Timestamp> &source, const T &xMin, const T &xMax, size_t tableSize);
+    TableScale(const T *table, size_t tableSize, const T &xMin, const T &xMax, boolean progmemTable = false);
     virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
-    virtual ~LowPass() {}
+    virtual ~TableScale();
   private:
-    T fc = static_cast<T>(0);
-    T fcDivider = static_cast<T>(1);
-    T fcPi2 = static_cast<T>(0);
-    T lastOutput = static_cast<T>(0);
+    boolean initDomain(size_t tableSize, const T &xMin, const T &xMax);
+    inline T readTable(size_t index) const;
+  private:
+    T * ownTable = nullptr;
+    const T * table = nullptr;
+    size_t tableSize = 0;
+    boolean progmemTable = false;
+    int64_t xMin = 0;
+    int64_t xMax = 0;
+    int64_t inverseStep = 0;   ///< Number of table entries per input unit
 };
 
 template <typename T, typename Timestamp>
-LowPass<T, Timestamp>::LowPass(const T & fc, const T & pi, const T & fcDivider) {
+TableScale<T, Timestamp>::TableScale(TemplateFilter<T, Timestamp> & source, const T & xMin, const T & xMax, size_t tableSize) {
+  /// @brief Initialises the filter with the table calculated by sampling another filter
+  /// @param source Filter to sample; it must not depend on time or previous inputs, since
+  /// the sampling inputs are supplied with zero timestamp
+  /// @param xMin Minimum input value of the domain
+  /// @param xMax Maximum input value of the domain
+  /// @param tableSize Number of table entries, must be at least 2
+  if (!initDomain(tableSize, xMin, xMax)) return;
+  ownTable = reinterpret_cast<T *>(malloc(tableSize * sizeof(T)));
+  if (!ownTable) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
+    return;
+  }
+  const int64_t range = this->xMax - this->xMin;
+  for (size_t i = 0; i < tableSize; i++) {
+    const T x = FixedPointMath::toFixedPoint<T>(this->xMin + range * static_cast<int64_t>(i) / static_cast<int64_t>(tableSize - 1));
+    new (&ownTable[i]) T(source.filter(static_cast<Timestamp>(0), x));
+    if (source.getStatus() != TemplateFilter<T, Timestamp>::Status::OK) {
+      TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
+      return;
+    }
+  }
+  table = ownTable;
+  this->tableSize = tableSize;
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+TableScale<T, Timestamp>::TableScale(const T * table, size_t tableSize, const T & xMin, const T & xMax, boolean progmemTable) {
+  /// @brief Initialises the filter with the supplied table
+  /// @param table Output values for inputs xMin, xMin + step, ..., xMax, where step is (xMax - xMin) / (tableSize - 1)
+  /// @param tableSize Number of table entries, must be at least 2
+  /// @param xMin Minimum input value of the domain
+  /// @param xMax Maximum input value of the domain
+  /// @param progmemTable If true the table is assumed to be located in PROGMEM, if false in RAM
+  if (!initDomain(tableSize, xMin, xMax)) return;
+  if (!table) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+    return;
+  }
+  this->table = table;
+  this->progmemTable = progmemTable;
+  this->tableSize = tableSize;
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+TableScale<T, Timestamp>::~TableScale() {
+  if (ownTable) free(ownTable);
+}
+
+template <typename T, typename Timestamp>
+boolean TableScale<T, Timestamp>::initDomain(size_t tableSize, const T & xMin, const T & xMax) {
+  /// @brief Sets the input domain
+  /// @return true if the domain and the table size are valid, false otherwise
   static const size_t inputNumber = 1;
+  static const size_t minTableSize = 2;
+  static_assert(sizeof(T) <= sizeof(uint32_t), "TableScale requires FixedPoint base type of 32 bits or less");
   TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  if ((fc <= static_cast<T>(0)) || (fcDivider <= static_cast<T>(0)) || overflow (fc / fcDivider)) {
-    this->fc = static_cast<T>(0);
-    this->fcDivider = static_cast<T>(1);
+  if ((tableSize < minTableSize) || overflow(xMin) || overflow(xMax) || (xMax <= xMin)) {
     TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
-    return;
+    return (false);
   }
-  this->fc = fc;
-  this->fcDivider = fcDivider;
-  fcPi2 = fc * pi * static_cast<T>(2);
-  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+  this->xMin = FixedPointMath::fromFixedPoint(xMin);
+  this->xMax = FixedPointMath::fromFixedPoint(xMax);
+  inverseStep = FixedPointMath::divIntermediary(static_cast<int64_t>(tableSize - 1) << FixedPointMath::fractionBits, this->xMax - this->xMin);
+  return (true);
 }
 
 template <typename T, typename Timestamp>
-typename TemplateFilter<T, Timestamp>::Status LowPass<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+T TableScale<T, Timestamp>::readTable(size_t index) const {
+  if (!progmemTable) return (table[index]);
+  decltype(table->getRaw()) raw;
+  memcpy_P(&raw, &table[index], sizeof(raw));
+  return (T::fromRaw(raw));
+}
 
-  Timestamp deltaTime (this->getDeltaTime(timestamp));
-  if (!inputsNumber) {
-    return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
-  }
-  if (!deltaTime) {
-    output = static_cast<T>(inputs[0]);
-    lastOutput = static_cast<T>(inputs[0]);
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status TableScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  (void)timestamp;
+  static const int64_t fractionMask = (static_cast<int64_t>(1) << FixedPointMath::fractionBits) - 1;
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  if (overflow(inputs[0])) {
+    output = inputs[0];
+    return (TemplateFilter<T, Timestamp>::Status::OK);
   }
-  else {
-    T dt = static_cast<T>(deltaTime);
-    output = lastOutput + (dt * fcPi2 * (inputs[0] - lastOutput)) / (dt * fcPi2 / fcDivider + static_cast<T>(1)) / fcDivider;
-    lastOutput = output;
+  const int64_t x = FixedPointMath::fromFixedPoint(inputs[0]);
+  const int64_t position = (x > xMin) ? FixedPointMath::mulIntermediary(x - xMin, inverseStep) : 0;
+  const size_t index = static_cast<size_t>(position >> FixedPointMath::fractionBits);
+  if ((x >= xMax) || (index >= (tableSize - 1))) {
+    output = readTable(tableSize - 1);
+    return (TemplateFilter<T, Timestamp>::Status::OK);
   }
+  const int64_t y0 = static_cast<int64_t>(readTable(index).getRaw());
+  const int64_t y1 = static_cast<int64_t>(readTable(index + 1).getRaw());
+  static const int64_t rounding = static_cast<int64_t>(1) << (FixedPointMath::fractionBits - 1);
+  const int64_t fraction = position & fractionMask;
+  output = T::fromIntermediary(y0 + (((y1 - y0) * fraction + rounding) >> FixedPointMath::fractionBits));
   return (TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 //////////////////////////////////////////////////////////////////////
-// LinearScale
+// Biquad
 //////////////////////////////////////////////////////////////////////
 
+/// @brief Second order IIR filter (biquad) or a cascade of biquads
+/// @details Implemented in Direct Form II Transposed. Coefficients are calculated as
+/// per RBJ Audio EQ Cookbook for the sampling period equal to the time between inputs.
+/// The coefficients are recalculated only when the time between inputs changes, thus
+/// with a constant sampling period each input costs five multiply-adds per section.
+/// @par Higher orders are achieved by cascading sections with the same frequency and
+/// individual Q factors, e.g. 4th order Butterworth filter consists of two sections with
+/// Q factors 0.5412 and 1.3066 (single section with Q factor 0.7071 is 2nd order
+/// Butterworth filter).
+/// @par Coefficients are stored with FixedPointMath::fractionBits fraction bits and the
+/// filter state has stateGuardBits more fraction bits than T, so that the precision is
+/// not lost when the frequency is much lower than the sampling rate.
+/// @par The filter is initialised to steady state with the first input value. If the
+/// time between inputs is not less than half of the period of frequency fc, status
+/// ERROR_SAMPLING_RATE_TOO_LOW is returned and the filter is initialised again with the
+/// next input.
+/// @par Overflow inputs are passed to output and do not affect filter state.
+/// @tparam T FixedPoint type
 template <typename T, typename Timestamp>
-class LinearScale : public TemplateFilter<T, Timestamp> {
+class Biquad : public TemplateFilter<T, Timestamp> {
   public:
-    LinearScale(const T &x1, const T &y1, const T &x2, const T &y2);
-    LinearScale(const T &a, const T &b);
-    LinearScale(const T &b);
+    enum class Type {
+      LOW_PASS,   ///< Low-pass filter, fc is cutoff frequency (-3dB if Q factor is 0.7071)
+      HIGH_PASS,  ///< High-pass filter, fc is cutoff frequency (-3dB if Q factor is 0.7071)
+      BAND_PASS,  ///< Band-pass filter with 0dB peak gain at fc, bandwidth is fc / Q factor
+      NOTCH       ///< Band-stop filter rejecting frequency fc, bandwidth is fc / Q factor
+    };
+  public:
+    Biquad(Type type, const T &fc, const T &q, const T &fcDivider = static_cast<T>(1));
+    Biquad(Type type, const T &fc, const T *q, size_t stages, const T &fcDivider = static_cast<T>(1));
     virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~Biquad();
   private:
-    T a = static_cast<T>(1);
-    T b = static_cast<T>(0);
+    void init(Type type, const T &fc, const T *q, size_t stages, const T &fcDivider);
+    boolean calculateCoefficients(Timestamp deltaTime);
+    void initState(int64_t input);
+    int64_t process(int64_t input);
+    inline int64_t dcGain(int64_t input) const;
+  private:
+    struct Section {
+      T q = static_cast<T>(1);                  ///< Q factor of the section
+      int32_t b0 = 0, b1 = 0, b2 = 0;           ///< Feed-forward coefficients with FixedPointMath::fractionBits fraction bits
+      int32_t a1 = 0, a2 = 0;                   ///< Feedback coefficients with FixedPointMath::fractionBits fraction bits
+      int64_t s1 = 0, s2 = 0;                   ///< Filter state with stateGuardBits extra fraction bits
+    };
+    Section * sections = nullptr;
+    size_t sectionsCount = 0;
+    Type type = Type::LOW_PASS;
+    T fc = static_cast<T>(0);
+    T fcDivider = static_cast<T>(1);
+    Timestamp coefficientsDeltaTime = static_cast<Timestamp>(0);
+    boolean initialised = false;      ///< First input was received
+    boolean stateInitialised = false; ///< State was set to steady state for the first input
+    int64_t initialInput = 0;
+    int64_t lastOutput = 0;
+    static const size_t stateGuardBits = 16;
 };
 
 template <typename T, typename Timestamp>
-LinearScale<T, Timestamp>::LinearScale(const T & x1, const T & y1, const T & x2, const T & y2) {
+Biquad<T, Timestamp>::Biquad(Type type, const T & fc, const T & q, const T & fcDivider) {
+  init(type, fc, &q, 1, fcDivider);
+}
+
+template <typename T, typename Timestamp>
+Biquad<T, Timestamp>::Biquad(Type type, const T & fc, const T * q, size_t stages, const T & fcDivider) {
+  init(type, fc, q, stages, fcDivider);
+}
+
+template <typename T, typename Timestamp>
+Biquad<T, Timestamp>::~Biquad() {
+  if (sections) free(sections);
+}
+
+template <typename T, typename Timestamp>
+void Biquad<T, Timestamp>::init(Type type, const T & fc, const T * q, size_t stages, const T & fcDivider) {
+  /// @brief Initialises the filter
+  /// @param type Filter type
+  /// @param fc Frequency, cycles per Timestamp unit multiplied by fcDivider
+  /// @param q Array of Q factors, one per section
+  /// @param stages Number of sections
+  /// @param fcDivider Divider for fc, e.g. if fc is in Hz and Timestamp is in milliseconds,
+  /// fcDivider must be 1000
   static const size_t inputNumber = 1;
   TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  if (x1 == x2) {
+  if (!q || !stages || (fc <= static_cast<T>(0)) || (fcDivider <= static_cast<T>(0)) || overflow(fc) || overflow(fcDivider)) {
     TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
     return;
   }
-  a = (y1 - y2) / (x1 - x2);
-  b = y1 - a * x1;
-  if (overflow(a) || overflow(b) || (a == static_cast<T>(0))) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
+  for (size_t i = 0; i < stages; i++) {
+    if ((q[i] <= static_cast<T>(0)) || overflow(q[i])) {
+      TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+      return;
+    }
+  }
+  sections = reinterpret_cast<Section *>(malloc(stages * sizeof(Section)));
+  if (!sections) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
     return;
   }
+  for (size_t i = 0; i < stages; i++) {
+    new (&sections[i]) Section;
+    sections[i].q = q[i];
+  }
+  sectionsCount = stages;
+  this->type = type;
+  this->fc = fc;
+  this->fcDivider = fcDivider;
   TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 template <typename T, typename Timestamp>
-LinearScale<T, Timestamp>::LinearScale(const T & a, const T & b) {
-  static const size_t inputNumber = 1;
-  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  this->a = a;
-  this->b = b;
-  if (overflow(a) || overflow(b)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
-    return;
+boolean Biquad<T, Timestamp>::calculateCoefficients(Timestamp deltaTime) {
+  /// @brief Calculates coefficients of all sections for the sampling period
+  /// @param deltaTime Sampling period
+  /// @return true if coefficients were calculated, false if sampling period is too
+  /// long for the filter frequency
+  static const int64_t one = static_cast<int64_t>(1) << FixedPointMath::fractionBits;
+  static const int64_t twoPi = 6746518852; //2 * pi with 30 fraction bits
+  const uint64_t frequency = static_cast<uint64_t>(fc.getRaw()) * static_cast<uint64_t>(deltaTime);
+  const uint64_t divider = static_cast<uint64_t>(fcDivider.getRaw());
+  if (frequency >= (divider >> 1)) return (false);
+  //w0 = 2 * pi * fc * deltaTime / fcDivider
+  const int64_t normalisedFrequency = static_cast<int64_t>((frequency << FixedPointMath::fractionBits) / divider);
+  const int64_t w0 = (normalisedFrequency * twoPi) >> FixedPointMath::fractionBits;
+  int64_t sine, cosine;
+  FixedPointMath::sinCos(w0, sine, cosine);
+  const int64_t qOne = static_cast<int64_t>(static_cast<T>(1).getRaw());
+  for (size_t i = 0; i < sectionsCount; i++) {
+    Section & section = sections[i];
+    const int64_t alpha = sine * qOne / (2 * static_cast<int64_t>(section.q.getRaw()));
+    int64_t b0, b1, b2;
+    switch (type) {
+      case Type::LOW_PASS:
+        b1 = one - cosine;
+        b0 = b1 / 2;
+        b2 = b0;
+        break;
+      case Type::HIGH_PASS:
+        b1 = -(one + cosine);
+        b0 = -b1 / 2;
+        b2 = b0;
+        break;
+      case Type::BAND_PASS:
+        b0 = alpha;
+        b1 = 0;
+        b2 = -alpha;
+        break;
+      default:
+        b0 = one;
+        b1 = -2 * cosine;
+        b2 = one;
+        break;
+    }
+    //normalise by a0 = 1 + alpha
+    const int64_t a0 = one + alpha;
+    section.b0 = static_cast<int32_t>((b0 << FixedPointMath::fractionBits) / a0);
+    section.b1 = static_cast<int32_t>((b1 << FixedPointMath::fractionBits) / a0);
+    section.b2 = static_cast<int32_t>((b2 << FixedPointMath::fractionBits) / a0);
+    section.a1 = static_cast<int32_t>(((-2 * cosine) << FixedPointMath::fractionBits) / a0);
+    section.a2 = static_cast<int32_t>(((one - alpha) << FixedPointMath::fractionBits) / a0);
   }
-  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+  coefficientsDeltaTime = deltaTime;
+  return (true);
 }
 
 template <typename T, typename Timestamp>
-LinearScale<T, Timestamp>::LinearScale(const T & b) {
-  static const size_t inputNumber = 1;
-  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  this->a = static_cast<T>(1);
-  this->b = b;
-  if (overflow(b)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
-    return;
+int64_t Biquad<T, Timestamp>::dcGain(int64_t input) const {
+  /// @brief Calculates steady-state output for constant input
+  /// @param input Input with stateGuardBits extra fraction bits
+  /// @return Output with stateGuardBits extra fraction bits
+  return (((type == Type::LOW_PASS) || (type == Type::NOTCH)) ? input : 0);
+}
+
+template <typename T, typename Timestamp>
+void Biquad<T, Timestamp>::initState(int64_t input) {
+  /// @brief Sets state of all sections to steady state for constant input
+  /// @param input Input with stateGuardBits extra fraction bits
+  for (size_t i = 0; i < sectionsCount; i++) {
+    Section & section = sections[i];
+    const int64_t output = dcGain(input);
+    section.s2 = FixedPointMath::mulFraction(input, section.b2) - FixedPointMath::mulFraction(output, section.a2);
+    section.s1 = FixedPointMath::mulFraction(input, section.b1) - FixedPointMath::mulFraction(output, section.a1) + section.s2;
+    input = output;
   }
-  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 template <typename T, typename Timestamp>
-typename TemplateFilter<T, Timestamp>::Status LinearScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
-  (void)timestamp;
+int64_t Biquad<T, Timestamp>::process(int64_t input) {
+  /// @brief Passes the input through all sections
+  /// @param input Input with stateGuardBits extra fraction bits
+  /// @return Output with stateGuardBits extra fraction bits
+  for (size_t i = 0; i < sectionsCount; i++) {
+    Section & section = sections[i];
+    const int64_t output = FixedPointMath::mulFraction(input, section.b0) + section.s1;
+    section.s1 = FixedPointMath::mulFraction(input, section.b1) - FixedPointMath::mulFraction(output, section.a1) + section.s2;
+    section.s2 = FixedPointMath::mulFraction(input, section.b2) - FixedPointMath::mulFraction(output, section.a2);
+    input = output;
+  }
+  return (input);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status Biquad<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  static const int64_t rounding = static_cast<int64_t>(1) << (stateGuardBits - 1);
   if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
-  output = a * inputs[0] + b;
+  if (overflow(inputs[0])) {
+    output = inputs[0];
+    return (TemplateFilter<T, Timestamp>::Status::OK);
+  }
+  const Timestamp deltaTime = this->getDeltaTime(timestamp);
+  const int64_t input = static_cast<int64_t>(inputs[0].getRaw()) << stateGuardBits;
+  if (!initialised) {
+    //First input: the state is set when sampling period is known
+    initialInput = input;
+    lastOutput = dcGain(input);
+    initialised = true;
+    stateInitialised = false;
+  }
+  else if (deltaTime) {
+    if ((deltaTime != coefficientsDeltaTime) && !calculateCoefficients(deltaTime)) {
+      initialised = false;
+      coefficientsDeltaTime = static_cast<Timestamp>(0);
+      output = static_cast<T>(0);
+      return (TemplateFilter<T, Timestamp>::Status::ERROR_SAMPLING_RATE_TOO_LOW);
+    }
+    if (!stateInitialised) {
+      initState(initialInput);
+      stateInitialised = true;
+    }
+    lastOutput = process(input);
+  }
+  output = T::fromIntermediary((lastOutput + rounding) >> stateGuardBits);
   return (TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 //////////////////////////////////////////////////////////////////////
-// SquareScale
+// Decimator
 //////////////////////////////////////////////////////////////////////
 
+/// @brief Decimation (downsampling) filter
+/// @details Produces one output per factor inputs; for other inputs status
+/// OUTPUT_NOT_READY is returned and the output remains the same.
+/// @par Implemented as CIC (cascaded integrator-comb) filter: stages integrators run at
+/// input rate and stages combs run at output rate, followed by division by the filter
+/// gain factor^stages. Single stage filter outputs average of the last factor inputs;
+/// more stages give better anti-aliasing (frequency response is sinc^stages with zeros at
+/// multiples of output rate). No multiplications are required per input.
+/// @par Integrators and combs use modular 64-bit arithmetic, thus their overflow does not
+/// affect output; factor and stages are limited so that the gain does not exceed 2^31.
+/// @par The filter is initialised to steady state with the first input, and output is
+/// ready with the first input. Overflow input makes outputs overflow until it is out of
+/// the filter's response window.
 template <typename T, typename Timestamp>
-class SquareScale : public TemplateFilter<T, Timestamp> {
+class Decimator : public TemplateFilter<T, Timestamp> {
   public:
-    SquareScale(const T &x1, const T &y1,
-                const T &x2, const T &y2,
-                const T &x3, const T &y3);
-    SquareScale(const T &a, const T &b, const T&c);
+    Decimator(size_t factor, size_t stages = 1);
     virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~Decimator();
   private:
-    T a = static_cast<T>(0);
-    T b = static_cast<T>(1);
-    T c = static_cast<T>(0);
-    T h = static_cast<T>(0);
+    inline void integrate(uint64_t input);
+    inline int64_t comb(void);
+  private:
+    uint64_t * integrators = nullptr;
+    uint64_t * combDelays = nullptr;
+    size_t factor = 1;
+    size_t stages = 0;
+    size_t phase = 0;
+    int64_t gain = 1;
+    size_t overflowCountdown = 0;
+    T overflowOutput = static_cast<T>(0);
+    T lastOutput = static_cast<T>(0);
+    boolean initialised = false;
+    static const size_t maxGainBits = 31;
 };
 
 template <typename T, typename Timestamp>
-SquareScale<T, Timestamp>::SquareScale(
-  const T & x1, const T & y1,
-  const T & x2, const T & y2,
-  const T & x3, const T & y3) {
-  //Set input number
+Decimator<T, Timestamp>::Decimator(size_t factor, size_t stages) {
+  /// @brief Initialises the filter
+  /// @param factor Decimation factor, number of inputs per output
+  /// @param stages Number of CIC filter stages
   static const size_t inputNumber = 1;
   TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  //Calculate square function a, b, c coefficients
-  const T denominator1 = (x1 - x2);
-  const T denominator2 = (x1 - x3);
-  const T denominator3 = (x2 - x3);
-  if ((denominator1 == static_cast<T>(0)) ||
-      (denominator2 == static_cast<T>(0)) ||
-      (denominator3 == static_cast<T>(0))) {
+  size_t gainBits = 0;
+  while ((gainBits <= maxGainBits) && ((static_cast<size_t>(1) << gainBits) < factor)) gainBits++;
+  if (!factor || !stages || ((gainBits * stages) > maxGainBits)) {
     TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
     return;
   }
-  a = x3 * (y2 - y1) + x2 * (y1 - y3) + x1 * (y3 - y2);
-  a /= denominator1;
-  a /= denominator2;
-  a /= denominator3;
-  b = (y1 - y2) * x3 * x3 + (y3 - y1) * x2 * x2 + (y2 - y3) * x1 * x1;
-  b /= denominator1;
-  b /= denominator2;
-  b /= denominator3;
-  c = y1 * (x2 - x3) * x2 * x3 + y2 * (x3 - x1) * x3 * x1 + y3 * (x1 - x2) * x1 * x2;
-  c /= denominator1;
-  c /= denominator2;
-  c /= denominator3;
-  if (overflow(a) || overflow(b) || overflow(c)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
-    return;
-  }
-  //Check parabola vertex position
-  if (a == static_cast<T>(0)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+  integrators = reinterpret_cast<uint64_t *>(malloc(stages * sizeof(uint64_t)));
+  combDelays = reinterpret_cast<uint64_t *>(malloc(stages * sizeof(uint64_t)));
+  if (!integrators || !combDelays) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
     return;
   }
-  h = b / a / static_cast<T>(-2);
-  //k = c - h * h;
-  if (overflow(h)) return;
-  T xmin = x1;
-  if (x2 < xmin) xmin = x2;
-  if (x3 < xmin) xmin = x3;
-  T xmax = x3;
-  if (x2 > xmax) xmax = x2;
-  if (x1 > xmax) xmax = x1;
-  if ((h > xmin) && (h < xmax)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::WARNING_INIT_DATA_INCORRECT);
-    return;
+  for (size_t i = 0; i < stages; i++) {
+    integrators[i] = 0;
+    combDelays[i] = 0;
+    gain *= static_cast<int64_t>(factor);
   }
+  this->factor = factor;
+  this->stages = stages;
   TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 template <typename T, typename Timestamp>
-SquareScale<T, Timestamp>::SquareScale(const T & a, const T & b, const T & c) {
-  static const size_t inputNumber = 1;
-  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  this->a = a;
-  this->b = b;
-  this->c = c;
-  if (overflow(a) || overflow(b) || overflow (c)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
-    return;
+Decimator<T, Timestamp>::~Decimator() {
+  if (integrators) free(integrators);
+  if (combDelays) free(combDelays);
+}
+
+template <typename T, typename Timestamp>
+void Decimator<T, Timestamp>::integrate(uint64_t input) {
+  /// @brief Passes input through integrators
+  /// @param input Raw input value, sign-extended to 64 bits
+  for (size_t i = 0; i < stages; i++) {
+    integrators[i] += input;
+    input = integrators[i];
   }
-  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 template <typename T, typename Timestamp>
-typename TemplateFilter<T, Timestamp>::Status SquareScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+int64_t Decimator<T, Timestamp>::comb(void) {
+  /// @brief Passes integrators output through combs
+  /// @return Sum of inputs weighted by CIC filter response (gain times the output)
+  uint64_t value = integrators[stages - 1];
+  for (size_t i = 0; i < stages; i++) {
+    const uint64_t delayed = combDelays[i];
+    combDelays[i] = value;
+    value -= delayed;
+  }
+  return (static_cast<int64_t>(value));
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status Decimator<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
   (void)timestamp;
   if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
-  output = a * inputs[0] * inputs[0] + b * inputs[0] + c;
+  const uint64_t input = static_cast<uint64_t>(static_cast<int64_t>(inputs[0].getRaw()));
+  if (overflowCountdown) overflowCountdown--;
+  if (overflow(inputs[0])) {
+    overflowCountdown = stages * (factor - 1) + 1;
+    overflowOutput = inputs[0];
+  }
+  if (!initialised) {
+    //Run the filter with the first input until steady state
+    for (size_t i = 0; i < (factor * stages - 1); i++) {
+      integrate(input);
+      if (++phase == factor) {
+        phase = 0;
+        comb();
+      }
+    }
+    initialised = true;
+  }
+  integrate(input);
+  if (++phase < factor) {
+    output = lastOutput;
+    return (TemplateFilter<T, Timestamp>::Status::OUTPUT_NOT_READY);
+  }
+  phase = 0;
+  const int64_t sum = comb();
+  const int64_t rounding = (sum < 0) ? -(gain / 2) : (gain / 2);
+  lastOutput = overflowCountdown ? overflowOutput : T::fromIntermediary((sum + rounding) / gain);
+  output = lastOutput;
   return (TemplateFilter<T, Timestamp>::Status::OK);
 }
 
 //////////////////////////////////////////////////////////////////////
-// SplineScale
+// Kalman
 //////////////////////////////////////////////////////////////////////
 
+/// @brief Common part of Kalman filters
+/// @details Each filter input is a measurement of the same quantity with its own
+/// measurement noise variance (e.g. temperature from two different sensors); the
+/// measurements are fused by sequential updates. Overflow inputs are treated as missing
+/// measurements.
+/// @par Filter state and covariance are intermediary values with
+/// FixedPointMath::fractionBits fraction bits; time between inputs is measured in time
+/// units of timeDivider timestamps and is capped at maxDeltaTime time units.
+/// @tparam T FixedPoint type
 template <typename T, typename Timestamp>
-class SplineScale : public TemplateFilter<T, Timestamp> {
+class KalmanBase : public TemplateFilter<T, Timestamp> {
   public:
-    SplineScale(const T &x1, const T &y1,
-                const T &x2, const T &y2,
-                const T &x3, const T &y3);
-    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~KalmanBase();
+  protected:
+    KalmanBase(const T &processNoise, const T *measurementNoise, size_t inputsNumber, const T &timeDivider);
+    inline int64_t getMeasurementNoise(size_t index) const;
+    inline size_t getMeasurementsNumber(size_t inputsNumber) const;
+    int64_t getDeltaTimeUnits(Timestamp timestamp);
+  protected:
+    int64_t processNoise = 0;
   private:
-    T a1 = static_cast<T>(0);
-    T b1 = static_cast<T>(1);
-    T a2 = static_cast<T>(0);
-    T b2 = static_cast<T>(1);
-    T x1 = static_cast<T>(0);
-    T y1 = static_cast<T>(0);
-    T x2 = static_cast<T>(0);
-    T y2 = static_cast<T>(0);
-    T x3 = static_cast<T>(0);
-    T y3 = static_cast<T>(0);
+    int64_t * measurementNoise = nullptr;
+    size_t measurementNoiseNumber = 0;
+    int64_t timeDivider = 0;
 };
 
 template <typename T, typename Timestamp>
-SplineScale<T, Timestamp>::SplineScale(
-  const T & xMin, const T & yMin,
-  const T & xMid, const T & yMid,
-  const T & xMax, const T & yMax) {
-  //Set input number
-  static const size_t inputNumber = 1;
-  TemplateFilter<T, Timestamp>::setInputsNumber(inputNumber, inputNumber);
-  //Initialise points
-  x1 = xMin;
-  y1 = yMin;
-  x2 = xMid;
-  y2 = yMid;
-  x3 = xMax;
-  y3 = yMax;
-  //Sort points by x in accending order
-  struct TSwapHelper {
-    inline static void swap(T &a, T &b) {
-      T temp = a;
-      a = b;
-      b = temp;
-    }
-  };
-  if (x1 > x2) {
-    TSwapHelper::swap(x1, x2);
-    TSwapHelper::swap(y1, y2);
-  }
-  if (x2 > x3) {
-    TSwapHelper::swap(x2, x3);
-    TSwapHelper::swap(y2, y3);
-  }
-  if (x1 > x2) {
-    TSwapHelper::swap(x1, x2);
-    TSwapHelper::swap(y1, y2);
-  }
-
-  //Calculate cubic spline coefficients
-  const T denominator1 = 2 * (x1 - x2);
-  const T denominator2 = x1 - x3;
-  const T denominator3 = x2 - x3;
-  if ((denominator1 == static_cast<T>(0)) ||
-      (denominator2 == static_cast<T>(0)) ||
-      (denominator3 == static_cast<T>(0))) {
+KalmanBase<T, Timestamp>::KalmanBase(const T & processNoise, const T * measurementNoise, size_t inputsNumber, const T & timeDivider) {
+  /// @brief Initialises process and measurement noise
+  /// @param processNoise Process noise variance per time unit
+  /// @param measurementNoise Array of measurement noise variances, one per input
+  /// @param inputsNumber Number of inputs
+  /// @param timeDivider Number of timestamps in time unit, e.g. 1000 if timestamp is in milliseconds and time unit is second
+  static const size_t minInputs = 1;
+  TemplateFilter<T, Timestamp>::setInputsNumber(minInputs, inputsNumber);
+  if (!measurementNoise || !inputsNumber || (processNoise < static_cast<T>(0)) || overflow(processNoise) ||
+      (timeDivider <= static_cast<T>(0)) || overflow(timeDivider)) {
     TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
     return;
   }
-  a1 = x1 * (y2 - y3) + x2 * (y3 - y1) + x3 * (y1 - y2);
-  a1 /= denominator1;
-  a1 /= denominator2;
-  a1 /= denominator3;
-  a1 /= (x1 - x2);
-  a2 = a1 * (x2 - x1);
-  a2 /= (x2 - x3);
-  b1 = x1 * x1 * (y3 - y2) - x1 * (x2 * (-3 * y1 + y2 + 2 * y3) + 3 * x3 * (y1 - y2)) + x2 * x2 * (y3 - y1) + x2 * x3 * (y2 - y1) + 2 * x3 * x3 * (y1 - y2);
-  b1 /= denominator1;
-  b1 /= denominator2;
-  b1 /= denominator3;
-  b2 = 2 * x1 * x1 * (y2 - y3) + x2 * (x1 * (y3 - y2) + x3 * (2 * y1 + y2 - 3 * y3)) + 3 * x1 * x3 * (y3 - y2) + x2 * x2 * (y3 - y1) + x3 * x3 * (y2 - y1);
-  b2 /= denominator1;
-  b2 /= denominator2;
-  b2 /= denominator3;
-  //Check validity
-  if (overflow(a1) || overflow(a2) || overflow(b1) || overflow(b2)) {
-    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_FAILED);
+  for (size_t i = 0; i < inputsNumber; i++) {
+    if ((measurementNoise[i] <= static_cast<T>(0)) || overflow(measurementNoise[i])) {
+      TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_DATA_INCORRECT);
+      return;
+    }
+  }
+  this->measurementNoise = reinterpret_cast<int64_t *>(malloc(inputsNumber * sizeof(int64_t)));
+  if (!this->measurementNoise) {
+    TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::ERROR_INIT_NOT_ENOUGH_MEMORY);
     return;
   }
-  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+  for (size_t i = 0; i < inputsNumber; i++)
+    this->measurementNoise[i] = FixedPointMath::fromFixedPoint(measurementNoise[i]);
+  measurementNoiseNumber = inputsNumber;
+  this->processNoise = FixedPointMath::fromFixedPoint(processNoise);
+  this->timeDivider = FixedPointMath::fromFixedPoint(timeDivider);
+  TemplateFilter<T, Timestamp>::setInitStatus(TemplateFilter<T, Timestamp>::Status::OK);
+}
+
+template <typename T, typename Timestamp>
+KalmanBase<T, Timestamp>::~KalmanBase() {
+  if (measurementNoise) free(measurementNoise);
+}
+
+template <typename T, typename Timestamp>
+int64_t KalmanBase<T, Timestamp>::getMeasurementNoise(size_t index) const {
+  return (measurementNoise[index]);
+}
+
+template <typename T, typename Timestamp>
+size_t KalmanBase<T, Timestamp>::getMeasurementsNumber(size_t inputsNumber) const {
+  /// @brief Limits number of inputs to the number of measurement noise values
+  return ((inputsNumber < measurementNoiseNumber) ? inputsNumber : measurementNoiseNumber);
+}
+
+template <typename T, typename Timestamp>
+int64_t KalmanBase<T, Timestamp>::getDeltaTimeUnits(Timestamp timestamp) {
+  /// @brief Calculates time since last input
+  /// @return Time in time units with FixedPointMath::fractionBits fraction bits
+  static const int64_t maxDeltaTime = static_cast<int64_t>(1024) << FixedPointMath::fractionBits;
+  const int64_t deltaTime = static_cast<int64_t>(this->getDeltaTime(timestamp)) << FixedPointMath::fractionBits;
+  const int64_t deltaTimeUnits = FixedPointMath::divIntermediary(deltaTime, timeDivider);
+  return ((deltaTimeUnits > maxDeltaTime) ? maxDeltaTime : deltaTimeUnits);
+}
+
+/// @brief Scalar Kalman filter
+/// @details Estimates a slowly changing quantity modelled as random walk: its variance
+/// increases by processNoise per time unit between inputs. For each measurement z with
+/// noise variance r, gain K = P / (P + r) is applied: x += K * (z - x), P -= K * P.
+/// @par Output for the first input equals the first valid measurement.
+/// @tparam T FixedPoint type
+template <typename T, typename Timestamp>
+class Kalman : public KalmanBase<T, Timestamp> {
+  public:
+    Kalman(const T &processNoise, const T &measurementNoise, const T &timeDivider = static_cast<T>(1));
+    Kalman(const T &processNoise, const T *measurementNoise, size_t inputsNumber, const T &timeDivider = static_cast<T>(1));
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    virtual ~Kalman() {}
+  private:
+    int64_t estimate = 0;
+    int64_t variance = 0;
+    boolean initialised = false;
+};
+
+template <typename T, typename Timestamp>
+Kalman<T, Timestamp>::Kalman(const T & processNoise, const T & measurementNoise, const T & timeDivider) :
+  KalmanBase<T, Timestamp>(processNoise, &measurementNoise, 1, timeDivider) {}
+
+template <typename T, typename Timestamp>
+Kalman<T, Timestamp>::Kalman(const T & processNoise, const T * measurementNoise, size_t inputsNumber, const T & timeDivider) :
+  KalmanBase<T, Timestamp>(processNoise, measurementNoise, inputsNumber, timeDivider) {}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status Kalman<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
+  if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
+  const int64_t deltaTime = this->getDeltaTimeUnits(timestamp);
+  if (initialised) variance += FixedPointMath::mulIntermediary(this->processNoise, deltaTime);
+  for (size_t i = 0; i < this->getMeasurementsNumber(inputsNumber); i++) {
+    if (overflow(inputs[i])) continue;
+    const int64_t measurement = FixedPointMath::fromFixedPoint(inputs[i]);
+    const int64_t measurementNoise = this->getMeasurementNoise(i);
+    if (!initialised) {
+      estimate = measurement;
+      variance = measurementNoise;
+      initialised = true;
+      continue;
+    }
+    const int64_t gain = FixedPointMath::divIntermediary(variance, variance + measurementNoise);
+    estimate += FixedPointMath::mulIntermediary(gain, measurement - estimate);
+    variance -= FixedPointMath::mulIntermediary(gain, variance);
+  }
+  output = initialised ? FixedPointMath::toFixedPoint<T>(estimate) : inputs[0];
+  return (TemplateFilter<T, Timestamp>::Status::OK);
 }
 
+/// @brief Two-state Kalman filter
+/// @details Estimates a quantity and its rate of change (per time unit) with constant
+/// rate model; processNoise is variance of the rate change per time unit (white noise
+/// acceleration). Covariance prediction for time dt:
+/// P00 += dt * (2 * P01 + dt * P11) + q * dt^3 / 3, P01 += dt * P11 + q * dt^2 / 2,
+/// P11 += q * dt. For each measurement z with noise variance r, gains are
+/// K0 = P00 / (P00 + r) and K1 = P01 / (P00 + r).
+/// @par Output is the estimated quantity; estimated rate is available with getRate().
+/// @par The filter is initialised with the first valid measurement and zero rate; initial
+/// rate variance equals measurement noise variance per time unit squared.
+/// @tparam T FixedPoint type
 template <typename T, typename Timestamp>
-typename TemplateFilter<T, Timestamp>::Status SplineScale<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
-  (void)timestamp;
+class Kalman2 : public KalmanBase<T, Timestamp> {
+  public:
+    Kalman2(const T &processNoise, const T &measurementNoise, const T &timeDivider = static_cast<T>(1));
+    Kalman2(const T &processNoise, const T *measurementNoise, size_t inputsNumber, const T &timeDivider = static_cast<T>(1));
+    virtual typename TemplateFilter<T, Timestamp>::Status filterProcess(const T *inputs, size_t inputsNumber, T &output, Timestamp timestamp);
+    T getRate(void) const;
+    virtual ~Kalman2() {}
+  private:
+    void predict(int64_t deltaTime);
+    void update(int64_t measurement, int64_t measurementNoise);
+  private:
+    int64_t estimate = 0;
+    int64_t rate = 0;
+    int64_t p00 = 0, p01 = 0, p11 = 0;  ///< Covariance matrix (symmetric)
+    boolean initialised = false;
+};
+
+template <typename T, typename Timestamp>
+Kalman2<T, Timestamp>::Kalman2(const T & processNoise, const T & measurementNoise, const T & timeDivider) :
+  KalmanBase<T, Timestamp>(processNoise, &measurementNoise, 1, timeDivider) {}
+
+template <typename T, typename Timestamp>
+Kalman2<T, Timestamp>::Kalman2(const T & processNoise, const T * measurementNoise, size_t inputsNumber, const T & timeDivider) :
+  KalmanBase<T, Timestamp>(processNoise, measurementNoise, inputsNumber, timeDivider) {}
+
+template <typename T, typename Timestamp>
+T Kalman2<T, Timestamp>::getRate(void) const {
+  /// @brief Returns estimated rate of change of the filtered quantity
+  /// @return Rate of change per time unit
+  return (FixedPointMath::toFixedPoint<T>(rate));
+}
+
+template <typename T, typename Timestamp>
+void Kalman2<T, Timestamp>::predict(int64_t deltaTime) {
+  /// @param deltaTime Time since last input in time units
+  if (!deltaTime) return;
+  const int64_t deltaTime2 = FixedPointMath::mulIntermediary(deltaTime, deltaTime);
+  const int64_t deltaTime3 = FixedPointMath::mulIntermediary(deltaTime2, deltaTime);
+  const int64_t q = this->processNoise;
+  estimate += FixedPointMath::mulIntermediary(rate, deltaTime);
+  p00 += FixedPointMath::mulIntermediary(deltaTime, 2 * p01 + FixedPointMath::mulIntermediary(deltaTime, p11)) +
+         FixedPointMath::mulIntermediary(q, deltaTime3) / 3;
+  p01 += FixedPointMath::mulIntermediary(deltaTime, p11) + FixedPointMath::mulIntermediary(q, deltaTime2) / 2;
+  p11 += FixedPointMath::mulIntermediary(q, deltaTime);
+}
+
+template <typename T, typename Timestamp>
+void Kalman2<T, Timestamp>::update(int64_t measurement, int64_t measurementNoise) {
+  const int64_t innovationVariance = p00 + measurementNoise;
+  const int64_t gain0 = FixedPointMath::divIntermediary(p00, innovationVariance);
+  const int64_t gain1 = FixedPointMath::divIntermediary(p01, innovationVariance);
+  const int64_t innovation = measurement - estimate;
+  estimate += FixedPointMath::mulIntermediary(gain0, innovation);
+  rate += FixedPointMath::mulIntermediary(gain1, innovation);
+  p11 -= FixedPointMath::mulIntermediary(gain1, p01);
+  p01 -= FixedPointMath::mulIntermediary(gain0, p01);
+  p00 -= FixedPointMath::mulIntermediary(gain0, p00);
+}
+
+template <typename T, typename Timestamp>
+typename TemplateFilter<T, Timestamp>::Status Kalman2<T, Timestamp>::filterProcess(const T * inputs, size_t inputsNumber, T & output, Timestamp timestamp) {
   if (!inputsNumber) return (TemplateFilter<T, Timestamp>::Status::ERROR_TOO_FEW_INPUTS);
-  output = (inputs[0] < x2) ?
-           (a1 * (inputs[0] - x1) * (inputs[0] - x1) * (inputs[0] - x1) + b1 * (inputs[0] - x1) + y1) :
-           (a2 * (inputs[0] - x3) * (inputs[0] - x3) * (inputs[0] - x3) + b2 * (inputs[0] - x3) + y3);
+  const int64_t deltaTime = this->getDeltaTimeUnits(timestamp);
+  if (initialised) predict(deltaTime);
+  for (size_t i = 0; i < this->getMeasurementsNumber(inputsNumber); i++) {
+    if (overflow(inputs[i])) continue;
+    const int64_t measurement = FixedPointMath::fromFixedPoint(inputs[i]);
+    const int64_t measurementNoise = this->getMeasurementNoise(i);
+    if (!initialised) {
+      estimate = measurement;
+      rate = 0;
+      p00 = measurementNoise;
+      p01 = 0;
+      p11 = measurementNoise;
+      initialised = true;
+      continue;
+    }
+    update(measurement, measurementNoise);
+  }
+  output = initialised ? FixedPointMath::toFixedPoint<T>(estimate) : inputs[0];
   return (TemplateFilter<T, Timestamp>::Status::OK);
 }
 
@@ -1368,15 +4707,39 @@ typename TemplateFilter<T, Timestamp>::Status SplineScale<T, Timestamp>::filterP
 using Filter = TemplateFilter<Value, Timestamp>;
 using FilterMovingAverage = MovingAverage<Value, Timestamp>;
 using FilterLowPass = LowPass<Value, Timestamp>;
+using FilterLowPassTable = LowPassTable<Value, Timestamp>;
 using FilterLinearScale = LinearScale<Value, Timestamp>;
 using FilterSquareScale = SquareScale<Value, Timestamp>;
 using FilterSplineScale = SplineScale<Value, Timestamp>;
+using FilterPiecewiseLinearScale = PiecewiseLinearScale<Value, Timestamp>;
+using FilterNaturalSplineScale = NaturalSplineScale<Value, Timestamp>;
+using FilterExpScale = ExpScale<Value, Timestamp>;
+using FilterTableScale = TableScale<Value, Timestamp>;
+using FilterBiquad = Biquad<Value, Timestamp>;
+using FilterMovingMedian = MovingMedian<Value, Timestamp>;
+using FilterHampel = Hampel<Value, Timestamp>;
+using FilterStatistics = Statistics<Value, Timestamp>;
+using FilterDecimator = Decimator<Value, Timestamp>;
+using FilterKalman = Kalman<Value, Timestamp>;
+using FilterKalman2 = Kalman2<Value, Timestamp>;
 
 enum class FilterType {
   MOVING_AVERAGE,
   LOW_PASS,
   LINEAR_SCALE,
-  SQUARE_SCALE
+  SQUARE_SCALE,
+  EXP_SCALE,
+  BIQUAD,
+  MOVING_MEDIAN,
+  HAMPEL,
+  DECIMATOR,
+  LOW_PASS_TABLE,
+  KALMAN,
+  KALMAN2,
+  PIECEWISE_LINEAR_SCALE,
+  NATURAL_SPLINE_SCALE,
+  TABLE_SCALE,
+  STATISTICS
 };
 
 }; //namespace dsp
@@ -1387,6 +4750,9 @@ enum class FilterType {
 
 namespace quantity {
 
+struct UnitConversionEntry;
+class UnitConversion;
+
 //////////////////////////////////////////////////////////////////////
 // Quantity
 //////////////////////////////////////////////////////////////////////
@@ -1496,6 +4862,10 @@ class Quantity {
       /// @return Physical quantity numeric value
       return (setUnitValue);
     }
+    inline unit_t getUnit(void) const {
+      /// @return Measurement unit of getValue() in numeric form
+      return (setUnit);
+    }
     inline text_t PROGMEM getUnitText(void) const {
       /// @return C-string (in PROGMEM) with physical quantity measurement unit in
       /// human-readable form or nullptr if human-readable form was not provided
@@ -1517,6 +4887,13 @@ class Quantity {
                               text_t unitText = {},
                               value_t minRange = value_t(0),
                               value_t maxRange = value_t(0));
+    boolean applyConversion(unit_t unit,
+                            text_t unitText,
+                            const UnitConversion & conversion);
+    boolean convertByTable(unit_t unit,
+                           text_t unitText,
+                           const UnitConversionEntry * table,
+                           size_t tableSize);
   protected:
     inline value_t getInitValue(void) const {
       /// @return Value used to initialise the object
@@ -1604,6 +4981,88 @@ Quantity::Quantity(id_t id,
   this->setUnitValue = initValue;
 }
 
+//////////////////////////////////////////////////////////////////////
+// UnitConversion
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Affine conversion between two measurement units
+/// @details The converted value is calculated as value * scale + offset. Scale
+/// and offset are stored with extra fraction bits and the result is rounded only
+/// once, so that conversions such as Celsius to Fahrenheit (scale 9/5) do not
+/// accumulate the rounding errors of separate Value multiplication and division.
+/// @par The number of scale fraction bits is chosen for each conversion so that
+/// scale is stored with at least 30 significant bits, i.e. small scales (e.g. ppb
+/// to ppm) are as precise as large ones.
+/// @par The constructor is constexpr: the conversions specified by rational scale
+/// and offset are calculated at compile time.
+/// @par Overflow values are not converted and remain the same overflow values;
+/// the results exceeding Value range are capped to overflow values.
+class UnitConversion {
+  public:
+    /// @brief Initialises identity conversion
+    constexpr UnitConversion() : UnitConversion(1, 1) {}
+    /// @brief Initialises conversion value * scaleNumerator / scaleDenominator + offsetNumerator / offsetDenominator
+    /// @param scaleNumerator Numerator of scale, scale must be less than 2^29 by absolute value
+    /// @param scaleDenominator Denominator of scale, must be positive
+    /// @param offsetNumerator Numerator of offset, offset must be within Value range
+    /// @param offsetDenominator Denominator of offset, must be positive
+    constexpr UnitConversion(int32_t scaleNumerator,
+                             int32_t scaleDenominator,
+                             int32_t offsetNumerator = 0,
+                             int32_t offsetDenominator = 1) :
+      scale(divideRounded(static_cast<int64_t>(scaleNumerator) * (static_cast<int64_t>(1) << calculateShift(scaleNumerator, scaleDenominator)), scaleDenominator)),
+      offset(divideRounded(static_cast<int64_t>(offsetNumerator) * (static_cast<int64_t>(1) << (calculateShift(scaleNumerator, scaleDenominator) + ValueFractionBits)), offsetDenominator)),
+      shift(calculateShift(scaleNumerator, scaleDenominator)) {}
+  public:
+    inline Value apply(const Value & value) const {
+      /// @brief Converts single value
+      /// @param value Value to convert
+      /// @return Converted value
+      return (Value::fromRaw(applyElement(value.getRaw())));
+    }
+    void apply(const ValueBase * input, ValueBase * output, size_t count) const;
+    static boolean find(const UnitConversionEntry * table,
+                        size_t tableSize,
+                        uint8_t fromUnit,
+                        uint8_t toUnit,
+                        UnitConversion & conversion);
+  private:
+    inline ValueBase applyElement(ValueBase x) const;
+    static const size_t scaleBits = 30;  ///< Scale is less than 2^scaleBits after shifting
+    static const size_t maxShift = 30;   ///< Maximum number of scale fraction bits
+    static constexpr size_t calculateShift(int64_t numerator, int64_t denominator, size_t shift = maxShift) {
+      return (((shift == 0) || ((((numerator < 0) ? -numerator : numerator) << shift) < (denominator << scaleBits))) ?
+              shift :
+              calculateShift(numerator, denominator, shift - 1));
+    }
+    static constexpr int64_t divideRounded(int64_t dividend, int64_t divisor) {
+      return ((dividend >= 0) ? ((dividend + divisor / 2) / divisor) : ((dividend - divisor / 2) / divisor));
+    }
+  private:
+    int64_t scale;    ///< Scale with shift fraction bits
+    int64_t offset;   ///< Offset with shift + ValueFractionBits fraction bits
+    uint8_t shift;    ///< Number of scale fraction bits
+};
+
+ValueBase UnitConversion::applyElement(ValueBase x) const {
+  /// @brief Converts single value in its internal representation
+  /// @param x Raw value to convert
+  /// @return Converted raw value rounded to nearest and capped at Value range
+  if ((x == ValueBaseMin) || (x == ValueBaseMax)) return (x);
+  const int64_t rounding = (static_cast<int64_t>(1) << shift) >> 1;
+  const int64_t result = (static_cast<int64_t>(x) * scale + offset + rounding) >> shift;
+  if (result < static_cast<int64_t>(ValueBaseMin)) return (ValueBaseMin);
+  if (result > static_cast<int64_t>(ValueBaseMax)) return (ValueBaseMax);
+  return (static_cast<ValueBase>(result));
+}
+
+/// @brief Conversion table entry: conversion from one measurement unit to another
+struct UnitConversionEntry {
+  Quantity::unit_t fromUnit;
+  Quantity::unit_t toUnit;
+  UnitConversion conversion;
+};
+
 //////////////////////////////////////////////////////////////////////
 // Generic Quantity
 //////////////////////////////////////////////////////////////////////
@@ -1689,6 +5148,9 @@ class Dimensionless : public Quantity {
   public:
     boolean convertToUnit(Dimensionless::Unit unit);
     static text_t getUnitTextByUnit(Dimensionless::Unit unit);
+    static boolean getConversion(Dimensionless::Unit fromUnit,
+                                 Dimensionless::Unit toUnit,
+                                 UnitConversion & conversion);
 };
 
 
@@ -1731,13 +5193,505 @@ class Temperature : public Quantity {
   public:
     boolean convertToUnit(Temperature::Unit unit);
     static text_t getUnitTextByUnit(Temperature::Unit unit);
+    static boolean getConversion(Temperature::Unit fromUnit,
+                                 Temperature::Unit toUnit,
+                                 UnitConversion & conversion);
+};
+
+//////////////////////////////////////////////////////////////////////
+// Concentration
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Concentration of a gas in the air as physical quantity
+/// @details The available measurement units are PPM, PPB and MG_PER_CUBIC_METER,
+/// representing parts per million, parts per billion (by volume) and milligrams
+/// per cubic meter respectively
+/// @par Conversion between PPM and PPB is always possible. Conversion to or from
+/// MG_PER_CUBIC_METER requires molar mass of the gas (in grams per mole) and assumes
+/// molar volume of 24.45 litres per mole (25 degrees Celsius, 101.325 kPa).
+class Concentration : public Quantity {
+  public:
+    enum class Unit : unit_t {
+      PPM,                  ///< Parts per million
+      PPB,                  ///< Parts per billion
+      MG_PER_CUBIC_METER,   ///< Milligrams per cubic meter
+    };
+  public:
+    INTROSPECTED_SET_CLASS_TYPE(INTROSPECTED_CLASS_TYPE_AUTO());
+  public:
+    inline Concentration (id_t id,
+                          id_t idGroup,
+                          value_t value,
+                          Unit unit,
+                          value_t molarMass = {},
+                          timestamp_t timestamp = {},
+                          boolean valid = true,
+                          value_t minRange = {},
+                          value_t maxRange = {})
+      : Quantity(id,
+                 idGroup,
+                 value,
+                 static_cast<unit_t>(unit),
+                 getUnitTextByUnit(unit),
+                 timestamp,
+                 valid,
+                 minRange,
+                 maxRange)
+    {
+      INTROSPECTED_SET_OBJECT_TYPE();
+      this->molarMass = molarMass;
+    }
+  public:
+    boolean convertToUnit(Concentration::Unit unit);
+    static text_t getUnitTextByUnit(Concentration::Unit unit);
+    static boolean getConversion(Concentration::Unit fromUnit,
+                                 Concentration::Unit toUnit,
+                                 value_t molarMass,
+                                 UnitConversion & conversion);
+    inline value_t getMolarMass(void) const {
+      /// @return Molar mass of the gas in grams per mole or zero if not set
+      return (molarMass);
+    }
+  private:
+    value_t molarMass {};  ///< Molar mass of the gas, grams per mole
+};
+
+//////////////////////////////////////////////////////////////////////
+// Humidity
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Air humidity as physical quantity
+/// @details The available measurement units are RELATIVE and ABSOLUTE,
+/// representing relative humidity (percent) and absolute humidity (grams of
+/// water vapour per cubic meter) respectively
+/// @par Air temperature (degrees Celsius) is required for conversion between
+/// relative and absolute humidity and for dew point calculation. Saturation
+/// vapour pressure is calculated by Magnus formula; the conversion is valid for
+/// temperatures from -45 to 60 degrees Celsius.
+class Humidity : public Quantity {
+  public:
+    enum class Unit : unit_t {
+      RELATIVE,   ///< Relative humidity, percent
+      ABSOLUTE,   ///< Absolute humidity, grams per cubic meter
+    };
+  public:
+    INTROSPECTED_SET_CLASS_TYPE(INTROSPECTED_CLASS_TYPE_AUTO());
+  public:
+    inline Humidity (id_t id,
+                     id_t idGroup,
+                     value_t value,
+                     Unit unit,
+                     value_t temperature,
+                     timestamp_t timestamp = {},
+                     boolean valid = true,
+                     value_t minRange = {},
+                     value_t maxRange = {})
+      : Quantity(id,
+                 idGroup,
+                 value,
+                 static_cast<unit_t>(unit),
+                 getUnitTextByUnit(unit),
+                 timestamp,
+                 valid,
+                 minRange,
+                 maxRange)
+    {
+      INTROSPECTED_SET_OBJECT_TYPE();
+      this->temperature = temperature;
+    }
+  public:
+    boolean convertToUnit(Humidity::Unit unit);
+    static text_t getUnitTextByUnit(Humidity::Unit unit);
+    static boolean getConversion(Humidity::Unit fromUnit,
+                                 Humidity::Unit toUnit,
+                                 value_t temperature,
+                                 UnitConversion & conversion);
+    value_t getDewPoint(void) const;
+    inline value_t getTemperature(void) const {
+      /// @return Air temperature in degrees Celsius
+      return (temperature);
+    }
+  private:
+    static int64_t absoluteHumidityFactor(value_t temperature);
+  private:
+    value_t temperature {};  ///< Air temperature, degrees Celsius
+};
+
+//////////////////////////////////////////////////////////////////////
+// Pressure
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Pressure as physical quantity
+/// @details The available measurement units are PASCAL, HECTOPASCAL, KILOPASCAL
+/// and MM_HG, representing pascals, hectopascals, kilopascals and millimeters
+/// of mercury respectively
+class Pressure : public Quantity {
+  public:
+    enum class Unit : unit_t {
+      PASCAL,       ///< Pascals
+      HECTOPASCAL,  ///< Hectopascals (millibars)
+      KILOPASCAL,   ///< Kilopascals
+      MM_HG,        ///< Millimeters of mercury
+    };
+  public:
+    INTROSPECTED_SET_CLASS_TYPE(INTROSPECTED_CLASS_TYPE_AUTO());
+  public:
+    inline Pressure (id_t id,
+                     id_t idGroup,
+                     value_t value,
+                     Unit unit,
+                     timestamp_t timestamp = {},
+                     boolean valid = true,
+                     value_t minRange = {},
+                     value_t maxRange = {})
+      : Quantity(id,
+                 idGroup,
+                 value,
+                 static_cast<unit_t>(unit),
+                 getUnitTextByUnit(unit),
+                 timestamp,
+                 valid,
+                 minRange,
+                 maxRange)
+    {
+      INTROSPECTED_SET_OBJECT_TYPE();
+    }
+  public:
+    boolean convertToUnit(Pressure::Unit unit);
+    static text_t getUnitTextByUnit(Pressure::Unit unit);
+    static boolean getConversion(Pressure::Unit fromUnit,
+                                 Pressure::Unit toUnit,
+                                 UnitConversion & conversion);
+};
+
+//////////////////////////////////////////////////////////////////////
+// QuantityVisitor
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Selects reflected type with the same constness as quantity type Q
+template <class T, class Q>
+struct ReflectedQuantity {
+  typedef T type;
+};
+
+template <class T, class Q>
+struct ReflectedQuantity<T, const Q> {
+  typedef const T type;
+};
+
+/// @brief Reflects quantity to type T preserving constness
+/// @tparam T Concrete quantity type
+/// @tparam Q Quantity or const Quantity
+/// @param quantity Quantity to reflect
+/// @return Reference to quantity reflected to type T
+template <class T, class Q>
+inline typename ReflectedQuantity<T, Q>::type & reflectQuantity(Q & quantity) {
+  typedef typename ReflectedQuantity<T, Q>::type Reflected;
+  return (*REFLECT_OBJECT(Reflected, &quantity));
+}
+
+/// @brief Passes quantity to a handler as its concrete type
+/// @details The object type of the quantity is obtained once and matched against
+/// class types of Types; the handler is then called with the quantity reflected to
+/// the matching concrete type. No virtual methods are involved: the matching is
+/// a chain of comparisons with compile-time constants, and every handler call is
+/// resolved at compile time.
+/// @par If object type does not match any of Types, the handler is called with
+/// the quantity reflected to Generic (which is always a valid reflection since
+/// Generic does not add any data to Quantity).
+/// @par The handler is a function object with operator() accepting every type
+/// from Types and Generic (templated operator() can be used to handle several
+/// types the same way). All overloads must return the same type; this type is
+/// returned by visit().
+/// @par Example:
+///
+///     struct ToFahrenheit {
+///       boolean operator()(Temperature & t) { return (t.convertToUnit(Temperature::Unit::FAHRENHEIT)); }
+///       template <class T> boolean operator()(T &) { return (false); }
+///     };
+///     QuantityVisitor<Dimensionless, Temperature>::visit(quantity, ToFahrenheit());
+///
+/// @tparam Types Concrete quantity classes recognised by the visitor
+template <class... Types>
+class QuantityVisitor;
+
+template <>
+class QuantityVisitor<> {
+  public:
+    template <class Q, class Handler>
+    static inline auto visit(Q & quantity, Handler && handler)
+    -> decltype(handler(reflectQuantity<Generic>(quantity))) {
+      /// @brief Passes quantity to the handler as Generic
+      /// @param quantity Quantity to pass to the handler
+      /// @param handler Function object to call
+      /// @return Value returned by handler
+      return (handler(reflectQuantity<Generic>(quantity)));
+    }
+  private:
+    template <class... OtherTypes> friend class QuantityVisitor;
+    template <class Q, class Handler>
+    static inline auto dispatch(TYPE_ID, Q & quantity, Handler & handler)
+    -> decltype(handler(reflectQuantity<Generic>(quantity))) {
+      return (handler(reflectQuantity<Generic>(quantity)));
+    }
+};
+
+template <class T, class... Types>
+class QuantityVisitor<T, Types...> {
+  public:
+    template <class Q, class Handler>
+    static inline auto visit(Q & quantity, Handler && handler)
+    -> decltype(handler(reflectQuantity<Generic>(quantity))) {
+      /// @brief Passes quantity to the handler as its concrete type
+      /// @param quantity Quantity (or const Quantity) to pass to the handler
+      /// @param handler Function object to call
+      /// @return Value returned by handler
+      return (dispatch(quantity.getObjectType(), quantity, handler));
+    }
   private:
-    static value_t celsiusToFahrenheit(value_t celsiusValue);
-    static value_t fahrenheitToCelsius(value_t fahrenheitValue);
+    template <class... OtherTypes> friend class QuantityVisitor;
+    template <class Q, class Handler>
+    static inline auto dispatch(TYPE_ID objectType, Q & quantity, Handler & handler)
+    -> decltype(handler(reflectQuantity<Generic>(quantity))) {
+      if (objectType == INTROSPECT_CLASS(T))
+        return (handler(reflectQuantity<T>(quantity)));
+      return (QuantityVisitor<Types...>::dispatch(objectType, quantity, handler));
+    }
 };
 
+/// @brief Visitor recognising all concrete quantity classes
+typedef QuantityVisitor<Generic, Dimensionless, Temperature, Concentration, Humidity, Pressure> AllQuantitiesVisitor;
+
 }; //namespace quantity
 
+//////////////////////////////////////////////////////////////////////
+// Compact encoding of timestamped value series
+//////////////////////////////////////////////////////////////////////
+
+namespace series {
+
+/// @brief Single sample of timestamped value series
+struct Sample {
+  Timestamp timestamp;
+  Value value;
+};
+
+//////////////////////////////////////////////////////////////////////
+// SeriesEncoder
+//////////////////////////////////////////////////////////////////////
+
+/// @brief Encodes series of timestamped values into compact byte stream
+/// @details Timestamps are delta-of-delta encoded: for samples taken at regular
+/// intervals the encoded difference is zero. Values are delta encoded using their
+/// internal (raw) representation. Both are then zig-zag encoded (so that small
+/// negative differences become small unsigned numbers) and stored as variable
+/// length integers (7 bits per byte, most significant bit set if more bytes follow).
+/// @par A sample taken at a regular interval with a slowly changing value is
+/// typically encoded in 2 or 3 bytes.
+/// @par All differences are calculated modulo 2^32, so the encoding is lossless for
+/// any timestamps and values including timestamp rollover and overflown values.
+class SeriesEncoder {
+  public:
+    static const size_t maxSampleSize = 10; ///< Maximum size of single encoded sample in bytes
+  public:
+    inline SeriesEncoder(uint8_t * buffer, size_t bufferSize);
+    inline boolean validate(void) const;
+    boolean encode(const Sample & sample);
+    inline boolean encode(Timestamp timestamp, const Value & value);
+    inline boolean encode(const quantity::Quantity & quantity);
+    inline void reset(void);
+    inline size_t size(void) const;
+    inline size_t count(void) const;
+    inline const uint8_t * data(void) const;
+  public:
+    static inline uint32_t zigZagEncode(int32_t value);
+    static inline int32_t zigZagDecode(uint32_t value);
+    static size_t writeVarint(uint8_t * buffer, uint32_t value);
+    static size_t readVarint(const uint8_t * buffer, size_t bufferSize, uint32_t & value);
+  private:
+    uint8_t * buffer = NULL;
+    size_t bufferSize = 0;
+    size_t position = 0;
+    size_t samples = 0;
+    uint32_t previousTimestamp = 0;
+    uint32_t previousTimestampDelta = 0;
+    uint32_t previousValue = 0;
+};
+
+/// @param buffer Buffer to store encoded samples
+/// @param bufferSize Size of the buffer in bytes
+SeriesEncoder::SeriesEncoder(uint8_t * buffer, size_t bufferSize) {
+  if (!buffer) return;
+  this->buffer = buffer;
+  this->bufferSize = bufferSize;
+}
+
+/// @brief Checks if the encoder is initialised
+boolean SeriesEncoder::validate(void) const {
+  return (buffer && bufferSize);
+}
+
+/// @brief Encodes the sample and appends it to the buffer
+/// @param timestamp Timestamp of the sample
+/// @param value Value of the sample
+/// @return true if the sample was encoded, false if there is not enough space in buffer
+boolean SeriesEncoder::encode(Timestamp timestamp, const Value & value) {
+  Sample sample;
+  sample.timestamp = timestamp;
+  sample.value = value;
+  return (encode(sample));
+}
+
+/// @brief Encodes timestamp and value of the physical quantity
+/// @details Value is encoded in the currently set measurement unit; id, unit and
+/// validity are not encoded and need to be stored separately for the whole series
+/// @param quantity Physical quantity
+/// @return true if the sample was encoded, false if there is not enough space in buffer
+boolean SeriesEncoder::encode(const quantity::Quantity & quantity) {
+  return (encode(quantity.getTimestamp(), quantity.getValue()));
+}
+
+/// @brief Removes all encoded samples and starts new series
+void SeriesEncoder::reset(void) {
+  position = 0;
+  samples = 0;
+  previousTimestamp = 0;
+  previousTimestampDelta = 0;
+  previousValue = 0;
+}
+
+/// @brief Returns size of the encoded data in bytes
+size_t SeriesEncoder::size(void) const {
+  return (position);
+}
+
+/// @brief Returns number of encoded samples
+size_t SeriesEncoder::count(void) const {
+  return (samples);
+}
+
+/// @brief Returns encoded data
+const uint8_t * SeriesEncoder::data(void) const {
+  return (buffer);
+}
+
+/// @brief Maps signed integers to unsigned so that numbers with small absolute
+/// value have small encoded values (0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, etc)
+uint32_t SeriesEncoder::zigZagEncode(int32_t value) {
+  return ((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+}
+
+/// @brief Reverses zigZagEncode()
+int32_t SeriesEncoder::zigZagDecode(uint32_t value) {
+  return (static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1)));
+}
+
+//////////////////////////////////////////////////////////////////////
+// SeriesDecoder
+//////////////////////////////////////////////////////////////////////
+
+class SeriesDecoder;
+
+/// @brief Forward iterator over the samples decoded by SeriesDecoder
+/// @details Provides range-based for loop support for SeriesDecoder. Each sample
+/// is decoded when the iterator is incremented. Iteration stops at the end of the
+/// data or at malformed data.
+class SeriesIterator {
+  public:
+    inline SeriesIterator(SeriesDecoder * decoder);
+    inline const Sample & operator * (void) const;
+    inline SeriesIterator & operator ++ (void);
+    inline boolean operator != (const SeriesIterator & other) const;
+  private:
+    SeriesDecoder * decoder;
+    Sample sample;
+};
+
+/// @brief Decodes the byte stream produced by SeriesEncoder
+/// @details Samples are decoded one at a time with decode() or with range-based
+/// for loop:
+/// @par
+///     util::series::SeriesDecoder decoder(encoder.data(), encoder.size());
+///     for (const util::series::Sample & sample : decoder) { ... }
+class SeriesDecoder {
+  public:
+    inline SeriesDecoder(const uint8_t * buffer, size_t size);
+    boolean decode(Sample & sample);
+    inline void rewind(void);
+    inline boolean finished(void) const;
+    inline boolean error(void) const;
+    inline SeriesIterator begin(void);
+    inline SeriesIterator end(void);
+  private:
+    const uint8_t * buffer = NULL;
+    size_t bufferSize = 0;
+    size_t position = 0;
+    size_t samples = 0;
+    boolean malformed = false;
+    uint32_t previousTimestamp = 0;
+    uint32_t previousTimestampDelta = 0;
+    uint32_t previousValue = 0;
+};
+
+/// @param buffer Encoded data
+/// @param size Size of the encoded data in bytes
+SeriesDecoder::SeriesDecoder(const uint8_t * buffer, size_t size) {
+  if (!buffer) return;
+  this->buffer = buffer;
+  this->bufferSize = size;
+}
+
+/// @brief Restarts decoding from the first sample
+void SeriesDecoder::rewind(void) {
+  position = 0;
+  samples = 0;
+  malformed = false;
+  previousTimestamp = 0;
+  previousTimestampDelta = 0;
+  previousValue = 0;
+}
+
+/// @brief Returns true if all data were decoded or malformed data were found
+boolean SeriesDecoder::finished(void) const {
+  return (malformed || (position >= bufferSize));
+}
+
+/// @brief Returns true if malformed (e.g. truncated) data were found
+boolean SeriesDecoder::error(void) const {
+  return (malformed);
+}
+
+/// @brief Rewinds the decoder and returns iterator pointing to the first sample
+SeriesIterator SeriesDecoder::begin(void) {
+  rewind();
+  return (SeriesIterator(this));
+}
+
+/// @brief Returns iterator pointing past the last sample
+SeriesIterator SeriesDecoder::end(void) {
+  return (SeriesIterator(nullptr));
+}
+
+/// @param decoder Decoder to decode samples from, or nullptr for end iterator
+SeriesIterator::SeriesIterator(SeriesDecoder * decoder) : decoder(decoder) {
+  ++(*this);
+}
+
+const Sample & SeriesIterator::operator * (void) const {
+  return (sample);
+}
+
+SeriesIterator & SeriesIterator::operator ++ (void) {
+  if (decoder && !decoder->decode(sample)) decoder = nullptr;
+  return (*this);
+}
+
+boolean SeriesIterator::operator != (const SeriesIterator & other) const {
+  return (decoder != other.decoder);
+}
+
+}; //namespace series
+
 }; //namespace util
 
 #endif